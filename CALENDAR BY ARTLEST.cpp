@@ -1,402 +1,11982 @@
-/*
-================================================================================
-PROFESSIONAL C++ CALENDAR IMPLEMENTATION SYSTEM
-================================================================================
-Purpose: Comprehensive calendar generation with date calculations and
-         statistical analysis for temporal data processing
-Author: Professional C++ Development Team
-Code hints and optimizations by artlest
-Platform: Cross-platform compatible (Online IDEs, Standard Compilers)
-Standards: C++11 Standard Library Implementation
-================================================================================
-*/
-
-#include <iostream>      // Provides standard input/output stream functionality
-#include <iomanip>       // Enables formatted output manipulation and precision control
-#include <string>        // Implements string class for text processing operations
-#include <vector>        // Provides dynamic array container for data storage
-#include <algorithm>     // Contains algorithmic functions for data manipulation
-
-using namespace std;
-
-/*
-================================================================================
-FUNCTION DECLARATIONS AND PROTOTYPES
-================================================================================
-*/
-
-// Function determines if specified year is a leap year using algorithmic calculation
-bool calculate_leap_year_status(int target_year);
-
-// Function calculates total days in specified month considering leap year conditions
-int calculate_month_day_count(int target_month, int target_year);
-
-// Function determines the starting day of week for specified month and year
-int calculate_month_starting_day(int target_month, int target_year);
-
-// Function generates and displays formatted calendar for specified month
-void generate_monthly_calendar_display(int target_month, int target_year);
-
-// Function performs statistical analysis on calendar data patterns
-void execute_calendar_statistics_analysis(int target_year);
-
-// Function validates date input parameters within acceptable ranges
-bool validate_date_input_parameters(int month_value, int year_value);
-
-// Function displays formatted program header with identification information
-void display_program_identification_header();
-
-// Function converts numeric month value to corresponding text representation
-string convert_month_number_to_text(int month_number);
-
-// Function calculates day of year for specified date parameters
-int calculate_day_of_year_position(int day_value, int month_value, int year_value);
-
-// Function displays progress indicator for calendar generation operations
-void display_calendar_generation_progress(int current_month, int total_months);
-
-/*
-================================================================================
-MAIN PROGRAM EXECUTION ENTRY POINT
-================================================================================
-*/
-
-int main() {
-    // Initialize primary execution parameters for calendar demonstration
-    const int demonstration_year = 2025;
-    const int total_demonstration_months = 12;
-    int current_processing_month = 1;
-    
-    // Display professional program identification header
-    display_program_identification_header();
-    
-    // Validate demonstration year parameters before processing
-    if (validate_date_input_parameters(1, demonstration_year)) {
-        cout << "Calendar Generation Parameters Validated Successfully" << endl;
-        cout << "Target Year: " << demonstration_year << endl;
-        cout << "Processing Mode: Complete Annual Calendar" << endl;
-        cout << string(60, '=') << endl;
-        
-        // Execute comprehensive calendar generation for entire year
-        while (current_processing_month <= total_demonstration_months) {
-            cout << "\n" << string(50, '-') << endl;
-            cout << "PROCESSING MONTH: " << current_processing_month 
-                 << " (" << convert_month_number_to_text(current_processing_month) << ")" << endl;
-            cout << string(50, '-') << endl;
-            
-            // Generate formatted calendar display for current month
-            generate_monthly_calendar_display(current_processing_month, demonstration_year);
-            
-            // Display processing progress indicator
-            display_calendar_generation_progress(current_processing_month, total_demonstration_months);
-            
-            // Increment month processing counter
-            current_processing_month++;
-        }
-        
-        // Execute statistical analysis on generated calendar data
-        cout << "\n" << string(60, '=') << endl;
-        cout << "EXECUTING CALENDAR STATISTICAL ANALYSIS" << endl;
-        cout << string(60, '=') << endl;
-        execute_calendar_statistics_analysis(demonstration_year);
-        
-    } else {
-        cout << "ERROR: Invalid calendar parameters detected." << endl;
-        return 1; // Indicates parameter validation failure
-    }
-    
-    // Display program completion status and summary
-    cout << "\n" << string(60, '=') << endl;
-    cout << "CALENDAR GENERATION COMPLETED SUCCESSFULLY" << endl;
-    cout << "Year Processed: " << demonstration_year << endl;
-    cout << "Months Generated: " << total_demonstration_months << endl;
-    cout << "Leap Year Status: " << (calculate_leap_year_status(demonstration_year) ? "TRUE" : "FALSE") << endl;
-    cout << string(60, '=') << endl;
-    
-    return 0; // Indicates successful program termination
-}
-
-/*
-================================================================================
-LEAP YEAR CALCULATION ALGORITHM IMPLEMENTATION
-================================================================================
-*/
-
-bool calculate_leap_year_status(int target_year) {
-    // Implements standard Gregorian calendar leap year determination algorithm
-    // Year is leap if divisible by 4, except century years must be divisible by 400
-    if (target_year % 400 == 0) {
-        return true; // Century year divisible by 400 is leap year
-    } else if (target_year % 100 == 0) {
-        return false; // Century year not divisible by 400 is not leap year
-    } else if (target_year % 4 == 0) {
-        return true; // Non-century year divisible by 4 is leap year
-    } else {
-        return false; // Year not divisible by 4 is not leap year
-    }
-}
-
-/*
-================================================================================
-MONTH DAY COUNT CALCULATION FUNCTION
-================================================================================
-*/
-
-int calculate_month_day_count(int target_month, int target_year) {
-    // Array stores standard day counts for each month (non-leap year)
-    int standard_month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    
-    // Validate month parameter within acceptable range
-    if (target_month < 1 || target_month > 12) {
-        return 0; // Return zero for invalid month parameter
-    }
-    
-    // Adjust February day count for leap year conditions
-    if (target_month == 2 && calculate_leap_year_status(target_year)) {
-        return 29; // February has 29 days in leap years
-    } else {
-        return standard_month_days[target_month - 1]; // Return standard day count
-    }
-}
-
-/*
-================================================================================
-MONTH STARTING DAY CALCULATION ALGORITHM
-================================================================================
-*/
-
-int calculate_month_starting_day(int target_month, int target_year) {
-    // Implements Zeller's Congruence algorithm for day-of-week calculation
-    // Adjusts month and year values for algorithm requirements
-    int adjusted_month = target_month;
-    int adjusted_year = target_year;
-    
-    // Zeller's algorithm treats January and February as months 13 and 14 of previous year
-    if (adjusted_month < 3) {
-        adjusted_month += 12;
-        adjusted_year--;
-    }
-    
-    // Calculate century and year components for Zeller's formula
-    int century_component = adjusted_year / 100;
-    int year_component = adjusted_year % 100;
-    
-    // Apply Zeller's Congruence formula for day-of-week determination
-    int day_of_week = (1 + (13 * (adjusted_month + 1)) / 5 + year_component + 
-                       year_component / 4 + century_component / 4 - 2 * century_component) % 7;
-    
-    // Convert Zeller's result (0=Saturday) to standard format (0=Sunday)
-    return (day_of_week + 6) % 7;
-}
-
-/*
-================================================================================
-MONTHLY CALENDAR DISPLAY GENERATION FUNCTION
-================================================================================
-*/
-
-void generate_monthly_calendar_display(int target_month, int target_year) {
-    // Retrieve month-specific parameters for calendar generation
-    int month_day_count = calculate_month_day_count(target_month, target_year);
-    int starting_day_position = calculate_month_starting_day(target_month, target_year);
-    string month_text_representation = convert_month_number_to_text(target_month);
-    
-    // Display formatted calendar header with month and year information
-    cout << "\n" << setw(20) << month_text_representation << " " << target_year << endl;
-    cout << string(28, '-') << endl;
-    
-    // Display day-of-week column headers
-    cout << " Su Mo Tu We Th Fr Sa" << endl;
-    
-    // Generate leading spaces for first week alignment
-    int calendar_position_counter = 0;
-    for (int leading_space_counter = 0; leading_space_counter < starting_day_position; leading_space_counter++) {
-        cout << "   "; // Three spaces per calendar position
-        calendar_position_counter++;
-    }
-    
-    // Generate calendar days with proper formatting and positioning
-    for (int current_day = 1; current_day <= month_day_count; current_day++) {
-        cout << setw(3) << current_day; // Right-aligned day number
-        calendar_position_counter++;
-        
-        // Insert line break after Saturday (position 7) for new week
-        if (calendar_position_counter % 7 == 0) {
-            cout << endl;
-        }
-    }
-    
-    // Add final newline if month doesn't end on Saturday
-    if (calendar_position_counter % 7 != 0) {
-        cout << endl;
-    }
-    
-    // Display month statistics and analysis
-    cout << "\nMonth Analysis:" << endl;
-    cout << "  Total Days: " << month_day_count << endl;
-    cout << "  Starting Day: " << starting_day_position << " (0=Sunday)" << endl;
-    cout << "  Weekends: " << ((month_day_count + starting_day_position + 6) / 7) << endl;
-}
-
-/*
-================================================================================
-CALENDAR STATISTICAL ANALYSIS FUNCTION
-================================================================================
-*/
-
-void execute_calendar_statistics_analysis(int target_year) {
-    // Initialize statistical accumulation variables
-    int total_year_days = 0;
-    int total_weekend_days = 0;
-    int total_weekday_count = 0;
-    vector<int> month_length_distribution;
-    
-    // Process each month for statistical data collection
-    for (int analysis_month = 1; analysis_month <= 12; analysis_month++) {
-        int current_month_days = calculate_month_day_count(analysis_month, target_year);
-        int month_starting_day = calculate_month_starting_day(analysis_month, target_year);
-        
-        // Accumulate total day count for year
-        total_year_days += current_month_days;
-        
-        // Store month length for distribution analysis
-        month_length_distribution.push_back(current_month_days);
-        
-        // Calculate weekend days for current month
-        int month_weekend_days = 0;
-        for (int day_counter = 1; day_counter <= current_month_days; day_counter++) {
-            int day_of_week = (month_starting_day + day_counter - 1) % 7;
-            if (day_of_week == 0 || day_of_week == 6) { // Sunday or Saturday
-                month_weekend_days++;
-            }
-        }
-        total_weekend_days += month_weekend_days;
-    }
-    
-    // Calculate derived statistical metrics
-    total_weekday_count = total_year_days - total_weekend_days;
-    double weekend_percentage = (double(total_weekend_days) / total_year_days) * 100.0;
-    
-    // Display comprehensive statistical analysis results
-    cout << "ANNUAL CALENDAR STATISTICS REPORT" << endl;
-    cout << string(40, '-') << endl;
-    cout << "Target Year: " << target_year << endl;
-    cout << "Leap Year Status: " << (calculate_leap_year_status(target_year) ? "TRUE" : "FALSE") << endl;
-    cout << "Total Days: " << total_year_days << endl;
-    cout << "Weekend Days: " << total_weekend_days << endl;
-    cout << "Weekday Count: " << total_weekday_count << endl;
-    cout << "Weekend Percentage: " << fixed << setprecision(1) << weekend_percentage << "%" << endl;
-    
-    // Calculate and display month length distribution statistics
-    sort(month_length_distribution.begin(), month_length_distribution.end());
-    cout << "\nMonth Length Distribution:" << endl;
-    cout << "  Shortest Month: " << month_length_distribution[0] << " days" << endl;
-    cout << "  Longest Month: " << month_length_distribution[11] << " days" << endl;
-    cout << "  Average Month Length: " << fixed << setprecision(1) 
-         << (double(total_year_days) / 12.0) << " days" << endl;
-}
-
-/*
-================================================================================
-INPUT VALIDATION FUNCTION IMPLEMENTATION
-================================================================================
-*/
-
-bool validate_date_input_parameters(int month_value, int year_value) {
-    // Validate month parameter within acceptable range (1-12)
-    if (month_value < 1 || month_value > 12) {
-        return false; // Month value outside valid range
-    }
-    
-    // Validate year parameter within reasonable range (1900-2100)
-    if (year_value < 1900 || year_value > 2100) {
-        return false; // Year value outside reasonable range
-    }
-    
-    return true; // All parameters within valid ranges
-}
-
-/*
-================================================================================
-PROGRAM HEADER DISPLAY FUNCTION
-================================================================================
-*/
-
-void display_program_identification_header() {
-    cout << string(60, '=') << endl;
-    cout << "PROFESSIONAL C++ CALENDAR GENERATION SYSTEM" << endl;
-    cout << "Advanced Date Processing and Statistical Analysis" << endl;
-    cout << string(60, '=') << endl;
-    cout << "Features: Leap Year Calculation, Monthly Display, Statistics" << endl;
-    cout << "Algorithm: Zeller's Congruence for Day-of-Week Determination" << endl;
-    cout << string(60, '=') << endl;
-}
-
-/*
-================================================================================
-MONTH NUMBER TO TEXT CONVERSION FUNCTION
-================================================================================
-*/
-
-string convert_month_number_to_text(int month_number) {
-    // Array contains full month names for text conversion
-    string month_names[] = {"January", "February", "March", "April", "May", "June",
-                           "July", "August", "September", "October", "November", "December"};
-    
-    // Validate month number and return corresponding text
-    if (month_number >= 1 && month_number <= 12) {
-        return month_names[month_number - 1];
-    } else {
-        return "Invalid Month"; // Return error indicator for invalid input
-    }
-}
-
-/*
-================================================================================
-DAY OF YEAR CALCULATION FUNCTION
-================================================================================
-*/
-
-int calculate_day_of_year_position(int day_value, int month_value, int year_value) {
-    // Initialize day accumulation counter
-    int accumulated_days = 0;
-    
-    // Sum days from all preceding months
-    for (int preceding_month = 1; preceding_month < month_value; preceding_month++) {
-        accumulated_days += calculate_month_day_count(preceding_month, year_value);
-    }
-    
-    // Add current month day value to accumulated total
-    accumulated_days += day_value;
-    
-    return accumulated_days; // Return calculated day-of-year position
-}
-
-/*
-================================================================================
-PROGRESS INDICATOR DISPLAY FUNCTION
-================================================================================
-*/
-
-void display_calendar_generation_progress(int current_month, int total_months) {
-    // Calculate completion percentage for progress indication
-    double completion_percentage = (double(current_month) / total_months) * 100.0;
-    
-    // Display formatted progress indicator
-    cout << "Generation Progress: " << current_month << "/" << total_months 
-         << " (" << fixed << setprecision(0) << completion_percentage << "%)" << endl;
-    
-    // Generate visual progress bar representation
-    int progress_bar_length = 30;
-    int completed_segments = (current_month * progress_bar_length) / total_months;
-    
-    cout << "Progress Bar: [";
-    for (int segment_counter = 0; segment_counter < progress_bar_length; segment_counter++) {
-        if (segment_counter < completed_segments) {
-            cout << "="; // Completed segment indicator
-        } else {
-            cout << " "; // Remaining segment indicator
-        }
-    }
-    cout << "]" << endl;
-}
\ No newline at end of file
+/*
+================================================================================
+PROFESSIONAL C++ CALENDAR IMPLEMENTATION SYSTEM
+================================================================================
+Purpose: Comprehensive calendar generation with date calculations and
+         statistical analysis for temporal data processing
+Author: Professional C++ Development Team
+Code hints and optimizations by artlest
+Platform: Cross-platform compatible (Online IDEs, Standard Compilers)
+Standards: C++11 Standard Library Implementation
+================================================================================
+*/
+
+#include <iostream>      // Provides standard input/output stream functionality
+#include <iomanip>       // Enables formatted output manipulation and precision control
+#include <string>        // Implements string class for text processing operations
+#include <vector>        // Provides dynamic array container for data storage
+#include <algorithm>     // Contains algorithmic functions for data manipulation
+#include <fstream>       // Provides file stream access for binary query logs
+#include <sstream>       // Enables string stream parsing of query text lines
+#include <chrono>        // Supplies monotonic clocks for latency measurement
+#include <thread>        // Provides sleep facilities for paced query replay
+#include <cstdint>       // Defines fixed-width integer types for binary records
+#include <cstdlib>       // Supplies numeric text conversion routines
+#include <cstring>       // Provides raw memory copies into caller-provided buffers
+#include <atomic>        // Provides lock-free counters shared by worker threads
+#include <cstdio>        // Provides compact numeric formatting for page coordinates
+#include <cmath>         // Provides trigonometric functions for lunar phase corrections
+#include <cstddef>       // Provides offsetof for checksummed file header layouts
+#include <mutex>         // Serializes ordered hand-off of enriched chunks to the writer
+#include <condition_variable> // Signals chunk completion between workers and the writer
+#include <queue>         // Provides the binary heap used as the timer benchmark baseline
+#include <unordered_set> // Provides hashed date sets for the packed date benchmark
+#include <unordered_map> // Provides the in-memory index of the persistent render cache
+#include <deque>         // Keeps newly rendered cache outputs at stable addresses
+#include <climits>       // Provides the lowest 64-bit value marking an empty transition table
+#include <cctype>        // Classifies characters of POSIX TZ rule strings
+#include <cerrno>        // Reports interrupted lock waits
+
+#include "calendar_c_api.h" // Declares the exported C ABI entry points
+
+// Platform file mapping and durability primitives
+#if defined(_WIN32)
+#include <windows.h>     // Provides file mapping objects and atomic file replacement
+#include <io.h>          // Provides descriptor-level commit and resize operations
+#else
+#include <sys/mman.h>    // Provides memory mapping of files
+#include <sys/stat.h>    // Provides file size queries
+#include <fcntl.h>       // Provides file descriptor open flags
+#include <unistd.h>      // Provides descriptor close, fsync and truncate
+#include <sys/file.h>    // Provides advisory whole-file locks
+#include <dirent.h>      // Provides directory listing for zone file discovery
+#endif
+
+// Coroutine generators are compiled only when the compiler implements C++20 coroutines
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>     // Provides coroutine handles and suspension awaitables
+#include <iterator>      // Provides the default sentinel ending generator ranges
+#include <utility>       // Provides exchange for transferring coroutine ownership
+#define CALENDAR_COROUTINE_GENERATORS_AVAILABLE 1
+#endif
+
+// Vector week-row emission is compiled only for targets that guarantee SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>   // Provides 128-bit loads, byte compares and bitwise blends
+#if defined(_MSC_VER)
+#include <intrin.h>      // Provides the time stamp counter for per-row cycle counts
+#else
+#include <x86intrin.h>   // Provides the time stamp counter for per-row cycle counts
+#endif
+#define CALENDAR_SSE2_ROW_EMITTER_AVAILABLE 1
+#endif
+
+using namespace std;
+
+/*
+================================================================================
+STATISTICAL DATA STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure stores annual statistics computed by the statistical analysis function
+struct annual_calendar_statistics {
+    int target_year;             // Year the statistics describe
+    bool leap_year_status;       // Leap year determination result
+    int total_year_days;         // Days in the year (365 or 366)
+    int total_weekend_days;      // Saturdays and Sundays in the year
+    int total_weekday_count;     // Monday through Friday days in the year
+    int shortest_month_days;     // Length of the shortest month
+    int longest_month_days;      // Length of the longest month
+    double average_month_days;   // Mean month length
+    double weekend_percentage;   // Weekend share of total days
+};
+
+// Structure extends the annual statistics with planner metrics derived from month start weekdays
+struct extended_annual_statistics {
+    annual_calendar_statistics base_statistics; // Totals shown by the statistical analysis report
+    int weekday_counts[7];                      // Occurrences of each weekday (0 = Sunday)
+    int quarter_working_days[4];                // Monday-Friday days per quarter less weekday holidays
+    int friday_thirteenth_count;                // Months whose 13th falls on a Friday
+    int holiday_region_code;                    // holiday_region_code applied, or -1 for none
+    int weekday_holiday_count;                  // Distinct holidays falling Monday-Friday
+    int three_day_weekend_count;                // Weekends lengthened by a Friday or Monday holiday
+    int month_start_weekday_counts[7];          // Months starting on each weekday (0 = Sunday)
+};
+
+/*
+================================================================================
+STREAMING RECORD STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure describes one month yielded by the month descriptor stream
+struct calendar_month_descriptor {
+    int year_value;              // Calendar year of the month
+    int month_value;             // Month number (1-12)
+    int starting_day_position;   // Weekday of the first day (0=Sunday)
+    int month_day_count;         // Number of days in the month
+};
+
+// Structure describes one day yielded by the day record stream
+struct calendar_day_record {
+    int year_value;              // Calendar year of the day
+    int month_value;             // Month number (1-12)
+    int day_value;               // Day of month (1-31)
+    int day_of_week;             // Weekday (0=Sunday)
+    int day_of_year;             // One-based position within the year
+};
+
+/*
+================================================================================
+QUERY LOG DATA STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration identifies the calendar query categories captured by the query log
+enum calendar_query_type {
+    QUERY_TYPE_MONTH_RENDER = 1,   // Monthly calendar display generation
+    QUERY_TYPE_STATISTICS = 2,     // Annual statistical analysis report
+    QUERY_TYPE_DAY_OF_YEAR = 3,    // Day-of-year position lookup
+    QUERY_TYPE_LEAP_STATUS = 4,    // Leap year status lookup
+    QUERY_TYPE_MONTH_LENGTH = 5,   // Month day count lookup
+    QUERY_TYPE_MONTH_START = 6     // Month starting weekday lookup
+};
+
+// Number of query type slots (index zero is reserved as invalid)
+const int QUERY_TYPE_SLOT_COUNT = 7;
+
+// Structure stores one captured calendar query together with its arrival time
+struct calendar_query_record {
+    uint64_t arrival_offset_nanoseconds; // Arrival time relative to recording start
+    int32_t year_value;                  // Target year of the query
+    uint8_t query_type;                  // Value from calendar_query_type
+    uint8_t month_value;                 // Target month (zero when unused)
+    uint8_t day_value;                   // Target day (zero when unused)
+};
+
+// Binary query log layout: 8-byte signature followed by fixed 16-byte records
+const char QUERY_LOG_FILE_SIGNATURE[] = "CALQLOG1";
+const int QUERY_LOG_SIGNATURE_LENGTH = 8;
+const int QUERY_LOG_RECORD_LENGTH = 16;
+
+// Status returned by command line dispatch when the default demonstration should run
+const int COMMAND_LINE_CONTINUE_DEMONSTRATION = -1;
+
+/*
+================================================================================
+PRINT LAYOUT STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration identifies the vector output formats produced by the print renderer
+enum print_output_format {
+    PRINT_FORMAT_SVG = 0,          // Scalable Vector Graphics, one file per page
+    PRINT_FORMAT_POSTSCRIPT = 1    // PostScript, one multi-page document per calendar
+};
+
+// Enumeration identifies the per-page values spliced into cached page templates
+enum print_placeholder_kind {
+    PRINT_PLACEHOLDER_YEAR = 0,           // Four-digit year text
+    PRINT_PLACEHOLDER_PERSONAL_TEXT = 1   // Escaped personalization line
+};
+
+// Number of distinct year layouts (January 1 weekday combined with leap status)
+const int YEAR_LAYOUT_CLASS_COUNT = 14;
+
+// Page geometry in points (A4 portrait)
+const double PRINT_PAGE_WIDTH = 595.0;
+const double PRINT_PAGE_HEIGHT = 842.0;
+
+// Structure stores a page as static fragments interleaved with placeholders
+struct print_page_template {
+    vector<string> static_fragments;  // Always one more fragment than placeholders
+    vector<int> placeholder_kinds;    // Values from print_placeholder_kind
+};
+
+// Structure stores every page template for one year layout class
+struct print_layout_template_set {
+    print_page_template year_page;        // Twelve-month overview page
+    print_page_template month_pages[12];  // One full-grid page per month
+};
+
+// Structure describes one personalized calendar in a print batch
+struct print_job_request {
+    int target_year;                // Calendar year to print
+    string personalization_text;    // Recipient line printed under the title
+};
+
+/*
+================================================================================
+LUNAR PHASE AND DISPLAY OPTION STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration identifies the lunar phases recorded in precomputed phase tables
+enum lunar_phase_kind {
+    LUNAR_PHASE_NEW_MOON = 0,    // Conjunction of Moon and Sun
+    LUNAR_PHASE_FULL_MOON = 1    // Opposition of Moon and Sun
+};
+
+// Structure stores one lunar phase instant as a serial day and UTC minute
+struct lunar_phase_event {
+    int serial_day;      // Serial day number of the phase (0001-01-01 = 1)
+    int minute_of_day;   // Minutes after 00:00 UTC
+    int phase_kind;      // Value from lunar_phase_kind
+};
+
+// Grid markers used for phase days in monthly calendar displays
+const char LUNAR_NEW_MOON_MARKER = '*';
+const char LUNAR_FULL_MOON_MARKER = 'o';
+
+// Booking capacity calendar (defined with the segment tree structures below)
+struct sharded_capacity_calendar;
+
+// Compressed date set (defined with the date set structures below)
+struct compressed_date_set;
+
+// Marker placed before day numbers contained in a highlighted date set
+const char DATE_SET_HIGHLIGHT_MARKER = '>';
+
+// Marker placed before day numbers that are holidays of the selected regions
+const char HOLIDAY_DAY_MARKER = '!';
+
+// Occupancy markers placed before day numbers relative to the display capacity
+const char OCCUPANCY_PARTIAL_MARKER = '.';  // Booked below half of capacity
+const char OCCUPANCY_BUSY_MARKER = '+';     // Booked at half of capacity or more
+const char OCCUPANCY_FULL_MARKER = '#';     // Booked at or above capacity
+
+// Structure selects optional annotations for monthly calendar displays
+struct calendar_display_options {
+    const vector<lunar_phase_event>* lunar_phase_table;  // Sorted phase table, or NULL to omit phases
+    const sharded_capacity_calendar* occupancy_calendar; // Booking levels to mark, or NULL to omit occupancy
+    int occupancy_capacity;                               // Capacity the occupancy markers are relative to
+    const compressed_date_set* highlighted_days;          // Days to highlight, or NULL to omit highlighting
+    const vector<uint8_t>* holiday_day_table;             // build_holiday_day_table result, or NULL to omit holidays
+    uint8_t holiday_region_mask;                          // Region bits of holiday_day_table to mark
+    
+    calendar_display_options() : lunar_phase_table(NULL), occupancy_calendar(NULL), occupancy_capacity(0),
+                                 highlighted_days(NULL), holiday_day_table(NULL), holiday_region_mask(0) {}
+};
+
+/*
+================================================================================
+MAPPED FILE AND EVENT STORE STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure describes a read-only view of a file mapped into memory
+struct mapped_file_region {
+    const char* mapped_data;     // First byte of the file contents (NULL when empty)
+    size_t mapped_size;          // File length in bytes
+#if defined(_WIN32)
+    HANDLE file_handle;          // Underlying file handle
+    HANDLE mapping_handle;       // File mapping object handle
+#endif
+};
+
+// Structure holds an exclusive advisory lock on a lock file until it is released
+struct exclusive_file_lock {
+#if defined(_WIN32)
+    HANDLE file_handle;          // Locked file handle (INVALID_HANDLE_VALUE when not held)
+#else
+    int file_descriptor;         // Locked descriptor (-1 when not held)
+#endif
+};
+
+// Structure stores one calendar event in its fixed on-disk and in-memory layout
+struct calendar_event_record {
+    int32_t serial_day;          // Index key: serial day of the event (0001-01-01 = 1)
+    uint16_t start_minute;       // Minutes after midnight
+    uint16_t duration_minutes;   // Event length in minutes
+    uint64_t event_identifier;   // Store-assigned unique identifier
+    char event_title[40];        // NUL-padded title text
+};
+
+// Event log operation codes
+const uint32_t EVENT_LOG_OPERATION_APPEND = 1;
+const uint32_t EVENT_LOG_OPERATION_REMOVE = 2;
+
+// Structure stores one checksummed event log entry
+struct calendar_event_log_entry {
+    uint32_t entry_checksum;                // CRC-32 of the bytes following this field
+    uint32_t operation_code;                // EVENT_LOG_OPERATION_APPEND or EVENT_LOG_OPERATION_REMOVE
+    calendar_event_record event_record;     // Appended event, or identifier to remove
+};
+
+// Structure stores the event log file header
+struct calendar_event_log_header {
+    char file_signature[8];      // "CALEVLOG"
+    uint32_t format_version;     // Layout version of log entries
+    uint32_t entry_length;       // sizeof(calendar_event_log_entry) of the writer
+    uint64_t log_generation;     // Incremented each time compaction starts a new log
+    uint32_t header_checksum;    // CRC-32 of the preceding header bytes
+    char reserved_bytes[36];     // Pads the header to one entry length
+};
+
+// Structure stores the compacted snapshot file header; sorted records follow it
+struct calendar_event_snapshot_header {
+    char file_signature[8];          // "CALEVSNP"
+    uint32_t format_version;         // Layout version of snapshot records
+    uint32_t record_length;          // sizeof(calendar_event_record) of the writer
+    uint64_t record_count;           // Number of records following the header
+    uint64_t next_log_generation;    // Log generation whose entries are not yet included
+    uint64_t next_event_identifier;  // Identifier to assign to the next appended event
+    uint32_t records_checksum;       // CRC-32 of the record array
+    uint32_t header_checksum;        // CRC-32 of the preceding header bytes
+    char reserved_bytes[16];         // Pads the header to one entry length
+};
+
+const uint32_t EVENT_STORE_FORMAT_VERSION = 1;
+
+// Structure holds an open event store: the sorted in-memory index and its append log
+struct calendar_event_store {
+    string store_directory;                    // Directory containing log and snapshot files
+    FILE* log_file;                            // Append handle for the active log generation
+    uint64_t log_valid_length;                 // Bytes of the active log holding complete entries
+    uint64_t log_generation;                   // Generation of the active log
+    uint64_t next_event_identifier;            // Identifier for the next appended event
+    vector<calendar_event_record> event_index; // Records sorted by serial day, then identifier
+    size_t entries_since_snapshot;             // Log entries not yet folded into a snapshot
+    size_t compaction_threshold;               // Entries that trigger automatic compaction
+    bool synchronize_each_append;              // Flush to stable storage after every append
+    size_t recovered_snapshot_records;         // Records loaded from the snapshot at open
+    size_t replayed_log_entries;               // Tail entries replayed at open
+    size_t truncated_log_bytes;                // Torn tail bytes discarded at open
+};
+
+/*
+================================================================================
+ICALENDAR IMPORT STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure stores one VEVENT extracted from an iCalendar (RFC 5545) stream
+struct icalendar_event_record {
+    int start_serial_day;        // Serial day of DTSTART
+    int start_minute;            // Minutes after midnight, or -1 for all-day events
+    int end_serial_day;          // Serial day of DTEND (or DTSTART plus DURATION)
+    int end_minute;              // Minutes after midnight, or -1 for all-day events
+    bool utc_time;               // DTSTART carried the UTC designator 'Z'
+    string time_zone_identifier; // TZID parameter of DTSTART (empty when absent)
+    string recurrence_rule;      // RRULE value (empty when absent)
+    string summary_text;         // SUMMARY value with RFC 5545 escapes removed
+};
+
+// Structure accumulates counters reported by the iCalendar importer
+struct icalendar_import_statistics {
+    size_t parsed_event_count;       // VEVENT blocks with a valid DTSTART
+    size_t rejected_event_count;     // VEVENT blocks without a usable DTSTART
+    size_t recurring_event_count;    // Events carrying an RRULE
+    size_t zoned_event_count;        // Events carrying a TZID parameter
+    size_t all_day_event_count;      // Events with DATE-valued DTSTART
+    size_t unfolded_line_count;      // Logical lines that spanned folded physical lines
+};
+
+/*
+================================================================================
+CSV DATE ENRICHMENT STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Holiday rule sets available for enrichment flags (bit positions in the holiday table)
+enum holiday_region_code {
+    HOLIDAY_REGION_UNITED_STATES = 0,  // US federal holidays
+    HOLIDAY_REGION_GREAT_BRITAIN = 1,  // England and Wales bank holidays
+    HOLIDAY_REGION_GERMANY = 2,        // German nationwide public holidays
+    HOLIDAY_REGION_COUNT = 3
+};
+
+// Structure describes one newline-aligned slice of the mapped CSV input
+struct csv_enrichment_chunk {
+    const char* chunk_begin;     // First byte of the slice
+    const char* chunk_end;       // One past the final newline of the slice
+    string enriched_output;      // Rows with appended attribute columns
+    size_t row_count;            // Rows processed in this slice
+    size_t invalid_date_count;   // Rows whose date column did not parse
+    bool output_ready;           // Set by the worker once enriched_output is complete
+};
+
+/*
+================================================================================
+CALENDAR ARCHIVE STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure describes the slice of an archive produced by one shard
+struct calendar_archive_shard_manifest {
+    int first_year;              // First year of the complete archive
+    int last_year;               // Last year of the complete archive
+    int shard_number;            // One-based shard index k
+    int shard_count;             // Total shard count n
+    int first_month_index;       // First month of the shard (0 = January of first_year)
+    int end_month_index;         // One past the final month of the shard
+    uint64_t byte_offset;        // Offset of the shard within the complete archive
+    uint64_t byte_length;        // Bytes written by the shard
+    uint64_t archive_total_bytes; // Size of the complete archive
+    uint32_t content_checksum;   // CRC-32 of the shard bytes
+};
+
+// Structure accumulates calendar totals over the months written to an archive
+struct archive_generation_statistics {
+    uint64_t covered_day_count;  // Days in all written months
+    uint64_t weekend_day_count;  // Saturdays and Sundays in all written months
+    uint64_t leap_year_count;    // Leap years whose February was written
+};
+
+// Structure records resumable progress of an archive generation run
+struct calendar_archive_checkpoint {
+    int first_year;              // Archive year range and shard selection the run was started with
+    int last_year;
+    int shard_number;
+    int shard_count;
+    int next_month_index;        // First month not yet written (always January of a year)
+    uint64_t output_offset;      // Durable output bytes preceding next_month_index
+    uint32_t content_checksum;   // CRC-32 of the durable output bytes
+    archive_generation_statistics accumulated_statistics; // Totals over the durable output
+};
+
+/*
+================================================================================
+ROLLING WINDOW STATISTICS STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure holds cumulative day-class counts so any date range is answered in constant time
+struct rolling_window_prefix_tables {
+    int base_serial_day;                  // Serial day represented by prefix index 0
+    vector<uint32_t> weekend_prefix_counts;  // Saturdays and Sundays before each day
+    vector<uint32_t> holiday_prefix_counts;  // Holidays (any selected region) before each day
+    vector<uint32_t> business_prefix_counts; // Weekdays that are not holidays before each day
+};
+
+// Structure reports day-class totals for one inclusive window of days
+struct rolling_window_statistics {
+    int window_first_serial_day;  // First day of the window
+    int window_last_serial_day;   // Final day of the window
+    int total_days;               // Days in the window
+    int weekend_days;             // Saturdays and Sundays
+    int holiday_days;             // Holidays, including those on weekends
+    int business_days;            // Weekdays that are not holidays
+};
+
+/*
+================================================================================
+CRON SCHEDULE STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure holds a cron expression compiled into per-field bitsets
+struct compiled_cron_schedule {
+    uint64_t minute_bits;           // Bit n set when minute n (0-59) matches
+    uint32_t hour_bits;             // Bit n set when hour n (0-23) matches
+    uint32_t day_of_month_bits;     // Bit n set when day n (1-31) matches
+    uint16_t month_bits;            // Bit n set when month n (1-12) matches
+    uint8_t weekday_bits;           // Bit n set when weekday n (0=Sunday) matches
+    uint8_t last_weekday_bits;      // Bit n set for "nL", the last weekday n of the month
+    uint8_t nth_weekday_masks[7];   // Bit k-1 of entry n set for "n#k", the kth weekday n of the month
+    bool last_day_of_month;         // "L" in the day-of-month field
+    bool day_of_month_restricted;   // Day-of-month field did not start with '*'
+    bool weekday_restricted;        // Weekday field did not start with '*'
+    uint32_t weekday_day_masks[7];  // Days 1-31 matching weekday_bits, indexed by weekday of the 1st
+};
+
+/*
+================================================================================
+TIMER WHEEL STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Timer wheel geometry: minutes of the current day, days of the current 512-day block,
+// 512-day blocks of the current 262144-day era, then an overflow list and a due list
+enum timer_wheel_geometry {
+    TIMER_WHEEL_MINUTE_SLOTS = 1440,
+    TIMER_WHEEL_DAY_SLOTS = 512,
+    TIMER_WHEEL_BLOCK_SLOTS = 512,
+    TIMER_WHEEL_MINUTE_LEVEL = 0,
+    TIMER_WHEEL_DAY_LEVEL = TIMER_WHEEL_MINUTE_LEVEL + TIMER_WHEEL_MINUTE_SLOTS,
+    TIMER_WHEEL_BLOCK_LEVEL = TIMER_WHEEL_DAY_LEVEL + TIMER_WHEEL_DAY_SLOTS,
+    TIMER_WHEEL_OVERFLOW_SLOT = TIMER_WHEEL_BLOCK_LEVEL + TIMER_WHEEL_BLOCK_SLOTS,
+    TIMER_WHEEL_DUE_SLOT = TIMER_WHEEL_OVERFLOW_SLOT + 1,
+    TIMER_WHEEL_SLOT_COUNT = TIMER_WHEEL_DUE_SLOT + 1
+};
+
+const uint32_t TIMER_WHEEL_NO_ENTRY = 0xFFFFFFFFu; // Link terminator and free-slot marker
+
+// Structure stores one pending reminder inside the timer wheel entry pool
+struct timer_wheel_entry {
+    long long expiry_minute;     // Serial minute at which the reminder fires
+    uint64_t reminder_identifier; // Caller payload returned on firing
+    uint32_t next_entry_index;   // Next entry in the same slot (or free list)
+    uint32_t previous_entry_index; // Previous entry in the same slot
+    uint32_t slot_index;         // Slot holding the entry, TIMER_WHEEL_NO_ENTRY when free
+    uint32_t generation_count;   // Incremented on release so stale handles are rejected
+};
+
+// Structure reports one fired reminder
+struct timer_wheel_firing {
+    long long expiry_minute;     // Scheduled serial minute
+    uint64_t reminder_identifier; // Caller payload
+};
+
+// Structure holds the hierarchical timer wheel with its pooled entries
+struct calendar_timer_wheel {
+    long long current_minute;    // Serial minute up to which timers have fired
+    vector<timer_wheel_entry> wheel_entries; // Entry pool indexed by handle
+    uint32_t free_entry_index;   // Head of the released entry list
+    size_t active_entry_count;   // Scheduled, not yet fired or cancelled entries
+    uint32_t slot_heads[TIMER_WHEEL_SLOT_COUNT];                 // First entry of each slot
+    uint64_t slot_occupancy_bits[(TIMER_WHEEL_SLOT_COUNT + 63) / 64]; // Bit set for non-empty slots
+};
+
+/*
+================================================================================
+CAPACITY SEGMENT TREE STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Structure holds a flat lazy segment tree supporting range-add and range-max
+struct capacity_segment_tree {
+    int indexed_count;                   // Indexed days; later leaves are padding
+    int leaf_count;                      // Power of two covering every indexed day
+    int tree_height;                     // log2(leaf_count)
+    vector<int32_t> node_maximums;       // Node 1 is the root; leaves start at leaf_count
+    vector<int32_t> pending_additions;   // Additions not yet pushed below each node (leaf entries stay unused)
+};
+
+// Structure holds the tree for one calendar year with the lock that serializes access to it
+struct capacity_year_shard {
+    mutable mutex shard_mutex;           // Guards day_tree, including reads through const calendars
+    capacity_segment_tree day_tree;      // Index 0 is January 1
+    int first_serial_day;                // Serial day of January 1
+    int day_count;                       // Days in the year
+};
+
+// Structure shards booking capacity by year so independent years never contend
+struct sharded_capacity_calendar {
+    int first_year;                      // Year held by year_shards[0]
+    int last_year;                       // Year held by the final shard
+    vector<capacity_year_shard> year_shards;
+};
+
+// Structure describes one booking over an inclusive serial day range
+struct capacity_booking {
+    int first_serial_day;                // First booked day
+    int last_serial_day;                 // Final booked day
+    int32_t booked_amount;               // Units reserved on each day
+};
+
+/*
+================================================================================
+PACKED DATE VALUE TYPE DEFINITIONS
+================================================================================
+*/
+
+// Structure packs a date into 32 bits as year << 9 | month << 5 | day, so integer order is date order
+struct packed_calendar_date {
+    uint32_t packed_value;               // Bits 0-4 day, bits 5-8 month, bits 9-31 year
+};
+
+// Structure stores a date in 16 bits as days since 1900-01-01, covering 1900-01-01 through 2079-06-06
+struct compact_calendar_date {
+    uint16_t day_offset;                 // Days elapsed since 1900-01-01
+};
+
+inline bool operator==(packed_calendar_date left_date, packed_calendar_date right_date) {
+    return left_date.packed_value == right_date.packed_value;
+}
+
+inline bool operator!=(packed_calendar_date left_date, packed_calendar_date right_date) {
+    return left_date.packed_value != right_date.packed_value;
+}
+
+inline bool operator<(packed_calendar_date left_date, packed_calendar_date right_date) {
+    return left_date.packed_value < right_date.packed_value;
+}
+
+inline bool operator==(compact_calendar_date left_date, compact_calendar_date right_date) {
+    return left_date.day_offset == right_date.day_offset;
+}
+
+inline bool operator<(compact_calendar_date left_date, compact_calendar_date right_date) {
+    return left_date.day_offset < right_date.day_offset;
+}
+
+// Function returns a well-mixed 32-bit hash of a packed date (lowbias32 integer finalizer)
+inline uint32_t hash_packed_calendar_date(packed_calendar_date date_value) {
+    uint32_t hash_value = date_value.packed_value;
+    hash_value ^= hash_value >> 16;
+    hash_value *= 0x7FEB352DU;
+    hash_value ^= hash_value >> 15;
+    hash_value *= 0x846CA68BU;
+    hash_value ^= hash_value >> 16;
+    return hash_value;
+}
+
+// Structure adapts hash_packed_calendar_date for unordered containers
+struct packed_calendar_date_hasher {
+    size_t operator()(packed_calendar_date date_value) const { return hash_packed_calendar_date(date_value); }
+};
+
+/*
+================================================================================
+CALENDAR GROUP-BY AGGREGATION STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration selects the calendar key rows are grouped by
+enum calendar_group_key_kind {
+    GROUP_BY_WEEKDAY = 0,         // 7 groups, Sunday first
+    GROUP_BY_ISO_WEEK = 1,        // 53 groups, ISO week 1 first
+    GROUP_BY_MONTH = 2,           // 12 groups
+    GROUP_BY_QUARTER = 3,         // 4 groups
+    GROUP_BY_DAY_OF_YEAR = 4,     // 366 groups
+    GROUP_BY_KEY_COUNT = 5
+};
+
+// Structure accumulates one group of values
+struct calendar_group_aggregate {
+    double value_sum;             // Sum of grouped values
+    uint64_t row_count;           // Rows in the group
+    double minimum_value;         // Smallest value (+infinity when empty)
+    double maximum_value;         // Largest value (-infinity when empty)
+};
+
+/*
+================================================================================
+BUSINESS-DAY RESAMPLING STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration selects the target calendar series are aligned to
+enum resample_calendar_kind {
+    RESAMPLE_CALENDAR_BUSINESS_DAYS = 0,    // Every weekday that is not a holiday
+    RESAMPLE_CALENDAR_MONTH_END = 1         // Last business day of each month
+};
+
+// Enumeration selects how observations between target days become one value
+enum resample_fill_method {
+    RESAMPLE_FILL_FORWARD = 0,              // Latest observation at or before the target day, carried forward
+    RESAMPLE_FILL_LAST_VALUE = 1,           // Latest observation since the previous target day, else NaN
+    RESAMPLE_FILL_SUM = 2                   // Sum of observations since the previous target day
+};
+
+// Structure describes one input series and the caller-provided column receiving its aligned values
+struct resample_series_columns {
+    const int32_t* observation_days;        // Ascending serial days
+    const double* observation_values;       // Value of each observation
+    size_t observation_count;               // Observations in the series
+    double* output_values;                  // One slot per target day
+};
+
+/*
+================================================================================
+COMPRESSED DATE SET STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration identifies how one year of a compressed date set is encoded
+enum date_set_container_kind {
+    DATE_SET_ARRAY_CONTAINER = 0,     // Ascending day-of-year indexes, 2 bytes per day
+    DATE_SET_BITMAP_CONTAINER = 1,    // 384-bit map stored as 24 words, 48 bytes
+    DATE_SET_RUN_CONTAINER = 2        // (first index, length - 1) pairs, 4 bytes per run
+};
+
+// Words of the expanded per-year bitmap (366 days rounded up to 64-bit words)
+const int DATE_SET_BITMAP_WORDS = 6;
+
+// Structure describes the days of one year in whichever encoding is smallest (12 bytes)
+struct date_set_container {
+    int16_t year_value;                   // Year the container covers
+    uint8_t container_kind;               // date_set_container_kind
+    uint8_t reserved_byte;                // Padding kept zero
+    uint16_t cardinality;                 // Days in the container
+    uint16_t value_count;                 // Encoded values owned by the container
+    uint32_t value_offset;                // First encoded value in the set's value pool
+};
+
+// Structure stores a set of serial days as one container per non-empty year, Roaring style;
+// every container's encoded values share one pool so small years carry no allocation of their own
+struct compressed_date_set {
+    vector<date_set_container> year_containers;  // Ascending by year
+    vector<uint16_t> container_values;           // Value pool indexed by value_offset
+};
+
+/*
+================================================================================
+VACATION OPTIMIZER STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Words of the planning bitmap, which covers the plan year and the following year so a break
+// starting in December can run on past December 31
+const int VACATION_WINDOW_WORDS = 12;
+
+// Vacation days a bridge may use unless --bridge-days says otherwise
+const int VACATION_DEFAULT_BRIDGE_DAYS = 5;
+
+// Structure describes one continuous break starting in the plan year (day indexes count from
+// January 1 = 0 and continue into the following year)
+struct vacation_break_plan {
+    int first_day_index;          // First day of the break
+    int last_day_index;           // Final day of the break
+    int vacation_day_count;       // Working days that must be taken as vacation
+    int break_length;             // Calendar days in the break
+};
+
+// Structure describes one employee's planning inputs
+struct vacation_request {
+    int region_code;              // holiday_region_code whose holidays apply, or -1 for none
+    int vacation_budget;          // Vacation days available
+    uint8_t extra_off_weekdays;   // Bit per weekday (bit 0 = Sunday) of regular part-time days off
+};
+
+/*
+================================================================================
+PERSISTENT RENDER CACHE STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Pack file identification and layout version
+const char RENDER_CACHE_MAGIC[8] = {'C', 'A', 'L', 'R', 'C', 'A', 'C', 'H'};
+const uint32_t RENDER_CACHE_FORMAT_VERSION = 1;
+
+// Enumeration identifies the rendered output kinds stored in the cache
+enum render_cache_output_format {
+    RENDER_CACHE_FORMAT_TEXT_MONTH = 1   // Month grid and analysis below the title line
+};
+
+// Option flags that change rendered output and therefore the cache key
+const uint32_t RENDER_CACHE_OPTION_HOLIDAY_MARKERS = 1;
+
+// Structure is the fixed pack file header; the index follows the packed outputs
+struct render_cache_file_header {
+    char magic[8];                 // RENDER_CACHE_MAGIC
+    uint32_t format_version;       // RENDER_CACHE_FORMAT_VERSION
+    uint32_t entry_count;          // Index records at index_offset
+    uint64_t access_clock;         // Logical clock used for LRU ordering
+    uint64_t index_offset;         // File offset of the first index record
+    uint32_t index_checksum;       // CRC-32 of the index records
+    uint32_t header_checksum;      // CRC-32 of the preceding header fields
+};
+
+// Structure is one index record describing a packed output
+struct render_cache_index_record {
+    uint64_t input_hash;           // Hash of every input that affects the rendered bytes
+    uint64_t data_offset;          // File offset of the output bytes
+    uint32_t data_length;          // Output length in bytes
+    uint32_t data_checksum;        // CRC-32 of the output bytes
+    uint64_t last_access_tick;     // access_clock value at the most recent use
+};
+
+// Structure holds an index record with the address of its bytes in memory
+struct render_cache_slot {
+    render_cache_index_record index_record;
+    const char* data_pointer;      // Inside the mapped pack or a pending output
+    bool checksum_verified;        // Set once the bytes have matched data_checksum
+};
+
+// Structure is an open pack file plus outputs rendered since it was opened.
+// Lookups serve bytes straight from the mapping; flushes rewrite the pack atomically.
+struct persistent_render_cache {
+    string pack_file_path;
+    mapped_file_region mapped_pack;
+    unordered_map<uint64_t, render_cache_slot> cache_slots;
+    deque<string> pending_outputs;                // Outputs not yet written to the pack
+    uint64_t access_clock;
+    uint64_t size_limit_bytes;                    // Upper bound on the pack size after a flush
+    unsigned long long lookup_count;
+    unsigned long long hit_count;
+    unsigned long long hit_byte_count;            // Bytes served without rendering
+    unsigned long long stored_byte_count;         // Bytes rendered and added
+    unsigned long long evicted_entry_count;
+    unsigned long long rejected_entry_count;      // Entries dropped after a checksum mismatch
+};
+
+/*
+================================================================================
+WEEK ROW EMITTER STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// A month grid is a window onto one strip: seven blank cells followed by the cells
+// for days 1-31, padded so a 32-byte load at the last row start stays inside
+const int CALENDAR_ROW_STRIP_BLANK_BYTES = 21;
+const int CALENDAR_ROW_STRIP_LENGTH = 144;
+
+// Structure holds the per-month marker bytes aligned with the shared cell strip
+struct calendar_row_marker_strip {
+    alignas(16) char marker_bytes[CALENDAR_ROW_STRIP_LENGTH]; // Zero where the cell strip byte is kept
+    bool markers_present;                                     // False lets rows skip the blend
+};
+
+/*
+================================================================================
+TIME ZONE TRANSITION STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Serial day number of 1970-01-01, the origin of TZif transition times
+const int UNIX_EPOCH_SERIAL_DAY = 719163;
+
+// Structure describes one change of UTC offset or daylight flag in a zone
+struct time_zone_transition {
+    long long utc_seconds;          // Instant of the change in seconds since 1970-01-01 UTC
+    int offset_before_seconds;      // UTC offset in effect before the change (east positive)
+    int offset_after_seconds;       // UTC offset in effect after the change
+    bool daylight_before;           // Daylight saving flag before the change
+    bool daylight_after;            // Daylight saving flag after the change
+    char abbreviation_before[8];    // Zone abbreviation before the change
+    char abbreviation_after[8];     // Zone abbreviation after the change
+};
+
+// Structure collects the transitions of one zone file and the names that share its contents
+struct time_zone_transition_report {
+    string zone_name;                          // Path below the zone directory, e.g. Europe/Berlin
+    vector<string> alias_names;                // Other names whose files have identical contents
+    uint64_t content_hash;                     // FNV-1a hash of the file bytes
+    vector<time_zone_transition> transitions;  // Transitions ordered by instant
+};
+
+// Structure is one POSIX TZ rule date: Jn (kind 'J'), n (kind 'D') or Mm.w.d (kind 'M')
+struct posix_zone_rule_date {
+    char rule_kind;
+    int first_field;                // Julian day, zero-based day or month
+    int second_field;               // Week of month (5 = last) for 'M' rules
+    int third_field;                // Weekday (0 = Sunday) for 'M' rules
+    int local_time_seconds;         // Local time of the change (may be negative or past 24h)
+};
+
+// Structure is the POSIX TZ footer rule that continues a zone past its final transition
+struct posix_zone_footer {
+    char standard_abbreviation[8];
+    char daylight_abbreviation[8];
+    int standard_offset_seconds;    // East positive, unlike the POSIX text
+    int daylight_offset_seconds;
+    bool daylight_rules_present;
+    posix_zone_rule_date daylight_start_rule;
+    posix_zone_rule_date daylight_end_rule;
+};
+
+/*
+================================================================================
+TIMELINE RENDERER STRUCTURE DEFINITIONS
+================================================================================
+*/
+
+// Enumeration identifies the precomputed level-of-detail bucket sizes, finest first
+enum timeline_level_kind {
+    TIMELINE_LEVEL_DAY = 0,
+    TIMELINE_LEVEL_WEEK = 1,       // Monday-based weeks
+    TIMELINE_LEVEL_MONTH = 2,
+    TIMELINE_LEVEL_QUARTER = 3,
+    TIMELINE_LEVEL_YEAR = 4,       // Coarsest level; several years share a column when a view needs it
+    TIMELINE_LEVEL_COUNT = 5
+};
+
+// Enumeration identifies the timeline output formats
+enum timeline_output_format {
+    TIMELINE_FORMAT_TEXT = 0,
+    TIMELINE_FORMAT_SVG = 1,
+    TIMELINE_FORMAT_HTML = 2       // SVG embedded in a standalone page
+};
+
+// Visible tasks a lane may have in a day or week view and still be drawn as bars rather than a heat strip
+const int TIMELINE_BAR_TASK_LIMIT = 8;
+
+// Structure describes one task as an inclusive serial day range in a lane
+struct timeline_task {
+    int first_serial_day;
+    int last_serial_day;
+    int lane_index;                // Index into the lane name list
+};
+
+// Structure is one run of a lane's non-empty buckets at one level: a single bucket with its own aggregates,
+// or consecutive buckets that have the same number of tasks active on every day and no task starts
+struct timeline_bucket_run {
+    int32_t first_bucket;          // Bucket number (see calculate_timeline_bucket_number)
+    int32_t end_bucket;            // One past the last bucket of the run
+    int32_t peak_active_tasks;     // Most tasks active on any day of each bucket
+    int32_t started_task_count;    // Tasks starting inside the bucket (zero in multi-bucket runs)
+    int64_t task_day_total;        // Sum of active tasks over the bucket's days (single-bucket runs only)
+};
+
+// Structure holds the visible buckets of one view and their per-lane aggregates (lane-major, bucket_count per lane)
+struct timeline_level_aggregates {
+    vector<int> bucket_first_serial_days;   // bucket_count + 1 boundaries clipped to the task span
+    vector<int32_t> peak_active_tasks;      // Most tasks active on any day of the bucket
+    vector<int64_t> task_day_totals;        // Sum of active tasks over the bucket's days
+    vector<int32_t> started_task_counts;    // Tasks starting inside the bucket
+};
+
+// Structure is one view ready to format: its level, visible buckets and the tasks drawn as bars
+struct timeline_view_layout {
+    int level_kind;
+    int first_bucket;                       // Bucket number of the first column
+    int buckets_per_column;                 // Consecutive buckets merged into each column (above 1 only for years)
+    timeline_level_aggregates visible_buckets;  // No boundaries when the view holds no day of the task span
+    vector<uint8_t> lane_shows_bars;        // Lanes drawn as task bars instead of a heat strip
+    vector<size_t> lane_bar_offsets;        // lane_count + 1 offsets into bar_task_positions
+    vector<size_t> bar_task_positions;      // Visible tasks of bar lanes as positions in the index task arrays
+};
+
+// Structure places one task bar of a lane within a view
+struct timeline_bar_placement {
+    size_t task_position;          // Position in the index task arrays
+    int first_column;
+    int last_column;
+    int row_index;                 // Row within the lane
+    bool title_inside;             // Title fits between the bar ends; otherwise it follows the bar
+};
+
+// Structure is the level-of-detail index that rendering reads instead of the tasks. Every level keeps only
+// each lane's non-empty buckets, with runs of identical buckets folded together, so the index grows with
+// the tasks rather than with lanes times the calendar span
+struct timeline_lod_index {
+    int span_first_serial_day;              // Greater than span_last_serial_day when there are no tasks
+    int span_last_serial_day;
+    size_t task_count;
+    vector<string> lane_names;
+    vector<size_t> lane_run_offsets[TIMELINE_LEVEL_COUNT];          // lane_count + 1 per level
+    vector<timeline_bucket_run> bucket_runs[TIMELINE_LEVEL_COUNT];  // Lane-major, ascending within a lane
+    vector<size_t> lane_task_offsets;       // lane_count + 1 offsets into the task arrays
+    vector<int> task_first_serial_days;     // Lane-major, ascending by first day within a lane
+    vector<int> task_last_serial_days;
+    vector<int> sorted_last_serial_days;    // Each lane's last days ascending, for counting finished tasks
+    vector<int> task_last_day_trees;        // Per-lane maximum trees of last days, two entries per task
+    vector<size_t> task_title_offsets;      // task_count + 1 offsets into task_title_text
+    string task_title_text;
+};
+
+/*
+================================================================================
+FUNCTION DECLARATIONS AND PROTOTYPES
+================================================================================
+*/
+
+// Function determines if specified year is a leap year using algorithmic calculation
+bool calculate_leap_year_status(int target_year);
+
+// Function calculates total days in specified month considering leap year conditions
+int calculate_month_day_count(int target_month, int target_year);
+
+// Function determines the starting day of week for specified month and year
+int calculate_month_starting_day(int target_month, int target_year);
+
+// Function generates and displays formatted calendar for specified month
+void generate_monthly_calendar_display(int target_month, int target_year);
+
+// Function generates formatted calendar with optional annotations for specified month
+void generate_monthly_calendar_display(int target_month, int target_year, const calendar_display_options& display_options);
+
+// Function appends the blank line and the month title right-aligned in 20 columns that open a calendar
+void append_monthly_calendar_title(string& display_buffer, int target_month, int target_year);
+
+// Function appends formatted calendar text for specified month to a buffer
+void append_monthly_calendar_display(string& display_buffer, int target_month, int target_year);
+
+// Function appends formatted calendar text with optional annotations to a buffer
+void append_monthly_calendar_display(string& display_buffer, int target_month, int target_year,
+                                     const calendar_display_options& display_options);
+
+// Function performs statistical analysis on calendar data patterns
+void execute_calendar_statistics_analysis(int target_year);
+
+// Function computes annual calendar statistics without producing output
+annual_calendar_statistics calculate_annual_calendar_statistics(int target_year);
+
+// Function counts the days of a short weekday span (first_weekday onward) that fall in a weekday mask
+int count_weekday_span_matches(int first_weekday, int span_length, uint8_t weekday_mask);
+
+// Function computes the extended statistics from month start weekdays and the holiday list
+extended_annual_statistics calculate_extended_annual_statistics(int target_year, int holiday_region_code);
+
+// Function computes extended statistics for a year range across worker threads
+void calculate_extended_statistics_range(int first_year, int last_year, int holiday_region_code, int thread_count,
+                                         vector<extended_annual_statistics>& range_statistics);
+
+// Function prints extended statistics as one compact table row per year
+void print_extended_statistics_table(const vector<extended_annual_statistics>& range_statistics);
+
+// Function runs the multi-year extended statistics mode
+int execute_extended_statistics_report(int argument_count, char* argument_values[], const string& year_range_text);
+
+// Function validates date input parameters within acceptable ranges
+bool validate_date_input_parameters(int month_value, int year_value);
+
+// Function displays formatted program header with identification information
+void display_program_identification_header();
+
+// Function converts numeric month value to corresponding text representation
+string convert_month_number_to_text(int month_number);
+
+// Function calculates day of year for specified date parameters
+int calculate_day_of_year_position(int day_value, int month_value, int year_value);
+
+// Function displays progress indicator for calendar generation operations
+void display_calendar_generation_progress(int current_month, int total_months);
+
+/*
+================================================================================
+COMMAND LINE AND QUERY LOG FUNCTION DECLARATIONS
+================================================================================
+*/
+
+// Function dispatches command line options to specialized processing modes
+int execute_command_line_processing_mode(int argument_count, char* argument_values[]);
+
+// Function locates a named command line option and returns its argument index
+int find_command_line_option_index(int argument_count, char* argument_values[], const string& option_name);
+
+// Function retrieves the value following a named command line option
+string find_command_line_option_value(int argument_count, char* argument_values[],
+                                      const string& option_name, const string& default_value);
+
+// Function reports whether a named command line flag is present
+bool check_command_line_flag_present(int argument_count, char* argument_values[], const string& flag_name);
+
+// Function displays supported command line options
+void display_command_line_usage_information();
+
+// Function opens the binary query log recorder for incoming queries
+bool open_query_log_recorder(const string& log_file_path);
+
+// Function appends an incoming query to the active query log recorder
+void capture_incoming_calendar_query(int query_type, int day_value, int month_value, int year_value);
+
+// Function flushes and closes the active query log recorder
+void close_query_log_recorder();
+
+// Function loads every record stored in a binary query log file
+bool load_query_log_records(const string& log_file_path, vector<calendar_query_record>& loaded_records);
+
+// Function checks that a query record carries the fields its query type needs
+bool check_calendar_query_fields(const calendar_query_record& calendar_query);
+
+// Function parses one text query line into a query record
+bool parse_calendar_query_line(const string& query_line, calendar_query_record& parsed_query);
+
+// Function executes a query record through the calendar entry points
+void execute_calendar_query(const calendar_query_record& calendar_query);
+
+// Function serves text queries from standard input until end of stream
+int execute_query_service_mode();
+
+// Function replays a recorded query log and reports latency percentiles
+int execute_query_log_replay(const string& log_file_path, const string& replay_speed_text);
+
+// Function converts query type identifier to corresponding text representation
+string convert_query_type_to_text(int query_type);
+
+/*
+================================================================================
+COROUTINE GENERATOR DECLARATIONS
+================================================================================
+*/
+
+#ifdef CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+
+// Function obtains coroutine frame storage from the per-thread frame pool
+void* allocate_coroutine_frame(size_t frame_size);
+
+// Function returns coroutine frame storage to the per-thread frame pool
+void release_coroutine_frame(void* frame_pointer, size_t frame_size);
+
+// Class template exposes a lazily evaluated coroutine sequence as an input range
+template <typename yielded_type>
+class calendar_generator {
+public:
+    struct promise_type {
+        const yielded_type* current_value_pointer = nullptr;
+        
+        calendar_generator get_return_object() {
+            return calendar_generator(coroutine_handle<promise_type>::from_promise(*this));
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        suspend_always yield_value(const yielded_type& yielded_value) noexcept {
+            current_value_pointer = &yielded_value; // Value lives in the suspended frame
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { throw; }
+        
+        // Frames are drawn from the pooled allocator instead of the global heap
+        static void* operator new(size_t frame_size) { return allocate_coroutine_frame(frame_size); }
+        static void operator delete(void* frame_pointer, size_t frame_size) {
+            release_coroutine_frame(frame_pointer, frame_size);
+        }
+    };
+    
+    class iterator {
+    public:
+        explicit iterator(coroutine_handle<promise_type> coroutine_state) : coroutine_state(coroutine_state) {}
+        const yielded_type& operator*() const { return *coroutine_state.promise().current_value_pointer; }
+        const yielded_type* operator->() const { return coroutine_state.promise().current_value_pointer; }
+        iterator& operator++() {
+            coroutine_state.resume();
+            return *this;
+        }
+        bool operator==(default_sentinel_t) const { return !coroutine_state || coroutine_state.done(); }
+    private:
+        coroutine_handle<promise_type> coroutine_state;
+    };
+    
+    explicit calendar_generator(coroutine_handle<promise_type> coroutine_state) : coroutine_state(coroutine_state) {}
+    calendar_generator(calendar_generator&& other_generator) noexcept
+        : coroutine_state(exchange(other_generator.coroutine_state, nullptr)) {}
+    calendar_generator(const calendar_generator&) = delete;
+    calendar_generator& operator=(const calendar_generator&) = delete;
+    ~calendar_generator() {
+        if (coroutine_state) {
+            coroutine_state.destroy();
+        }
+    }
+    
+    // Starting iteration runs the coroutine to its first yield
+    iterator begin() {
+        coroutine_state.resume();
+        return iterator(coroutine_state);
+    }
+    default_sentinel_t end() { return default_sentinel; }
+    
+private:
+    coroutine_handle<promise_type> coroutine_state;
+};
+
+// Structure holds the descriptors of one year's months within a month range, so the month stream
+// resumes once per year and hands out references into the block
+struct calendar_month_descriptor_block {
+    calendar_month_descriptor month_descriptors[12]; // Months of the year in calendar order
+    int month_descriptor_count;                      // Number of filled descriptors
+};
+
+// Function lazily yields one block of month descriptors per year for an inclusive month range
+calendar_generator<calendar_month_descriptor_block> generate_month_descriptor_blocks(int first_month, int first_year,
+                                                                                     int last_month, int last_year);
+
+// Class flattens year blocks into a lazily evaluated range of individual month descriptors
+class calendar_month_descriptor_stream {
+public:
+    class iterator {
+    public:
+        explicit iterator(calendar_generator<calendar_month_descriptor_block>::iterator block_position)
+            : block_position(block_position), current_descriptor(nullptr), remaining_descriptor_count(0) {
+            load_next_block();
+        }
+        const calendar_month_descriptor& operator*() const { return *current_descriptor; }
+        const calendar_month_descriptor* operator->() const { return current_descriptor; }
+        iterator& operator++() {
+            // Walk the year block in place; resume the coroutine only between years
+            if (--remaining_descriptor_count > 0) {
+                ++current_descriptor;
+            } else {
+                ++block_position;
+                load_next_block();
+            }
+            return *this;
+        }
+        bool operator==(default_sentinel_t) const { return remaining_descriptor_count == 0; } // Zero only once blocks run out
+    private:
+        void load_next_block() {
+            while (!(block_position == default_sentinel) && block_position->month_descriptor_count <= 0) {
+                ++block_position;
+            }
+            if (!(block_position == default_sentinel)) {
+                current_descriptor = block_position->month_descriptors; // Block lives in the suspended frame
+                remaining_descriptor_count = block_position->month_descriptor_count;
+            }
+        }
+        
+        calendar_generator<calendar_month_descriptor_block>::iterator block_position;
+        const calendar_month_descriptor* current_descriptor;
+        int remaining_descriptor_count;   // Descriptors of the current block not yet passed, including the current one
+    };
+    
+    explicit calendar_month_descriptor_stream(calendar_generator<calendar_month_descriptor_block>&& block_generator)
+        : block_generator(move(block_generator)) {}
+    iterator begin() { return iterator(block_generator.begin()); }
+    default_sentinel_t end() { return default_sentinel; }
+    
+private:
+    calendar_generator<calendar_month_descriptor_block> block_generator;
+};
+
+// Function lazily yields month descriptors for an inclusive month range
+calendar_month_descriptor_stream generate_month_descriptor_stream(int first_month, int first_year,
+                                                                  int last_month, int last_year);
+
+// Structure describes one month of consecutive day records by its first record, so the day stream
+// resumes once per month and steps through the days without copying them
+struct calendar_day_record_block {
+    calendar_day_record first_day_record; // Record of the month's first day
+    int day_record_count;                 // Number of days in the month
+};
+
+// Function lazily yields one block of day records per month for an inclusive month range
+calendar_generator<calendar_day_record_block> generate_day_record_blocks(int first_month, int first_year,
+                                                                         int last_month, int last_year);
+
+// Class flattens month blocks into a lazily evaluated range of individual day records
+class calendar_day_record_stream {
+public:
+    class iterator {
+    public:
+        explicit iterator(calendar_generator<calendar_day_record_block>::iterator block_position)
+            : block_position(block_position), remaining_day_count(0) {
+            load_next_block();
+        }
+        const calendar_day_record& operator*() const { return current_record; }
+        const calendar_day_record* operator->() const { return &current_record; }
+        iterator& operator++() {
+            // Step within the month as a hand-written loop would; resume the coroutine only between months
+            if (--remaining_day_count > 0) {
+                current_record.day_value++;
+                current_record.day_of_year++;
+                if (++current_record.day_of_week == 7) {
+                    current_record.day_of_week = 0;
+                }
+            } else {
+                ++block_position;
+                load_next_block();
+            }
+            return *this;
+        }
+        bool operator==(default_sentinel_t) const { return remaining_day_count == 0; } // Zero only once blocks run out
+    private:
+        // Blocks without records (invalid months) are skipped rather than exposing an unfilled record
+        void load_next_block() {
+            while (!(block_position == default_sentinel) && block_position->day_record_count <= 0) {
+                ++block_position;
+            }
+            if (!(block_position == default_sentinel)) {
+                current_record = block_position->first_day_record;
+                remaining_day_count = block_position->day_record_count;
+            }
+        }
+        
+        calendar_generator<calendar_day_record_block>::iterator block_position;
+        calendar_day_record current_record;
+        int remaining_day_count;          // Days of the current month not yet passed, including the current one
+    };
+    
+    explicit calendar_day_record_stream(calendar_generator<calendar_day_record_block>&& block_generator)
+        : block_generator(move(block_generator)) {}
+    iterator begin() { return iterator(block_generator.begin()); }
+    default_sentinel_t end() { return default_sentinel; }
+    
+private:
+    calendar_generator<calendar_day_record_block> block_generator;
+};
+
+// Function lazily yields day records for an inclusive month range
+calendar_day_record_stream generate_day_record_stream(int first_month, int first_year, int last_month, int last_year);
+
+// Function compares generator iteration against equivalent hand-written loops
+int execute_generator_benchmark(int first_year, int last_year);
+
+#endif // CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+
+/*
+================================================================================
+PRINT LAYOUT RENDERER DECLARATIONS
+================================================================================
+*/
+
+// Function classifies a year by January 1 weekday and leap status (0-13)
+int calculate_year_layout_class(int target_year);
+
+// Function retrieves a numeric command line option or its default value
+int find_command_line_integer_option(int argument_count, char* argument_values[],
+                                     const string& option_name, int default_value);
+
+// Function escapes text for inclusion in the selected vector output format
+string escape_print_text(const string& raw_text, int output_format);
+
+// Function builds month and year page templates for every year layout class
+vector<print_layout_template_set> build_print_layout_templates(int output_format);
+
+// Function splices per-page values into a cached page template
+void append_print_page_from_template(string& page_buffer, const print_page_template& page_template,
+                                     const string& year_text, const string& escaped_personal_text);
+
+// Function renders a batch of personalized calendars across worker threads
+int execute_print_batch_generation(const string& jobs_file_path, const string& format_text,
+                                   const string& page_kind_text, const string& output_directory, int thread_count);
+
+/*
+================================================================================
+SERIAL DAY AND LUNAR PHASE DECLARATIONS
+================================================================================
+*/
+
+// Function converts a proleptic Gregorian date to a serial day number (0001-01-01 = 1)
+int calculate_serial_day_number(int day_value, int month_value, int year_value);
+
+// Function converts a serial day number back to its proleptic Gregorian date
+void convert_serial_day_to_calendar_date(int serial_day, int& day_value, int& month_value, int& year_value);
+
+// Function computes the Julian Ephemeris Day of the lunation phase with index k
+double calculate_lunar_phase_julian_day(double lunation_index, int phase_kind);
+
+// Function precomputes new and full moons over an inclusive year range into a sorted table
+vector<lunar_phase_event> build_lunar_phase_table(int first_year, int last_year);
+
+// Function displays every month of a year with moon phase days marked
+int execute_moon_phase_calendar_display(int target_year);
+
+/*
+================================================================================
+MAPPED FILE, CHECKSUM AND EVENT STORE DECLARATIONS
+================================================================================
+*/
+
+// Function maps an entire file read-only into memory
+bool map_file_read_only(const string& file_path, mapped_file_region& mapped_region);
+
+// Function releases a mapping created by map_file_read_only
+void unmap_file_region(mapped_file_region& mapped_region);
+
+// Function computes the CRC-32 (IEEE 802.3) checksum of a byte range
+uint32_t calculate_crc32_checksum(const void* data_pointer, size_t data_length, uint32_t running_checksum = 0);
+
+// Function parses a YYYY-MM-DD date, returning false for malformed or invalid dates
+bool parse_iso_calendar_date(const char* date_text, size_t text_length, int& day_value, int& month_value, int& year_value);
+
+// Function opens an event store, recovering from its snapshot and replaying the log tail
+bool open_calendar_event_store(calendar_event_store& event_store, const string& store_directory);
+
+// Function durably appends events to the log and merges them into the index
+bool append_calendar_events(calendar_event_store& event_store, vector<calendar_event_record>& new_events);
+
+// Function durably removes an event by identifier
+bool remove_calendar_event(calendar_event_store& event_store, uint64_t event_identifier);
+
+// Function writes a compacted snapshot and starts a new log generation
+bool compact_calendar_event_store(calendar_event_store& event_store);
+
+// Function closes the log handle of an event store
+void close_calendar_event_store(calendar_event_store& event_store);
+
+// Function times bulk appends and recovery on a scratch store created inside a directory and removed afterwards
+int execute_event_store_benchmark(const string& parent_directory, size_t benchmark_event_count);
+
+// Function handles the event store command line subcommands
+int execute_event_store_command(int argument_count, char* argument_values[], int option_index);
+
+/*
+================================================================================
+ICALENDAR IMPORT DECLARATIONS
+================================================================================
+*/
+
+// Function parses VEVENT blocks from a byte range of iCalendar text
+void parse_icalendar_event_range(const char* range_begin, const char* range_end,
+                                 vector<icalendar_event_record>& parsed_events,
+                                 icalendar_import_statistics& import_statistics);
+
+// Function imports a memory-mapped iCalendar file, splitting work on BEGIN:VEVENT boundaries
+int execute_icalendar_import(const string& ics_file_path, int thread_count, const string& event_store_directory);
+
+/*
+================================================================================
+CSV DATE ENRICHMENT DECLARATIONS
+================================================================================
+*/
+
+// Function returns the serial day of the nth weekday of a month (n = -1 selects the last one)
+int calculate_nth_weekday_serial_day(int occurrence_number, int weekday_index, int month_value, int year_value);
+
+// Function returns the serial day of Gregorian Easter Sunday
+int calculate_easter_sunday_serial_day(int year_value);
+
+// Function lists the serial days of one region's holidays in a year and returns their count
+int generate_region_holiday_serial_days(int region_code, int year_value, int holiday_serial_days[12]);
+
+// Function builds a per-serial-day bit table of holidays for the requested regions; the table always
+// spans years 1-9999 but only the given years are filled
+vector<uint8_t> build_holiday_day_table(const vector<int>& region_codes, int first_year = 1, int last_year = 9999);
+
+// Short region names accepted by --holidays, indexed by holiday_region_code
+extern const char* const holiday_region_names[HOLIDAY_REGION_COUNT];
+
+// Function parses a comma-separated holiday region list such as "US,GB"
+bool parse_holiday_region_list(const string& region_list_text, vector<int>& region_codes);
+
+// Function computes the ISO 8601 week number and week-numbering year
+void calculate_iso_week_date(int day_value, int month_value, int year_value, int& iso_week, int& iso_year);
+
+// Function enriches a date column of a CSV file with calendar attributes
+int execute_csv_date_enrichment(int argument_count, char* argument_values[], const string& input_file_path);
+
+/*
+================================================================================
+CALENDAR ARCHIVE DECLARATIONS
+================================================================================
+*/
+
+// Function returns the exact byte length of an unannotated monthly calendar display
+size_t calculate_monthly_calendar_display_size(int target_month, int target_year);
+
+// Function generates the monthly archive for a year range, optionally one byte-balanced shard of it
+int execute_archive_generation(const string& output_file_path, int first_year, int last_year,
+                               const string& shard_text, int checkpoint_interval_years);
+
+// Function verifies shard manifests and concatenates shard outputs into the complete archive
+int execute_archive_merge(const string& output_file_path, const vector<string>& shard_file_paths);
+
+/*
+================================================================================
+ROLLING WINDOW STATISTICS DECLARATIONS
+================================================================================
+*/
+
+// Function builds prefix-count tables covering an inclusive serial day range
+rolling_window_prefix_tables build_rolling_window_prefix_tables(int first_serial_day, int last_serial_day,
+                                                                const vector<int>& region_codes);
+
+// Function evaluates an inclusive window from the prefix tables in constant time
+rolling_window_statistics query_rolling_window_statistics(const rolling_window_prefix_tables& prefix_tables,
+                                                          int window_first_serial_day, int window_last_serial_day);
+
+// Function returns the first day of the trailing window of whole months ending on a date
+int calculate_trailing_window_start_serial_day(int day_value, int month_value, int year_value, int window_months);
+
+// Function writes the rolling statistics series for every day or month end in a year range
+int execute_rolling_window_statistics(int argument_count, char* argument_values[], const string& year_range_text);
+
+/*
+================================================================================
+CRON SCHEDULE DECLARATIONS
+================================================================================
+*/
+
+// Function compiles a five-field cron expression or @macro, reporting the reason on failure
+bool compile_cron_expression(const string& cron_expression, compiled_cron_schedule& compiled_schedule,
+                             string& error_text);
+
+// Function returns the bitmask of days (bit n = day n) on which a schedule fires in a month
+uint32_t calculate_cron_day_mask(const compiled_cron_schedule& compiled_schedule, int month_value, int year_value);
+
+// Function returns the first fire minute strictly after a serial minute, or -1 when none exists before 10000
+long long find_next_cron_fire_minute(const compiled_cron_schedule& compiled_schedule, long long after_serial_minute);
+
+// Function returns the last fire minute strictly before a serial minute, or -1 when none exists after year 1
+long long find_previous_cron_fire_minute(const compiled_cron_schedule& compiled_schedule, long long before_serial_minute);
+
+// Function computes next fire minutes for many schedules from one reference minute
+void compute_next_cron_fire_minutes(const vector<compiled_cron_schedule>& compiled_schedules,
+                                    long long after_serial_minute, vector<long long>& next_fire_minutes);
+
+// Function lists upcoming or preceding fire times of one cron expression
+int execute_cron_schedule_listing(int argument_count, char* argument_values[], const string& cron_expression);
+
+// Function benchmarks batch next-fire computation against day-by-day evaluation
+int execute_cron_schedule_benchmark(int schedule_count);
+
+/*
+================================================================================
+TIMER WHEEL DECLARATIONS
+================================================================================
+*/
+
+// Function prepares an empty timer wheel positioned at a serial minute
+void initialize_calendar_timer_wheel(calendar_timer_wheel& timer_wheel, long long start_minute, size_t capacity_hint);
+
+// Function schedules a reminder in constant time and returns its cancellation handle
+uint64_t insert_calendar_timer(calendar_timer_wheel& timer_wheel, long long expiry_minute, uint64_t reminder_identifier);
+
+// Function cancels a scheduled reminder in constant time, returning false for stale handles
+bool cancel_calendar_timer(calendar_timer_wheel& timer_wheel, uint64_t timer_handle);
+
+// Function advances the wheel to a serial minute, appending reminders that fire in expiry order
+size_t advance_calendar_timer_wheel(calendar_timer_wheel& timer_wheel, long long target_minute,
+                                    vector<timer_wheel_firing>& fired_reminders);
+
+// Function loads reminders from a file and fires them against a simulated or real clock
+int execute_reminder_driver(int argument_count, char* argument_values[], const string& reminder_file_path);
+
+// Function benchmarks timer wheel insert, cancel and fire against std::priority_queue
+int execute_timer_wheel_benchmark(int timer_count);
+
+/*
+================================================================================
+CAPACITY SEGMENT TREE DECLARATIONS
+================================================================================
+*/
+
+// Function builds a segment tree bottom-up from per-day values in linear time
+void build_capacity_segment_tree(capacity_segment_tree& segment_tree, const int32_t* day_values, int day_count);
+
+// Function adds an amount to every index in an inclusive range
+void add_capacity_segment_range(capacity_segment_tree& segment_tree, int first_index, int last_index, int32_t amount);
+
+// Function returns the maximum over an inclusive index range
+int32_t query_capacity_segment_maximum(const capacity_segment_tree& segment_tree, int first_index, int last_index);
+
+// Function creates one empty shard per year of an inclusive range
+void initialize_sharded_capacity_calendar(sharded_capacity_calendar& capacity_calendar, int first_year, int last_year);
+
+// Function bulk-loads bookings through per-year difference arrays and linear tree builds
+void bulk_load_capacity_bookings(sharded_capacity_calendar& capacity_calendar, const vector<capacity_booking>& bookings);
+
+// Function adds a booking amount to every day of an inclusive serial day range
+void reserve_capacity_range(sharded_capacity_calendar& capacity_calendar, int first_serial_day, int last_serial_day,
+                            int32_t booked_amount);
+
+// Function reserves only when every day stays within the limit, atomically across year shards
+bool try_reserve_capacity_range(sharded_capacity_calendar& capacity_calendar, int first_serial_day, int last_serial_day,
+                                int32_t booked_amount, int32_t capacity_limit);
+
+// Function returns the highest booking level on any day of an inclusive serial day range
+int32_t query_maximum_capacity_range(const sharded_capacity_calendar& capacity_calendar, int first_serial_day,
+                                     int last_serial_day);
+
+// Function loads bookings and displays month grids with per-day occupancy
+int execute_capacity_occupancy_display(int argument_count, char* argument_values[], const string& bookings_file_path);
+
+// Function benchmarks segment tree updates and queries against day-by-day scans
+int execute_capacity_benchmark(int operation_count, int thread_count);
+
+/*
+================================================================================
+PACKED DATE VALUE TYPE DECLARATIONS
+================================================================================
+*/
+
+// Function packs validated day, month and year values
+inline packed_calendar_date pack_calendar_date(int day_value, int month_value, int year_value);
+
+// Functions extract packed fields with shifts and masks only
+inline int extract_packed_day(packed_calendar_date date_value);
+inline int extract_packed_month(packed_calendar_date date_value);
+inline int extract_packed_year(packed_calendar_date date_value);
+
+// Function converts a packed date to its serial day number
+int convert_packed_date_to_serial_day(packed_calendar_date date_value);
+
+// Function converts a serial day number to a packed date
+packed_calendar_date convert_serial_day_to_packed_date(int serial_day);
+
+// Function converts a packed date to the 16-bit form, returning false outside 1900-01-01..2079-06-06
+bool convert_packed_date_to_compact_date(packed_calendar_date date_value, compact_calendar_date& compact_date);
+
+// Function converts a 16-bit date back to the packed form
+packed_calendar_date convert_compact_date_to_packed_date(compact_calendar_date compact_date);
+
+// Packed-date forms of the calendar calculations (branch-free leap and month tables)
+bool calculate_leap_year_status(packed_calendar_date date_value);
+int calculate_month_day_count(packed_calendar_date date_value);
+int calculate_day_of_year_position(packed_calendar_date date_value);
+
+// Function compares memory use and throughput of separate-int, packed and compact dates
+int execute_packed_date_benchmark(int date_count);
+
+/*
+================================================================================
+RADIX DATE SORT DECLARATIONS
+================================================================================
+*/
+
+// Functions return the unsigned radix key whose order matches date order
+inline uint32_t extract_radix_date_key(packed_calendar_date date_value) { return date_value.packed_value; }
+inline uint32_t extract_radix_date_key(int32_t serial_day) { return uint32_t(serial_day) ^ 0x80000000U; }
+
+// Function sorts a date column ascending with parallel LSD radix passes, optionally fusing duplicate
+// removal into the final pass; returns the number of elements left at the front of the column
+template <typename date_element_type>
+size_t radix_sort_date_column(date_element_type* date_elements, size_t element_count, bool remove_duplicates,
+                              int thread_count);
+
+// Function compares radix sorting with std::sort on clustered and uniform date columns
+int execute_date_sort_benchmark(int element_count, int thread_count);
+
+/*
+================================================================================
+CALENDAR GROUP-BY AGGREGATION DECLARATIONS
+================================================================================
+*/
+
+// Function parses a group key name (weekday, iso-week, month, quarter, day-of-year), returning false if unknown
+bool parse_calendar_group_key(const string& key_text, calendar_group_key_kind& key_kind);
+
+// Function returns the number of groups a key produces
+int calculate_calendar_group_count(calendar_group_key_kind key_kind);
+
+// Function derives the zero-based group index of one serial day through the calendar core
+int calculate_calendar_group_index(int serial_day, calendar_group_key_kind key_kind);
+
+// Function aggregates (serial day, value) columns by calendar key with per-thread partial aggregates
+void aggregate_calendar_groups(const int32_t* serial_days, const double* values, size_t row_count,
+                               calendar_group_key_kind key_kind, int thread_count,
+                               vector<calendar_group_aggregate>& group_aggregates);
+
+// Function aggregates a date,value CSV file and prints one line per group
+int execute_calendar_group_by(const string& key_text, const string& input_file_path, int thread_count);
+
+// Function compares per-row key derivation with the fused kernel on synthetic columns
+int execute_group_by_benchmark(int row_count, const string& key_text, int thread_count);
+
+/*
+================================================================================
+BUSINESS-DAY RESAMPLING DECLARATIONS
+================================================================================
+*/
+
+// Function lists the target serial days of a calendar, skipping weekends and days whose holiday bits match
+vector<int32_t> build_business_day_index(int first_serial_day, int last_serial_day, resample_calendar_kind calendar_kind,
+                                         const vector<uint8_t>& holiday_table, uint8_t holiday_mask);
+
+// Function aligns one series onto the target days with a single merge pass
+void align_series_to_calendar(const vector<int32_t>& target_days, const resample_series_columns& series_columns,
+                              resample_fill_method fill_method);
+
+// Function aligns many series in parallel, each worker claiming series from a shared counter
+void resample_series_batch(const vector<int32_t>& target_days, const vector<resample_series_columns>& series_columns,
+                           resample_fill_method fill_method, int thread_count);
+
+// Function resamples a series,date,value CSV into one wide CSV column per series
+int execute_series_resampling(int argument_count, char* argument_values[], const string& input_file_path);
+
+// Function compares the merge pass with per-target binary searches across many series
+int execute_resample_benchmark(int series_count, int thread_count);
+
+/*
+================================================================================
+COMPRESSED DATE SET DECLARATIONS
+================================================================================
+*/
+
+// Function builds a date set from ascending, distinct serial days
+compressed_date_set build_compressed_date_set(const vector<int32_t>& serial_days);
+
+// Function adds one serial day to a date set
+void add_date_set_day(compressed_date_set& date_set, int serial_day);
+
+// Function reports whether a serial day is in the set
+bool contains_date_set_day(const compressed_date_set& date_set, int serial_day);
+
+// Function expands one year of a set into a day-of-year bitmap, returning false when the year is empty
+bool expand_date_set_year(const compressed_date_set& date_set, int year_value, uint64_t bitmap_words[DATE_SET_BITMAP_WORDS]);
+
+// Functions combine two sets year by year
+compressed_date_set calculate_date_set_union(const compressed_date_set& left_set, const compressed_date_set& right_set);
+compressed_date_set calculate_date_set_intersection(const compressed_date_set& left_set, const compressed_date_set& right_set);
+compressed_date_set calculate_date_set_difference(const compressed_date_set& left_set, const compressed_date_set& right_set);
+
+// Function counts common days without materializing the intersection
+size_t calculate_date_set_intersection_cardinality(const compressed_date_set& left_set, const compressed_date_set& right_set);
+
+// Function returns the number of days in a set
+size_t calculate_date_set_cardinality(const compressed_date_set& date_set);
+
+// Function returns the heap and inline bytes a set occupies
+size_t calculate_date_set_memory_bytes(const compressed_date_set& date_set);
+
+// Function appends the set's serial days in ascending order
+void append_date_set_serial_days(const compressed_date_set& date_set, vector<int32_t>& serial_days);
+
+// Function loads date lists, combines them and displays a year with highlighted days
+int execute_date_set_display(int argument_count, char* argument_values[], const string& date_list_path);
+
+// Function compares compressed sets with sorted vectors and dense bitmaps
+int execute_date_set_benchmark(int user_count);
+
+/*
+================================================================================
+VACATION OPTIMIZER DECLARATIONS
+================================================================================
+*/
+
+// Function returns the days a planning bitmap covers, the plan year followed by the next year
+int calculate_vacation_window_day_count(int year_value);
+
+// Function marks weekends, the selected holidays and regular days off in a planning bitmap
+void build_year_off_day_bitmap(int year_value, const vector<uint8_t>& holiday_table, uint8_t holiday_mask,
+                               uint8_t extra_off_weekdays, uint64_t off_day_words[VACATION_WINDOW_WORDS]);
+
+// Function finds the longest break starting in the plan year reachable with a vacation budget using
+// one sliding window pass
+vacation_break_plan find_longest_vacation_break(const uint64_t off_day_words[VACATION_WINDOW_WORDS], int year_day_count,
+                                                int window_day_count, int vacation_budget);
+
+// Function ranks bridge opportunities (working-day gaps between days off) starting in the plan year
+// by break days gained per vacation day
+vector<vacation_break_plan> rank_bridge_day_opportunities(const uint64_t off_day_words[VACATION_WINDOW_WORDS],
+                                                          int year_day_count, int window_day_count,
+                                                          int maximum_vacation_days);
+
+// Function plans many employees at once, evaluating each distinct (region, days off, budget) combination once
+void optimize_vacation_batch(int year_value, const vector<vacation_request>& vacation_requests,
+                             const vector<uint8_t>& holiday_table, vector<vacation_break_plan>& break_plans,
+                             int thread_count);
+
+// Function prints the longest break and the best bridge days for one year
+int execute_vacation_planner(int argument_count, char* argument_values[], int year_value);
+
+// Function compares the sliding window with a brute-force search over many employees
+int execute_vacation_benchmark(int employee_count, int thread_count);
+
+/*
+================================================================================
+PERSISTENT RENDER CACHE DECLARATIONS
+================================================================================
+*/
+
+// Function hashes the inputs that determine a month rendering into a cache key
+uint64_t calculate_render_input_hash(int layout_class, int month_value, int output_format, uint32_t option_flags,
+                                     uint64_t holiday_set_hash);
+
+// Function hashes which days of a month are holidays of the selected regions
+uint64_t calculate_month_holiday_set_hash(const vector<uint8_t>& holiday_table, uint8_t holiday_mask,
+                                          int month_value, int year_value);
+
+// Function opens (or starts) a pack file; an unreadable or damaged pack is treated as empty
+void open_persistent_render_cache(persistent_render_cache& render_cache, const string& pack_file_path,
+                                  uint64_t size_limit_bytes);
+
+// Function finds a cached output and refreshes its LRU position
+bool lookup_render_cache(persistent_render_cache& render_cache, uint64_t input_hash,
+                         const char*& data_pointer, size_t& data_length);
+
+// Function adds a newly rendered output to the cache
+void store_render_cache(persistent_render_cache& render_cache, uint64_t input_hash, const string& rendered_output);
+
+// Function merges concurrent updates, evicts least recently used outputs and replaces the pack atomically
+bool flush_persistent_render_cache(persistent_render_cache& render_cache);
+
+// Function releases the pack mapping and pending outputs
+void close_persistent_render_cache(persistent_render_cache& render_cache);
+
+// Function appends a month display, reusing a cached grid for the same layout, month and holidays
+void append_cached_monthly_calendar_display(persistent_render_cache& render_cache, string& display_buffer,
+                                            int target_month, int target_year, const calendar_display_options& display_options);
+
+// Function renders a year range through the cache and reports hit ratio and bytes saved
+int execute_render_cache_report(int argument_count, char* argument_values[], const string& pack_file_path);
+
+/*
+================================================================================
+WEEK ROW EMITTER DECLARATIONS
+================================================================================
+*/
+
+// Function returns the shared strip of blank and day-number cells built from a digit-pair table
+const char* retrieve_calendar_row_cell_strip();
+
+// Function lays out per-day markers (index 1-31, zero = none) at their cell strip positions
+void build_calendar_row_marker_strip(const char* day_markers, int month_day_count, calendar_row_marker_strip& marker_strip);
+
+// Function appends every week row of a month grid, one vector copy and blend per row
+void append_calendar_week_rows(string& display_buffer, int starting_day_position, int month_day_count,
+                               const calendar_row_marker_strip& marker_strip);
+
+// Function appends week rows one cell at a time (reference for the vector emitter)
+void append_calendar_week_rows_by_cell(string& display_buffer, int starting_day_position, int month_day_count,
+                                       const char* day_markers);
+
+// Function checks every month shape against the reference and times both emitters per row
+int execute_row_emitter_benchmark(int row_count);
+
+/*
+================================================================================
+DAYLIGHT SAVING TRANSITION REPORT DECLARATIONS
+================================================================================
+*/
+
+// Function lists zone files below a zoneinfo directory, skipping the posix/ and right/ variants
+bool list_zoneinfo_files(const string& directory_path, const string& relative_prefix, vector<string>& zone_names);
+
+// Function parses a POSIX TZ string such as CET-1CEST,M3.5.0,M10.5.0/3
+bool parse_posix_zone_footer(const char* footer_text, posix_zone_footer& zone_footer);
+
+// Function extracts transitions in a UTC window from mapped TZif bytes, extending them with the footer rule
+bool parse_tzif_transitions(const char* file_data, size_t file_size, long long first_utc_seconds, long long last_utc_seconds,
+                            vector<time_zone_transition>& zone_transitions);
+
+// Function collects the canonical zone names listed by tzdata.zi, or else zone1970.tab or zone.tab
+bool load_canonical_zone_names(const string& zoneinfo_directory, unordered_set<string>& canonical_names);
+
+// Function ranks a zone name for heading its alias group: canonical zones, then Area/City names, then the rest
+int rank_time_zone_name(const string& zone_name, const unordered_set<string>& canonical_names);
+
+// Function reports every zone's transitions for a year range as text and optionally JSON
+int execute_daylight_transition_report(int argument_count, char* argument_values[], const string& year_range_text);
+
+/*
+================================================================================
+TIMELINE RENDERER DECLARATIONS
+================================================================================
+*/
+
+// Function precomputes sparse day, week, month, quarter and year aggregates for every lane; task_titles is
+// parallel to the tasks, or empty when they are untitled
+void build_timeline_lod_index(const vector<timeline_task>& timeline_tasks, const vector<string>& task_titles,
+                              const vector<string>& lane_names, timeline_lod_index& lod_index, int thread_count);
+
+// Function picks the finest level whose visible buckets fit the column count, merging years into columns when
+// even the year level is too wide; bucket_count is the column count. A view holding no day of the task span
+// gets no buckets
+int select_timeline_level(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                          int column_count, int& first_bucket, int& bucket_count, int& buckets_per_column);
+
+// Function gathers a view's bucket aggregates and bar tasks in time proportional to lanes times columns
+void build_timeline_view_layout(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                                int column_count, timeline_view_layout& view_layout);
+
+// Function formats a view layout as text, SVG or HTML
+string format_timeline_view(const timeline_lod_index& lod_index, const timeline_view_layout& view_layout,
+                            int view_first_serial_day, int view_last_serial_day, int output_format);
+
+// Function renders a date range at the selected level
+string render_timeline_view(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                            int column_count, int output_format);
+
+// Function loads a task CSV and renders one view as text, SVG or HTML
+int execute_timeline_rendering(int argument_count, char* argument_values[], const string& task_file_path);
+
+// Function compares indexed rendering with a per-render scan of every task at each zoom level
+int execute_timeline_benchmark(int task_count);
+
+/*
+================================================================================
+MAIN PROGRAM EXECUTION ENTRY POINT
+================================================================================
+*/
+
+// Shared library builds (-DCALENDAR_LIBRARY_BUILD) export the C ABI without a program entry point
+#ifndef CALENDAR_LIBRARY_BUILD
+int main(int argc, char* argv[]) {
+    // Dispatch command line options before running the default demonstration
+    if (argc > 1) {
+        int command_line_status = execute_command_line_processing_mode(argc, argv);
+        if (command_line_status != COMMAND_LINE_CONTINUE_DEMONSTRATION) {
+            return command_line_status;
+        }
+    }
+    
+    // Initialize primary execution parameters for calendar demonstration
+    const int demonstration_year = 2025;
+    const int total_demonstration_months = 12;
+    int current_processing_month = 1;
+    
+    // Display professional program identification header
+    display_program_identification_header();
+    
+    // Validate demonstration year parameters before processing
+    if (validate_date_input_parameters(1, demonstration_year)) {
+        cout << "Calendar Generation Parameters Validated Successfully" << endl;
+        cout << "Target Year: " << demonstration_year << endl;
+        cout << "Processing Mode: Complete Annual Calendar" << endl;
+        cout << string(60, '=') << endl;
+        
+        // Execute comprehensive calendar generation for entire year
+        while (current_processing_month <= total_demonstration_months) {
+            cout << "\n" << string(50, '-') << endl;
+            cout << "PROCESSING MONTH: " << current_processing_month 
+                 << " (" << convert_month_number_to_text(current_processing_month) << ")" << endl;
+            cout << string(50, '-') << endl;
+            
+            // Generate formatted calendar display for current month
+            capture_incoming_calendar_query(QUERY_TYPE_MONTH_RENDER, 0, current_processing_month, demonstration_year);
+            generate_monthly_calendar_display(current_processing_month, demonstration_year);
+            
+            // Display processing progress indicator
+            display_calendar_generation_progress(current_processing_month, total_demonstration_months);
+            
+            // Increment month processing counter
+            current_processing_month++;
+        }
+        
+        // Execute statistical analysis on generated calendar data
+        cout << "\n" << string(60, '=') << endl;
+        cout << "EXECUTING CALENDAR STATISTICAL ANALYSIS" << endl;
+        cout << string(60, '=') << endl;
+        capture_incoming_calendar_query(QUERY_TYPE_STATISTICS, 0, 0, demonstration_year);
+        execute_calendar_statistics_analysis(demonstration_year);
+        
+    } else {
+        cout << "ERROR: Invalid calendar parameters detected." << endl;
+        return 1; // Indicates parameter validation failure
+    }
+    
+    // Display program completion status and summary
+    cout << "\n" << string(60, '=') << endl;
+    cout << "CALENDAR GENERATION COMPLETED SUCCESSFULLY" << endl;
+    cout << "Year Processed: " << demonstration_year << endl;
+    cout << "Months Generated: " << total_demonstration_months << endl;
+    cout << "Leap Year Status: " << (calculate_leap_year_status(demonstration_year) ? "TRUE" : "FALSE") << endl;
+    cout << string(60, '=') << endl;
+    
+    // Flush any queries captured during the demonstration run
+    close_query_log_recorder();
+    
+    return 0; // Indicates successful program termination
+}
+#endif // CALENDAR_LIBRARY_BUILD
+
+/*
+================================================================================
+LEAP YEAR CALCULATION ALGORITHM IMPLEMENTATION
+================================================================================
+*/
+
+bool calculate_leap_year_status(int target_year) {
+    // Implements standard Gregorian calendar leap year determination algorithm
+    // Year is leap if divisible by 4, except century years must be divisible by 400
+    if (target_year % 400 == 0) {
+        return true; // Century year divisible by 400 is leap year
+    } else if (target_year % 100 == 0) {
+        return false; // Century year not divisible by 400 is not leap year
+    } else if (target_year % 4 == 0) {
+        return true; // Non-century year divisible by 4 is leap year
+    } else {
+        return false; // Year not divisible by 4 is not leap year
+    }
+}
+
+/*
+================================================================================
+MONTH DAY COUNT CALCULATION FUNCTION
+================================================================================
+*/
+
+int calculate_month_day_count(int target_month, int target_year) {
+    // Array stores standard day counts for each month (non-leap year)
+    int standard_month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    
+    // Validate month parameter within acceptable range
+    if (target_month < 1 || target_month > 12) {
+        return 0; // Return zero for invalid month parameter
+    }
+    
+    // Adjust February day count for leap year conditions
+    if (target_month == 2 && calculate_leap_year_status(target_year)) {
+        return 29; // February has 29 days in leap years
+    } else {
+        return standard_month_days[target_month - 1]; // Return standard day count
+    }
+}
+
+/*
+================================================================================
+MONTH STARTING DAY CALCULATION ALGORITHM
+================================================================================
+*/
+
+int calculate_month_starting_day(int target_month, int target_year) {
+    // Implements Zeller's Congruence algorithm for day-of-week calculation
+    // Adjusts month and year values for algorithm requirements
+    int adjusted_month = target_month;
+    int adjusted_year = target_year;
+    
+    // Zeller's algorithm treats January and February as months 13 and 14 of previous year
+    if (adjusted_month < 3) {
+        adjusted_month += 12;
+        adjusted_year--;
+    }
+    
+    // Calculate century and year components for Zeller's formula
+    int century_component = adjusted_year / 100;
+    int year_component = adjusted_year % 100;
+    
+    // Apply Zeller's Congruence formula for day-of-week determination
+    int day_of_week = (1 + (13 * (adjusted_month + 1)) / 5 + year_component + 
+                       year_component / 4 + century_component / 4 - 2 * century_component) % 7;
+    
+    // Convert Zeller's result (0=Saturday) to standard format (0=Sunday)
+    return (day_of_week + 6) % 7;
+}
+
+/*
+================================================================================
+MONTHLY CALENDAR DISPLAY GENERATION FUNCTION
+================================================================================
+*/
+
+void generate_monthly_calendar_display(int target_month, int target_year) {
+    generate_monthly_calendar_display(target_month, target_year, calendar_display_options());
+}
+
+void generate_monthly_calendar_display(int target_month, int target_year, const calendar_display_options& display_options) {
+    // Render complete month text into a buffer and emit it with a single write
+    string calendar_display_buffer;
+    append_monthly_calendar_display(calendar_display_buffer, target_month, target_year, display_options);
+    cout << calendar_display_buffer << flush;
+}
+
+/*
+================================================================================
+MONTHLY CALENDAR TEXT RENDERING FUNCTION
+================================================================================
+*/
+
+void append_monthly_calendar_title(string& display_buffer, int target_month, int target_year) {
+    string month_text_representation = convert_month_number_to_text(target_month);
+    display_buffer += "\n";
+    if (month_text_representation.size() < 20) {
+        display_buffer.append(20 - month_text_representation.size(), ' ');
+    }
+    display_buffer += month_text_representation + " " + to_string(target_year) + "\n";
+}
+
+void append_monthly_calendar_display(string& display_buffer, int target_month, int target_year) {
+    append_monthly_calendar_display(display_buffer, target_month, target_year, calendar_display_options());
+}
+
+void append_monthly_calendar_display(string& display_buffer, int target_month, int target_year,
+                                     const calendar_display_options& display_options) {
+    // Retrieve month-specific parameters for calendar generation
+    int month_day_count = calculate_month_day_count(target_month, target_year);
+    int starting_day_position = calculate_month_starting_day(target_month, target_year);
+    
+    // Resolve per-day grid markers from the requested annotations (zero = unmarked)
+    char day_markers[32] = {0};
+    vector<lunar_phase_event> month_phase_events;
+    if (display_options.lunar_phase_table != NULL && month_day_count > 0) {
+        // Binary search locates the first phase on or after the first day of the month
+        int month_first_serial_day = calculate_serial_day_number(1, target_month, target_year);
+        lunar_phase_event search_key = {month_first_serial_day, 0, 0};
+        vector<lunar_phase_event>::const_iterator phase_position = lower_bound(
+            display_options.lunar_phase_table->begin(), display_options.lunar_phase_table->end(), search_key,
+            [](const lunar_phase_event& left_event, const lunar_phase_event& right_event) {
+                return left_event.serial_day < right_event.serial_day;
+            });
+        for (; phase_position != display_options.lunar_phase_table->end() &&
+               phase_position->serial_day < month_first_serial_day + month_day_count; ++phase_position) {
+            day_markers[phase_position->serial_day - month_first_serial_day + 1] =
+                phase_position->phase_kind == LUNAR_PHASE_NEW_MOON ? LUNAR_NEW_MOON_MARKER : LUNAR_FULL_MOON_MARKER;
+            month_phase_events.push_back(*phase_position);
+        }
+    }
+    
+    // Occupancy markers classify each day's booking level against the display capacity
+    int32_t peak_occupancy = 0;
+    int peak_occupancy_day = 0;
+    if (display_options.occupancy_calendar != NULL && month_day_count > 0) {
+        int month_first_serial_day = calculate_serial_day_number(1, target_month, target_year);
+        for (int current_day = 1; current_day <= month_day_count; current_day++) {
+            int32_t booked_amount = query_maximum_capacity_range(*display_options.occupancy_calendar,
+                                                                 month_first_serial_day + current_day - 1,
+                                                                 month_first_serial_day + current_day - 1);
+            if (booked_amount > peak_occupancy) {
+                peak_occupancy = booked_amount;
+                peak_occupancy_day = current_day;
+            }
+            if (booked_amount <= 0) {
+                continue;
+            }
+            day_markers[current_day] = booked_amount >= display_options.occupancy_capacity ? OCCUPANCY_FULL_MARKER :
+                                       booked_amount * 2 >= display_options.occupancy_capacity ? OCCUPANCY_BUSY_MARKER :
+                                       OCCUPANCY_PARTIAL_MARKER;
+        }
+    }
+    
+    // Holiday markers replace phase and occupancy markers
+    int holiday_day_count = 0;
+    if (display_options.holiday_day_table != NULL && month_day_count > 0) {
+        int month_first_serial_day = calculate_serial_day_number(1, target_month, target_year);
+        for (int current_day = 1; current_day <= month_day_count; current_day++) {
+            if (((*display_options.holiday_day_table)[size_t(month_first_serial_day + current_day - 1)] &
+                 display_options.holiday_region_mask) != 0) {
+                day_markers[current_day] = HOLIDAY_DAY_MARKER;
+                holiday_day_count++;
+            }
+        }
+    }
+    
+    // Highlighted days take precedence over every other marker
+    int highlighted_day_count = 0;
+    if (display_options.highlighted_days != NULL && month_day_count > 0) {
+        uint64_t year_bitmap_words[DATE_SET_BITMAP_WORDS];
+        if (expand_date_set_year(*display_options.highlighted_days, target_year, year_bitmap_words)) {
+            int month_first_day_index = calculate_day_of_year_position(1, target_month, target_year) - 1;
+            for (int current_day = 1; current_day <= month_day_count; current_day++) {
+                int day_index = month_first_day_index + current_day - 1;
+                if ((year_bitmap_words[day_index >> 6] >> (day_index & 63) & 1) != 0) {
+                    day_markers[current_day] = DATE_SET_HIGHLIGHT_MARKER;
+                    highlighted_day_count++;
+                }
+            }
+        }
+    }
+    
+    // Append formatted calendar header with month name right-aligned in 20 columns
+    append_monthly_calendar_title(display_buffer, target_month, target_year);
+    display_buffer.append(28, '-');
+    display_buffer += "\n";
+    
+    // Append day-of-week column headers
+    display_buffer += " Su Mo Tu We Th Fr Sa\n";
+    
+    // Generate week rows of right-aligned three-character cells, leading blanks included
+    calendar_row_marker_strip marker_strip;
+    build_calendar_row_marker_strip(day_markers, month_day_count, marker_strip);
+    append_calendar_week_rows(display_buffer, starting_day_position, month_day_count, marker_strip);
+    
+    // Append month statistics and analysis
+    display_buffer += "\nMonth Analysis:\n";
+    display_buffer += "  Total Days: " + to_string(month_day_count) + "\n";
+    display_buffer += "  Starting Day: " + to_string(starting_day_position) + " (0=Sunday)\n";
+    display_buffer += "  Weekends: " + to_string((month_day_count + starting_day_position + 6) / 7) + "\n";
+    
+    // Append moon phase times when phase annotations were requested
+    if (display_options.lunar_phase_table != NULL) {
+        display_buffer += "  Moon Phases (" + string(1, LUNAR_NEW_MOON_MARKER) + "=New, " +
+                          string(1, LUNAR_FULL_MOON_MARKER) + "=Full):";
+        if (month_phase_events.empty()) {
+            display_buffer += " none";
+        }
+        display_buffer += "\n";
+        for (size_t event_index = 0; event_index < month_phase_events.size(); event_index++) {
+            const lunar_phase_event& phase_event = month_phase_events[event_index];
+            char phase_line[64];
+            snprintf(phase_line, sizeof(phase_line), "    %s Moon: %d at %02d:%02d UTC\n",
+                     phase_event.phase_kind == LUNAR_PHASE_NEW_MOON ? "New" : "Full",
+                     phase_event.serial_day - calculate_serial_day_number(1, target_month, target_year) + 1,
+                     phase_event.minute_of_day / 60, phase_event.minute_of_day % 60);
+            display_buffer += phase_line;
+        }
+    }
+    
+    // Append the occupancy legend and monthly peak when occupancy was requested
+    if (display_options.occupancy_calendar != NULL) {
+        display_buffer += "  Occupancy (" + string(1, OCCUPANCY_PARTIAL_MARKER) + "=<50%, " +
+                          string(1, OCCUPANCY_BUSY_MARKER) + "=50%+, " + string(1, OCCUPANCY_FULL_MARKER) + "=full): peak " +
+                          to_string(peak_occupancy) + "/" + to_string(display_options.occupancy_capacity);
+        display_buffer += peak_occupancy_day > 0 ? " on day " + to_string(peak_occupancy_day) + "\n" : "\n";
+    }
+    
+    // Append the holiday count when holidays were requested
+    if (display_options.holiday_day_table != NULL) {
+        display_buffer += "  Holidays (" + string(1, HOLIDAY_DAY_MARKER) + "): " + to_string(holiday_day_count) + " days\n";
+    }
+    
+    // Append the highlighted day count when a date set was supplied
+    if (display_options.highlighted_days != NULL) {
+        display_buffer += "  Highlighted (" + string(1, DATE_SET_HIGHLIGHT_MARKER) + "): " + to_string(highlighted_day_count) +
+                          " days\n";
+    }
+}
+
+/*
+================================================================================
+CALENDAR STATISTICAL ANALYSIS FUNCTION
+================================================================================
+*/
+
+annual_calendar_statistics calculate_annual_calendar_statistics(int target_year) {
+    // Initialize statistical accumulation variables
+    annual_calendar_statistics year_statistics;
+    year_statistics.target_year = target_year;
+    year_statistics.leap_year_status = calculate_leap_year_status(target_year);
+    year_statistics.total_year_days = 0;
+    year_statistics.total_weekend_days = 0;
+    vector<int> month_length_distribution;
+    
+    // Process each month for statistical data collection
+    for (int analysis_month = 1; analysis_month <= 12; analysis_month++) {
+        int current_month_days = calculate_month_day_count(analysis_month, target_year);
+        int month_starting_day = calculate_month_starting_day(analysis_month, target_year);
+        
+        // Accumulate total day count for year
+        year_statistics.total_year_days += current_month_days;
+        
+        // Store month length for distribution analysis
+        month_length_distribution.push_back(current_month_days);
+        
+        // Four full weeks hold eight weekend days; only the remaining 0-3 days need checking
+        int month_weekend_days = 8 + count_weekday_span_matches(month_starting_day, current_month_days - 28, 0x41);
+        year_statistics.total_weekend_days += month_weekend_days;
+    }
+    
+    // Calculate derived statistical metrics
+    year_statistics.total_weekday_count = year_statistics.total_year_days - year_statistics.total_weekend_days;
+    year_statistics.weekend_percentage = (double(year_statistics.total_weekend_days) / year_statistics.total_year_days) * 100.0;
+    sort(month_length_distribution.begin(), month_length_distribution.end());
+    year_statistics.shortest_month_days = month_length_distribution[0];
+    year_statistics.longest_month_days = month_length_distribution[11];
+    year_statistics.average_month_days = double(year_statistics.total_year_days) / 12.0;
+    
+    return year_statistics;
+}
+
+void execute_calendar_statistics_analysis(int target_year) {
+    annual_calendar_statistics year_statistics = calculate_annual_calendar_statistics(target_year);
+    
+    // Display comprehensive statistical analysis results
+    cout << "ANNUAL CALENDAR STATISTICS REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Target Year: " << target_year << endl;
+    cout << "Leap Year Status: " << (year_statistics.leap_year_status ? "TRUE" : "FALSE") << endl;
+    cout << "Total Days: " << year_statistics.total_year_days << endl;
+    cout << "Weekend Days: " << year_statistics.total_weekend_days << endl;
+    cout << "Weekday Count: " << year_statistics.total_weekday_count << endl;
+    cout << "Weekend Percentage: " << fixed << setprecision(1) << year_statistics.weekend_percentage << "%" << endl;
+    
+    // Display month length distribution statistics
+    cout << "\nMonth Length Distribution:" << endl;
+    cout << "  Shortest Month: " << year_statistics.shortest_month_days << " days" << endl;
+    cout << "  Longest Month: " << year_statistics.longest_month_days << " days" << endl;
+    cout << "  Average Month Length: " << fixed << setprecision(1) 
+         << year_statistics.average_month_days << " days" << endl;
+}
+
+/*
+================================================================================
+EXTENDED ANNUAL STATISTICS FUNCTIONS
+================================================================================
+*/
+
+int count_weekday_span_matches(int first_weekday, int span_length, uint8_t weekday_mask) {
+    int match_count = 0;
+    for (int span_offset = 0; span_offset < span_length; span_offset++) {
+        match_count += (weekday_mask >> ((first_weekday + span_offset) % 7)) & 1;
+    }
+    return match_count;
+}
+
+extended_annual_statistics calculate_extended_annual_statistics(int target_year, int holiday_region_code) {
+    // Every metric follows from the twelve month start weekdays and at most a dozen
+    // holidays, so the cost per year is constant rather than one step per day
+    extended_annual_statistics year_statistics;
+    memset(&year_statistics, 0, sizeof(year_statistics));
+    year_statistics.base_statistics = calculate_annual_calendar_statistics(target_year);
+    year_statistics.holiday_region_code = holiday_region_code;
+    
+    // 52 full weeks plus one or two extra days starting from the January 1 weekday
+    int year_first_serial_day = calculate_serial_day_number(1, 1, target_year);
+    fill(year_statistics.weekday_counts, year_statistics.weekday_counts + 7, 52);
+    for (int extra_day = 0; extra_day < year_statistics.base_statistics.total_year_days - 364; extra_day++) {
+        year_statistics.weekday_counts[(year_first_serial_day + extra_day) % 7]++;
+    }
+    
+    int month_first_serial_day = year_first_serial_day;
+    for (int month_value = 1; month_value <= 12; month_value++) {
+        int month_day_count = calculate_month_day_count(month_value, target_year);
+        int month_starting_day = month_first_serial_day % 7;
+        year_statistics.month_start_weekday_counts[month_starting_day]++;
+        year_statistics.quarter_working_days[(month_value - 1) / 3] +=
+            20 + count_weekday_span_matches(month_starting_day, month_day_count - 28, 0x3E);
+        year_statistics.friday_thirteenth_count += (month_starting_day + 12) % 7 == 5 ? 1 : 0;
+        month_first_serial_day += month_day_count;
+    }
+    
+    if (holiday_region_code >= 0) {
+        // Rules can coincide (Ascension Day on May 1), so each date counts once
+        int holiday_serial_days[12];
+        int holiday_count = generate_region_holiday_serial_days(holiday_region_code, target_year, holiday_serial_days);
+        int lengthened_saturdays[12];
+        int lengthened_count = 0;
+        for (int holiday_index = 0; holiday_index < holiday_count; holiday_index++) {
+            int holiday_serial_day = holiday_serial_days[holiday_index];
+            int holiday_weekday = holiday_serial_day % 7;
+            if (holiday_weekday == 0 || holiday_weekday == 6 ||
+                find(holiday_serial_days, holiday_serial_days + holiday_index, holiday_serial_day) !=
+                    holiday_serial_days + holiday_index) {
+                continue;
+            }
+            int holiday_day = 0;
+            int holiday_month = 0;
+            int holiday_year = 0;
+            convert_serial_day_to_calendar_date(holiday_serial_day, holiday_day, holiday_month, holiday_year);
+            year_statistics.weekday_holiday_count++;
+            year_statistics.quarter_working_days[(holiday_month - 1) / 3]--;
+            if (holiday_weekday == 5 || holiday_weekday == 1) {
+                // Identify the weekend by its Saturday so Good Friday and Easter Monday count once
+                int weekend_saturday = holiday_weekday == 5 ? holiday_serial_day + 1 : holiday_serial_day - 2;
+                if (find(lengthened_saturdays, lengthened_saturdays + lengthened_count, weekend_saturday) ==
+                    lengthened_saturdays + lengthened_count) {
+                    lengthened_saturdays[lengthened_count++] = weekend_saturday;
+                }
+            }
+        }
+        year_statistics.three_day_weekend_count = lengthened_count;
+    }
+    return year_statistics;
+}
+
+void calculate_extended_statistics_range(int first_year, int last_year, int holiday_region_code, int thread_count,
+                                         vector<extended_annual_statistics>& range_statistics) {
+    // Years are independent, so each worker fills one contiguous slice of the output
+    range_statistics.resize(size_t(last_year - first_year + 1));
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    size_t year_count = range_statistics.size();
+    size_t slice_length = (year_count + size_t(thread_count) - 1) / size_t(thread_count);
+    vector<thread> worker_threads;
+    for (size_t slice_start = 0; slice_start < year_count; slice_start += slice_length) {
+        size_t slice_end = min(year_count, slice_start + slice_length);
+        worker_threads.push_back(thread([&range_statistics, first_year, holiday_region_code, slice_start, slice_end]() {
+            for (size_t year_index = slice_start; year_index < slice_end; year_index++) {
+                range_statistics[year_index] = calculate_extended_annual_statistics(first_year + int(year_index),
+                                                                                    holiday_region_code);
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+}
+
+void print_extended_statistics_table(const vector<extended_annual_statistics>& range_statistics) {
+    // Month starts are listed as seven digits, Sunday first (each weekday starts at most three months)
+    cout << "Year Leap Days  Sun Mon Tue Wed Thu Fri Sat  Q1wd Q2wd Q3wd Q4wd  Fr13 Hol 3DW  Starts" << endl;
+    cout << string(86, '-') << endl;
+    for (size_t year_index = 0; year_index < range_statistics.size(); year_index++) {
+        const extended_annual_statistics& year_statistics = range_statistics[year_index];
+        char row_text[160];
+        int row_length = snprintf(row_text, sizeof(row_text), "%04d %-4s %4d ", year_statistics.base_statistics.target_year,
+                                  year_statistics.base_statistics.leap_year_status ? "yes" : "no",
+                                  year_statistics.base_statistics.total_year_days);
+        for (int weekday_index = 0; weekday_index < 7; weekday_index++) {
+            row_length += snprintf(row_text + row_length, sizeof(row_text) - size_t(row_length), " %3d",
+                                   year_statistics.weekday_counts[weekday_index]);
+        }
+        row_length += snprintf(row_text + row_length, sizeof(row_text) - size_t(row_length), " ");
+        for (int quarter_index = 0; quarter_index < 4; quarter_index++) {
+            row_length += snprintf(row_text + row_length, sizeof(row_text) - size_t(row_length), " %4d",
+                                   year_statistics.quarter_working_days[quarter_index]);
+        }
+        if (year_statistics.holiday_region_code >= 0) {
+            row_length += snprintf(row_text + row_length, sizeof(row_text) - size_t(row_length), "  %4d %3d %3d  ",
+                                   year_statistics.friday_thirteenth_count, year_statistics.weekday_holiday_count,
+                                   year_statistics.three_day_weekend_count);
+        } else {
+            row_length += snprintf(row_text + row_length, sizeof(row_text) - size_t(row_length), "  %4d   -   -  ",
+                                   year_statistics.friday_thirteenth_count);
+        }
+        for (int weekday_index = 0; weekday_index < 7; weekday_index++) {
+            row_text[row_length++] = char('0' + year_statistics.month_start_weekday_counts[weekday_index]);
+        }
+        row_text[row_length] = '\0';
+        cout << row_text << "\n";
+    }
+}
+
+int execute_extended_statistics_report(int argument_count, char* argument_values[], const string& year_range_text) {
+    int first_year = 0;
+    int last_year = 0;
+    int parsed_field_count = sscanf(year_range_text.c_str(), "%d-%d", &first_year, &last_year);
+    if (parsed_field_count == 1) {
+        last_year = first_year;
+    }
+    vector<int> region_codes;
+    if (parsed_field_count < 1 || first_year < 1 || last_year > 9999 || first_year > last_year ||
+        !parse_holiday_region_list(find_command_line_option_value(argument_count, argument_values, "--holidays", ""),
+                                   region_codes)) {
+        cout << "ERROR: --extended-stats expects <year> or <first-last> within 1-9999" << endl;
+        return 1;
+    }
+    if (region_codes.size() > 1) {
+        cout << "ERROR: --extended-stats accepts a single --holidays region" << endl;
+        return 1;
+    }
+    
+    vector<extended_annual_statistics> range_statistics;
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    calculate_extended_statistics_range(first_year, last_year, region_codes.empty() ? -1 : region_codes[0],
+                                        find_command_line_integer_option(argument_count, argument_values, "--threads", 0),
+                                        range_statistics);
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    cout << "EXTENDED ANNUAL STATISTICS " << first_year << "-" << last_year;
+    if (!region_codes.empty()) {
+        cout << " (" << holiday_region_names[region_codes[0]] << " holidays)";
+    }
+    cout << endl;
+    print_extended_statistics_table(range_statistics);
+    cout << "Computed " << range_statistics.size() << " years in " << fixed << setprecision(3) << elapsed_seconds * 1000.0
+         << " ms" << endl;
+    return 0;
+}
+
+/*
+================================================================================
+INPUT VALIDATION FUNCTION IMPLEMENTATION
+================================================================================
+*/
+
+bool validate_date_input_parameters(int month_value, int year_value) {
+    // Validate month parameter within acceptable range (1-12)
+    if (month_value < 1 || month_value > 12) {
+        return false; // Month value outside valid range
+    }
+    
+    // Validate year parameter within reasonable range (1900-2100)
+    if (year_value < 1900 || year_value > 2100) {
+        return false; // Year value outside reasonable range
+    }
+    
+    return true; // All parameters within valid ranges
+}
+
+/*
+================================================================================
+PROGRAM HEADER DISPLAY FUNCTION
+================================================================================
+*/
+
+void display_program_identification_header() {
+    cout << string(60, '=') << endl;
+    cout << "PROFESSIONAL C++ CALENDAR GENERATION SYSTEM" << endl;
+    cout << "Advanced Date Processing and Statistical Analysis" << endl;
+    cout << string(60, '=') << endl;
+    cout << "Features: Leap Year Calculation, Monthly Display, Statistics" << endl;
+    cout << "Algorithm: Zeller's Congruence for Day-of-Week Determination" << endl;
+    cout << string(60, '=') << endl;
+}
+
+/*
+================================================================================
+MONTH NUMBER TO TEXT CONVERSION FUNCTION
+================================================================================
+*/
+
+string convert_month_number_to_text(int month_number) {
+    // Array contains full month names for text conversion
+    string month_names[] = {"January", "February", "March", "April", "May", "June",
+                           "July", "August", "September", "October", "November", "December"};
+    
+    // Validate month number and return corresponding text
+    if (month_number >= 1 && month_number <= 12) {
+        return month_names[month_number - 1];
+    } else {
+        return "Invalid Month"; // Return error indicator for invalid input
+    }
+}
+
+/*
+================================================================================
+DAY OF YEAR CALCULATION FUNCTION
+================================================================================
+*/
+
+int calculate_day_of_year_position(int day_value, int month_value, int year_value) {
+    // Initialize day accumulation counter
+    int accumulated_days = 0;
+    
+    // Sum days from all preceding months
+    for (int preceding_month = 1; preceding_month < month_value; preceding_month++) {
+        accumulated_days += calculate_month_day_count(preceding_month, year_value);
+    }
+    
+    // Add current month day value to accumulated total
+    accumulated_days += day_value;
+    
+    return accumulated_days; // Return calculated day-of-year position
+}
+
+/*
+================================================================================
+PROGRESS INDICATOR DISPLAY FUNCTION
+================================================================================
+*/
+
+void display_calendar_generation_progress(int current_month, int total_months) {
+    // Calculate completion percentage for progress indication
+    double completion_percentage = (double(current_month) / total_months) * 100.0;
+    
+    // Display formatted progress indicator
+    cout << "Generation Progress: " << current_month << "/" << total_months 
+         << " (" << fixed << setprecision(0) << completion_percentage << "%)" << endl;
+    
+    // Generate visual progress bar representation
+    int progress_bar_length = 30;
+    int completed_segments = (current_month * progress_bar_length) / total_months;
+    
+    cout << "Progress Bar: [";
+    for (int segment_counter = 0; segment_counter < progress_bar_length; segment_counter++) {
+        if (segment_counter < completed_segments) {
+            cout << "="; // Completed segment indicator
+        } else {
+            cout << " "; // Remaining segment indicator
+        }
+    }
+    cout << "]" << endl;
+}
+
+/*
+================================================================================
+COMMAND LINE OPTION PROCESSING FUNCTIONS
+================================================================================
+*/
+
+int find_command_line_option_index(int argument_count, char* argument_values[], const string& option_name) {
+    // Scan arguments for the option name and return its position
+    for (int argument_index = 1; argument_index < argument_count; argument_index++) {
+        if (option_name == argument_values[argument_index]) {
+            return argument_index;
+        }
+    }
+    return -1; // Option absent
+}
+
+string find_command_line_option_value(int argument_count, char* argument_values[],
+                                      const string& option_name, const string& default_value) {
+    // Return the argument that follows the option name
+    int option_index = find_command_line_option_index(argument_count, argument_values, option_name);
+    if (option_index < 0 || option_index + 1 >= argument_count) {
+        return default_value; // Option absent or missing its value
+    }
+    return argument_values[option_index + 1];
+}
+
+int find_command_line_integer_option(int argument_count, char* argument_values[],
+                                     const string& option_name, int default_value) {
+    string option_text = find_command_line_option_value(argument_count, argument_values, option_name, "");
+    return option_text.empty() ? default_value : atoi(option_text.c_str());
+}
+
+bool check_command_line_flag_present(int argument_count, char* argument_values[], const string& flag_name) {
+    // Scan arguments for an exact flag match
+    for (int argument_index = 1; argument_index < argument_count; argument_index++) {
+        if (flag_name == argument_values[argument_index]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void display_command_line_usage_information() {
+    cout << "Usage: calendar [options]" << endl;
+    cout << "  (no options)                     Run the annual calendar demonstration" << endl;
+    cout << "  --record-queries <log>           Record incoming queries into a binary log" << endl;
+    cout << "  --serve-queries                  Execute text queries read from standard input" << endl;
+    cout << "  --replay-queries <log>           Replay a recorded query log" << endl;
+    cout << "  --replay-speed original|max|<x>  Replay pacing (default: max)" << endl;
+#ifdef CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+    cout << "  --benchmark-generators [y1 y2]   Compare coroutine generators with plain loops" << endl;
+#endif
+    cout << "  --print-batch <jobs>             Render personalized calendars (lines: year text)" << endl;
+    cout << "      --print-format svg|ps --print-pages year|month --print-output <dir> --threads <n>" << endl;
+    cout << "  --moon-calendar <year>           Display a year with new and full moon days marked" << endl;
+    cout << "  --event-store <dir> <command>    add <date> <HH:MM> <minutes> <title> | remove <id> |" << endl;
+    cout << "                                   list <from> <to> | compact | benchmark <count> (run in a" << endl;
+    cout << "                                   scratch subdirectory of <dir> that is removed afterwards)" << endl;
+    cout << "  --ics-import <file>              Parse an iCalendar file (--threads <n>, --ics-store <dir>)" << endl;
+    cout << "  --enrich-csv <file>              Append weekday, ISO week, day of year, quarter and holiday" << endl;
+    cout << "                                   columns (--enrich-output <file>, --date-column <n|name>," << endl;
+    cout << "                                   --holidays US,GB,DE, --delimiter <c>, --threads <n>)" << endl;
+    cout << "  --generate-archive <file>        Write every month of --archive-years <y1-y2> (default 1-9999)," << endl;
+    cout << "                                   optionally one byte-balanced --shard <k/n> with a manifest;" << endl;
+    cout << "                                   --checkpoint-every <years> makes interrupted runs resumable" << endl;
+    cout << "  --merge-archive <out> <shards..> Verify shard manifests and concatenate shard outputs" << endl;
+    cout << "  --rolling-stats <y1-y2>          Trailing-window business, weekend and holiday day series" << endl;
+    cout << "                                   (--window-months <n>, --step day|month, --holidays US," << endl;
+    cout << "                                   --rolling-output <file>; without it the CSV goes" << endl;
+    cout << "                                   to standard output and the summary to standard error)" << endl;
+    cout << "  --cron \"<expr>\"                  List fire times (--cron-from <YYYY-MM-DDTHH:MM>, --cron-count <n>," << endl;
+    cout << "                                   --cron-previous); supports L, nL, n#k and @macros" << endl;
+    cout << "  --benchmark-cron [count]         Time batch next-fire computation for random schedules" << endl;
+    cout << "  --reminders <file>               Fire reminders (lines: YYYY-MM-DD HH:MM text) with a timer wheel" << endl;
+    cout << "                                   (--clock simulated|real, --until <YYYY-MM-DD>)" << endl;
+    cout << "  --benchmark-timer-wheel [count]  Compare timer wheel with std::priority_queue" << endl;
+    cout << "  --bookings <file>                Show month grids with occupancy (lines: first last amount)" << endl;
+    cout << "                                   (--capacity <n>, --occupancy-year <y>)" << endl;
+    cout << "  --benchmark-capacity [ops]       Compare segment tree range operations with day scans" << endl;
+    cout << "  --benchmark-packed-dates [count] Compare separate-int, 32-bit and 16-bit date storage" << endl;
+    cout << "  --benchmark-date-sort [count]    Compare radix date sort and dedupe with std::sort (--threads n)" << endl;
+    cout << "  --group-by <key> <file>          Sum/count/min/max of date,value CSV rows per weekday, iso-week," << endl;
+    cout << "                                   month, quarter or day-of-year (--threads n)" << endl;
+    cout << "  --benchmark-group-by [rows]      Compare per-row key derivation with the fused kernel (--group-key k)" << endl;
+    cout << "  --resample <file>                Align series,date,value rows to a business-day calendar" << endl;
+    cout << "                                   (--resample-output f, --resample-calendar business|month-end," << endl;
+    cout << "                                   --resample-fill ffill|last|sum, --holidays US,GB,DE, --threads n)" << endl;
+    cout << "  --benchmark-resample [series]    Compare merge alignment with per-target binary search" << endl;
+    cout << "  --date-set <file>                Show a year with the listed dates highlighted (--date-set-year y," << endl;
+    cout << "                                   --date-set-other f --date-set-op union|intersect|difference)" << endl;
+    cout << "  --benchmark-date-set [users]     Compare compressed date sets with sorted vectors and bitmaps" << endl;
+    cout << "  --vacation-plan <year>           Longest break and bridge days for --vacation-days n" << endl;
+    cout << "                                   (--holidays US|GB|DE, --part-time-off Mon,Fri, --bridge-days n" << endl;
+    cout << "                                   caps bridge vacation days, default 5); breaks start in the year" << endl;
+    cout << "                                   and may run into the next" << endl;
+    cout << "  --benchmark-vacation [employees] Compare the sliding window optimizer with brute force" << endl;
+    cout << "  --extended-stats <first-last>    Weekday, quarter, Friday 13th and long weekend table" << endl;
+    cout << "                                   (--holidays US|GB|DE, --threads n)" << endl;
+    cout << "  --render-cache <pack>            Render --cache-years <y1-y2> months through an on-disk cache" << endl;
+    cout << "                                   (--holidays US|GB|DE, --cache-limit-kb n, --cache-output f)" << endl;
+    cout << "  --benchmark-row-emitter [rows]   Compare vector week-row emission with per-cell formatting" << endl;
+    cout << "  --dst-report <y1-y2>             List DST and offset transitions of every installed zone" << endl;
+    cout << "                                   (--zoneinfo dir, --dst-zone prefix, --dst-json f, --threads n)" << endl;
+    cout << "  --timeline <file>                Render first,last,lane[,title] task rows as a timeline" << endl;
+    cout << "                                   (--timeline-format text|svg|html, --timeline-from/--timeline-to" << endl;
+    cout << "                                   <YYYY-MM-DD>, --timeline-width n, --timeline-output f); at day" << endl;
+    cout << "                                   and week zoom lanes with up to 8 visible tasks show titled bars" << endl;
+    cout << "  --benchmark-timeline [tasks]     Compare level-of-detail rendering with per-render task scans" << endl;
+    cout << "  --help                           Display this usage information" << endl;
+}
+
+int execute_command_line_processing_mode(int argument_count, char* argument_values[]) {
+    // Display usage information on request
+    if (check_command_line_flag_present(argument_count, argument_values, "--help")) {
+        display_command_line_usage_information();
+        return 0;
+    }
+    
+#ifdef CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+    // Generator benchmark streams every day of the requested year range
+    int generator_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-generators");
+    if (generator_option_index > 0) {
+        int first_year = generator_option_index + 1 < argument_count ? atoi(argument_values[generator_option_index + 1]) : 1;
+        int last_year = generator_option_index + 2 < argument_count ? atoi(argument_values[generator_option_index + 2]) : 9999;
+        return execute_generator_benchmark(first_year, last_year);
+    }
+#endif
+    
+    // Print batch mode renders vector calendar pages from cached layout templates
+    string print_jobs_path = find_command_line_option_value(argument_count, argument_values, "--print-batch", "");
+    if (!print_jobs_path.empty()) {
+        return execute_print_batch_generation(
+            print_jobs_path,
+            find_command_line_option_value(argument_count, argument_values, "--print-format", "svg"),
+            find_command_line_option_value(argument_count, argument_values, "--print-pages", "year"),
+            find_command_line_option_value(argument_count, argument_values, "--print-output", "."),
+            find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Moon calendar mode annotates monthly displays from a precomputed phase table
+    string moon_calendar_year = find_command_line_option_value(argument_count, argument_values, "--moon-calendar", "");
+    if (!moon_calendar_year.empty()) {
+        return execute_moon_phase_calendar_display(atoi(moon_calendar_year.c_str()));
+    }
+    
+    // Event store mode manages the durable calendar event log
+    int event_store_option_index = find_command_line_option_index(argument_count, argument_values, "--event-store");
+    if (event_store_option_index > 0) {
+        return execute_event_store_command(argument_count, argument_values, event_store_option_index);
+    }
+    
+    // iCalendar import mode parses VEVENT blocks from a memory-mapped file
+    string ics_file_path = find_command_line_option_value(argument_count, argument_values, "--ics-import", "");
+    if (!ics_file_path.empty()) {
+        return execute_icalendar_import(ics_file_path,
+                                        find_command_line_integer_option(argument_count, argument_values, "--threads", 0),
+                                        find_command_line_option_value(argument_count, argument_values, "--ics-store", ""));
+    }
+    
+    // CSV enrichment mode appends calendar attributes to a date column
+    string enrichment_input_path = find_command_line_option_value(argument_count, argument_values, "--enrich-csv", "");
+    if (!enrichment_input_path.empty()) {
+        return execute_csv_date_enrichment(argument_count, argument_values, enrichment_input_path);
+    }
+    
+    // Archive modes generate month ranges, optionally as byte-balanced shards
+    string archive_output_path = find_command_line_option_value(argument_count, argument_values, "--generate-archive", "");
+    if (!archive_output_path.empty()) {
+        string archive_years_text = find_command_line_option_value(argument_count, argument_values, "--archive-years", "1-9999");
+        int archive_first_year = 0;
+        int archive_last_year = 0;
+        if (sscanf(archive_years_text.c_str(), "%d-%d", &archive_first_year, &archive_last_year) != 2) {
+            cout << "ERROR: --archive-years expects <first-last>" << endl;
+            return 1;
+        }
+        return execute_archive_generation(archive_output_path, archive_first_year, archive_last_year,
+                                          find_command_line_option_value(argument_count, argument_values, "--shard", ""),
+                                          find_command_line_integer_option(argument_count, argument_values,
+                                                                           "--checkpoint-every", 0));
+    }
+    int merge_option_index = find_command_line_option_index(argument_count, argument_values, "--merge-archive");
+    if (merge_option_index > 0 && merge_option_index + 2 < argument_count) {
+        return execute_archive_merge(argument_values[merge_option_index + 1],
+                                     vector<string>(argument_values + merge_option_index + 2, argument_values + argument_count));
+    }
+    
+    // Extended statistics mode prints closed-form planner metrics for a year range
+    string extended_years_text = find_command_line_option_value(argument_count, argument_values, "--extended-stats", "");
+    if (!extended_years_text.empty()) {
+        return execute_extended_statistics_report(argument_count, argument_values, extended_years_text);
+    }
+    
+    // Rolling statistics mode evaluates trailing windows from prefix-count tables
+    string rolling_years_text = find_command_line_option_value(argument_count, argument_values, "--rolling-stats", "");
+    if (!rolling_years_text.empty()) {
+        return execute_rolling_window_statistics(argument_count, argument_values, rolling_years_text);
+    }
+    
+    // Cron modes compile expressions into bitsets and jump directly to fire times
+    string cron_expression = find_command_line_option_value(argument_count, argument_values, "--cron", "");
+    if (!cron_expression.empty()) {
+        return execute_cron_schedule_listing(argument_count, argument_values, cron_expression);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-cron")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-cron");
+        int schedule_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_cron_schedule_benchmark(schedule_count > 0 ? schedule_count : 1000000);
+    }
+    
+    // Reminder modes schedule serial-minute timers on the hierarchical wheel
+    string reminder_file_path = find_command_line_option_value(argument_count, argument_values, "--reminders", "");
+    if (!reminder_file_path.empty()) {
+        return execute_reminder_driver(argument_count, argument_values, reminder_file_path);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-timer-wheel")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-timer-wheel");
+        int timer_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_timer_wheel_benchmark(timer_count > 0 ? timer_count : 4000000);
+    }
+    
+    // Capacity modes keep booking levels in year-sharded segment trees
+    string bookings_file_path = find_command_line_option_value(argument_count, argument_values, "--bookings", "");
+    if (!bookings_file_path.empty()) {
+        return execute_capacity_occupancy_display(argument_count, argument_values, bookings_file_path);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-capacity")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-capacity");
+        int operation_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_capacity_benchmark(operation_count > 0 ? operation_count : 2000000,
+                                          find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Packed date benchmark compares storage layouts for large date tables
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-packed-dates")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-packed-dates");
+        int date_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_packed_date_benchmark(date_count > 0 ? date_count : 4000000);
+    }
+    
+    // Date sort benchmark compares radix passes with comparison sorting
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-date-sort")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-date-sort");
+        int element_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_date_sort_benchmark(element_count > 0 ? element_count : 20000000,
+                                           find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Group-by modes aggregate numeric columns by calendar keys
+    int group_by_option_index = find_command_line_option_index(argument_count, argument_values, "--group-by");
+    if (group_by_option_index >= 0) {
+        if (group_by_option_index + 2 >= argument_count) {
+            cout << "ERROR: --group-by requires a key and an input file" << endl;
+            return 1;
+        }
+        return execute_calendar_group_by(argument_values[group_by_option_index + 1], argument_values[group_by_option_index + 2],
+                                         find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-group-by")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-group-by");
+        int row_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_group_by_benchmark(row_count > 0 ? row_count : 50000000,
+                                          find_command_line_option_value(argument_count, argument_values, "--group-key", "iso-week"),
+                                          find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Resampling modes align irregular series to business-day calendars
+    string resample_input_path = find_command_line_option_value(argument_count, argument_values, "--resample", "");
+    if (!resample_input_path.empty()) {
+        return execute_series_resampling(argument_count, argument_values, resample_input_path);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-resample")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-resample");
+        int series_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_resample_benchmark(series_count > 0 ? series_count : 2000,
+                                          find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Date set modes keep day sets in per-year compressed containers
+    string date_list_path = find_command_line_option_value(argument_count, argument_values, "--date-set", "");
+    if (!date_list_path.empty()) {
+        return execute_date_set_display(argument_count, argument_values, date_list_path);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-date-set")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-date-set");
+        int user_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_date_set_benchmark(user_count > 0 ? user_count : 3000);
+    }
+    
+    // Vacation modes search per-year off-day bitmaps for the longest breaks
+    int vacation_option_index = find_command_line_option_index(argument_count, argument_values, "--vacation-plan");
+    if (vacation_option_index >= 0) {
+        return execute_vacation_planner(argument_count, argument_values,
+                                        vacation_option_index + 1 < argument_count ? atoi(argument_values[vacation_option_index + 1]) : 0);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-vacation")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-vacation");
+        int employee_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_vacation_benchmark(employee_count > 0 ? employee_count : 5000,
+                                          find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    }
+    
+    // Render cache mode serves repeated month renderings from a memory-mapped pack file
+    string render_cache_path = find_command_line_option_value(argument_count, argument_values, "--render-cache", "");
+    if (!render_cache_path.empty()) {
+        return execute_render_cache_report(argument_count, argument_values, render_cache_path);
+    }
+    
+    // Row emitter benchmark times month grid rows built from the shared cell strip
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-row-emitter")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-row-emitter");
+        int row_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_row_emitter_benchmark(row_count > 0 ? row_count : 2000000);
+    }
+    
+    // DST report mode parses every installed TZif file for transitions in a year range
+    string dst_years_text = find_command_line_option_value(argument_count, argument_values, "--dst-report", "");
+    if (!dst_years_text.empty()) {
+        return execute_daylight_transition_report(argument_count, argument_values, dst_years_text);
+    }
+    
+    // Timeline modes render task lanes from precomputed level-of-detail aggregates
+    string timeline_file_path = find_command_line_option_value(argument_count, argument_values, "--timeline", "");
+    if (!timeline_file_path.empty()) {
+        return execute_timeline_rendering(argument_count, argument_values, timeline_file_path);
+    }
+    if (check_command_line_flag_present(argument_count, argument_values, "--benchmark-timeline")) {
+        int benchmark_option_index = find_command_line_option_index(argument_count, argument_values, "--benchmark-timeline");
+        int task_count = benchmark_option_index + 1 < argument_count ? atoi(argument_values[benchmark_option_index + 1]) : 0;
+        return execute_timeline_benchmark(task_count > 0 ? task_count : 300000);
+    }
+    
+    // Replay mode feeds a recorded log back through the query entry points
+    string replay_log_path = find_command_line_option_value(argument_count, argument_values, "--replay-queries", "");
+    if (!replay_log_path.empty()) {
+        string replay_speed_text = find_command_line_option_value(argument_count, argument_values, "--replay-speed", "max");
+        return execute_query_log_replay(replay_log_path, replay_speed_text);
+    }
+    
+    // Recording applies to whichever query source runs next
+    string record_log_path = find_command_line_option_value(argument_count, argument_values, "--record-queries", "");
+    if (!record_log_path.empty() && !open_query_log_recorder(record_log_path)) {
+        cout << "ERROR: Unable to open query log for recording: " << record_log_path << endl;
+        return 1;
+    }
+    
+    // Service mode reads text queries from standard input
+    if (check_command_line_flag_present(argument_count, argument_values, "--serve-queries")) {
+        int service_status = execute_query_service_mode();
+        close_query_log_recorder();
+        return service_status;
+    }
+    
+    // Recording without another mode captures the default demonstration
+    if (!record_log_path.empty()) {
+        return COMMAND_LINE_CONTINUE_DEMONSTRATION;
+    }
+    
+    display_command_line_usage_information();
+    return 1; // Unrecognized option combination
+}
+
+/*
+================================================================================
+QUERY LOG RECORDER IMPLEMENTATION
+================================================================================
+*/
+
+// Recorder state shared by the capture hooks in the query entry points
+struct calendar_query_log_recorder_state {
+    bool recording_active;
+    ofstream log_output_stream;
+    chrono::steady_clock::time_point recording_start_time;
+};
+
+calendar_query_log_recorder_state active_query_log_recorder = {false, ofstream(), chrono::steady_clock::time_point()};
+
+bool open_query_log_recorder(const string& log_file_path) {
+    // Replace any previously active recording
+    close_query_log_recorder();
+    
+    active_query_log_recorder.log_output_stream.open(log_file_path.c_str(), ios::binary | ios::trunc);
+    if (!active_query_log_recorder.log_output_stream) {
+        return false; // Log file could not be created
+    }
+    
+    // Write file signature and start the arrival clock
+    active_query_log_recorder.log_output_stream.write(QUERY_LOG_FILE_SIGNATURE, QUERY_LOG_SIGNATURE_LENGTH);
+    active_query_log_recorder.recording_start_time = chrono::steady_clock::now();
+    active_query_log_recorder.recording_active = true;
+    return true;
+}
+
+void capture_incoming_calendar_query(int query_type, int day_value, int month_value, int year_value) {
+    // Recording hook is a no-op unless a recorder is active
+    if (!active_query_log_recorder.recording_active) {
+        return;
+    }
+    
+    uint64_t arrival_offset = uint64_t(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - active_query_log_recorder.recording_start_time).count());
+    uint32_t encoded_year = uint32_t(int32_t(year_value));
+    
+    // Encode the record in little-endian byte order for portable log files
+    unsigned char record_bytes[QUERY_LOG_RECORD_LENGTH];
+    for (int byte_index = 0; byte_index < 8; byte_index++) {
+        record_bytes[byte_index] = (unsigned char)(arrival_offset >> (8 * byte_index));
+    }
+    for (int byte_index = 0; byte_index < 4; byte_index++) {
+        record_bytes[8 + byte_index] = (unsigned char)(encoded_year >> (8 * byte_index));
+    }
+    record_bytes[12] = (unsigned char)query_type;
+    record_bytes[13] = (unsigned char)month_value;
+    record_bytes[14] = (unsigned char)day_value;
+    record_bytes[15] = 0; // Reserved for future use
+    
+    active_query_log_recorder.log_output_stream.write((const char*)record_bytes, QUERY_LOG_RECORD_LENGTH);
+}
+
+void close_query_log_recorder() {
+    if (active_query_log_recorder.recording_active) {
+        active_query_log_recorder.log_output_stream.close();
+        active_query_log_recorder.recording_active = false;
+    }
+}
+
+bool load_query_log_records(const string& log_file_path, vector<calendar_query_record>& loaded_records) {
+    ifstream log_input_stream(log_file_path.c_str(), ios::binary);
+    if (!log_input_stream) {
+        return false; // Log file unavailable
+    }
+    
+    // Verify file signature before decoding records
+    char signature_buffer[QUERY_LOG_SIGNATURE_LENGTH];
+    if (!log_input_stream.read(signature_buffer, QUERY_LOG_SIGNATURE_LENGTH) ||
+        string(signature_buffer, QUERY_LOG_SIGNATURE_LENGTH) != QUERY_LOG_FILE_SIGNATURE) {
+        return false; // Not a query log file
+    }
+    
+    // Decode fixed-length little-endian records until end of file
+    unsigned char record_bytes[QUERY_LOG_RECORD_LENGTH];
+    while (log_input_stream.read((char*)record_bytes, QUERY_LOG_RECORD_LENGTH)) {
+        calendar_query_record decoded_query;
+        decoded_query.arrival_offset_nanoseconds = 0;
+        for (int byte_index = 7; byte_index >= 0; byte_index--) {
+            decoded_query.arrival_offset_nanoseconds = (decoded_query.arrival_offset_nanoseconds << 8) | record_bytes[byte_index];
+        }
+        uint32_t encoded_year = 0;
+        for (int byte_index = 3; byte_index >= 0; byte_index--) {
+            encoded_year = (encoded_year << 8) | record_bytes[8 + byte_index];
+        }
+        decoded_query.year_value = int32_t(encoded_year);
+        decoded_query.query_type = record_bytes[12];
+        decoded_query.month_value = record_bytes[13];
+        decoded_query.day_value = record_bytes[14];
+        loaded_records.push_back(decoded_query);
+    }
+    return true;
+}
+
+/*
+================================================================================
+QUERY EXECUTION AND SERVICE FUNCTIONS
+================================================================================
+*/
+
+bool parse_calendar_query_line(const string& query_line, calendar_query_record& parsed_query) {
+    // Query grammar: "month M Y", "stats Y", "day-of-year D M Y",
+    // "leap Y", "month-length M Y", "month-start M Y"
+    istringstream query_stream(query_line);
+    string query_keyword;
+    if (!(query_stream >> query_keyword)) {
+        return false; // Blank line
+    }
+    
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    parsed_query.arrival_offset_nanoseconds = 0;
+    
+    if (query_keyword == "month" && (query_stream >> month_value >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_MONTH_RENDER;
+    } else if (query_keyword == "stats" && (query_stream >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_STATISTICS;
+    } else if (query_keyword == "day-of-year" && (query_stream >> day_value >> month_value >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_DAY_OF_YEAR;
+    } else if (query_keyword == "leap" && (query_stream >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_LEAP_STATUS;
+    } else if (query_keyword == "month-length" && (query_stream >> month_value >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_MONTH_LENGTH;
+    } else if (query_keyword == "month-start" && (query_stream >> month_value >> year_value)) {
+        parsed_query.query_type = QUERY_TYPE_MONTH_START;
+    } else {
+        return false; // Unknown keyword or missing parameters
+    }
+    
+    // Reject values that cannot be represented in a query record
+    if (month_value < 0 || month_value > 12 || day_value < 0 || day_value > 31) {
+        return false;
+    }
+    parsed_query.day_value = (uint8_t)day_value;
+    parsed_query.month_value = (uint8_t)month_value;
+    parsed_query.year_value = year_value;
+    return check_calendar_query_fields(parsed_query);
+}
+
+bool check_calendar_query_fields(const calendar_query_record& calendar_query) {
+    // Year-only queries ignore the month and day fields
+    if (calendar_query.query_type == QUERY_TYPE_STATISTICS || calendar_query.query_type == QUERY_TYPE_LEAP_STATUS) {
+        return true;
+    }
+    if (calendar_query.month_value < 1 || calendar_query.month_value > 12) {
+        return false;
+    }
+    return calendar_query.query_type != QUERY_TYPE_DAY_OF_YEAR || calendar_query.day_value >= 1;
+}
+
+void execute_calendar_query(const calendar_query_record& calendar_query) {
+    // Route the query to the same entry points used by interactive callers
+    switch (calendar_query.query_type) {
+        case QUERY_TYPE_MONTH_RENDER:
+            generate_monthly_calendar_display(calendar_query.month_value, calendar_query.year_value);
+            break;
+        case QUERY_TYPE_STATISTICS:
+            execute_calendar_statistics_analysis(calendar_query.year_value);
+            break;
+        case QUERY_TYPE_DAY_OF_YEAR:
+            cout << "Day of Year: "
+                 << calculate_day_of_year_position(calendar_query.day_value, calendar_query.month_value,
+                                                   calendar_query.year_value) << endl;
+            break;
+        case QUERY_TYPE_LEAP_STATUS:
+            cout << "Leap Year Status: "
+                 << (calculate_leap_year_status(calendar_query.year_value) ? "TRUE" : "FALSE") << endl;
+            break;
+        case QUERY_TYPE_MONTH_LENGTH:
+            cout << "Total Days: "
+                 << calculate_month_day_count(calendar_query.month_value, calendar_query.year_value) << endl;
+            break;
+        case QUERY_TYPE_MONTH_START:
+            cout << "Starting Day: "
+                 << calculate_month_starting_day(calendar_query.month_value, calendar_query.year_value)
+                 << " (0=Sunday)" << endl;
+            break;
+        default:
+            break; // Unknown query types are ignored
+    }
+}
+
+int execute_query_service_mode() {
+    string query_line;
+    int rejected_query_count = 0;
+    
+    // Process one query per input line, capturing each before execution
+    while (getline(cin, query_line)) {
+        calendar_query_record incoming_query;
+        if (!parse_calendar_query_line(query_line, incoming_query)) {
+            if (query_line.find_first_not_of(" \t\r") != string::npos) {
+                cout << "ERROR: Unrecognized query: " << query_line << endl;
+                rejected_query_count++;
+            }
+            continue;
+        }
+        capture_incoming_calendar_query(incoming_query.query_type, incoming_query.day_value,
+                                        incoming_query.month_value, incoming_query.year_value);
+        execute_calendar_query(incoming_query);
+    }
+    
+    return rejected_query_count == 0 ? 0 : 1;
+}
+
+string convert_query_type_to_text(int query_type) {
+    // Array contains query type names indexed by calendar_query_type value
+    string query_type_names[] = {"invalid", "month-render", "statistics", "day-of-year",
+                                 "leap-status", "month-length", "month-start"};
+    
+    if (query_type >= 1 && query_type < QUERY_TYPE_SLOT_COUNT) {
+        return query_type_names[query_type];
+    } else {
+        return "invalid";
+    }
+}
+
+/*
+================================================================================
+QUERY LOG REPLAY FUNCTION
+================================================================================
+*/
+
+// Stream buffer discards replayed output so rendering cost, not terminal cost, is measured
+class discarding_output_buffer : public streambuf {
+protected:
+    int overflow(int character_value) { return character_value == EOF ? 0 : character_value; }
+    streamsize xsputn(const char*, streamsize character_count) { return character_count; }
+};
+
+int execute_query_log_replay(const string& log_file_path, const string& replay_speed_text) {
+    vector<calendar_query_record> recorded_queries;
+    if (!load_query_log_records(log_file_path, recorded_queries)) {
+        cout << "ERROR: Unable to read query log: " << log_file_path << endl;
+        return 1;
+    }
+    
+    // Interpret pacing: "max" ignores timestamps, "original" equals scale 1.0,
+    // and a numeric value replays that many times faster than recorded
+    bool paced_replay = replay_speed_text != "max";
+    double replay_speed_scale = 1.0;
+    if (paced_replay && replay_speed_text != "original") {
+        replay_speed_scale = strtod(replay_speed_text.c_str(), NULL);
+        if (replay_speed_scale <= 0.0) {
+            cout << "ERROR: Invalid replay speed: " << replay_speed_text << endl;
+            return 1;
+        }
+    }
+    
+    // Collect per-type latency samples in nanoseconds
+    vector<vector<double> > latency_samples_by_type(QUERY_TYPE_SLOT_COUNT);
+    
+    // Redirect rendered output away from the terminal for the duration of the replay
+    discarding_output_buffer discarding_buffer;
+    streambuf* original_output_buffer = cout.rdbuf(&discarding_buffer);
+    
+    size_t replayed_query_count = 0;
+    chrono::steady_clock::time_point replay_start_time = chrono::steady_clock::now();
+    for (size_t query_index = 0; query_index < recorded_queries.size(); query_index++) {
+        const calendar_query_record& replayed_query = recorded_queries[query_index];
+        if (replayed_query.query_type < 1 || replayed_query.query_type >= QUERY_TYPE_SLOT_COUNT ||
+            !check_calendar_query_fields(replayed_query)) {
+            continue; // Skip records written by newer recorder versions or damaged in storage
+        }
+        replayed_query_count++;
+        
+        // Wait until the scaled arrival time of the query when pacing is enabled
+        if (paced_replay) {
+            chrono::nanoseconds scheduled_offset(int64_t(double(replayed_query.arrival_offset_nanoseconds) / replay_speed_scale));
+            this_thread::sleep_until(replay_start_time + scheduled_offset);
+        }
+        
+        chrono::steady_clock::time_point query_start_time = chrono::steady_clock::now();
+        execute_calendar_query(replayed_query);
+        chrono::steady_clock::time_point query_end_time = chrono::steady_clock::now();
+        latency_samples_by_type[replayed_query.query_type].push_back(
+            double(chrono::duration_cast<chrono::nanoseconds>(query_end_time - query_start_time).count()));
+    }
+    double replay_elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - replay_start_time).count();
+    
+    cout.rdbuf(original_output_buffer);
+    
+    // Display replay summary with throughput and latency percentiles per query type
+    cout << "QUERY LOG REPLAY REPORT" << endl;
+    cout << string(60, '-') << endl;
+    cout << "Log File: " << log_file_path << endl;
+    cout << "Replay Speed: " << replay_speed_text << endl;
+    cout << "Queries Replayed: " << replayed_query_count << endl;
+    if (replayed_query_count < recorded_queries.size()) {
+        cout << "Records Skipped: " << recorded_queries.size() - replayed_query_count << endl;
+    }
+    cout << "Elapsed Time: " << fixed << setprecision(3) << replay_elapsed_seconds << " s" << endl;
+    cout << "Throughput: " << fixed << setprecision(0)
+         << (replay_elapsed_seconds > 0.0 ? double(replayed_query_count) / replay_elapsed_seconds : 0.0)
+         << " queries/s" << endl;
+    cout << "\nLatency Percentiles (microseconds):" << endl;
+    cout << left << setw(14) << "  Type" << right << setw(10) << "Count" << setw(10) << "p50"
+         << setw(10) << "p90" << setw(10) << "p99" << setw(10) << "Max" << endl;
+    
+    for (int query_type = 1; query_type < QUERY_TYPE_SLOT_COUNT; query_type++) {
+        vector<double>& type_samples = latency_samples_by_type[query_type];
+        if (type_samples.empty()) {
+            continue;
+        }
+        sort(type_samples.begin(), type_samples.end());
+        
+        // Nearest-rank percentile selection on sorted samples: rank ceil(p/100 * n), one-based
+        double percentile_levels[] = {50.0, 90.0, 99.0, 100.0};
+        cout << left << setw(14) << ("  " + convert_query_type_to_text(query_type)) << right
+             << setw(10) << type_samples.size() << fixed << setprecision(2);
+        for (int level_index = 0; level_index < 4; level_index++) {
+            size_t rank_index = size_t(ceil(percentile_levels[level_index] / 100.0 * double(type_samples.size())));
+            rank_index = min(max(rank_index, size_t(1)), type_samples.size()) - 1;
+            cout << setw(10) << type_samples[rank_index] / 1000.0;
+        }
+        cout << endl;
+    }
+    
+    return 0;
+}
+
+
+/*
+================================================================================
+C ABI EXPORTED FUNCTION IMPLEMENTATIONS
+================================================================================
+*/
+
+// Function validates a year against the range supported by the C ABI
+static bool validate_c_api_year(int32_t year) {
+    return year >= CALENDAR_MIN_YEAR && year <= CALENDAR_MAX_YEAR;
+}
+
+// Function validates a complete date against the range supported by the C ABI
+static bool validate_c_api_date(int32_t day, int32_t month, int32_t year) {
+    return validate_c_api_year(year) && month >= 1 && month <= 12 &&
+           day >= 1 && day <= calculate_month_day_count(month, year);
+}
+
+// Function copies annual statistics into the C ABI structure layout
+static void convert_statistics_to_c_api_layout(const annual_calendar_statistics& year_statistics,
+                                               calendar_year_statistics* statistics) {
+    statistics->year = year_statistics.target_year;
+    statistics->leap_year = year_statistics.leap_year_status ? 1 : 0;
+    statistics->total_days = year_statistics.total_year_days;
+    statistics->weekend_days = year_statistics.total_weekend_days;
+    statistics->weekday_count = year_statistics.total_weekday_count;
+    statistics->shortest_month_days = year_statistics.shortest_month_days;
+    statistics->longest_month_days = year_statistics.longest_month_days;
+    statistics->reserved = 0;
+    statistics->average_month_days = year_statistics.average_month_days;
+    statistics->weekend_percentage = year_statistics.weekend_percentage;
+}
+
+extern "C" {
+
+CALENDAR_API int32_t calendar_api_version(void) {
+    return CALENDAR_API_VERSION;
+}
+
+CALENDAR_API int32_t calendar_is_leap_year(int32_t year) {
+    if (!validate_c_api_year(year)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    return calculate_leap_year_status(year) ? 1 : 0;
+}
+
+CALENDAR_API int32_t calendar_month_length(int32_t month, int32_t year) {
+    if (!validate_c_api_year(year) || month < 1 || month > 12) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    return calculate_month_day_count(month, year);
+}
+
+CALENDAR_API int32_t calendar_weekday(int32_t day, int32_t month, int32_t year) {
+    if (!validate_c_api_date(day, month, year)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    // Offset the month starting weekday by the day position within the month
+    return (calculate_month_starting_day(month, year) + day - 1) % 7;
+}
+
+CALENDAR_API int32_t calendar_day_of_year(int32_t day, int32_t month, int32_t year) {
+    if (!validate_c_api_date(day, month, year)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    return calculate_day_of_year_position(day, month, year);
+}
+
+CALENDAR_API int32_t calendar_batch_is_leap_year(const int32_t* years, int32_t* results, size_t element_count) {
+    if (element_count > 0 && (years == NULL || results == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    int32_t batch_status = CALENDAR_STATUS_OK;
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        results[element_index] = calendar_is_leap_year(years[element_index]);
+        if (results[element_index] < 0) {
+            batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+        }
+    }
+    return batch_status;
+}
+
+CALENDAR_API int32_t calendar_batch_month_length(const int32_t* months, const int32_t* years,
+                                                 int32_t* results, size_t element_count) {
+    if (element_count > 0 && (months == NULL || years == NULL || results == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    int32_t batch_status = CALENDAR_STATUS_OK;
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        results[element_index] = calendar_month_length(months[element_index], years[element_index]);
+        if (results[element_index] < 0) {
+            batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+        }
+    }
+    return batch_status;
+}
+
+CALENDAR_API int32_t calendar_batch_weekday(const int32_t* days, const int32_t* months, const int32_t* years,
+                                            int32_t* results, size_t element_count) {
+    if (element_count > 0 && (days == NULL || months == NULL || years == NULL || results == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    
+    // Reuse the month length and month starting weekday while consecutive elements share a month
+    int32_t batch_status = CALENDAR_STATUS_OK;
+    int32_t cached_month = 0;
+    int32_t cached_year = 0;
+    int32_t cached_month_length = 0;
+    int32_t cached_starting_day = 0;
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        int32_t day = days[element_index];
+        int32_t month = months[element_index];
+        int32_t year = years[element_index];
+        if (month != cached_month || year != cached_year) {
+            if (!validate_c_api_year(year) || month < 1 || month > 12) {
+                results[element_index] = CALENDAR_STATUS_INVALID_ARGUMENT;
+                batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+                continue;
+            }
+            cached_month = month;
+            cached_year = year;
+            cached_month_length = calculate_month_day_count(month, year);
+            cached_starting_day = calculate_month_starting_day(month, year);
+        }
+        if (day < 1 || day > cached_month_length) {
+            results[element_index] = CALENDAR_STATUS_INVALID_ARGUMENT;
+            batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+            continue;
+        }
+        results[element_index] = (cached_starting_day + day - 1) % 7;
+    }
+    return batch_status;
+}
+
+CALENDAR_API int32_t calendar_batch_day_of_year(const int32_t* days, const int32_t* months, const int32_t* years,
+                                                int32_t* results, size_t element_count) {
+    if (element_count > 0 && (days == NULL || months == NULL || years == NULL || results == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    
+    // Reuse the month length and cumulative month offset while consecutive elements share a month
+    int32_t batch_status = CALENDAR_STATUS_OK;
+    int32_t cached_month = 0;
+    int32_t cached_year = 0;
+    int32_t cached_month_length = 0;
+    int32_t cached_month_offset = 0;
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        int32_t day = days[element_index];
+        int32_t month = months[element_index];
+        int32_t year = years[element_index];
+        if (month != cached_month || year != cached_year) {
+            if (!validate_c_api_year(year) || month < 1 || month > 12) {
+                results[element_index] = CALENDAR_STATUS_INVALID_ARGUMENT;
+                batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+                continue;
+            }
+            cached_month = month;
+            cached_year = year;
+            cached_month_length = calculate_month_day_count(month, year);
+            cached_month_offset = calculate_day_of_year_position(0, month, year);
+        }
+        if (day < 1 || day > cached_month_length) {
+            results[element_index] = CALENDAR_STATUS_INVALID_ARGUMENT;
+            batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+            continue;
+        }
+        results[element_index] = cached_month_offset + day;
+    }
+    return batch_status;
+}
+
+CALENDAR_API int32_t calendar_render_month(int32_t month, int32_t year, char* buffer,
+                                           size_t buffer_capacity, size_t* bytes_required) {
+    return calendar_batch_render_months(&month, &year, 1, buffer, buffer_capacity, NULL, bytes_required);
+}
+
+CALENDAR_API int32_t calendar_batch_render_months(const int32_t* months, const int32_t* years, size_t element_count,
+                                                  char* buffer, size_t buffer_capacity,
+                                                  size_t* month_offsets, size_t* bytes_required) {
+    if (element_count > 0 && (months == NULL || years == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    
+    // Render every month into one contiguous staging buffer, recording boundaries
+    string rendered_text;
+    rendered_text.reserve(element_count * 256);
+    vector<size_t> rendered_offsets(element_count + 1, 0);
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        if (!validate_c_api_year(years[element_index]) || months[element_index] < 1 || months[element_index] > 12) {
+            return CALENDAR_STATUS_INVALID_ARGUMENT;
+        }
+        append_monthly_calendar_display(rendered_text, months[element_index], years[element_index]);
+        rendered_offsets[element_index + 1] = rendered_text.size();
+    }
+    
+    if (bytes_required != NULL) {
+        *bytes_required = rendered_text.size();
+    }
+    if (rendered_text.size() > buffer_capacity || (buffer == NULL && !rendered_text.empty())) {
+        return CALENDAR_STATUS_BUFFER_TOO_SMALL;
+    }
+    
+    // Copy rendered text and boundaries into caller-provided storage
+    if (!rendered_text.empty()) {
+        memcpy(buffer, rendered_text.data(), rendered_text.size());
+    }
+    if (month_offsets != NULL) {
+        copy(rendered_offsets.begin(), rendered_offsets.end(), month_offsets);
+    }
+    return CALENDAR_STATUS_OK;
+}
+
+CALENDAR_API int32_t calendar_year_statistics_compute(int32_t year, calendar_year_statistics* statistics) {
+    if (statistics == NULL || !validate_c_api_year(year)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    convert_statistics_to_c_api_layout(calculate_annual_calendar_statistics(year), statistics);
+    return CALENDAR_STATUS_OK;
+}
+
+CALENDAR_API int32_t calendar_batch_year_statistics(const int32_t* years, calendar_year_statistics* statistics,
+                                                    size_t element_count) {
+    if (element_count > 0 && (years == NULL || statistics == NULL)) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    int32_t batch_status = CALENDAR_STATUS_OK;
+    for (size_t element_index = 0; element_index < element_count; element_index++) {
+        if (calendar_year_statistics_compute(years[element_index], &statistics[element_index]) != CALENDAR_STATUS_OK) {
+            memset(&statistics[element_index], 0, sizeof(calendar_year_statistics));
+            statistics[element_index].year = -1;
+            batch_status = CALENDAR_STATUS_INVALID_ARGUMENT;
+        }
+    }
+    return batch_status;
+}
+
+CALENDAR_API int32_t calendar_batch_sort_serial_days(int32_t* serial_days, size_t element_count, int32_t remove_duplicates,
+                                                     int32_t thread_count, size_t* result_count) {
+    if ((element_count > 0 && serial_days == NULL) || thread_count < 0) {
+        return CALENDAR_STATUS_INVALID_ARGUMENT;
+    }
+    size_t sorted_count = radix_sort_date_column(serial_days, element_count, remove_duplicates != 0, thread_count);
+    if (result_count != NULL) {
+        *result_count = sorted_count;
+    }
+    return CALENDAR_STATUS_OK;
+}
+
+} // extern "C"
+
+/*
+================================================================================
+COROUTINE FRAME POOL IMPLEMENTATION
+================================================================================
+*/
+
+#ifdef CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+
+// Frames up to this size share one block size so any released block fits any request; the largest
+// frame is the month stream's, which keeps a year block of descriptors plus the frame header,
+// promise and locals
+const size_t COROUTINE_FRAME_BLOCK_SIZE = 512;
+static_assert(sizeof(calendar_month_descriptor_block) + 256 <= COROUTINE_FRAME_BLOCK_SIZE,
+              "Coroutine frame blocks must hold the month stream frame");
+
+// Upper bound on idle blocks retained per thread
+const size_t COROUTINE_FRAME_POOL_CAPACITY = 64;
+
+// Per-thread free list of released frame blocks with reuse accounting
+struct coroutine_frame_pool_state {
+    vector<void*> free_frame_blocks;
+    size_t reused_frame_count = 0;
+    size_t fresh_frame_count = 0;
+    
+    ~coroutine_frame_pool_state() {
+        for (size_t block_index = 0; block_index < free_frame_blocks.size(); block_index++) {
+            ::operator delete(free_frame_blocks[block_index]);
+        }
+    }
+};
+
+thread_local coroutine_frame_pool_state coroutine_frame_pool;
+
+void* allocate_coroutine_frame(size_t frame_size) {
+    // Oversized frames bypass the pool entirely
+    if (frame_size > COROUTINE_FRAME_BLOCK_SIZE) {
+        coroutine_frame_pool.fresh_frame_count++;
+        return ::operator new(frame_size);
+    }
+    
+    // Reuse the most recently released block while one is available
+    if (!coroutine_frame_pool.free_frame_blocks.empty()) {
+        void* frame_pointer = coroutine_frame_pool.free_frame_blocks.back();
+        coroutine_frame_pool.free_frame_blocks.pop_back();
+        coroutine_frame_pool.reused_frame_count++;
+        return frame_pointer;
+    }
+    coroutine_frame_pool.fresh_frame_count++;
+    return ::operator new(COROUTINE_FRAME_BLOCK_SIZE);
+}
+
+void release_coroutine_frame(void* frame_pointer, size_t frame_size) {
+    // Retain pool-sized blocks up to the pool capacity
+    if (frame_size <= COROUTINE_FRAME_BLOCK_SIZE &&
+        coroutine_frame_pool.free_frame_blocks.size() < COROUTINE_FRAME_POOL_CAPACITY) {
+        coroutine_frame_pool.free_frame_blocks.push_back(frame_pointer);
+        return;
+    }
+    ::operator delete(frame_pointer);
+}
+
+/*
+================================================================================
+COROUTINE MONTH AND DAY STREAM GENERATORS
+================================================================================
+*/
+
+calendar_generator<calendar_month_descriptor_block> generate_month_descriptor_blocks(int first_month, int first_year,
+                                                                                     int last_month, int last_year) {
+    static const int standard_month_day_counts[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    
+    // Walk years in calendar order, suspending after each year's block of descriptors
+    calendar_month_descriptor_block year_block;
+    int starting_day_position = calculate_month_starting_day(max(first_month, 1), first_year);
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        int block_first_month = current_year == first_year ? max(first_month, 1) : 1;
+        int block_last_month = current_year == last_year ? min(last_month, 12) : 12;
+        int february_extra_day = calculate_leap_year_status(current_year) ? 1 : 0; // Leap status once per year
+        year_block.month_descriptor_count = 0;
+        for (int current_month = block_first_month; current_month <= block_last_month; current_month++) {
+            calendar_month_descriptor& month_descriptor = year_block.month_descriptors[year_block.month_descriptor_count++];
+            month_descriptor.year_value = current_year;
+            month_descriptor.month_value = current_month;
+            month_descriptor.starting_day_position = starting_day_position;
+            month_descriptor.month_day_count = standard_month_day_counts[current_month - 1] +
+                                               (current_month == 2 ? february_extra_day : 0);
+            
+            // Consecutive months start where the previous month left off, so Zeller's congruence runs once per
+            // stream; months run 28 days plus at most 3, so one subtraction replaces the modulo
+            starting_day_position += month_descriptor.month_day_count - 28;
+            if (starting_day_position >= 7) {
+                starting_day_position -= 7;
+            }
+        }
+        co_yield year_block;
+    }
+}
+
+calendar_month_descriptor_stream generate_month_descriptor_stream(int first_month, int first_year,
+                                                                  int last_month, int last_year) {
+    return calendar_month_descriptor_stream(generate_month_descriptor_blocks(first_month, first_year, last_month, last_year));
+}
+
+calendar_generator<calendar_day_record_block> generate_day_record_blocks(int first_month, int first_year,
+                                                                         int last_month, int last_year) {
+    // Day-of-year position starts from the days preceding the first month
+    int day_of_year_counter = calculate_day_of_year_position(0, first_month, first_year);
+    int current_month = first_month;
+    int current_year = first_year;
+    int starting_day_position = calculate_month_starting_day(first_month, first_year);
+    calendar_day_record_block month_block;
+    
+    while (current_year < last_year || (current_year == last_year && current_month <= last_month)) {
+        // Only the month's first record is built; the stream iterator steps through the remaining days
+        month_block.first_day_record.year_value = current_year;
+        month_block.first_day_record.month_value = current_month;
+        month_block.first_day_record.day_value = 1;
+        month_block.first_day_record.day_of_week = starting_day_position;
+        month_block.first_day_record.day_of_year = day_of_year_counter + 1;
+        month_block.day_record_count = calculate_month_day_count(current_month, current_year);
+        day_of_year_counter += month_block.day_record_count;
+        starting_day_position += month_block.day_record_count - 28; // Same weekday step as the month stream
+        if (starting_day_position >= 7) {
+            starting_day_position -= 7;
+        }
+        co_yield month_block;
+        
+        // Advance to the following month, resetting the day counter at year boundaries
+        if (++current_month > 12) {
+            current_month = 1;
+            current_year++;
+            day_of_year_counter = 0;
+        }
+    }
+}
+
+calendar_day_record_stream generate_day_record_stream(int first_month, int first_year, int last_month, int last_year) {
+    return calendar_day_record_stream(generate_day_record_blocks(first_month, first_year, last_month, last_year));
+}
+
+/*
+================================================================================
+COROUTINE GENERATOR BENCHMARK FUNCTION
+================================================================================
+*/
+
+// Function prints one benchmark comparison line with per-element cost and overhead
+void display_generator_benchmark_line(const string& benchmark_name, double loop_seconds, double generator_seconds,
+                                      long long element_count) {
+    cout << left << setw(16) << ("  " + benchmark_name) << right << fixed << setprecision(2)
+         << setw(12) << loop_seconds * 1e9 / double(element_count)
+         << setw(12) << generator_seconds * 1e9 / double(element_count)
+         << setw(11) << (loop_seconds > 0.0 ? (generator_seconds / loop_seconds - 1.0) * 100.0 : 0.0) << "%" << endl;
+}
+
+// Functions each run one benchmark phase and return its checksum; a phase per function keeps the
+// accumulator in a register for both the loops and the generators, as in a caller's own loop
+long long sum_month_descriptors_by_loop(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        for (int current_month = 1; current_month <= 12; current_month++) {
+            phase_checksum += calculate_month_starting_day(current_month, current_year) +
+                              calculate_month_day_count(current_month, current_year);
+        }
+    }
+    return phase_checksum;
+}
+
+long long sum_month_descriptors_by_generator(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (const calendar_month_descriptor& month_descriptor : generate_month_descriptor_stream(1, first_year, 12, last_year)) {
+        phase_checksum += month_descriptor.starting_day_position + month_descriptor.month_day_count;
+    }
+    return phase_checksum;
+}
+
+long long sum_month_descriptors_by_short_generators(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        phase_checksum += sum_month_descriptors_by_generator(current_year, current_year);
+    }
+    return phase_checksum;
+}
+
+long long sum_day_records_by_loop(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        int day_of_year_counter = 0;
+        for (int current_month = 1; current_month <= 12; current_month++) {
+            int month_day_count = calculate_month_day_count(current_month, current_year);
+            int day_of_week = calculate_month_starting_day(current_month, current_year);
+            for (int current_day = 1; current_day <= month_day_count; current_day++) {
+                phase_checksum += day_of_week + (++day_of_year_counter) + current_day;
+                day_of_week = day_of_week == 6 ? 0 : day_of_week + 1;
+            }
+        }
+    }
+    return phase_checksum;
+}
+
+long long sum_day_records_by_generator(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (const calendar_day_record& day_record : generate_day_record_stream(1, first_year, 12, last_year)) {
+        phase_checksum += day_record.day_of_week + day_record.day_of_year + day_record.day_value;
+    }
+    return phase_checksum;
+}
+
+long long sum_day_records_by_short_generators(int first_year, int last_year) {
+    long long phase_checksum = 0;
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        phase_checksum += sum_day_records_by_generator(current_year, current_year);
+    }
+    return phase_checksum;
+}
+
+// Function times one benchmark phase, keeping the fastest pass in fastest_seconds
+void time_generator_benchmark_phase(long long (*phase_function)(int, int), int first_year, int last_year,
+                                    double& fastest_seconds, long long& phase_checksum) {
+    // Calling through a volatile pointer stops the compiler from moving a side-effect-free loop
+    // phase out of the timed region
+    long long (*volatile opaque_phase_function)(int, int) = phase_function;
+    chrono::steady_clock::time_point phase_start_time = chrono::steady_clock::now();
+    phase_checksum = opaque_phase_function(first_year, last_year);
+    fastest_seconds = min(fastest_seconds, chrono::duration<double>(chrono::steady_clock::now() - phase_start_time).count());
+}
+
+int execute_generator_benchmark(int first_year, int last_year) {
+    if (first_year < 1 || last_year < first_year) {
+        cout << "ERROR: Invalid benchmark year range" << endl;
+        return 1;
+    }
+    
+    long long month_loop_checksum = 0;
+    long long month_generator_checksum = 0;
+    long long short_generator_checksum = 0;
+    long long day_loop_checksum = 0;
+    long long day_generator_checksum = 0;
+    long long short_day_generator_checksum = 0;
+    long long streamed_month_count = (long long)(last_year - first_year + 1) * 12;
+    long long streamed_day_count = 0;
+    for (int current_year = first_year; current_year <= last_year; current_year++) {
+        streamed_day_count += calculate_day_of_year_position(31, 12, current_year);
+    }
+    double month_loop_seconds = 1e30;
+    double month_generator_seconds = 1e30;
+    double day_loop_seconds = 1e30;
+    double day_generator_seconds = 1e30;
+    double short_generator_seconds = 1e30;
+    double short_day_generator_seconds = 1e30;
+    size_t month_reused_frames = 0;
+    size_t month_fresh_frames = 0;
+    size_t day_reused_frames = 0;
+    size_t day_fresh_frames = 0;
+    
+    // Each phase keeps its fastest of several passes so scheduler noise does not read as overhead
+    const int benchmark_pass_count = 25;
+    for (int pass_index = 0; pass_index < benchmark_pass_count; pass_index++) {
+        time_generator_benchmark_phase(sum_month_descriptors_by_loop, first_year, last_year,
+                                       month_loop_seconds, month_loop_checksum);
+        time_generator_benchmark_phase(sum_month_descriptors_by_generator, first_year, last_year,
+                                       month_generator_seconds, month_generator_checksum);
+        time_generator_benchmark_phase(sum_day_records_by_loop, first_year, last_year,
+                                       day_loop_seconds, day_loop_checksum);
+        time_generator_benchmark_phase(sum_day_records_by_generator, first_year, last_year,
+                                       day_generator_seconds, day_generator_checksum);
+        
+        // One short generator per year exercises frame allocation from the pool
+        size_t reused_frames_before = coroutine_frame_pool.reused_frame_count;
+        size_t fresh_frames_before = coroutine_frame_pool.fresh_frame_count;
+        time_generator_benchmark_phase(sum_month_descriptors_by_short_generators, first_year, last_year,
+                                       short_generator_seconds, short_generator_checksum);
+        month_reused_frames = coroutine_frame_pool.reused_frame_count - reused_frames_before;
+        month_fresh_frames = coroutine_frame_pool.fresh_frame_count - fresh_frames_before;
+        
+        // One short day stream per year checks that the day stream frames are pooled as well
+        reused_frames_before = coroutine_frame_pool.reused_frame_count;
+        fresh_frames_before = coroutine_frame_pool.fresh_frame_count;
+        time_generator_benchmark_phase(sum_day_records_by_short_generators, first_year, last_year,
+                                       short_day_generator_seconds, short_day_generator_checksum);
+        day_reused_frames = coroutine_frame_pool.reused_frame_count - reused_frames_before;
+        day_fresh_frames = coroutine_frame_pool.fresh_frame_count - fresh_frames_before;
+    }
+    
+    // Display benchmark comparison
+    cout << "COROUTINE GENERATOR BENCHMARK" << endl;
+    cout << string(52, '-') << endl;
+    cout << "Year Range: " << first_year << "-" << last_year << endl;
+    cout << "Months Streamed: " << streamed_month_count << endl;
+    cout << "Days Streamed: " << streamed_day_count << endl;
+    bool checksums_match = month_loop_checksum == month_generator_checksum &&
+                           month_loop_checksum == short_generator_checksum &&
+                           day_loop_checksum == day_generator_checksum &&
+                           day_loop_checksum == short_day_generator_checksum;
+    cout << "Checksums Match: " << (checksums_match ? "YES" : "NO") << endl;
+    cout << left << setw(16) << "  Stream" << right << setw(12) << "Loop ns" << setw(12) << "Gen ns"
+         << setw(12) << "Overhead" << endl;
+    display_generator_benchmark_line("months", month_loop_seconds, month_generator_seconds, streamed_month_count);
+    display_generator_benchmark_line("days", day_loop_seconds, day_generator_seconds, streamed_day_count);
+    display_generator_benchmark_line("short months", month_loop_seconds, short_generator_seconds, streamed_month_count);
+    display_generator_benchmark_line("short days", day_loop_seconds, short_day_generator_seconds, streamed_day_count);
+    
+    // At most one fresh block per stream kind once the thread's pool is warm
+    bool frames_pooled = month_fresh_frames <= 1 && day_fresh_frames <= 1;
+    cout << "Month Frame Pool: " << month_reused_frames << " reused, " << month_fresh_frames << " fresh allocations" << endl;
+    cout << "Day Frame Pool: " << day_reused_frames << " reused, " << day_fresh_frames << " fresh allocations" << endl;
+    cout << "Frames Pooled: " << (frames_pooled ? "YES" : "NO") << endl;
+    
+    return checksums_match && frames_pooled ? 0 : 1;
+}
+
+#endif // CALENDAR_COROUTINE_GENERATORS_AVAILABLE
+
+/*
+================================================================================
+YEAR LAYOUT CLASSIFICATION FUNCTION
+================================================================================
+*/
+
+int calculate_year_layout_class(int target_year) {
+    // Years sharing January 1 weekday and leap status share every month grid
+    return calculate_month_starting_day(1, target_year) + (calculate_leap_year_status(target_year) ? 7 : 0);
+}
+
+/*
+================================================================================
+PRINT TEMPLATE CONSTRUCTION PRIMITIVES
+================================================================================
+*/
+
+// Function formats a page coordinate with one decimal place
+string format_print_coordinate(double coordinate_value) {
+    char coordinate_text[32];
+    snprintf(coordinate_text, sizeof(coordinate_text), "%.1f", coordinate_value);
+    return coordinate_text;
+}
+
+string escape_print_text(const string& raw_text, int output_format) {
+    string escaped_text;
+    escaped_text.reserve(raw_text.size());
+    for (size_t character_index = 0; character_index < raw_text.size(); character_index++) {
+        char current_character = raw_text[character_index];
+        if (output_format == PRINT_FORMAT_SVG) {
+            // XML character entities for markup-significant characters
+            switch (current_character) {
+                case '&': escaped_text += "&amp;"; break;
+                case '<': escaped_text += "&lt;"; break;
+                case '>': escaped_text += "&gt;"; break;
+                case '"': escaped_text += "&quot;"; break;
+                default: escaped_text += current_character; break;
+            }
+        } else {
+            // PostScript string literal escapes
+            if (current_character == '(' || current_character == ')' || current_character == '\\') {
+                escaped_text += '\\';
+            }
+            escaped_text += current_character;
+        }
+    }
+    return escaped_text;
+}
+
+// Function appends static markup to the open fragment of a page template
+void append_print_fragment(print_page_template& page_template, const string& fragment_text) {
+    page_template.static_fragments.back() += fragment_text;
+}
+
+// Function closes the open fragment and records a placeholder after it
+void append_print_placeholder(print_page_template& page_template, int placeholder_kind) {
+    page_template.placeholder_kinds.push_back(placeholder_kind);
+    page_template.static_fragments.push_back("");
+}
+
+// Function opens a text element; anchor is 'l' (left aligned) or 'c' (centered)
+void append_print_text_opening(print_page_template& page_template, int output_format,
+                               double font_size, char anchor) {
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template, "<text font-size=\"" + format_print_coordinate(font_size) + "\"" +
+                                             (anchor == 'c' ? " text-anchor=\"middle\"" : "") + " x=\"");
+    } else {
+        append_print_fragment(page_template, format_print_coordinate(font_size) + " F (");
+    }
+}
+
+// Function closes a text element at the given top-down page position
+void append_print_text_closing(print_page_template& page_template, int output_format,
+                               double x_position, double y_position, char anchor) {
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template, "</text>\n");
+    } else {
+        append_print_fragment(page_template, ") " + format_print_coordinate(x_position) + " " +
+                                             format_print_coordinate(PRINT_PAGE_HEIGHT - y_position) +
+                                             (anchor == 'c' ? " CT\n" : " LT\n"));
+    }
+}
+
+// Function appends a complete static text element
+void append_print_static_text(print_page_template& page_template, int output_format, double x_position,
+                              double y_position, double font_size, char anchor, const string& text_value) {
+    append_print_text_opening(page_template, output_format, font_size, anchor);
+    if (output_format == PRINT_FORMAT_SVG) {
+        // SVG carries the position in the opening tag
+        append_print_fragment(page_template, format_print_coordinate(x_position) + "\" y=\"" +
+                                             format_print_coordinate(y_position) + "\">");
+    }
+    append_print_fragment(page_template, escape_print_text(text_value, output_format));
+    append_print_text_closing(page_template, output_format, x_position, y_position, anchor);
+}
+
+// Function appends a text element whose content is prefix, placeholder value, suffix
+void append_print_spliced_text(print_page_template& page_template, int output_format, double x_position,
+                               double y_position, double font_size, const string& text_prefix,
+                               int placeholder_kind) {
+    append_print_text_opening(page_template, output_format, font_size, 'c');
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template, format_print_coordinate(x_position) + "\" y=\"" +
+                                             format_print_coordinate(y_position) + "\">");
+    }
+    append_print_fragment(page_template, escape_print_text(text_prefix, output_format));
+    append_print_placeholder(page_template, placeholder_kind);
+    append_print_text_closing(page_template, output_format, x_position, y_position, 'c');
+}
+
+// Function appends an outlined rectangle given its top-left corner
+void append_print_rectangle(print_page_template& page_template, int output_format, double x_position,
+                            double y_position, double rectangle_width, double rectangle_height) {
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template, "<rect x=\"" + format_print_coordinate(x_position) + "\" y=\"" +
+                                             format_print_coordinate(y_position) + "\" width=\"" +
+                                             format_print_coordinate(rectangle_width) + "\" height=\"" +
+                                             format_print_coordinate(rectangle_height) + "\"/>\n");
+    } else {
+        append_print_fragment(page_template, format_print_coordinate(x_position) + " " +
+                                             format_print_coordinate(PRINT_PAGE_HEIGHT - y_position - rectangle_height) + " " +
+                                             format_print_coordinate(rectangle_width) + " " +
+                                             format_print_coordinate(rectangle_height) + " RS\n");
+    }
+}
+
+// Function starts a page template with format-specific page setup
+void begin_print_page_template(print_page_template& page_template, int output_format, int page_number) {
+    page_template.static_fragments.assign(1, "");
+    page_template.placeholder_kinds.clear();
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template,
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"595pt\" height=\"842pt\" viewBox=\"0 0 595 842\" "
+            "font-family=\"Helvetica, Arial, sans-serif\">\n"
+            "<rect width=\"595\" height=\"842\" fill=\"#fff\"/>\n"
+            "<g fill=\"none\" stroke=\"#000\" stroke-width=\"0.5\">\n");
+    } else {
+        append_print_fragment(page_template, "%%Page: " + to_string(page_number) + " " + to_string(page_number) +
+                                             "\n0.5 setlinewidth\n");
+    }
+}
+
+// Function switches from outlined shapes to filled text within a page
+void begin_print_text_layer(print_page_template& page_template, int output_format) {
+    if (output_format == PRINT_FORMAT_SVG) {
+        append_print_fragment(page_template, "</g>\n<g fill=\"#000\">\n");
+    }
+}
+
+// Function finishes a page template
+void end_print_page_template(print_page_template& page_template, int output_format) {
+    append_print_fragment(page_template, output_format == PRINT_FORMAT_SVG ? "</g>\n</svg>\n" : "showpage\n");
+}
+
+/*
+================================================================================
+PRINT PAGE TEMPLATE CONSTRUCTION FUNCTIONS
+================================================================================
+*/
+
+// Function builds the full-grid month page for a month of the given layout class
+void build_month_print_page_template(print_page_template& page_template, int output_format,
+                                     int target_month, int starting_day_position, int month_day_count) {
+    const char* weekday_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    const double grid_left = 40.0;
+    const double grid_top = 160.0;
+    const double cell_width = (PRINT_PAGE_WIDTH - 2.0 * grid_left) / 7.0;
+    const double cell_height = 100.0;
+    
+    // Grid layout matches generate_monthly_calendar_display: position = start + day - 1
+    int week_row_count = (month_day_count + starting_day_position + 6) / 7;
+    
+    begin_print_page_template(page_template, output_format, target_month);
+    for (int row_index = 0; row_index < week_row_count; row_index++) {
+        for (int column_index = 0; column_index < 7; column_index++) {
+            append_print_rectangle(page_template, output_format, grid_left + column_index * cell_width,
+                                   grid_top + row_index * cell_height, cell_width, cell_height);
+        }
+    }
+    
+    begin_print_text_layer(page_template, output_format);
+    append_print_spliced_text(page_template, output_format, PRINT_PAGE_WIDTH / 2.0, 90.0, 28.0,
+                              convert_month_number_to_text(target_month) + " ", PRINT_PLACEHOLDER_YEAR);
+    append_print_spliced_text(page_template, output_format, PRINT_PAGE_WIDTH / 2.0, 122.0, 14.0,
+                              "", PRINT_PLACEHOLDER_PERSONAL_TEXT);
+    for (int column_index = 0; column_index < 7; column_index++) {
+        append_print_static_text(page_template, output_format, grid_left + (column_index + 0.5) * cell_width,
+                                 grid_top - 8.0, 11.0, 'c', weekday_names[column_index]);
+    }
+    for (int current_day = 1; current_day <= month_day_count; current_day++) {
+        int grid_position = starting_day_position + current_day - 1;
+        append_print_static_text(page_template, output_format, grid_left + (grid_position % 7) * cell_width + 6.0,
+                                 grid_top + (grid_position / 7) * cell_height + 18.0, 14.0, 'l',
+                                 to_string(current_day));
+    }
+    end_print_page_template(page_template, output_format);
+}
+
+// Function builds the twelve-month overview page for a layout class
+void build_year_print_page_template(print_page_template& page_template, int output_format,
+                                    const int month_starting_days[12], const int month_day_counts[12]) {
+    const char* weekday_initials[] = {"S", "M", "T", "W", "T", "F", "S"};
+    const double area_left = 40.0;
+    const double area_top = 140.0;
+    const double block_width = (PRINT_PAGE_WIDTH - 2.0 * area_left) / 3.0;
+    const double block_height = (PRINT_PAGE_HEIGHT - area_top - 40.0) / 4.0;
+    const double cell_width = (block_width - 12.0) / 7.0;
+    const double row_height = 18.0;
+    
+    begin_print_page_template(page_template, output_format, 1);
+    for (int month_index = 0; month_index < 12; month_index++) {
+        append_print_rectangle(page_template, output_format, area_left + (month_index % 3) * block_width,
+                               area_top + (month_index / 3) * block_height, block_width, block_height);
+    }
+    
+    begin_print_text_layer(page_template, output_format);
+    append_print_spliced_text(page_template, output_format, PRINT_PAGE_WIDTH / 2.0, 80.0, 32.0,
+                              "", PRINT_PLACEHOLDER_YEAR);
+    append_print_spliced_text(page_template, output_format, PRINT_PAGE_WIDTH / 2.0, 110.0, 14.0,
+                              "", PRINT_PLACEHOLDER_PERSONAL_TEXT);
+    for (int month_index = 0; month_index < 12; month_index++) {
+        double block_left = area_left + (month_index % 3) * block_width;
+        double block_top = area_top + (month_index / 3) * block_height;
+        double cells_left = block_left + 6.0;
+        
+        append_print_static_text(page_template, output_format, block_left + block_width / 2.0, block_top + 18.0,
+                                 12.0, 'c', convert_month_number_to_text(month_index + 1));
+        for (int column_index = 0; column_index < 7; column_index++) {
+            append_print_static_text(page_template, output_format, cells_left + (column_index + 0.5) * cell_width,
+                                     block_top + 36.0, 8.0, 'c', weekday_initials[column_index]);
+        }
+        for (int current_day = 1; current_day <= month_day_counts[month_index]; current_day++) {
+            int grid_position = month_starting_days[month_index] + current_day - 1;
+            append_print_static_text(page_template, output_format,
+                                     cells_left + ((grid_position % 7) + 0.5) * cell_width,
+                                     block_top + 54.0 + (grid_position / 7) * row_height, 8.0, 'c',
+                                     to_string(current_day));
+        }
+    }
+    end_print_page_template(page_template, output_format);
+}
+
+vector<print_layout_template_set> build_print_layout_templates(int output_format) {
+    vector<print_layout_template_set> layout_templates(YEAR_LAYOUT_CLASS_COUNT);
+    
+    for (int layout_class = 0; layout_class < YEAR_LAYOUT_CLASS_COUNT; layout_class++) {
+        // Derive every month grid from the January 1 weekday and a representative leap status
+        int reference_year = layout_class >= 7 ? 2000 : 2001;
+        int month_starting_days[12];
+        int month_day_counts[12];
+        int days_before_month = 0;
+        for (int month_index = 0; month_index < 12; month_index++) {
+            month_starting_days[month_index] = (layout_class % 7 + days_before_month) % 7;
+            month_day_counts[month_index] = calculate_month_day_count(month_index + 1, reference_year);
+            days_before_month += month_day_counts[month_index];
+        }
+        
+        print_layout_template_set& template_set = layout_templates[layout_class];
+        build_year_print_page_template(template_set.year_page, output_format, month_starting_days, month_day_counts);
+        for (int month_index = 0; month_index < 12; month_index++) {
+            build_month_print_page_template(template_set.month_pages[month_index], output_format, month_index + 1,
+                                            month_starting_days[month_index], month_day_counts[month_index]);
+        }
+    }
+    return layout_templates;
+}
+
+void append_print_page_from_template(string& page_buffer, const print_page_template& page_template,
+                                     const string& year_text, const string& escaped_personal_text) {
+    // Concatenate cached fragments with per-page values in between
+    for (size_t placeholder_index = 0; placeholder_index < page_template.placeholder_kinds.size(); placeholder_index++) {
+        page_buffer += page_template.static_fragments[placeholder_index];
+        page_buffer += page_template.placeholder_kinds[placeholder_index] == PRINT_PLACEHOLDER_YEAR
+                           ? year_text : escaped_personal_text;
+    }
+    page_buffer += page_template.static_fragments.back();
+}
+
+/*
+================================================================================
+PARALLEL PRINT BATCH GENERATION FUNCTION
+================================================================================
+*/
+
+// Function writes a rendered document to the given file path
+bool write_print_document_file(const string& file_path, const string& document_text) {
+    ofstream document_stream(file_path.c_str(), ios::binary | ios::trunc);
+    document_stream.write(document_text.data(), streamsize(document_text.size()));
+    return bool(document_stream);
+}
+
+int execute_print_batch_generation(const string& jobs_file_path, const string& format_text,
+                                   const string& page_kind_text, const string& output_directory, int thread_count) {
+    // Validate format and page selection
+    if ((format_text != "svg" && format_text != "ps") || (page_kind_text != "year" && page_kind_text != "month")) {
+        cout << "ERROR: Unsupported print format or page kind" << endl;
+        return 1;
+    }
+    int output_format = format_text == "svg" ? PRINT_FORMAT_SVG : PRINT_FORMAT_POSTSCRIPT;
+    bool month_pages_selected = page_kind_text == "month";
+    
+    // Load job lines: year followed by optional personalization text
+    ifstream jobs_stream(jobs_file_path.c_str());
+    if (!jobs_stream) {
+        cout << "ERROR: Unable to read print jobs: " << jobs_file_path << endl;
+        return 1;
+    }
+    vector<print_job_request> print_jobs;
+    string job_line;
+    while (getline(jobs_stream, job_line)) {
+        istringstream job_stream(job_line);
+        print_job_request job_request;
+        if (!(job_stream >> job_request.target_year)) {
+            continue; // Skip blank and comment lines
+        }
+        if (job_request.target_year < 1 || job_request.target_year > 9999) {
+            cout << "ERROR: Print job year out of range: " << job_request.target_year << endl;
+            return 1;
+        }
+        getline(job_stream >> ws, job_request.personalization_text);
+        if (!job_request.personalization_text.empty() &&
+            job_request.personalization_text[job_request.personalization_text.size() - 1] == '\r') {
+            job_request.personalization_text.erase(job_request.personalization_text.size() - 1);
+        }
+        print_jobs.push_back(job_request);
+    }
+    
+    // Precompute page templates for all fourteen year layout classes
+    chrono::steady_clock::time_point template_start_time = chrono::steady_clock::now();
+    const vector<print_layout_template_set> layout_templates = build_print_layout_templates(output_format);
+    double template_seconds = chrono::duration<double>(chrono::steady_clock::now() - template_start_time).count();
+    
+    const string postscript_header = string("%!PS-Adobe-3.0\n%%Creator: CALENDAR BY ARTLEST\n%%Pages: ") +
+        (month_pages_selected ? "12" : "1") + "\n%%BoundingBox: 0 0 595 842\n%%EndComments\n%%BeginProlog\n"
+        "/F { /Helvetica findfont exch scalefont setfont } bind def\n"
+        "/LT { moveto show } bind def\n"
+        "/CT { moveto dup stringwidth pop 2 div neg 0 rmoveto show } bind def\n"
+        "/RS { rectstroke } bind def\n%%EndProlog\n";
+    
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    
+    // Workers claim jobs through a shared counter and write their own files
+    atomic<size_t> next_job_index(0);
+    atomic<unsigned long long> written_page_count(0);
+    atomic<unsigned long long> written_byte_count(0);
+    atomic<bool> write_failure_detected(false);
+    
+    chrono::steady_clock::time_point batch_start_time = chrono::steady_clock::now();
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            string document_buffer;
+            char file_name_buffer[64];
+            for (size_t job_index = next_job_index++; job_index < print_jobs.size(); job_index = next_job_index++) {
+                const print_job_request& job_request = print_jobs[job_index];
+                const print_layout_template_set& template_set =
+                    layout_templates[calculate_year_layout_class(job_request.target_year)];
+                string year_text = to_string(job_request.target_year);
+                string escaped_personal_text = escape_print_text(job_request.personalization_text, output_format);
+                int page_total = month_pages_selected ? 12 : 1;
+                
+                document_buffer.clear();
+                if (output_format == PRINT_FORMAT_POSTSCRIPT) {
+                    document_buffer += postscript_header;
+                }
+                for (int page_index = 0; page_index < page_total; page_index++) {
+                    const print_page_template& page_template =
+                        month_pages_selected ? template_set.month_pages[page_index] : template_set.year_page;
+                    append_print_page_from_template(document_buffer, page_template, year_text, escaped_personal_text);
+                    
+                    // SVG holds one page per file; PostScript collects the pages into one document
+                    if (output_format == PRINT_FORMAT_SVG) {
+                        if (month_pages_selected) {
+                            snprintf(file_name_buffer, sizeof(file_name_buffer), "/calendar_%06lu_%04d_%02d.svg",
+                                     (unsigned long)job_index, job_request.target_year, page_index + 1);
+                        } else {
+                            snprintf(file_name_buffer, sizeof(file_name_buffer), "/calendar_%06lu_%04d.svg",
+                                     (unsigned long)job_index, job_request.target_year);
+                        }
+                        if (!write_print_document_file(output_directory + file_name_buffer, document_buffer)) {
+                            write_failure_detected = true;
+                        }
+                        written_byte_count += document_buffer.size();
+                        document_buffer.clear();
+                    }
+                }
+                if (output_format == PRINT_FORMAT_POSTSCRIPT) {
+                    document_buffer += "%%EOF\n";
+                    snprintf(file_name_buffer, sizeof(file_name_buffer), "/calendar_%06lu_%04d.ps",
+                             (unsigned long)job_index, job_request.target_year);
+                    if (!write_print_document_file(output_directory + file_name_buffer, document_buffer)) {
+                        write_failure_detected = true;
+                    }
+                    written_byte_count += document_buffer.size();
+                }
+                written_page_count += page_total;
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    double batch_seconds = chrono::duration<double>(chrono::steady_clock::now() - batch_start_time).count();
+    
+    // Display batch summary
+    cout << "PRINT BATCH GENERATION REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Format: " << format_text << " (" << page_kind_text << " pages)" << endl;
+    cout << "Calendars: " << print_jobs.size() << endl;
+    cout << "Pages Written: " << written_page_count.load() << endl;
+    cout << "Bytes Written: " << written_byte_count.load() << endl;
+    cout << "Worker Threads: " << thread_count << endl;
+    cout << "Template Build Time: " << fixed << setprecision(3) << template_seconds * 1000.0 << " ms" << endl;
+    cout << "Generation Time: " << fixed << setprecision(3) << batch_seconds << " s" << endl;
+    cout << "Throughput: " << fixed << setprecision(0)
+         << (batch_seconds > 0.0 ? double(written_page_count.load()) / batch_seconds : 0.0) << " pages/s" << endl;
+    
+    if (write_failure_detected) {
+        cout << "ERROR: One or more pages could not be written to " << output_directory << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+================================================================================
+SERIAL DAY CONVERSION FUNCTIONS
+================================================================================
+*/
+
+int calculate_serial_day_number(int day_value, int month_value, int year_value) {
+    // Count days in a March-based year so the leap day falls at the end of each cycle
+    int shifted_year = month_value <= 2 ? year_value - 1 : year_value;
+    int era_index = (shifted_year >= 0 ? shifted_year : shifted_year - 399) / 400;
+    int year_of_era = shifted_year - era_index * 400;                                    // [0, 399]
+    int day_of_shifted_year = (153 * (month_value + (month_value > 2 ? -3 : 9)) + 2) / 5 + day_value - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_shifted_year;
+    
+    // Era 0 begins on 0000-03-01, which is serial day -305
+    return era_index * 146097 + day_of_era - 305;
+}
+
+void convert_serial_day_to_calendar_date(int serial_day, int& day_value, int& month_value, int& year_value) {
+    // Invert calculate_serial_day_number through the 400-year era decomposition
+    int days_since_epoch = serial_day + 305;
+    int era_index = (days_since_epoch >= 0 ? days_since_epoch : days_since_epoch - 146096) / 146097;
+    int day_of_era = days_since_epoch - era_index * 146097;                                  // [0, 146096]
+    int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int day_of_shifted_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int shifted_month = (5 * day_of_shifted_year + 2) / 153;                                 // [0, 11] from March
+    
+    day_value = day_of_shifted_year - (153 * shifted_month + 2) / 5 + 1;
+    month_value = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    year_value = year_of_era + era_index * 400 + (month_value <= 2 ? 1 : 0);
+}
+
+/*
+================================================================================
+LUNAR PHASE CALCULATION FUNCTIONS
+================================================================================
+*/
+
+double calculate_lunar_phase_julian_day(double lunation_index, int phase_kind) {
+    // Mean lunation model with periodic corrections (Meeus, Astronomical Algorithms, ch. 49)
+    const double degrees_to_radians = 3.14159265358979323846 / 180.0;
+    double k = lunation_index;
+    double t = k / 1236.85; // Julian centuries since J2000.0
+    double t2 = t * t;
+    double t3 = t2 * t;
+    double t4 = t3 * t;
+    
+    // Mean phase instant
+    double julian_day = 2451550.09766 + 29.530588861 * k + 0.00015437 * t2 - 0.000000150 * t3 + 0.00000000073 * t4;
+    
+    // Eccentricity factor and fundamental arguments in radians
+    double e = 1.0 - 0.002516 * t - 0.0000074 * t2;
+    double sun_anomaly = (2.5534 + 29.10535670 * k - 0.0000014 * t2 - 0.00000011 * t3) * degrees_to_radians;
+    double moon_anomaly = (201.5643 + 385.81693528 * k + 0.0107582 * t2 + 0.00001238 * t3 - 0.000000058 * t4) *
+                          degrees_to_radians;
+    double latitude_argument = (160.7108 + 390.67050284 * k - 0.0016118 * t2 - 0.00000227 * t3 + 0.000000011 * t4) *
+                               degrees_to_radians;
+    double node_longitude = (124.7746 - 1.56375588 * k + 0.0020672 * t2 + 0.00000215 * t3) * degrees_to_radians;
+    double m = sun_anomaly;
+    double mp = moon_anomaly;
+    double f = latitude_argument;
+    
+    // Periodic terms; new and full moon differ only in the leading coefficients
+    bool new_moon_phase = phase_kind == LUNAR_PHASE_NEW_MOON;
+    julian_day += (new_moon_phase ? -0.40720 : -0.40614) * sin(mp)
+                + (new_moon_phase ? 0.17241 : 0.17302) * e * sin(m)
+                + (new_moon_phase ? 0.01608 : 0.01614) * sin(2.0 * mp)
+                + (new_moon_phase ? 0.01039 : 0.01043) * sin(2.0 * f)
+                + (new_moon_phase ? 0.00739 : 0.00734) * e * sin(mp - m)
+                + (new_moon_phase ? -0.00514 : -0.00515) * e * sin(mp + m)
+                + (new_moon_phase ? 0.00208 : 0.00209) * e * e * sin(2.0 * m)
+                - 0.00111 * sin(mp - 2.0 * f)
+                - 0.00057 * sin(mp + 2.0 * f)
+                + 0.00056 * e * sin(2.0 * mp + m)
+                - 0.00042 * sin(3.0 * mp)
+                + 0.00042 * e * sin(m + 2.0 * f)
+                + 0.00038 * e * sin(m - 2.0 * f)
+                - 0.00024 * e * sin(2.0 * mp - m)
+                - 0.00017 * sin(node_longitude)
+                - 0.00007 * sin(mp + 2.0 * m)
+                + 0.00004 * sin(2.0 * mp - 2.0 * f)
+                + 0.00004 * sin(3.0 * m)
+                + 0.00003 * sin(mp + m - 2.0 * f)
+                + 0.00003 * sin(2.0 * mp + 2.0 * f)
+                - 0.00003 * sin(mp + m + 2.0 * f)
+                + 0.00003 * sin(mp - m + 2.0 * f)
+                - 0.00002 * sin(mp - m - 2.0 * f)
+                - 0.00002 * sin(3.0 * mp + m)
+                + 0.00002 * sin(4.0 * mp);
+    
+    // Planetary arguments common to all phases
+    const double planetary_coefficients[14] = {0.000325, 0.000165, 0.000164, 0.000126, 0.000110, 0.000062, 0.000060,
+                                               0.000056, 0.000047, 0.000042, 0.000040, 0.000037, 0.000035, 0.000023};
+    const double planetary_arguments[14] = {
+        299.77 + 0.107408 * k - 0.009173 * t2, 251.88 + 0.016321 * k, 251.83 + 26.651886 * k,
+        349.42 + 36.412478 * k, 84.66 + 18.206239 * k, 141.74 + 53.303771 * k, 207.14 + 2.453732 * k,
+        154.84 + 7.306860 * k, 34.52 + 27.261239 * k, 207.19 + 0.121824 * k, 291.34 + 1.844379 * k,
+        161.72 + 24.198154 * k, 239.56 + 25.513099 * k, 331.55 + 3.592518 * k};
+    for (int argument_index = 0; argument_index < 14; argument_index++) {
+        julian_day += planetary_coefficients[argument_index] * sin(planetary_arguments[argument_index] * degrees_to_radians);
+    }
+    
+    return julian_day;
+}
+
+// Function approximates Terrestrial Time minus Universal Time in seconds for a decimal year
+double approximate_delta_t_seconds(double decimal_year) {
+    // Polynomial fit near the present, long-term parabola elsewhere
+    if (decimal_year >= 1900.0 && decimal_year <= 2150.0) {
+        double years_since_2000 = decimal_year - 2000.0;
+        return 62.92 + 0.32217 * years_since_2000 + 0.005589 * years_since_2000 * years_since_2000;
+    }
+    double centuries_since_1820 = (decimal_year - 1820.0) / 100.0;
+    return -20.0 + 32.0 * centuries_since_1820 * centuries_since_1820;
+}
+
+vector<lunar_phase_event> build_lunar_phase_table(int first_year, int last_year) {
+    vector<lunar_phase_event> phase_table;
+    if (last_year < first_year) {
+        return phase_table;
+    }
+    
+    // Serial day boundaries of the requested range; Julian Day = serial day + 1721424.5
+    int first_serial_day = calculate_serial_day_number(1, 1, first_year);
+    int last_serial_day = calculate_serial_day_number(31, 12, last_year);
+    const double serial_day_julian_offset = 1721424.5;
+    
+    // Lunation indices bracketing the range with one lunation of margin on each side
+    long long first_lunation = (long long)floor((first_year - 2000.0) * 12.3685) - 1;
+    long long last_lunation = (long long)ceil((last_year + 1 - 2000.0) * 12.3685) + 1;
+    phase_table.reserve(size_t(last_lunation - first_lunation + 1) * 2);
+    
+    for (long long lunation = first_lunation; lunation <= last_lunation; lunation++) {
+        for (int phase_kind = LUNAR_PHASE_NEW_MOON; phase_kind <= LUNAR_PHASE_FULL_MOON; phase_kind++) {
+            double ephemeris_julian_day = calculate_lunar_phase_julian_day(
+                double(lunation) + (phase_kind == LUNAR_PHASE_FULL_MOON ? 0.5 : 0.0), phase_kind);
+            
+            // Convert dynamical time to UTC and split into serial day and minute
+            double decimal_year = 2000.0 + (ephemeris_julian_day - 2451545.0) / 365.25;
+            double universal_julian_day = ephemeris_julian_day - approximate_delta_t_seconds(decimal_year) / 86400.0;
+            double serial_day_value = universal_julian_day - serial_day_julian_offset;
+            int serial_day = int(floor(serial_day_value));
+            int minute_of_day = int((serial_day_value - serial_day) * 1440.0 + 0.5);
+            if (minute_of_day >= 1440) {
+                minute_of_day -= 1440;
+                serial_day++;
+            }
+            
+            if (serial_day >= first_serial_day && serial_day <= last_serial_day) {
+                lunar_phase_event phase_event = {serial_day, minute_of_day, phase_kind};
+                phase_table.push_back(phase_event);
+            }
+        }
+    }
+    
+    // Phases alternate in time already; sorting guards against correction overlap at boundaries
+    sort(phase_table.begin(), phase_table.end(), [](const lunar_phase_event& left_event, const lunar_phase_event& right_event) {
+        return left_event.serial_day != right_event.serial_day ? left_event.serial_day < right_event.serial_day
+                                                                : left_event.minute_of_day < right_event.minute_of_day;
+    });
+    return phase_table;
+}
+
+int execute_moon_phase_calendar_display(int target_year) {
+    if (target_year < 1 || target_year > 9999) {
+        cout << "ERROR: Moon calendar year must be between 1 and 9999" << endl;
+        return 1;
+    }
+    
+    // Precompute the phase table once; each month marks its phase days by lookup
+    vector<lunar_phase_event> phase_table = build_lunar_phase_table(target_year, target_year);
+    calendar_display_options display_options;
+    display_options.lunar_phase_table = &phase_table;
+    
+    cout << "MOON PHASE CALENDAR " << target_year << endl;
+    cout << string(40, '-') << endl;
+    for (int target_month = 1; target_month <= 12; target_month++) {
+        generate_monthly_calendar_display(target_month, target_year, display_options);
+    }
+    return 0;
+}
+
+/*
+================================================================================
+MEMORY MAPPED FILE FUNCTIONS
+================================================================================
+*/
+
+bool map_file_read_only(const string& file_path, mapped_file_region& mapped_region) {
+    mapped_region.mapped_data = NULL;
+    mapped_region.mapped_size = 0;
+#if defined(_WIN32)
+    mapped_region.mapping_handle = NULL;
+    mapped_region.file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (mapped_region.file_handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(mapped_region.file_handle, &file_size)) {
+        CloseHandle(mapped_region.file_handle);
+        return false;
+    }
+    mapped_region.mapped_size = size_t(file_size.QuadPart);
+    if (mapped_region.mapped_size == 0) {
+        return true; // Empty files cannot be mapped but are valid
+    }
+    mapped_region.mapping_handle = CreateFileMappingA(mapped_region.file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapped_region.mapping_handle != NULL) {
+        mapped_region.mapped_data = (const char*)MapViewOfFile(mapped_region.mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (mapped_region.mapped_data == NULL) {
+        unmap_file_region(mapped_region);
+        return false;
+    }
+    return true;
+#else
+    int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        return false;
+    }
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0) {
+        close(file_descriptor);
+        return false;
+    }
+    mapped_region.mapped_size = size_t(file_status.st_size);
+    if (mapped_region.mapped_size > 0) {
+        void* mapping_address = mmap(NULL, mapped_region.mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (mapping_address == MAP_FAILED) {
+            close(file_descriptor);
+            mapped_region.mapped_size = 0;
+            return false;
+        }
+        mapped_region.mapped_data = (const char*)mapping_address;
+    }
+    close(file_descriptor); // The mapping keeps its own reference to the file
+    return true;
+#endif
+}
+
+void unmap_file_region(mapped_file_region& mapped_region) {
+#if defined(_WIN32)
+    if (mapped_region.mapped_data != NULL) {
+        UnmapViewOfFile(mapped_region.mapped_data);
+    }
+    if (mapped_region.mapping_handle != NULL) {
+        CloseHandle(mapped_region.mapping_handle);
+    }
+    if (mapped_region.file_handle != INVALID_HANDLE_VALUE && mapped_region.file_handle != NULL) {
+        CloseHandle(mapped_region.file_handle);
+    }
+    mapped_region.mapping_handle = NULL;
+    mapped_region.file_handle = NULL;
+#else
+    if (mapped_region.mapped_data != NULL) {
+        munmap((void*)mapped_region.mapped_data, mapped_region.mapped_size);
+    }
+#endif
+    mapped_region.mapped_data = NULL;
+    mapped_region.mapped_size = 0;
+}
+
+/*
+================================================================================
+FILE DURABILITY HELPER FUNCTIONS
+================================================================================
+*/
+
+// Function flushes buffered writes and forces them to stable storage
+bool flush_file_to_stable_storage(FILE* file_stream) {
+    if (fflush(file_stream) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(file_stream)) == 0;
+#else
+    return fsync(fileno(file_stream)) == 0;
+#endif
+}
+
+// Function forces the directory entry of a newly created or renamed file to stable storage
+bool synchronize_directory_entry(const string& file_path) {
+#if defined(_WIN32)
+    (void)file_path;
+    return true; // MOVEFILE_WRITE_THROUGH already commits the rename
+#else
+    size_t separator_position = file_path.find_last_of('/');
+    string directory_path = separator_position == string::npos ? string(".") :
+                            separator_position == 0 ? string("/") : file_path.substr(0, separator_position);
+    int directory_descriptor = open(directory_path.c_str(), O_RDONLY);
+    if (directory_descriptor < 0) {
+        return false;
+    }
+    bool synchronize_succeeded = fsync(directory_descriptor) == 0;
+    close(directory_descriptor);
+    return synchronize_succeeded;
+#endif
+}
+
+// Function atomically replaces the destination file with the source file
+bool replace_file_atomically(const string& source_path, const string& destination_path) {
+#if defined(_WIN32)
+    return MoveFileExA(source_path.c_str(), destination_path.c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(source_path.c_str(), destination_path.c_str()) == 0;
+#endif
+}
+
+// Function reads the current length of a file, returning false when it cannot be examined
+bool read_file_length(const string& file_path, uint64_t& file_length) {
+#if defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA file_attributes;
+    if (!GetFileAttributesExA(file_path.c_str(), GetFileExInfoStandard, &file_attributes)) {
+        return false;
+    }
+    file_length = uint64_t(file_attributes.nFileSizeHigh) << 32 | file_attributes.nFileSizeLow;
+    return true;
+#else
+    struct stat file_status;
+    if (stat(file_path.c_str(), &file_status) != 0) {
+        return false;
+    }
+    file_length = uint64_t(file_status.st_size);
+    return true;
+#endif
+}
+
+// Function shortens a file to the given length
+bool truncate_file_to_length(const string& file_path, uint64_t file_length) {
+#if defined(_WIN32)
+    FILE* file_stream = fopen(file_path.c_str(), "r+b");
+    if (file_stream == NULL) {
+        return false;
+    }
+    bool truncation_succeeded = _chsize_s(_fileno(file_stream), (long long)file_length) == 0;
+    fclose(file_stream);
+    return truncation_succeeded;
+#else
+    return truncate(file_path.c_str(), off_t(file_length)) == 0;
+#endif
+}
+
+// Function opens or creates a lock file and waits until this process holds it exclusively
+bool acquire_exclusive_file_lock(const string& lock_path, exclusive_file_lock& file_lock) {
+#if defined(_WIN32)
+    file_lock.file_handle = CreateFileA(lock_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS,
+                                        FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_lock.file_handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    OVERLAPPED lock_region;
+    memset(&lock_region, 0, sizeof(lock_region));
+    if (!LockFileEx(file_lock.file_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &lock_region)) {
+        CloseHandle(file_lock.file_handle);
+        file_lock.file_handle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    return true;
+#else
+    file_lock.file_descriptor = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file_lock.file_descriptor < 0) {
+        return false;
+    }
+    int lock_result = 0;
+    do {
+        lock_result = flock(file_lock.file_descriptor, LOCK_EX);
+    } while (lock_result != 0 && errno == EINTR);
+    if (lock_result != 0) {
+        close(file_lock.file_descriptor);
+        file_lock.file_descriptor = -1;
+        return false;
+    }
+    return true;
+#endif
+}
+
+// Function releases a lock taken by acquire_exclusive_file_lock; the lock file itself is left in place
+void release_exclusive_file_lock(exclusive_file_lock& file_lock) {
+#if defined(_WIN32)
+    if (file_lock.file_handle != INVALID_HANDLE_VALUE) {
+        OVERLAPPED lock_region;
+        memset(&lock_region, 0, sizeof(lock_region));
+        UnlockFileEx(file_lock.file_handle, 0, 1, 0, &lock_region);
+        CloseHandle(file_lock.file_handle);
+        file_lock.file_handle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (file_lock.file_descriptor >= 0) {
+        flock(file_lock.file_descriptor, LOCK_UN);
+        close(file_lock.file_descriptor);
+        file_lock.file_descriptor = -1;
+    }
+#endif
+}
+
+// Function writes a complete file through a temporary name and an atomic rename; the temporary
+// name is fixed, so concurrent writers of one path must serialize (see acquire_exclusive_file_lock)
+bool write_file_atomically(const string& file_path, const string& file_contents) {
+    string temporary_path = file_path + ".tmp";
+    FILE* temporary_stream = fopen(temporary_path.c_str(), "wb");
+    if (temporary_stream == NULL) {
+        return false;
+    }
+    bool write_succeeded = fwrite(file_contents.data(), 1, file_contents.size(), temporary_stream) == file_contents.size() &&
+                           flush_file_to_stable_storage(temporary_stream);
+    write_succeeded = fclose(temporary_stream) == 0 && write_succeeded;
+    if (!write_succeeded || !replace_file_atomically(temporary_path, file_path)) {
+        remove(temporary_path.c_str());
+        return false;
+    }
+    // The rename itself is durable only once the directory is synchronized
+    return synchronize_directory_entry(file_path);
+}
+
+// Function creates a new, uniquely named directory inside a parent directory
+bool create_scratch_directory(const string& parent_directory, const string& name_prefix, string& scratch_directory) {
+#if defined(_WIN32)
+    for (int attempt_index = 0; attempt_index < 100; attempt_index++) {
+        scratch_directory = parent_directory + "/" + name_prefix + to_string(GetCurrentProcessId()) + "-" +
+                            to_string(attempt_index);
+        if (CreateDirectoryA(scratch_directory.c_str(), NULL)) {
+            return true;
+        }
+        if (GetLastError() != ERROR_ALREADY_EXISTS) {
+            return false;
+        }
+    }
+    return false;
+#else
+    string directory_template = parent_directory + "/" + name_prefix + "XXXXXX";
+    vector<char> template_characters(directory_template.begin(), directory_template.end());
+    template_characters.push_back('\0');
+    if (mkdtemp(template_characters.data()) == NULL) {
+        return false;
+    }
+    scratch_directory = template_characters.data();
+    return true;
+#endif
+}
+
+// Function deletes the named files of a scratch directory, then the directory itself
+bool remove_scratch_directory(const string& scratch_directory, const char* const* file_names, size_t file_count) {
+    for (size_t file_index = 0; file_index < file_count; file_index++) {
+        remove((scratch_directory + "/" + file_names[file_index]).c_str()); // Files never created are fine
+    }
+#if defined(_WIN32)
+    return RemoveDirectoryA(scratch_directory.c_str()) != 0;
+#else
+    return rmdir(scratch_directory.c_str()) == 0;
+#endif
+}
+
+/*
+================================================================================
+CRC-32 CHECKSUM FUNCTION
+================================================================================
+*/
+
+uint32_t calculate_crc32_checksum(const void* data_pointer, size_t data_length, uint32_t running_checksum) {
+    // Slicing-by-8 tables built once on first use: table 0 is the reflected polynomial
+    // table, table n advances a byte that sits n positions further back in the block
+    static const vector<uint32_t> checksum_tables = []() {
+        vector<uint32_t> generated_tables(8 * 256);
+        for (uint32_t table_index = 0; table_index < 256; table_index++) {
+            uint32_t table_value = table_index;
+            for (int bit_index = 0; bit_index < 8; bit_index++) {
+                table_value = (table_value & 1) ? 0xEDB88320u ^ (table_value >> 1) : table_value >> 1;
+            }
+            generated_tables[table_index] = table_value;
+        }
+        for (uint32_t table_index = 0; table_index < 256; table_index++) {
+            for (int slice_index = 1; slice_index < 8; slice_index++) {
+                uint32_t previous_value = generated_tables[(slice_index - 1) * 256 + table_index];
+                generated_tables[slice_index * 256 + table_index] = (previous_value >> 8) ^ generated_tables[previous_value & 0xFF];
+            }
+        }
+        return generated_tables;
+    }();
+    const uint32_t* table = checksum_tables.data();
+    
+    const unsigned char* data_bytes = (const unsigned char*)data_pointer;
+    uint32_t checksum_state = ~running_checksum;
+    
+    // Consume eight bytes per step with one lookup in each table
+    while (data_length >= 8) {
+        uint32_t low_word = checksum_state ^ (uint32_t(data_bytes[0]) | uint32_t(data_bytes[1]) << 8 |
+                                              uint32_t(data_bytes[2]) << 16 | uint32_t(data_bytes[3]) << 24);
+        checksum_state = table[7 * 256 + (low_word & 0xFF)] ^ table[6 * 256 + ((low_word >> 8) & 0xFF)] ^
+                         table[5 * 256 + ((low_word >> 16) & 0xFF)] ^ table[4 * 256 + (low_word >> 24)] ^
+                         table[3 * 256 + data_bytes[4]] ^ table[2 * 256 + data_bytes[5]] ^
+                         table[1 * 256 + data_bytes[6]] ^ table[data_bytes[7]];
+        data_bytes += 8;
+        data_length -= 8;
+    }
+    
+    // Finish the remaining bytes one at a time
+    while (data_length-- > 0) {
+        checksum_state = table[(checksum_state ^ *data_bytes++) & 0xFF] ^ (checksum_state >> 8);
+    }
+    return ~checksum_state;
+}
+
+/*
+================================================================================
+ISO DATE PARSING FUNCTION
+================================================================================
+*/
+
+bool parse_iso_calendar_date(const char* date_text, size_t text_length, int& day_value, int& month_value, int& year_value) {
+    // Fixed-width YYYY-MM-DD layout parsed digit by digit without locale overhead; callers
+    // reading a date prefix (date-time text) pass a length of 10
+    if (text_length != 10 || date_text[4] != '-' || date_text[7] != '-') {
+        return false;
+    }
+    const int digit_positions[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+    int digit_values[8];
+    for (int digit_index = 0; digit_index < 8; digit_index++) {
+        unsigned digit_value = unsigned(date_text[digit_positions[digit_index]] - '0');
+        if (digit_value > 9) {
+            return false;
+        }
+        digit_values[digit_index] = int(digit_value);
+    }
+    year_value = digit_values[0] * 1000 + digit_values[1] * 100 + digit_values[2] * 10 + digit_values[3];
+    month_value = digit_values[4] * 10 + digit_values[5];
+    day_value = digit_values[6] * 10 + digit_values[7];
+    
+    // Reject dates that do not exist in the proleptic Gregorian calendar
+    return year_value >= 1 && month_value >= 1 && month_value <= 12 &&
+           day_value >= 1 && day_value <= calculate_month_day_count(month_value, year_value);
+}
+
+/*
+================================================================================
+EVENT STORE FILE FORMAT FUNCTIONS
+================================================================================
+*/
+
+static_assert(sizeof(calendar_event_record) == 56, "event record layout must stay fixed");
+static_assert(sizeof(calendar_event_log_entry) == 64, "event log entry layout must stay fixed");
+static_assert(sizeof(calendar_event_log_header) == 64, "event log header must span one entry");
+static_assert(sizeof(calendar_event_snapshot_header) == 64, "snapshot header must span one entry");
+
+// Function orders events by serial day, then by identifier
+bool compare_calendar_event_order(const calendar_event_record& left_event, const calendar_event_record& right_event) {
+    return left_event.serial_day != right_event.serial_day ? left_event.serial_day < right_event.serial_day
+                                                           : left_event.event_identifier < right_event.event_identifier;
+}
+
+// Function computes the checksum protecting one log entry
+uint32_t calculate_event_log_entry_checksum(const calendar_event_log_entry& log_entry) {
+    return calculate_crc32_checksum((const char*)&log_entry + sizeof(uint32_t),
+                                    sizeof(calendar_event_log_entry) - sizeof(uint32_t));
+}
+
+// Function creates an empty log of the given generation through an atomic rename
+bool create_calendar_event_log(const string& log_path, uint64_t log_generation) {
+    calendar_event_log_header log_header;
+    memset(&log_header, 0, sizeof(log_header));
+    memcpy(log_header.file_signature, "CALEVLOG", 8);
+    log_header.format_version = EVENT_STORE_FORMAT_VERSION;
+    log_header.entry_length = sizeof(calendar_event_log_entry);
+    log_header.log_generation = log_generation;
+    log_header.header_checksum = calculate_crc32_checksum(&log_header, offsetof(calendar_event_log_header, header_checksum));
+    return write_file_atomically(log_path, string((const char*)&log_header, sizeof(log_header)));
+}
+
+// Function builds the file paths used by an event store
+string build_event_store_path(const calendar_event_store& event_store, const char* file_name) {
+    return event_store.store_directory + "/" + file_name;
+}
+
+/*
+================================================================================
+EVENT STORE RECOVERY FUNCTION
+================================================================================
+*/
+
+// Function sorts replayed events by serial day; log order already orders identifiers within a day
+void sort_replayed_calendar_events(vector<calendar_event_record>& replayed_events) {
+    // Sort compact (serial day, log position) keys instead of moving full records
+    vector<uint64_t> ordering_keys(replayed_events.size());
+    for (size_t event_index = 0; event_index < replayed_events.size(); event_index++) {
+        ordering_keys[event_index] = uint64_t(uint32_t(replayed_events[event_index].serial_day) ^ 0x80000000u) << 32 |
+                                     uint64_t(event_index);
+    }
+    sort(ordering_keys.begin(), ordering_keys.end());
+    
+    // Gather records into key order
+    vector<calendar_event_record> sorted_events(replayed_events.size());
+    for (size_t key_index = 0; key_index < ordering_keys.size(); key_index++) {
+        sorted_events[key_index] = replayed_events[size_t(ordering_keys[key_index] & 0xFFFFFFFFu)];
+    }
+    replayed_events.swap(sorted_events);
+}
+
+bool open_calendar_event_store(calendar_event_store& event_store, const string& store_directory) {
+    event_store.store_directory = store_directory;
+    event_store.log_file = NULL;
+    event_store.log_valid_length = sizeof(calendar_event_log_header);
+    event_store.log_generation = 0;
+    event_store.next_event_identifier = 1;
+    event_store.event_index.clear();
+    event_store.entries_since_snapshot = 0;
+    event_store.compaction_threshold = 1 << 20;
+    event_store.synchronize_each_append = true;
+    event_store.recovered_snapshot_records = 0;
+    event_store.replayed_log_entries = 0;
+    event_store.truncated_log_bytes = 0;
+    
+    string snapshot_path = build_event_store_path(event_store, "events.snapshot");
+    string log_path = build_event_store_path(event_store, "events.log");
+    
+    // Map the snapshot; its sorted record array is merged straight from the mapping below
+    mapped_file_region snapshot_region;
+    const calendar_event_record* snapshot_records = NULL;
+    if (map_file_read_only(snapshot_path, snapshot_region)) {
+        calendar_event_snapshot_header snapshot_header;
+        bool snapshot_valid = snapshot_region.mapped_size >= sizeof(snapshot_header);
+        if (snapshot_valid) {
+            memcpy(&snapshot_header, snapshot_region.mapped_data, sizeof(snapshot_header));
+            const char* record_bytes = snapshot_region.mapped_data + sizeof(snapshot_header);
+            size_t records_length = snapshot_region.mapped_size - sizeof(snapshot_header);
+            snapshot_valid = memcmp(snapshot_header.file_signature, "CALEVSNP", 8) == 0 &&
+                             snapshot_header.format_version == EVENT_STORE_FORMAT_VERSION &&
+                             snapshot_header.record_length == sizeof(calendar_event_record) &&
+                             snapshot_header.header_checksum == calculate_crc32_checksum(
+                                 &snapshot_header, offsetof(calendar_event_snapshot_header, header_checksum)) &&
+                             records_length == snapshot_header.record_count * sizeof(calendar_event_record) &&
+                             snapshot_header.records_checksum == calculate_crc32_checksum(record_bytes, records_length);
+            if (snapshot_valid) {
+                snapshot_records = (const calendar_event_record*)record_bytes;
+                event_store.recovered_snapshot_records = size_t(snapshot_header.record_count);
+                event_store.log_generation = snapshot_header.next_log_generation;
+                event_store.next_event_identifier = snapshot_header.next_event_identifier;
+            }
+        }
+        if (!snapshot_valid) {
+            unmap_file_region(snapshot_region);
+            cout << "ERROR: Event snapshot is corrupt: " << snapshot_path << endl;
+            return false;
+        }
+    }
+    
+    // Map the log and validate its generation against the snapshot
+    mapped_file_region log_region;
+    bool log_usable = map_file_read_only(log_path, log_region);
+    calendar_event_log_header log_header;
+    if (log_usable) {
+        log_usable = log_region.mapped_size >= sizeof(log_header);
+        if (log_usable) {
+            memcpy(&log_header, log_region.mapped_data, sizeof(log_header));
+            log_usable = memcmp(log_header.file_signature, "CALEVLOG", 8) == 0 &&
+                         log_header.format_version == EVENT_STORE_FORMAT_VERSION &&
+                         log_header.entry_length == sizeof(calendar_event_log_entry) &&
+                         log_header.header_checksum == calculate_crc32_checksum(
+                             &log_header, offsetof(calendar_event_log_header, header_checksum));
+        }
+        // Logs are only ever created whole through a rename, so a bad header is damage, not a torn write
+        if (!log_usable) {
+            unmap_file_region(log_region);
+            unmap_file_region(snapshot_region);
+            cout << "ERROR: Event log header is corrupt: " << log_path << endl;
+            return false;
+        }
+        if (log_header.log_generation > event_store.log_generation) {
+            unmap_file_region(log_region);
+            unmap_file_region(snapshot_region);
+            cout << "ERROR: Event log is newer than its snapshot: " << log_path << endl;
+            return false;
+        }
+        // An older generation was fully folded into the snapshot before a crash during compaction
+        log_usable = log_header.log_generation == event_store.log_generation;
+    }
+    
+    // Replay checksummed entries until the first torn or corrupt entry
+    vector<calendar_event_record> appended_events;
+    vector<uint64_t> removed_identifiers;
+    if (log_usable) {
+        size_t valid_log_length = sizeof(log_header);
+        calendar_event_log_entry log_entry;
+        appended_events.reserve((log_region.mapped_size - valid_log_length) / sizeof(log_entry));
+        while (valid_log_length + sizeof(log_entry) <= log_region.mapped_size) {
+            memcpy(&log_entry, log_region.mapped_data + valid_log_length, sizeof(log_entry));
+            if (log_entry.entry_checksum != calculate_event_log_entry_checksum(log_entry)) {
+                break;
+            }
+            if (log_entry.operation_code == EVENT_LOG_OPERATION_APPEND) {
+                appended_events.push_back(log_entry.event_record);
+                event_store.next_event_identifier = max(event_store.next_event_identifier,
+                                                        log_entry.event_record.event_identifier + 1);
+            } else if (log_entry.operation_code == EVENT_LOG_OPERATION_REMOVE) {
+                removed_identifiers.push_back(log_entry.event_record.event_identifier);
+            }
+            valid_log_length += sizeof(log_entry);
+            event_store.replayed_log_entries++;
+        }
+        size_t mapped_log_length = log_region.mapped_size;
+        unmap_file_region(log_region);
+        
+        // Discard a torn tail left by an interrupted append
+        if (valid_log_length < mapped_log_length) {
+            event_store.truncated_log_bytes = mapped_log_length - valid_log_length;
+            if (!truncate_file_to_length(log_path, valid_log_length)) {
+                unmap_file_region(snapshot_region);
+                cout << "ERROR: Unable to truncate torn event log tail: " << log_path << endl;
+                return false;
+            }
+        }
+        event_store.entries_since_snapshot = event_store.replayed_log_entries;
+        event_store.log_valid_length = valid_log_length;
+    } else {
+        // Missing or stale log: start the expected generation afresh
+        unmap_file_region(log_region);
+        if (!create_calendar_event_log(log_path, event_store.log_generation)) {
+            unmap_file_region(snapshot_region);
+            cout << "ERROR: Unable to create event log: " << log_path << endl;
+            return false;
+        }
+    }
+    
+    // Merge the mapped snapshot records with the sorted tail in a single pass
+    sort_replayed_calendar_events(appended_events);
+    event_store.event_index.resize(event_store.recovered_snapshot_records + appended_events.size());
+    merge(snapshot_records, snapshot_records + event_store.recovered_snapshot_records,
+          appended_events.begin(), appended_events.end(), event_store.event_index.begin(), compare_calendar_event_order);
+    unmap_file_region(snapshot_region);
+    
+    // Drop events removed after they were written
+    if (!removed_identifiers.empty()) {
+        sort(removed_identifiers.begin(), removed_identifiers.end());
+        event_store.event_index.erase(
+            remove_if(event_store.event_index.begin(), event_store.event_index.end(),
+                      [&removed_identifiers](const calendar_event_record& event_record) {
+                          return binary_search(removed_identifiers.begin(), removed_identifiers.end(),
+                                               event_record.event_identifier);
+                      }),
+            event_store.event_index.end());
+    }
+    
+    event_store.log_file = fopen(log_path.c_str(), "ab");
+    return event_store.log_file != NULL;
+}
+
+/*
+================================================================================
+EVENT STORE UPDATE FUNCTIONS
+================================================================================
+*/
+
+// Function writes log entries and optionally forces them to stable storage
+bool write_calendar_event_log_entries(calendar_event_store& event_store, const vector<calendar_event_log_entry>& log_entries) {
+    if (event_store.log_file == NULL) {
+        return false; // Store closed or disabled by an earlier failed append
+    }
+    bool write_succeeded =
+        fwrite(log_entries.data(), sizeof(calendar_event_log_entry), log_entries.size(), event_store.log_file) == log_entries.size();
+    write_succeeded = write_succeeded && (event_store.synchronize_each_append ? flush_file_to_stable_storage(event_store.log_file)
+                                                                              : fflush(event_store.log_file) == 0);
+    if (write_succeeded) {
+        event_store.log_valid_length += log_entries.size() * sizeof(calendar_event_log_entry);
+        event_store.entries_since_snapshot += log_entries.size();
+        return true;
+    }
+    
+    // Cut a partial write back to the last complete entry so later appends are not stranded behind a
+    // torn record that recovery would stop at; if that fails the store refuses further appends
+    string log_path = build_event_store_path(event_store, "events.log");
+    fclose(event_store.log_file);
+    event_store.log_file = NULL;
+    if (truncate_file_to_length(log_path, event_store.log_valid_length)) {
+        event_store.log_file = fopen(log_path.c_str(), "ab");
+    }
+    return false;
+}
+
+bool append_calendar_events(calendar_event_store& event_store, vector<calendar_event_record>& new_events) {
+    // Assign identifiers and log every event before it becomes visible in the index
+    vector<calendar_event_log_entry> log_entries(new_events.size());
+    for (size_t event_index = 0; event_index < new_events.size(); event_index++) {
+        new_events[event_index].event_identifier = event_store.next_event_identifier++;
+        memset(&log_entries[event_index], 0, sizeof(calendar_event_log_entry));
+        log_entries[event_index].operation_code = EVENT_LOG_OPERATION_APPEND;
+        log_entries[event_index].event_record = new_events[event_index];
+        log_entries[event_index].entry_checksum = calculate_event_log_entry_checksum(log_entries[event_index]);
+    }
+    if (!write_calendar_event_log_entries(event_store, log_entries)) {
+        return false;
+    }
+    
+    // Merge the sorted batch into the sorted index
+    vector<calendar_event_record> sorted_events(new_events);
+    sort(sorted_events.begin(), sorted_events.end(), compare_calendar_event_order);
+    size_t existing_record_count = event_store.event_index.size();
+    event_store.event_index.insert(event_store.event_index.end(), sorted_events.begin(), sorted_events.end());
+    inplace_merge(event_store.event_index.begin(), event_store.event_index.begin() + existing_record_count,
+                  event_store.event_index.end(), compare_calendar_event_order);
+    
+    // Fold the log into a snapshot once it grows past the threshold
+    if (event_store.entries_since_snapshot >= event_store.compaction_threshold) {
+        return compact_calendar_event_store(event_store);
+    }
+    return true;
+}
+
+bool remove_calendar_event(calendar_event_store& event_store, uint64_t event_identifier) {
+    vector<calendar_event_record>::iterator event_position = event_store.event_index.begin();
+    while (event_position != event_store.event_index.end() && event_position->event_identifier != event_identifier) {
+        ++event_position;
+    }
+    if (event_position == event_store.event_index.end()) {
+        return false; // Unknown identifier
+    }
+    
+    vector<calendar_event_log_entry> log_entries(1);
+    memset(&log_entries[0], 0, sizeof(calendar_event_log_entry));
+    log_entries[0].operation_code = EVENT_LOG_OPERATION_REMOVE;
+    log_entries[0].event_record.event_identifier = event_identifier;
+    log_entries[0].entry_checksum = calculate_event_log_entry_checksum(log_entries[0]);
+    if (!write_calendar_event_log_entries(event_store, log_entries)) {
+        return false;
+    }
+    event_store.event_index.erase(event_position);
+    return true;
+}
+
+bool compact_calendar_event_store(calendar_event_store& event_store) {
+    // Snapshot covers every entry of the current generation and expects the next one
+    calendar_event_snapshot_header snapshot_header;
+    memset(&snapshot_header, 0, sizeof(snapshot_header));
+    memcpy(snapshot_header.file_signature, "CALEVSNP", 8);
+    snapshot_header.format_version = EVENT_STORE_FORMAT_VERSION;
+    snapshot_header.record_length = sizeof(calendar_event_record);
+    snapshot_header.record_count = event_store.event_index.size();
+    snapshot_header.next_log_generation = event_store.log_generation + 1;
+    snapshot_header.next_event_identifier = event_store.next_event_identifier;
+    snapshot_header.records_checksum = calculate_crc32_checksum(event_store.event_index.data(),
+                                                                event_store.event_index.size() * sizeof(calendar_event_record));
+    snapshot_header.header_checksum = calculate_crc32_checksum(&snapshot_header,
+                                                               offsetof(calendar_event_snapshot_header, header_checksum));
+    
+    string snapshot_contents((const char*)&snapshot_header, sizeof(snapshot_header));
+    snapshot_contents.append((const char*)event_store.event_index.data(),
+                             event_store.event_index.size() * sizeof(calendar_event_record));
+    
+    // Publish the snapshot first; a crash before the new log exists leaves a stale log that recovery discards
+    if (!write_file_atomically(build_event_store_path(event_store, "events.snapshot"), snapshot_contents)) {
+        return false;
+    }
+    if (event_store.log_file != NULL) {
+        fclose(event_store.log_file);
+        event_store.log_file = NULL;
+    }
+    string log_path = build_event_store_path(event_store, "events.log");
+    if (!create_calendar_event_log(log_path, event_store.log_generation + 1)) {
+        return false;
+    }
+    event_store.log_generation++;
+    event_store.entries_since_snapshot = 0;
+    event_store.log_valid_length = sizeof(calendar_event_log_header);
+    event_store.log_file = fopen(log_path.c_str(), "ab");
+    return event_store.log_file != NULL;
+}
+
+void close_calendar_event_store(calendar_event_store& event_store) {
+    if (event_store.log_file != NULL) {
+        fclose(event_store.log_file);
+        event_store.log_file = NULL;
+    }
+}
+
+/*
+================================================================================
+EVENT STORE COMMAND FUNCTION
+================================================================================
+*/
+
+// Function displays one event record as a text line
+void display_calendar_event_record(const calendar_event_record& event_record) {
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(event_record.serial_day, day_value, month_value, year_value);
+    char event_line[160];
+    snprintf(event_line, sizeof(event_line), "%8llu  %04d-%02d-%02d %02d:%02d  %4u min  %.40s",
+             (unsigned long long)event_record.event_identifier, year_value, month_value, day_value,
+             event_record.start_minute / 60, event_record.start_minute % 60,
+             unsigned(event_record.duration_minutes), event_record.event_title);
+    cout << event_line << endl;
+}
+
+int execute_event_store_benchmark(const string& parent_directory, size_t benchmark_event_count) {
+    static const char* const store_file_names[] = {"events.log", "events.snapshot", "events.log.tmp", "events.snapshot.tmp"};
+    const size_t store_file_count = sizeof(store_file_names) / sizeof(store_file_names[0]);
+    string store_directory;
+    if (!create_scratch_directory(parent_directory, "event-store-benchmark-", store_directory)) {
+        cout << "ERROR: Unable to create a benchmark directory in " << parent_directory << endl;
+        return 1;
+    }
+    cout << "Benchmark Store: " << store_directory << " (removed afterwards)" << endl;
+    calendar_event_store event_store;
+    if (!open_calendar_event_store(event_store, store_directory)) {
+        remove_scratch_directory(store_directory, store_file_names, store_file_count);
+        return 1;
+    }
+    
+    // Bulk append in batches, compact, then measure recovery of snapshot plus tail
+    const size_t batch_length = 65536;
+    event_store.synchronize_each_append = false;
+    event_store.compaction_threshold = benchmark_event_count / 2 + 1;
+    chrono::steady_clock::time_point append_start_time = chrono::steady_clock::now();
+    for (size_t batch_start = 0; batch_start < benchmark_event_count; batch_start += batch_length) {
+        vector<calendar_event_record> new_events(min(batch_length, benchmark_event_count - batch_start));
+        for (size_t event_index = 0; event_index < new_events.size(); event_index++) {
+            memset(&new_events[event_index], 0, sizeof(calendar_event_record));
+            new_events[event_index].serial_day = 730120 + int((batch_start + event_index) * 2654435761u % 36525);
+            new_events[event_index].start_minute = uint16_t((batch_start + event_index) % 1440);
+            new_events[event_index].duration_minutes = 30;
+            strncpy(new_events[event_index].event_title, "Benchmark event", sizeof(new_events[event_index].event_title) - 1);
+        }
+        if (!append_calendar_events(event_store, new_events)) {
+            cout << "ERROR: Benchmark append failed" << endl;
+            close_calendar_event_store(event_store);
+            remove_scratch_directory(store_directory, store_file_names, store_file_count);
+            return 1;
+        }
+    }
+    flush_file_to_stable_storage(event_store.log_file);
+    double append_seconds = chrono::duration<double>(chrono::steady_clock::now() - append_start_time).count();
+    close_calendar_event_store(event_store);
+    
+    chrono::steady_clock::time_point recovery_start_time = chrono::steady_clock::now();
+    calendar_event_store recovered_store;
+    bool recovery_succeeded = open_calendar_event_store(recovered_store, store_directory);
+    double recovery_seconds = chrono::duration<double>(chrono::steady_clock::now() - recovery_start_time).count();
+    if (recovery_succeeded) {
+        cout << "Appended: " << benchmark_event_count << " events in " << fixed << setprecision(3) << append_seconds
+             << " s (" << setprecision(0) << (append_seconds > 0.0 ? benchmark_event_count / append_seconds : 0.0)
+             << " events/s)" << endl;
+        cout << "Recovered: " << recovered_store.event_index.size() << " events (" << recovered_store.recovered_snapshot_records
+             << " from snapshot, " << recovered_store.replayed_log_entries << " replayed) in " << setprecision(3)
+             << recovery_seconds * 1000.0 << " ms" << endl;
+        close_calendar_event_store(recovered_store);
+    }
+    if (!remove_scratch_directory(store_directory, store_file_names, store_file_count)) {
+        cout << "ERROR: Unable to remove benchmark directory " << store_directory << endl;
+        return 1;
+    }
+    return recovery_succeeded ? 0 : 1;
+}
+
+int execute_event_store_command(int argument_count, char* argument_values[], int option_index) {
+    if (option_index + 2 >= argument_count) {
+        display_command_line_usage_information();
+        return 1;
+    }
+    string store_directory = argument_values[option_index + 1];
+    string store_command = argument_values[option_index + 2];
+    int parameter_index = option_index + 3;
+    if (store_command == "benchmark") {
+        // The benchmark never opens the store it is pointed at, so its synthetic events cannot reach user data
+        if (parameter_index >= argument_count) {
+            display_command_line_usage_information();
+            return 1;
+        }
+        return execute_event_store_benchmark(store_directory, size_t(strtoull(argument_values[parameter_index], NULL, 10)));
+    }
+    
+    // Recovery timing is reported for every command
+    chrono::steady_clock::time_point open_start_time = chrono::steady_clock::now();
+    calendar_event_store event_store;
+    if (!open_calendar_event_store(event_store, store_directory)) {
+        return 1;
+    }
+    double open_seconds = chrono::duration<double>(chrono::steady_clock::now() - open_start_time).count();
+    cout << "Event Store: " << event_store.event_index.size() << " events recovered ("
+         << event_store.recovered_snapshot_records << " from snapshot, " << event_store.replayed_log_entries
+         << " log entries replayed, " << event_store.truncated_log_bytes << " torn bytes discarded) in "
+         << fixed << setprecision(3) << open_seconds * 1000.0 << " ms" << endl;
+    
+    int command_status = 0;
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    if (store_command == "add" && parameter_index + 3 < argument_count &&
+        parse_iso_calendar_date(argument_values[parameter_index], strlen(argument_values[parameter_index]),
+                                day_value, month_value, year_value)) {
+        // add <YYYY-MM-DD> <HH:MM> <minutes> <title words...>
+        int start_hour = 0;
+        int start_minute = 0;
+        sscanf(argument_values[parameter_index + 1], "%d:%d", &start_hour, &start_minute);
+        string event_title;
+        for (int word_index = parameter_index + 3; word_index < argument_count; word_index++) {
+            event_title += (event_title.empty() ? "" : " ") + string(argument_values[word_index]);
+        }
+        vector<calendar_event_record> new_events(1);
+        memset(&new_events[0], 0, sizeof(calendar_event_record));
+        new_events[0].serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+        new_events[0].start_minute = uint16_t(min(max(start_hour * 60 + start_minute, 0), 1439));
+        new_events[0].duration_minutes = uint16_t(min(max(atoi(argument_values[parameter_index + 2]), 0), 65535));
+        strncpy(new_events[0].event_title, event_title.c_str(), sizeof(new_events[0].event_title) - 1);
+        if (append_calendar_events(event_store, new_events)) {
+            display_calendar_event_record(new_events[0]);
+        } else {
+            cout << "ERROR: Unable to append event" << endl;
+            command_status = 1;
+        }
+    } else if (store_command == "remove" && parameter_index < argument_count) {
+        if (!remove_calendar_event(event_store, strtoull(argument_values[parameter_index], NULL, 10))) {
+            cout << "ERROR: Event not found or log write failed" << endl;
+            command_status = 1;
+        }
+    } else if (store_command == "list") {
+        // Optional inclusive date bounds select a serial day range by binary search
+        int first_serial_day = 1;
+        int last_serial_day = calculate_serial_day_number(31, 12, 9999);
+        if (parameter_index + 1 < argument_count &&
+            parse_iso_calendar_date(argument_values[parameter_index], strlen(argument_values[parameter_index]),
+                                    day_value, month_value, year_value)) {
+            first_serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+            if (parse_iso_calendar_date(argument_values[parameter_index + 1], strlen(argument_values[parameter_index + 1]),
+                                        day_value, month_value, year_value)) {
+                last_serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+            }
+        }
+        calendar_event_record search_key;
+        memset(&search_key, 0, sizeof(search_key));
+        search_key.serial_day = first_serial_day;
+        for (vector<calendar_event_record>::const_iterator event_position =
+                 lower_bound(event_store.event_index.begin(), event_store.event_index.end(), search_key,
+                             compare_calendar_event_order);
+             event_position != event_store.event_index.end() && event_position->serial_day <= last_serial_day;
+             ++event_position) {
+            display_calendar_event_record(*event_position);
+        }
+    } else if (store_command == "compact") {
+        if (!compact_calendar_event_store(event_store)) {
+            cout << "ERROR: Compaction failed" << endl;
+            command_status = 1;
+        }
+    } else {
+        display_command_line_usage_information();
+        command_status = 1;
+    }
+    
+    close_calendar_event_store(event_store);
+    return command_status;
+}
+
+/*
+================================================================================
+ICALENDAR VALUE PARSING FUNCTIONS
+================================================================================
+*/
+
+// Function parses DATE (YYYYMMDD) or DATE-TIME (YYYYMMDDTHHMMSS[Z]) values
+bool parse_icalendar_date_time(const char* value_text, size_t value_length, int& serial_day,
+                               int& minute_of_day, bool& utc_time) {
+    if (value_length < 8) {
+        return false;
+    }
+    int digit_values[14];
+    for (int digit_index = 0; digit_index < 8; digit_index++) {
+        unsigned digit_value = unsigned(value_text[digit_index] - '0');
+        if (digit_value > 9) {
+            return false;
+        }
+        digit_values[digit_index] = int(digit_value);
+    }
+    int year_value = digit_values[0] * 1000 + digit_values[1] * 100 + digit_values[2] * 10 + digit_values[3];
+    int month_value = digit_values[4] * 10 + digit_values[5];
+    int day_value = digit_values[6] * 10 + digit_values[7];
+    if (year_value < 1 || month_value < 1 || month_value > 12 ||
+        day_value < 1 || day_value > calculate_month_day_count(month_value, year_value)) {
+        return false;
+    }
+    serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+    minute_of_day = -1; // DATE values describe whole days
+    utc_time = false;
+    
+    // Optional time component
+    if (value_length >= 15 && value_text[8] == 'T') {
+        for (int digit_index = 8; digit_index < 14; digit_index++) {
+            unsigned digit_value = unsigned(value_text[digit_index + 1] - '0');
+            if (digit_value > 9) {
+                return false;
+            }
+            digit_values[digit_index] = int(digit_value);
+        }
+        int hour_value = digit_values[8] * 10 + digit_values[9];
+        int minute_value = digit_values[10] * 10 + digit_values[11];
+        if (hour_value > 23 || minute_value > 59) {
+            return false;
+        }
+        minute_of_day = hour_value * 60 + minute_value;
+        utc_time = value_length >= 16 && value_text[15] == 'Z';
+    }
+    return true;
+}
+
+// Function parses an RFC 5545 DURATION value (for example P1D, PT1H30M, P2W) into minutes
+bool parse_icalendar_duration_minutes(const char* value_text, size_t value_length, long long& duration_minutes) {
+    size_t character_index = 0;
+    bool negative_duration = false;
+    if (character_index < value_length && (value_text[character_index] == '+' || value_text[character_index] == '-')) {
+        negative_duration = value_text[character_index++] == '-';
+    }
+    if (character_index >= value_length || value_text[character_index++] != 'P') {
+        return false;
+    }
+    duration_minutes = 0;
+    long long component_value = 0;
+    bool component_digits_present = false;
+    for (; character_index < value_length; character_index++) {
+        char current_character = value_text[character_index];
+        if (current_character >= '0' && current_character <= '9') {
+            component_value = component_value * 10 + (current_character - '0');
+            component_digits_present = true;
+            continue;
+        }
+        if (current_character == 'T') {
+            continue; // Time designator separates date and time components
+        }
+        if (!component_digits_present) {
+            return false;
+        }
+        switch (current_character) {
+            case 'W': duration_minutes += component_value * 7 * 1440; break;
+            case 'D': duration_minutes += component_value * 1440; break;
+            case 'H': duration_minutes += component_value * 60; break;
+            case 'M': duration_minutes += component_value; break;
+            case 'S': duration_minutes += component_value / 60; break;
+            default: return false;
+        }
+        component_value = 0;
+        component_digits_present = false;
+    }
+    if (negative_duration) {
+        duration_minutes = -duration_minutes;
+    }
+    return true;
+}
+
+// Function removes RFC 5545 TEXT escapes (\\n, \\, \; and \\\\)
+string unescape_icalendar_text(const char* value_text, size_t value_length) {
+    string unescaped_text;
+    unescaped_text.reserve(value_length);
+    for (size_t character_index = 0; character_index < value_length; character_index++) {
+        if (value_text[character_index] == '\\' && character_index + 1 < value_length) {
+            char escaped_character = value_text[++character_index];
+            unescaped_text += (escaped_character == 'n' || escaped_character == 'N') ? '\n' : escaped_character;
+        } else {
+            unescaped_text += value_text[character_index];
+        }
+    }
+    return unescaped_text;
+}
+
+/*
+================================================================================
+ICALENDAR STREAMING PARSER FUNCTION
+================================================================================
+*/
+
+// Function compares a property name case-insensitively against an upper-case literal
+bool match_icalendar_name(const char* name_text, size_t name_length, const char* expected_name) {
+    size_t expected_length = strlen(expected_name);
+    if (name_length != expected_length) {
+        return false;
+    }
+    for (size_t character_index = 0; character_index < name_length; character_index++) {
+        char current_character = name_text[character_index];
+        if (current_character >= 'a' && current_character <= 'z') {
+            current_character = char(current_character - 'a' + 'A');
+        }
+        if (current_character != expected_name[character_index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void parse_icalendar_event_range(const char* range_begin, const char* range_end,
+                                 vector<icalendar_event_record>& parsed_events,
+                                 icalendar_import_statistics& import_statistics) {
+    string unfolded_line;                 // Scratch buffer used only for folded lines
+    icalendar_event_record current_event;
+    bool inside_event = false;
+    bool start_present = false;
+    bool end_present = false;
+    long long duration_minutes = 0;
+    bool duration_present = false;
+    int nested_component_depth = 0;       // VALARM and other components inside VEVENT
+    
+    const char* line_begin = range_begin;
+    while (line_begin < range_end) {
+        // Locate the physical line end, then extend across folded continuation lines
+        const char* line_end = (const char*)memchr(line_begin, '\n', size_t(range_end - line_begin));
+        if (line_end == NULL) {
+            line_end = range_end;
+        }
+        const char* next_line_begin = line_end < range_end ? line_end + 1 : range_end;
+        const char* logical_text = line_begin;
+        size_t logical_length = size_t(line_end - line_begin);
+        if (logical_length > 0 && logical_text[logical_length - 1] == '\r') {
+            logical_length--;
+        }
+        if (next_line_begin < range_end && (*next_line_begin == ' ' || *next_line_begin == '\t')) {
+            unfolded_line.assign(logical_text, logical_length);
+            while (next_line_begin < range_end && (*next_line_begin == ' ' || *next_line_begin == '\t')) {
+                const char* continuation_end = (const char*)memchr(next_line_begin, '\n', size_t(range_end - next_line_begin));
+                if (continuation_end == NULL) {
+                    continuation_end = range_end;
+                }
+                size_t continuation_length = size_t(continuation_end - next_line_begin) - 1; // Drop the fold space
+                if (continuation_length > 0 && next_line_begin[continuation_length] == '\r') {
+                    continuation_length--;
+                }
+                unfolded_line.append(next_line_begin + 1, continuation_length);
+                next_line_begin = continuation_end < range_end ? continuation_end + 1 : range_end;
+            }
+            logical_text = unfolded_line.data();
+            logical_length = unfolded_line.size();
+            import_statistics.unfolded_line_count++;
+        }
+        line_begin = next_line_begin;
+        
+        // Split "NAME;PARAM=VALUE;...:VALUE", honouring quoted parameter values
+        size_t name_length = 0;
+        while (name_length < logical_length && logical_text[name_length] != ';' && logical_text[name_length] != ':') {
+            name_length++;
+        }
+        size_t value_offset = name_length;
+        bool inside_quotes = false;
+        while (value_offset < logical_length && (inside_quotes || logical_text[value_offset] != ':')) {
+            if (logical_text[value_offset] == '"') {
+                inside_quotes = !inside_quotes;
+            }
+            value_offset++;
+        }
+        if (value_offset >= logical_length) {
+            continue; // Not a content line
+        }
+        const char* parameter_text = logical_text + name_length;
+        size_t parameter_length = value_offset - name_length;
+        const char* value_text = logical_text + value_offset + 1;
+        size_t value_length = logical_length - value_offset - 1;
+        
+        // Component boundaries
+        if (match_icalendar_name(logical_text, name_length, "BEGIN")) {
+            if (!inside_event && match_icalendar_name(value_text, value_length, "VEVENT")) {
+                inside_event = true;
+                current_event = icalendar_event_record();
+                start_present = false;
+                end_present = false;
+                duration_present = false;
+                nested_component_depth = 0;
+            } else if (inside_event) {
+                nested_component_depth++;
+            }
+            continue;
+        }
+        if (match_icalendar_name(logical_text, name_length, "END")) {
+            if (inside_event && nested_component_depth > 0) {
+                nested_component_depth--;
+            } else if (inside_event && match_icalendar_name(value_text, value_length, "VEVENT")) {
+                inside_event = false;
+                if (!start_present) {
+                    import_statistics.rejected_event_count++;
+                    continue;
+                }
+                // Derive the end from DURATION, or default to the start (next day for all-day events)
+                if (!end_present) {
+                    long long start_total_minutes = (long long)current_event.start_serial_day * 1440 +
+                                                    max(current_event.start_minute, 0);
+                    long long end_total_minutes = start_total_minutes +
+                        (duration_present ? duration_minutes : (current_event.start_minute < 0 ? 1440 : 0));
+                    current_event.end_serial_day = int(end_total_minutes / 1440);
+                    current_event.end_minute = current_event.start_minute < 0 ? -1 : int(end_total_minutes % 1440);
+                }
+                import_statistics.parsed_event_count++;
+                import_statistics.recurring_event_count += current_event.recurrence_rule.empty() ? 0 : 1;
+                import_statistics.zoned_event_count += current_event.time_zone_identifier.empty() ? 0 : 1;
+                import_statistics.all_day_event_count += current_event.start_minute < 0 ? 1 : 0;
+                parsed_events.push_back(current_event);
+            }
+            continue;
+        }
+        if (!inside_event || nested_component_depth > 0) {
+            continue; // Properties outside VEVENT or inside nested components are ignored
+        }
+        
+        // VEVENT properties used by the calendar overlay
+        if (match_icalendar_name(logical_text, name_length, "DTSTART")) {
+            start_present = parse_icalendar_date_time(value_text, value_length, current_event.start_serial_day,
+                                                      current_event.start_minute, current_event.utc_time);
+            
+            // Extract the TZID parameter when present
+            for (size_t parameter_index = 0; parameter_index + 6 <= parameter_length; parameter_index++) {
+                if (parameter_text[parameter_index] == ';' &&
+                    match_icalendar_name(parameter_text + parameter_index + 1, 4, "TZID") &&
+                    parameter_text[parameter_index + 5] == '=') {
+                    size_t identifier_begin = parameter_index + 6;
+                    size_t identifier_end = identifier_begin;
+                    while (identifier_end < parameter_length && parameter_text[identifier_end] != ';') {
+                        identifier_end++;
+                    }
+                    if (identifier_end > identifier_begin && parameter_text[identifier_begin] == '"') {
+                        identifier_begin++;
+                        identifier_end -= parameter_text[identifier_end - 1] == '"' ? 1 : 0;
+                    }
+                    current_event.time_zone_identifier.assign(parameter_text + identifier_begin,
+                                                              identifier_end - identifier_begin);
+                    break;
+                }
+            }
+        } else if (match_icalendar_name(logical_text, name_length, "DTEND")) {
+            bool end_utc_time = false;
+            end_present = parse_icalendar_date_time(value_text, value_length, current_event.end_serial_day,
+                                                    current_event.end_minute, end_utc_time);
+        } else if (match_icalendar_name(logical_text, name_length, "DURATION")) {
+            duration_present = parse_icalendar_duration_minutes(value_text, value_length, duration_minutes);
+        } else if (match_icalendar_name(logical_text, name_length, "RRULE")) {
+            current_event.recurrence_rule.assign(value_text, value_length);
+        } else if (match_icalendar_name(logical_text, name_length, "SUMMARY")) {
+            current_event.summary_text = unescape_icalendar_text(value_text, value_length);
+        }
+    }
+}
+
+/*
+================================================================================
+ICALENDAR IMPORT DRIVER FUNCTION
+================================================================================
+*/
+
+// Function advances a split position to the start of the next BEGIN:VEVENT line
+const char* find_next_icalendar_event_boundary(const char* search_begin, const char* data_begin, const char* data_end) {
+    const char event_marker[] = "BEGIN:VEVENT";
+    const size_t marker_length = sizeof(event_marker) - 1;
+    for (const char* candidate = search_begin; candidate + marker_length <= data_end; candidate++) {
+        candidate = (const char*)memchr(candidate, 'B', size_t(data_end - candidate));
+        if (candidate == NULL || candidate + marker_length > data_end) {
+            break;
+        }
+        if ((candidate == data_begin || candidate[-1] == '\n') && memcmp(candidate, event_marker, marker_length) == 0) {
+            return candidate;
+        }
+    }
+    return data_end;
+}
+
+int execute_icalendar_import(const string& ics_file_path, int thread_count, const string& event_store_directory) {
+    chrono::steady_clock::time_point import_start_time = chrono::steady_clock::now();
+    mapped_file_region ics_region;
+    if (!map_file_read_only(ics_file_path, ics_region)) {
+        cout << "ERROR: Unable to map iCalendar file: " << ics_file_path << endl;
+        return 1;
+    }
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    
+    // Split the input into byte ranges that each begin on a BEGIN:VEVENT line
+    const char* data_begin = ics_region.mapped_data;
+    const char* data_end = data_begin + ics_region.mapped_size;
+    vector<const char*> range_boundaries(1, data_begin);
+    for (int range_index = 1; range_index < thread_count; range_index++) {
+        const char* proposed_split = data_begin + ics_region.mapped_size * size_t(range_index) / size_t(thread_count);
+        const char* aligned_split = find_next_icalendar_event_boundary(max(proposed_split, range_boundaries.back()),
+                                                                       data_begin, data_end);
+        range_boundaries.push_back(aligned_split);
+    }
+    range_boundaries.push_back(data_end);
+    
+    // Parse each range on its own thread into private result vectors
+    size_t range_count = range_boundaries.size() - 1;
+    vector<vector<icalendar_event_record> > range_events(range_count);
+    vector<icalendar_import_statistics> range_statistics(range_count);
+    vector<thread> worker_threads;
+    for (size_t range_index = 0; range_index < range_count; range_index++) {
+        memset(&range_statistics[range_index], 0, sizeof(icalendar_import_statistics));
+        worker_threads.push_back(thread([&, range_index]() {
+            parse_icalendar_event_range(range_boundaries[range_index], range_boundaries[range_index + 1],
+                                        range_events[range_index], range_statistics[range_index]);
+        }));
+    }
+    for (size_t range_index = 0; range_index < worker_threads.size(); range_index++) {
+        worker_threads[range_index].join();
+    }
+    double parse_seconds = chrono::duration<double>(chrono::steady_clock::now() - import_start_time).count();
+    size_t mapped_byte_count = ics_region.mapped_size;
+    unmap_file_region(ics_region);
+    
+    // Combine per-range results in file order
+    icalendar_import_statistics total_statistics;
+    memset(&total_statistics, 0, sizeof(total_statistics));
+    vector<icalendar_event_record> imported_events;
+    for (size_t range_index = 0; range_index < range_count; range_index++) {
+        total_statistics.parsed_event_count += range_statistics[range_index].parsed_event_count;
+        total_statistics.rejected_event_count += range_statistics[range_index].rejected_event_count;
+        total_statistics.recurring_event_count += range_statistics[range_index].recurring_event_count;
+        total_statistics.zoned_event_count += range_statistics[range_index].zoned_event_count;
+        total_statistics.all_day_event_count += range_statistics[range_index].all_day_event_count;
+        total_statistics.unfolded_line_count += range_statistics[range_index].unfolded_line_count;
+        if (imported_events.empty()) {
+            imported_events.swap(range_events[range_index]);
+        } else {
+            imported_events.insert(imported_events.end(), range_events[range_index].begin(), range_events[range_index].end());
+        }
+    }
+    
+    // Display import report
+    cout << "ICALENDAR IMPORT REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Input File: " << ics_file_path << " (" << mapped_byte_count << " bytes)" << endl;
+    cout << "Worker Threads: " << range_count << endl;
+    cout << "Events Parsed: " << total_statistics.parsed_event_count << endl;
+    cout << "Events Rejected: " << total_statistics.rejected_event_count << endl;
+    cout << "Recurring (RRULE): " << total_statistics.recurring_event_count << endl;
+    cout << "Zoned (TZID): " << total_statistics.zoned_event_count << endl;
+    cout << "All-Day: " << total_statistics.all_day_event_count << endl;
+    cout << "Folded Lines: " << total_statistics.unfolded_line_count << endl;
+    cout << "Parse Time: " << fixed << setprecision(3) << parse_seconds * 1000.0 << " ms" << endl;
+    cout << "Throughput: " << setprecision(0)
+         << (parse_seconds > 0.0 ? double(total_statistics.parsed_event_count) / parse_seconds : 0.0) << " events/s, "
+         << setprecision(1) << (parse_seconds > 0.0 ? double(mapped_byte_count) / parse_seconds / 1e6 : 0.0) << " MB/s" << endl;
+    if (!imported_events.empty()) {
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        convert_serial_day_to_calendar_date(imported_events[0].start_serial_day, day_value, month_value, year_value);
+        cout << "First Event: " << year_value << "-" << setfill('0') << setw(2) << month_value << "-" << setw(2)
+             << day_value << setfill(' ') << " " << imported_events[0].summary_text << endl;
+    }
+    
+    // Optionally overlay the imported events onto a durable event store
+    if (!event_store_directory.empty()) {
+        calendar_event_store event_store;
+        if (!open_calendar_event_store(event_store, event_store_directory)) {
+            return 1;
+        }
+        event_store.synchronize_each_append = false;
+        vector<calendar_event_record> store_events(imported_events.size());
+        for (size_t event_index = 0; event_index < imported_events.size(); event_index++) {
+            const icalendar_event_record& imported_event = imported_events[event_index];
+            calendar_event_record& store_event = store_events[event_index];
+            memset(&store_event, 0, sizeof(store_event));
+            store_event.serial_day = imported_event.start_serial_day;
+            store_event.start_minute = uint16_t(max(imported_event.start_minute, 0));
+            long long duration_minutes = ((long long)imported_event.end_serial_day * 1440 + max(imported_event.end_minute, 0)) -
+                                         ((long long)imported_event.start_serial_day * 1440 + max(imported_event.start_minute, 0));
+            store_event.duration_minutes = uint16_t(min(max(duration_minutes, 0LL), 65535LL));
+            strncpy(store_event.event_title, imported_event.summary_text.c_str(), sizeof(store_event.event_title) - 1);
+        }
+        bool append_succeeded = append_calendar_events(event_store, store_events) &&
+                                flush_file_to_stable_storage(event_store.log_file);
+        close_calendar_event_store(event_store);
+        if (!append_succeeded) {
+            cout << "ERROR: Unable to store imported events in " << event_store_directory << endl;
+            return 1;
+        }
+        cout << "Stored Events: " << store_events.size() << " in " << event_store_directory << endl;
+    }
+    return 0;
+}
+
+/*
+================================================================================
+HOLIDAY RULE FUNCTIONS
+================================================================================
+*/
+
+int calculate_nth_weekday_serial_day(int occurrence_number, int weekday_index, int month_value, int year_value) {
+    if (occurrence_number < 0) {
+        // Walk back from the final day of the month to the requested weekday
+        int last_serial_day = calculate_serial_day_number(calculate_month_day_count(month_value, year_value),
+                                                          month_value, year_value);
+        return last_serial_day - ((last_serial_day % 7 - weekday_index + 7) % 7);
+    }
+    int first_serial_day = calculate_serial_day_number(1, month_value, year_value);
+    return first_serial_day + (weekday_index - first_serial_day % 7 + 7) % 7 + 7 * (occurrence_number - 1);
+}
+
+int calculate_easter_sunday_serial_day(int year_value) {
+    // Anonymous Gregorian computus (Meeus/Jones/Butcher)
+    int golden_number = year_value % 19;
+    int century_value = year_value / 100;
+    int century_year = year_value % 100;
+    int epact_term = (19 * golden_number + century_value - century_value / 4 -
+                      (century_value - (century_value + 8) / 25 + 1) / 3 + 15) % 30;
+    int weekday_term = (32 + 2 * (century_value % 4) + 2 * (century_year / 4) - epact_term - century_year % 4) % 7;
+    int correction_term = (golden_number + 11 * epact_term + 22 * weekday_term) / 451;
+    int month_value = (epact_term + weekday_term - 7 * correction_term + 114) / 31;
+    int day_value = (epact_term + weekday_term - 7 * correction_term + 114) % 31 + 1;
+    return calculate_serial_day_number(day_value, month_value, year_value);
+}
+
+// Short region names accepted by --holidays, indexed by holiday_region_code
+const char* const holiday_region_names[HOLIDAY_REGION_COUNT] = {"US", "GB", "DE"};
+
+bool parse_holiday_region_list(const string& region_list_text, vector<int>& region_codes) {
+    istringstream regions_stream(region_list_text);
+    string region_name;
+    while (getline(regions_stream, region_name, ',')) {
+        int region_code = int(find(holiday_region_names, holiday_region_names + HOLIDAY_REGION_COUNT, region_name) -
+                              holiday_region_names);
+        if (region_code == HOLIDAY_REGION_COUNT) {
+            cout << "ERROR: Unknown holiday region: " << region_name << " (use US, GB or DE)" << endl;
+            return false;
+        }
+        region_codes.push_back(region_code);
+    }
+    return true;
+}
+
+int generate_region_holiday_serial_days(int region_code, int year_value, int holiday_serial_days[12]) {
+    // Current rules are applied to every year without historical start dates or
+    // weekend substitution days.
+    int holiday_count = 0;
+    int easter_serial_day = calculate_easter_sunday_serial_day(year_value);
+    holiday_serial_days[holiday_count++] = calculate_serial_day_number(1, 1, year_value);
+    holiday_serial_days[holiday_count++] = calculate_serial_day_number(25, 12, year_value);
+    if (region_code == HOLIDAY_REGION_UNITED_STATES) {
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(3, 1, 1, year_value);  // Martin Luther King Jr. Day
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(3, 1, 2, year_value);  // Washington's Birthday
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(-1, 1, 5, year_value); // Memorial Day
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(19, 6, year_value);         // Juneteenth
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(4, 7, year_value);          // Independence Day
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(1, 1, 9, year_value);  // Labor Day
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(2, 1, 10, year_value); // Columbus Day
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(11, 11, year_value);        // Veterans Day
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(4, 4, 11, year_value); // Thanksgiving
+    } else if (region_code == HOLIDAY_REGION_GREAT_BRITAIN) {
+        holiday_serial_days[holiday_count++] = easter_serial_day - 2;                                  // Good Friday
+        holiday_serial_days[holiday_count++] = easter_serial_day + 1;                                  // Easter Monday
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(1, 1, 5, year_value);  // Early May bank holiday
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(-1, 1, 5, year_value); // Spring bank holiday
+        holiday_serial_days[holiday_count++] = calculate_nth_weekday_serial_day(-1, 1, 8, year_value); // Summer bank holiday
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(26, 12, year_value);        // Boxing Day
+    } else if (region_code == HOLIDAY_REGION_GERMANY) {
+        holiday_serial_days[holiday_count++] = easter_serial_day - 2;                                  // Karfreitag
+        holiday_serial_days[holiday_count++] = easter_serial_day + 1;                                  // Ostermontag
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(1, 5, year_value);          // Tag der Arbeit
+        holiday_serial_days[holiday_count++] = easter_serial_day + 39;                                 // Christi Himmelfahrt
+        holiday_serial_days[holiday_count++] = easter_serial_day + 50;                                 // Pfingstmontag
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(3, 10, year_value);         // Tag der Deutschen Einheit
+        holiday_serial_days[holiday_count++] = calculate_serial_day_number(26, 12, year_value);        // Zweiter Weihnachtstag
+    }
+    return holiday_count;
+}
+
+vector<uint8_t> build_holiday_day_table(const vector<int>& region_codes, int first_year, int last_year) {
+    // One byte per serial day across years 1-9999; bit n marks a holiday of region n
+    vector<uint8_t> holiday_table(size_t(calculate_serial_day_number(31, 12, 9999)) + 1, 0);
+    first_year = max(first_year, 1);
+    last_year = min(last_year, 9999);
+    for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+        int region_code = region_codes[region_index];
+        uint8_t region_bit = uint8_t(1 << region_code);
+        for (int year_value = first_year; year_value <= last_year; year_value++) {
+            int holiday_serial_days[12];
+            int holiday_count = generate_region_holiday_serial_days(region_code, year_value, holiday_serial_days);
+            for (int holiday_index = 0; holiday_index < holiday_count; holiday_index++) {
+                holiday_table[size_t(holiday_serial_days[holiday_index])] |= region_bit;
+            }
+        }
+    }
+    return holiday_table;
+}
+
+void calculate_iso_week_date(int day_value, int month_value, int year_value, int& iso_week, int& iso_year) {
+    // The ISO week belongs to the year containing its Thursday
+    int serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+    int day_of_year = serial_day - calculate_serial_day_number(1, 1, year_value) + 1;
+    int iso_weekday = (serial_day + 6) % 7 + 1; // Monday = 1
+    int thursday_day_of_year = day_of_year + 4 - iso_weekday;
+    iso_year = year_value;
+    if (thursday_day_of_year < 1) {
+        iso_year = year_value - 1;
+        thursday_day_of_year += calculate_leap_year_status(iso_year) ? 366 : 365;
+    } else if (thursday_day_of_year > (calculate_leap_year_status(year_value) ? 366 : 365)) {
+        thursday_day_of_year -= calculate_leap_year_status(year_value) ? 366 : 365;
+        iso_year = year_value + 1;
+    }
+    iso_week = (thursday_day_of_year - 1) / 7 + 1;
+}
+
+/*
+================================================================================
+CSV DATE ENRICHMENT FUNCTIONS
+================================================================================
+*/
+
+// Function locates a delimited field in one CSV row, skipping delimiters inside quotes
+bool locate_csv_field(const char* row_begin, const char* row_end, int field_index, char field_delimiter,
+                      const char*& field_begin, const char*& field_end) {
+    const char* scan_position = row_begin;
+    for (int current_field = 0; ; current_field++) {
+        const char* current_begin = scan_position;
+        bool inside_quotes = false;
+        while (scan_position < row_end && (inside_quotes || *scan_position != field_delimiter)) {
+            if (*scan_position == '"') {
+                inside_quotes = !inside_quotes;
+            }
+            scan_position++;
+        }
+        if (current_field == field_index) {
+            field_begin = current_begin;
+            field_end = scan_position;
+            if (field_end - field_begin >= 2 && *field_begin == '"' && field_end[-1] == '"') {
+                field_begin++;
+                field_end--;
+            }
+            return true;
+        }
+        if (scan_position >= row_end) {
+            return false;
+        }
+        scan_position++; // Step over the delimiter
+    }
+}
+
+// Function writes a zero-padded decimal value into a character buffer
+inline char* write_padded_decimal(char* output_position, int numeric_value, int digit_count) {
+    for (int digit_index = digit_count - 1; digit_index >= 0; digit_index--) {
+        output_position[digit_index] = char('0' + numeric_value % 10);
+        numeric_value /= 10;
+    }
+    return output_position + digit_count;
+}
+
+// Function enriches every row of one chunk, reusing the suffix of runs of equal dates
+void enrich_csv_chunk(csv_enrichment_chunk& enrichment_chunk, int date_field_index, char field_delimiter,
+                      const vector<uint8_t>& holiday_table, const vector<int>& region_codes, bool skip_first_row) {
+    static const char* const weekday_labels[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    string& output_text = enrichment_chunk.enriched_output;
+    output_text.reserve(size_t(enrichment_chunk.chunk_end - enrichment_chunk.chunk_begin) * 3 / 2);
+    
+    char suffix_buffer[64];
+    size_t suffix_length = 0;
+    int previous_serial_day = -1;
+    
+    const char* row_begin = enrichment_chunk.chunk_begin;
+    while (row_begin < enrichment_chunk.chunk_end) {
+        const char* line_end = (const char*)memchr(row_begin, '\n', size_t(enrichment_chunk.chunk_end - row_begin));
+        if (line_end == NULL) {
+            line_end = enrichment_chunk.chunk_end; // Final row without a trailing newline
+        }
+        const char* row_end = (line_end > row_begin && line_end[-1] == '\r') ? line_end - 1 : line_end;
+        const char* next_row_begin = line_end < enrichment_chunk.chunk_end ? line_end + 1 : line_end;
+        
+        if (skip_first_row) {
+            // Header row is copied through by the caller
+            skip_first_row = false;
+            row_begin = next_row_begin;
+            continue;
+        }
+        
+        const char* field_begin = NULL;
+        const char* field_end = NULL;
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        if (locate_csv_field(row_begin, row_end, date_field_index, field_delimiter, field_begin, field_end) &&
+            parse_iso_calendar_date(field_begin, size_t(field_end - field_begin), day_value, month_value, year_value)) {
+            int serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+            if (serial_day != previous_serial_day) {
+                int iso_week = 0;
+                int iso_year = 0;
+                calculate_iso_week_date(day_value, month_value, year_value, iso_week, iso_year);
+                int weekday_index = serial_day % 7;
+                char* output_position = suffix_buffer;
+                *output_position++ = field_delimiter;
+                memcpy(output_position, weekday_labels[weekday_index], 3);
+                output_position += 3;
+                *output_position++ = field_delimiter;
+                output_position = write_padded_decimal(output_position, iso_year, 4);
+                *output_position++ = '-';
+                *output_position++ = 'W';
+                output_position = write_padded_decimal(output_position, iso_week, 2);
+                *output_position++ = field_delimiter;
+                output_position = write_padded_decimal(output_position,
+                                                       serial_day - calculate_serial_day_number(1, 1, year_value) + 1, 3);
+                *output_position++ = field_delimiter;
+                *output_position++ = 'Q';
+                *output_position++ = char('1' + (month_value - 1) / 3);
+                *output_position++ = field_delimiter;
+                *output_position++ = (weekday_index == 0 || weekday_index == 6) ? '1' : '0';
+                for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+                    *output_position++ = field_delimiter;
+                    *output_position++ = (holiday_table[size_t(serial_day)] >> region_codes[region_index]) & 1 ? '1' : '0';
+                }
+                suffix_length = size_t(output_position - suffix_buffer);
+                previous_serial_day = serial_day;
+            }
+            output_text.append(row_begin, size_t(row_end - row_begin));
+            output_text.append(suffix_buffer, suffix_length);
+        } else {
+            // Unparseable dates keep the column count with empty attribute fields
+            output_text.append(row_begin, size_t(row_end - row_begin));
+            output_text.append(5 + region_codes.size(), field_delimiter);
+            enrichment_chunk.invalid_date_count++;
+        }
+        output_text.append(row_end, size_t(next_row_begin - row_end)); // Preserve the original line ending
+        enrichment_chunk.row_count++;
+        row_begin = next_row_begin;
+    }
+}
+
+int execute_csv_date_enrichment(int argument_count, char* argument_values[], const string& input_file_path) {
+    chrono::steady_clock::time_point enrichment_start_time = chrono::steady_clock::now();
+    string output_file_path = find_command_line_option_value(argument_count, argument_values, "--enrich-output", "");
+    string date_column_text = find_command_line_option_value(argument_count, argument_values, "--date-column", "1");
+    string holiday_regions_text = find_command_line_option_value(argument_count, argument_values, "--holidays", "");
+    string delimiter_text = find_command_line_option_value(argument_count, argument_values, "--delimiter", ",");
+    int thread_count = find_command_line_integer_option(argument_count, argument_values, "--threads", 0);
+    char field_delimiter = delimiter_text == "tab" ? '\t' : delimiter_text[0];
+    if (output_file_path.empty()) {
+        cout << "ERROR: --enrich-output <file> is required" << endl;
+        return 1;
+    }
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    
+    // Resolve holiday regions from a comma-separated list
+    vector<int> region_codes;
+    if (!parse_holiday_region_list(holiday_regions_text, region_codes)) {
+        return 1;
+    }
+    vector<uint8_t> holiday_table;
+    if (!region_codes.empty()) {
+        holiday_table = build_holiday_day_table(region_codes);
+    }
+    
+    mapped_file_region input_region;
+    if (!map_file_read_only(input_file_path, input_region)) {
+        cout << "ERROR: Unable to map CSV file: " << input_file_path << endl;
+        return 1;
+    }
+    const char* data_begin = input_region.mapped_data;
+    const char* data_end = data_begin + input_region.mapped_size;
+    
+    // Resolve the date column by 1-based position or by header name, and detect a header row
+    const char* first_line_end = (const char*)memchr(data_begin, '\n', input_region.mapped_size);
+    first_line_end = first_line_end == NULL ? data_end : first_line_end;
+    const char* first_row_end = (first_line_end > data_begin && first_line_end[-1] == '\r') ? first_line_end - 1 : first_line_end;
+    int date_field_index = atoi(date_column_text.c_str()) - 1;
+    if (date_field_index < 0) {
+        for (int field_index = 0; ; field_index++) {
+            const char* field_begin = NULL;
+            const char* field_end = NULL;
+            if (!locate_csv_field(data_begin, first_row_end, field_index, field_delimiter, field_begin, field_end)) {
+                break;
+            }
+            if (string(field_begin, field_end) == date_column_text) {
+                date_field_index = field_index;
+                break;
+            }
+        }
+        if (date_field_index < 0) {
+            cout << "ERROR: Date column not found in header: " << date_column_text << endl;
+            unmap_file_region(input_region);
+            return 1;
+        }
+    }
+    bool header_row_present = false;
+    {
+        const char* field_begin = NULL;
+        const char* field_end = NULL;
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        header_row_present = data_begin < data_end &&
+            !(locate_csv_field(data_begin, first_row_end, date_field_index, field_delimiter, field_begin, field_end) &&
+              parse_iso_calendar_date(field_begin, size_t(field_end - field_begin), day_value, month_value, year_value));
+    }
+    
+    // Split the mapping into newline-aligned chunks, several per worker for load balance
+    const size_t target_chunk_bytes = size_t(8) << 20;
+    vector<csv_enrichment_chunk> enrichment_chunks;
+    for (const char* chunk_begin = data_begin; chunk_begin < data_end; ) {
+        const char* chunk_end = chunk_begin + min(target_chunk_bytes, size_t(data_end - chunk_begin));
+        if (chunk_end < data_end) {
+            const char* newline_position = (const char*)memchr(chunk_end, '\n', size_t(data_end - chunk_end));
+            chunk_end = newline_position == NULL ? data_end : newline_position + 1;
+        }
+        csv_enrichment_chunk enrichment_chunk;
+        enrichment_chunk.chunk_begin = chunk_begin;
+        enrichment_chunk.chunk_end = chunk_end;
+        enrichment_chunk.row_count = 0;
+        enrichment_chunk.invalid_date_count = 0;
+        enrichment_chunk.output_ready = false;
+        enrichment_chunks.push_back(enrichment_chunk);
+        chunk_begin = chunk_end;
+    }
+    
+    FILE* output_file = fopen(output_file_path.c_str(), "wb");
+    if (output_file == NULL) {
+        cout << "ERROR: Unable to create enrichment output: " << output_file_path << endl;
+        unmap_file_region(input_region);
+        return 1;
+    }
+    
+    // Header row gains the attribute column names
+    if (header_row_present) {
+        string header_text(data_begin, first_row_end);
+        const char* const attribute_names[] = {"weekday", "iso_week", "day_of_year", "quarter", "weekend"};
+        for (int attribute_index = 0; attribute_index < 5; attribute_index++) {
+            header_text += field_delimiter;
+            header_text += attribute_names[attribute_index];
+        }
+        for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+            header_text += field_delimiter;
+            header_text += string("holiday_") + holiday_region_names[region_codes[region_index]];
+        }
+        header_text.append(first_row_end, size_t(min(first_line_end + 1, data_end) - first_row_end));
+        fwrite(header_text.data(), 1, header_text.size(), output_file);
+    }
+    
+    // Workers claim chunks in order but may run at most a bounded window ahead of the writer
+    const size_t chunk_window = size_t(thread_count) * 2;
+    atomic<size_t> next_chunk_index(0);
+    size_t written_chunk_count = 0;
+    mutex chunk_mutex;
+    condition_variable chunk_condition;
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            for (size_t chunk_index = next_chunk_index++; chunk_index < enrichment_chunks.size();
+                 chunk_index = next_chunk_index++) {
+                {
+                    unique_lock<mutex> chunk_lock(chunk_mutex);
+                    chunk_condition.wait(chunk_lock, [&]() { return chunk_index < written_chunk_count + chunk_window; });
+                }
+                enrich_csv_chunk(enrichment_chunks[chunk_index], date_field_index, field_delimiter, holiday_table,
+                                 region_codes, chunk_index == 0 && header_row_present);
+                lock_guard<mutex> chunk_lock(chunk_mutex);
+                enrichment_chunks[chunk_index].output_ready = true;
+                chunk_condition.notify_all();
+            }
+        }));
+    }
+    
+    // The calling thread writes completed chunks strictly in input order
+    bool write_failure_detected = false;
+    size_t total_row_count = 0; // Data rows only; chunks never count the header row
+    size_t total_invalid_count = 0;
+    unsigned long long written_byte_count = 0;
+    for (size_t chunk_index = 0; chunk_index < enrichment_chunks.size(); chunk_index++) {
+        {
+            unique_lock<mutex> chunk_lock(chunk_mutex);
+            chunk_condition.wait(chunk_lock, [&]() { return enrichment_chunks[chunk_index].output_ready; });
+        }
+        csv_enrichment_chunk& enrichment_chunk = enrichment_chunks[chunk_index];
+        if (fwrite(enrichment_chunk.enriched_output.data(), 1, enrichment_chunk.enriched_output.size(), output_file) !=
+            enrichment_chunk.enriched_output.size()) {
+            write_failure_detected = true;
+        }
+        written_byte_count += enrichment_chunk.enriched_output.size();
+        total_row_count += enrichment_chunk.row_count;
+        total_invalid_count += enrichment_chunk.invalid_date_count;
+        string().swap(enrichment_chunk.enriched_output); // Release the chunk buffer immediately
+        
+        lock_guard<mutex> chunk_lock(chunk_mutex);
+        written_chunk_count = chunk_index + 1;
+        chunk_condition.notify_all();
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    write_failure_detected |= fclose(output_file) != 0;
+    size_t input_byte_count = input_region.mapped_size;
+    unmap_file_region(input_region);
+    double enrichment_seconds = chrono::duration<double>(chrono::steady_clock::now() - enrichment_start_time).count();
+    
+    // Display enrichment summary
+    cout << "CSV DATE ENRICHMENT REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Input File: " << input_file_path << " (" << input_byte_count << " bytes)" << endl;
+    cout << "Output File: " << output_file_path << " (" << written_byte_count << " bytes)" << endl;
+    cout << "Date Column: " << date_field_index + 1 << (header_row_present ? " (header row detected)" : "") << endl;
+    cout << "Rows: " << total_row_count << " (" << total_invalid_count << " without a valid date)" << endl;
+    cout << "Chunks: " << enrichment_chunks.size() << " across " << thread_count << " worker threads" << endl;
+    cout << "Elapsed Time: " << fixed << setprecision(3) << enrichment_seconds << " s" << endl;
+    cout << "Throughput: " << setprecision(1)
+         << (enrichment_seconds > 0.0 ? double(input_byte_count) / enrichment_seconds / 1e6 : 0.0) << " MB/s input, "
+         << setprecision(0) << (enrichment_seconds > 0.0 ? double(total_row_count) / enrichment_seconds : 0.0)
+         << " rows/s" << endl;
+    
+    if (write_failure_detected) {
+        cout << "ERROR: Enrichment output could not be written completely" << endl;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+================================================================================
+CALENDAR ARCHIVE SIZE AND SHARD PLANNING FUNCTIONS
+================================================================================
+*/
+
+size_t calculate_monthly_calendar_display_size(int target_month, int target_year) {
+    // Mirrors append_monthly_calendar_display without annotations, byte for byte
+    int month_day_count = calculate_month_day_count(target_month, target_year);
+    int starting_day_position = calculate_month_starting_day(target_month, target_year);
+    size_t month_name_length = convert_month_number_to_text(target_month).size();
+    size_t year_digit_count = to_string(target_year).size();
+    int grid_cell_count = starting_day_position + month_day_count;
+    
+    size_t display_size = 1;                                                  // Leading blank line
+    display_size += max(month_name_length, size_t(20)) + 1 + year_digit_count + 1; // Title line
+    display_size += 29 + 22;                                                  // Rule and weekday header
+    display_size += size_t(grid_cell_count) * 3 + size_t((grid_cell_count + 6) / 7); // Day grid rows
+    display_size += 17;                                                       // "\nMonth Analysis:\n"
+    display_size += 14 + to_string(month_day_count).size() + 1;               // Total Days line
+    display_size += 16 + to_string(starting_day_position).size() + 12;        // Starting Day line
+    display_size += 12 + to_string((month_day_count + starting_day_position + 6) / 7).size() + 1; // Weekends line
+    return display_size;
+}
+
+// Function computes archive byte offsets at every month boundary of a year range
+vector<uint64_t> calculate_archive_month_offsets(int first_year, int last_year) {
+    vector<uint64_t> month_offsets(1, 0);
+    month_offsets.reserve(size_t(last_year - first_year + 1) * 12 + 1);
+    for (int year_value = first_year; year_value <= last_year; year_value++) {
+        for (int month_value = 1; month_value <= 12; month_value++) {
+            month_offsets.push_back(month_offsets.back() + calculate_monthly_calendar_display_size(month_value, year_value));
+        }
+    }
+    return month_offsets;
+}
+
+// Function selects the month boundary nearest to a byte target (ties resolve to the earlier month)
+int locate_archive_shard_boundary(const vector<uint64_t>& month_offsets, uint64_t target_offset) {
+    int boundary_index = int(lower_bound(month_offsets.begin(), month_offsets.end(), target_offset) - month_offsets.begin());
+    if (boundary_index > 0 && target_offset - month_offsets[size_t(boundary_index - 1)] <=
+                              month_offsets[size_t(boundary_index)] - target_offset) {
+        boundary_index--;
+    }
+    return boundary_index;
+}
+
+// Function writes a shard manifest as one "key value" pair per line
+bool write_archive_shard_manifest(const string& manifest_path, const calendar_archive_shard_manifest& shard_manifest) {
+    ostringstream manifest_stream;
+    manifest_stream << "CALENDAR-ARCHIVE-SHARD 1\n"
+                    << "years " << shard_manifest.first_year << " " << shard_manifest.last_year << "\n"
+                    << "shard " << shard_manifest.shard_number << " " << shard_manifest.shard_count << "\n"
+                    << "months " << shard_manifest.first_month_index << " " << shard_manifest.end_month_index << "\n"
+                    << "offset " << shard_manifest.byte_offset << "\n"
+                    << "length " << shard_manifest.byte_length << "\n"
+                    << "total " << shard_manifest.archive_total_bytes << "\n"
+                    << "crc32 " << hex << setw(8) << setfill('0') << shard_manifest.content_checksum << "\n";
+    return write_file_atomically(manifest_path, manifest_stream.str());
+}
+
+// Function reads a shard manifest written by write_archive_shard_manifest
+bool read_archive_shard_manifest(const string& manifest_path, calendar_archive_shard_manifest& shard_manifest) {
+    ifstream manifest_stream(manifest_path.c_str());
+    string signature_text;
+    int format_version = 0;
+    string field_names[7];
+    manifest_stream >> signature_text >> format_version
+                    >> field_names[0] >> shard_manifest.first_year >> shard_manifest.last_year
+                    >> field_names[1] >> shard_manifest.shard_number >> shard_manifest.shard_count
+                    >> field_names[2] >> shard_manifest.first_month_index >> shard_manifest.end_month_index
+                    >> field_names[3] >> shard_manifest.byte_offset
+                    >> field_names[4] >> shard_manifest.byte_length
+                    >> field_names[5] >> shard_manifest.archive_total_bytes
+                    >> field_names[6] >> hex >> shard_manifest.content_checksum;
+    return manifest_stream && signature_text == "CALENDAR-ARCHIVE-SHARD" && format_version == 1 &&
+           field_names[0] == "years" && field_names[1] == "shard" && field_names[2] == "months" &&
+           field_names[3] == "offset" && field_names[4] == "length" && field_names[5] == "total" &&
+           field_names[6] == "crc32";
+}
+
+// Function writes an archive checkpoint through an atomic rename
+bool write_calendar_archive_checkpoint(const string& checkpoint_path, const calendar_archive_checkpoint& archive_checkpoint) {
+    ostringstream checkpoint_stream;
+    checkpoint_stream << "CALENDAR-ARCHIVE-CHECKPOINT 1\n"
+                      << "years " << archive_checkpoint.first_year << " " << archive_checkpoint.last_year << "\n"
+                      << "shard " << archive_checkpoint.shard_number << " " << archive_checkpoint.shard_count << "\n"
+                      << "next_month " << archive_checkpoint.next_month_index << "\n"
+                      << "offset " << archive_checkpoint.output_offset << "\n"
+                      << "statistics " << archive_checkpoint.accumulated_statistics.covered_day_count << " "
+                      << archive_checkpoint.accumulated_statistics.weekend_day_count << " "
+                      << archive_checkpoint.accumulated_statistics.leap_year_count << "\n"
+                      << "crc32 " << hex << setw(8) << setfill('0') << archive_checkpoint.content_checksum << "\n";
+    return write_file_atomically(checkpoint_path, checkpoint_stream.str());
+}
+
+// Function reads an archive checkpoint, returning false when absent or malformed
+bool read_calendar_archive_checkpoint(const string& checkpoint_path, calendar_archive_checkpoint& archive_checkpoint) {
+    ifstream checkpoint_stream(checkpoint_path.c_str());
+    string signature_text;
+    int format_version = 0;
+    string field_names[6];
+    checkpoint_stream >> signature_text >> format_version
+                      >> field_names[0] >> archive_checkpoint.first_year >> archive_checkpoint.last_year
+                      >> field_names[1] >> archive_checkpoint.shard_number >> archive_checkpoint.shard_count
+                      >> field_names[2] >> archive_checkpoint.next_month_index
+                      >> field_names[3] >> archive_checkpoint.output_offset
+                      >> field_names[4] >> archive_checkpoint.accumulated_statistics.covered_day_count
+                      >> archive_checkpoint.accumulated_statistics.weekend_day_count
+                      >> archive_checkpoint.accumulated_statistics.leap_year_count
+                      >> field_names[5] >> hex >> archive_checkpoint.content_checksum;
+    return checkpoint_stream && signature_text == "CALENDAR-ARCHIVE-CHECKPOINT" && format_version == 1 &&
+           field_names[0] == "years" && field_names[1] == "shard" && field_names[2] == "next_month" &&
+           field_names[3] == "offset" && field_names[4] == "statistics" && field_names[5] == "crc32";
+}
+
+/*
+================================================================================
+CALENDAR ARCHIVE GENERATION AND MERGE FUNCTIONS
+================================================================================
+*/
+
+int execute_archive_generation(const string& output_file_path, int first_year, int last_year,
+                               const string& shard_text, int checkpoint_interval_years) {
+    if (first_year < 1 || last_year > 9999 || first_year > last_year) {
+        cout << "ERROR: Archive years must satisfy 1 <= first <= last <= 9999" << endl;
+        return 1;
+    }
+    int shard_number = 1;
+    int shard_count = 1;
+    if (!shard_text.empty() &&
+        (sscanf(shard_text.c_str(), "%d/%d", &shard_number, &shard_count) != 2 ||
+         shard_count < 1 || shard_number < 1 || shard_number > shard_count)) {
+        cout << "ERROR: --shard expects <k/n> with 1 <= k <= n" << endl;
+        return 1;
+    }
+    chrono::steady_clock::time_point generation_start_time = chrono::steady_clock::now();
+    
+    // Every shard derives the same plan from exact month sizes, so no coordination is required
+    vector<uint64_t> month_offsets = calculate_archive_month_offsets(first_year, last_year);
+    uint64_t archive_total_bytes = month_offsets.back();
+    calendar_archive_shard_manifest shard_manifest;
+    shard_manifest.first_year = first_year;
+    shard_manifest.last_year = last_year;
+    shard_manifest.shard_number = shard_number;
+    shard_manifest.shard_count = shard_count;
+    shard_manifest.first_month_index = locate_archive_shard_boundary(
+        month_offsets, archive_total_bytes / uint64_t(shard_count) * uint64_t(shard_number - 1) +
+                       archive_total_bytes % uint64_t(shard_count) * uint64_t(shard_number - 1) / uint64_t(shard_count));
+    shard_manifest.end_month_index = shard_number == shard_count ? int(month_offsets.size() - 1) :
+        locate_archive_shard_boundary(month_offsets, archive_total_bytes / uint64_t(shard_count) * uint64_t(shard_number) +
+                                      archive_total_bytes % uint64_t(shard_count) * uint64_t(shard_number) / uint64_t(shard_count));
+    shard_manifest.byte_offset = month_offsets[size_t(shard_manifest.first_month_index)];
+    shard_manifest.byte_length = month_offsets[size_t(shard_manifest.end_month_index)] - shard_manifest.byte_offset;
+    shard_manifest.archive_total_bytes = archive_total_bytes;
+    shard_manifest.content_checksum = 0;
+    
+    // Resume from a matching checkpoint, discarding output written after it
+    string temporary_path = output_file_path + ".tmp";
+    string checkpoint_path = output_file_path + ".checkpoint";
+    remove((checkpoint_path + ".tmp").c_str()); // Left behind when a run was killed mid-checkpoint
+    calendar_archive_checkpoint archive_checkpoint;
+    bool resume_from_checkpoint = checkpoint_interval_years > 0 &&
+        read_calendar_archive_checkpoint(checkpoint_path, archive_checkpoint) &&
+        archive_checkpoint.first_year == first_year && archive_checkpoint.last_year == last_year &&
+        archive_checkpoint.shard_number == shard_number && archive_checkpoint.shard_count == shard_count &&
+        archive_checkpoint.next_month_index > shard_manifest.first_month_index &&
+        archive_checkpoint.next_month_index <= shard_manifest.end_month_index &&
+        archive_checkpoint.output_offset == month_offsets[size_t(archive_checkpoint.next_month_index)] -
+                                            shard_manifest.byte_offset;
+    
+    // Output shorter than the checkpoint (lost or replaced) restarts the shard rather than zero-filling
+    uint64_t temporary_length = 0;
+    bool short_output_discarded = resume_from_checkpoint &&
+        (!read_file_length(temporary_path, temporary_length) || temporary_length < archive_checkpoint.output_offset);
+    resume_from_checkpoint = resume_from_checkpoint && !short_output_discarded &&
+        truncate_file_to_length(temporary_path, archive_checkpoint.output_offset);
+    if (!resume_from_checkpoint) {
+        archive_checkpoint.first_year = first_year;
+        archive_checkpoint.last_year = last_year;
+        archive_checkpoint.shard_number = shard_number;
+        archive_checkpoint.shard_count = shard_count;
+        archive_checkpoint.next_month_index = shard_manifest.first_month_index;
+        archive_checkpoint.output_offset = 0;
+        archive_checkpoint.content_checksum = 0;
+        memset(&archive_checkpoint.accumulated_statistics, 0, sizeof(archive_checkpoint.accumulated_statistics));
+    }
+    FILE* output_file = fopen(temporary_path.c_str(), resume_from_checkpoint ? "ab" : "wb");
+    if (output_file == NULL) {
+        cout << "ERROR: Unable to create archive output: " << output_file_path << endl;
+        return 1;
+    }
+    
+    int resumed_month_index = archive_checkpoint.next_month_index;
+    uint64_t resumed_output_offset = archive_checkpoint.output_offset;
+    
+    // Render the shard months, flushing the buffer in large blocks and at checkpoint years
+    string archive_buffer;
+    archive_buffer.reserve(size_t(1) << 22);
+    uint64_t written_byte_count = archive_checkpoint.output_offset;
+    shard_manifest.content_checksum = archive_checkpoint.content_checksum;
+    archive_generation_statistics generation_statistics = archive_checkpoint.accumulated_statistics;
+    bool write_failure_detected = false;
+    for (int month_index = archive_checkpoint.next_month_index; month_index < shard_manifest.end_month_index; month_index++) {
+        int month_value = month_index % 12 + 1;
+        int year_value = first_year + month_index / 12;
+        append_monthly_calendar_display(archive_buffer, month_value, year_value);
+        
+        // Accumulate totals for the written month
+        int month_day_count = calculate_month_day_count(month_value, year_value);
+        int starting_day_position = calculate_month_starting_day(month_value, year_value);
+        generation_statistics.covered_day_count += uint64_t(month_day_count);
+        for (int day_offset = 0; day_offset < month_day_count % 7; day_offset++) {
+            int weekday_index = (starting_day_position + day_offset) % 7;
+            generation_statistics.weekend_day_count += (weekday_index == 0 || weekday_index == 6) ? 1 : 0;
+        }
+        generation_statistics.weekend_day_count += uint64_t(month_day_count / 7 * 2);
+        generation_statistics.leap_year_count += (month_value == 2 && month_day_count == 29) ? 1 : 0;
+        
+        bool checkpoint_due = checkpoint_interval_years > 0 && month_value == 12 &&
+                              (year_value - first_year + 1) % checkpoint_interval_years == 0;
+        if (archive_buffer.size() >= (size_t(1) << 22) || month_index + 1 == shard_manifest.end_month_index || checkpoint_due) {
+            shard_manifest.content_checksum = calculate_crc32_checksum(archive_buffer.data(), archive_buffer.size(),
+                                                                       shard_manifest.content_checksum);
+            write_failure_detected |= fwrite(archive_buffer.data(), 1, archive_buffer.size(), output_file) !=
+                                      archive_buffer.size();
+            written_byte_count += archive_buffer.size();
+            archive_buffer.clear();
+        }
+        
+        // Output reaches stable storage before the checkpoint that refers to it
+        if (checkpoint_due && !write_failure_detected && month_index + 1 < shard_manifest.end_month_index) {
+            archive_checkpoint.next_month_index = month_index + 1;
+            archive_checkpoint.output_offset = written_byte_count;
+            archive_checkpoint.content_checksum = shard_manifest.content_checksum;
+            archive_checkpoint.accumulated_statistics = generation_statistics;
+            write_failure_detected |= !flush_file_to_stable_storage(output_file) ||
+                                      !write_calendar_archive_checkpoint(checkpoint_path, archive_checkpoint);
+        }
+    }
+    write_failure_detected |= !flush_file_to_stable_storage(output_file);
+    write_failure_detected |= fclose(output_file) != 0;
+    if (written_byte_count != shard_manifest.byte_length) {
+        cout << "ERROR: Archive size plan disagrees with rendered output (" << written_byte_count << " != "
+             << shard_manifest.byte_length << ")" << endl;
+        return 1;
+    }
+    if (write_failure_detected || !replace_file_atomically(temporary_path, output_file_path) ||
+        !write_archive_shard_manifest(output_file_path + ".manifest", shard_manifest)) {
+        cout << "ERROR: Unable to write archive output: " << output_file_path << endl;
+        return 1;
+    }
+    remove(checkpoint_path.c_str()); // Completed runs leave no checkpoint behind
+    double generation_seconds = chrono::duration<double>(chrono::steady_clock::now() - generation_start_time).count();
+    
+    // Display shard summary
+    cout << "CALENDAR ARCHIVE GENERATION REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Years: " << first_year << "-" << last_year << " (" << archive_total_bytes << " bytes total)" << endl;
+    cout << "Shard: " << shard_number << "/" << shard_count << endl;
+    cout << "Months: " << shard_manifest.end_month_index - shard_manifest.first_month_index << " ("
+         << convert_month_number_to_text(shard_manifest.first_month_index % 12 + 1) << " "
+         << first_year + shard_manifest.first_month_index / 12 << " onward)" << endl;
+    cout << "Byte Range: " << shard_manifest.byte_offset << " + " << shard_manifest.byte_length << endl;
+    if (resume_from_checkpoint) {
+        cout << "Resumed From: " << convert_month_number_to_text(resumed_month_index % 12 + 1) << " "
+             << first_year + resumed_month_index / 12 << " (offset " << resumed_output_offset << ")" << endl;
+    }
+    if (short_output_discarded) {
+        cout << "Checkpoint Discarded: partial output shorter than checkpoint, shard restarted" << endl;
+    }
+    cout << "Days Covered: " << generation_statistics.covered_day_count << " (" << generation_statistics.weekend_day_count
+         << " weekend days, " << generation_statistics.leap_year_count << " leap years)" << endl;
+    cout << "CRC-32: " << hex << setw(8) << setfill('0') << shard_manifest.content_checksum << dec << setfill(' ') << endl;
+    cout << "Elapsed Time: " << fixed << setprecision(3) << generation_seconds << " s" << endl;
+    return 0;
+}
+
+int execute_archive_merge(const string& output_file_path, const vector<string>& shard_file_paths) {
+    // Load manifests and order the shards by number
+    vector<calendar_archive_shard_manifest> shard_manifests(shard_file_paths.size());
+    vector<size_t> shard_order(shard_file_paths.size());
+    for (size_t shard_index = 0; shard_index < shard_file_paths.size(); shard_index++) {
+        if (!read_archive_shard_manifest(shard_file_paths[shard_index] + ".manifest", shard_manifests[shard_index])) {
+            cout << "ERROR: Missing or malformed manifest for shard: " << shard_file_paths[shard_index] << endl;
+            return 1;
+        }
+        shard_order[shard_index] = shard_index;
+    }
+    sort(shard_order.begin(), shard_order.end(), [&](size_t left_index, size_t right_index) {
+        return shard_manifests[left_index].shard_number < shard_manifests[right_index].shard_number;
+    });
+    
+    // Shards must describe the same archive and tile it without gaps or overlaps
+    const calendar_archive_shard_manifest& first_manifest = shard_manifests[shard_order[0]];
+    if (first_manifest.shard_count != int(shard_order.size())) {
+        cout << "ERROR: Archive was generated as " << first_manifest.shard_count << " shards but "
+             << shard_order.size() << " were supplied" << endl;
+        return 1;
+    }
+    uint64_t expected_offset = 0;
+    int expected_month_index = 0;
+    for (size_t order_index = 0; order_index < shard_order.size(); order_index++) {
+        const calendar_archive_shard_manifest& shard_manifest = shard_manifests[shard_order[order_index]];
+        if (shard_manifest.first_year != first_manifest.first_year || shard_manifest.last_year != first_manifest.last_year ||
+            shard_manifest.shard_count != int(shard_order.size()) || shard_manifest.shard_number != int(order_index) + 1 ||
+            shard_manifest.archive_total_bytes != first_manifest.archive_total_bytes ||
+            shard_manifest.byte_offset != expected_offset || shard_manifest.first_month_index != expected_month_index) {
+            cout << "ERROR: Shard " << shard_file_paths[shard_order[order_index]]
+                 << " does not continue the archive (expected shard " << order_index + 1 << "/" << shard_order.size()
+                 << " at offset " << expected_offset << ")" << endl;
+            return 1;
+        }
+        expected_offset += shard_manifest.byte_length;
+        expected_month_index = shard_manifest.end_month_index;
+    }
+    if (expected_offset != first_manifest.archive_total_bytes ||
+        expected_month_index != (first_manifest.last_year - first_manifest.first_year + 1) * 12) {
+        cout << "ERROR: Shards cover " << expected_offset << " of " << first_manifest.archive_total_bytes << " bytes" << endl;
+        return 1;
+    }
+    
+    // Concatenate shard outputs, re-verifying each length and checksum while copying
+    string temporary_path = output_file_path + ".tmp";
+    FILE* output_file = fopen(temporary_path.c_str(), "wb");
+    if (output_file == NULL) {
+        cout << "ERROR: Unable to create merged archive: " << output_file_path << endl;
+        return 1;
+    }
+    bool merge_failure_detected = false;
+    uint32_t archive_checksum = 0;
+    for (size_t order_index = 0; order_index < shard_order.size() && !merge_failure_detected; order_index++) {
+        const string& shard_path = shard_file_paths[shard_order[order_index]];
+        const calendar_archive_shard_manifest& shard_manifest = shard_manifests[shard_order[order_index]];
+        mapped_file_region shard_region;
+        if (!map_file_read_only(shard_path, shard_region)) {
+            cout << "ERROR: Unable to map shard output: " << shard_path << endl;
+            merge_failure_detected = true;
+            break;
+        }
+        uint32_t shard_checksum = calculate_crc32_checksum(shard_region.mapped_data, shard_region.mapped_size);
+        if (shard_region.mapped_size != shard_manifest.byte_length || shard_checksum != shard_manifest.content_checksum) {
+            cout << "ERROR: Shard output does not match its manifest: " << shard_path << endl;
+            merge_failure_detected = true;
+        } else {
+            archive_checksum = calculate_crc32_checksum(shard_region.mapped_data, shard_region.mapped_size, archive_checksum);
+            merge_failure_detected |= fwrite(shard_region.mapped_data, 1, shard_region.mapped_size, output_file) !=
+                                      shard_region.mapped_size;
+        }
+        unmap_file_region(shard_region);
+    }
+    merge_failure_detected |= !flush_file_to_stable_storage(output_file);
+    merge_failure_detected |= fclose(output_file) != 0;
+    if (merge_failure_detected || !replace_file_atomically(temporary_path, output_file_path)) {
+        remove(temporary_path.c_str());
+        cout << "ERROR: Archive merge failed" << endl;
+        return 1;
+    }
+    
+    cout << "CALENDAR ARCHIVE MERGE REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Years: " << first_manifest.first_year << "-" << first_manifest.last_year << endl;
+    cout << "Shards Verified: " << shard_order.size() << endl;
+    cout << "Bytes Written: " << expected_offset << endl;
+    cout << "CRC-32: " << hex << setw(8) << setfill('0') << archive_checksum << dec << setfill(' ') << endl;
+    return 0;
+}
+
+/*
+================================================================================
+ROLLING WINDOW STATISTICS FUNCTIONS
+================================================================================
+*/
+
+rolling_window_prefix_tables build_rolling_window_prefix_tables(int first_serial_day, int last_serial_day,
+                                                                const vector<int>& region_codes) {
+    rolling_window_prefix_tables prefix_tables;
+    prefix_tables.base_serial_day = first_serial_day;
+    size_t day_count = size_t(last_serial_day - first_serial_day + 1);
+    prefix_tables.weekend_prefix_counts.assign(day_count + 1, 0);
+    prefix_tables.holiday_prefix_counts.assign(day_count + 1, 0);
+    prefix_tables.business_prefix_counts.assign(day_count + 1, 0);
+    vector<uint8_t> holiday_table;
+    if (!region_codes.empty()) {
+        int day_value = 0;
+        int month_value = 0;
+        int first_year = 0;
+        int last_year = 0;
+        convert_serial_day_to_calendar_date(first_serial_day, day_value, month_value, first_year);
+        convert_serial_day_to_calendar_date(last_serial_day, day_value, month_value, last_year);
+        holiday_table = build_holiday_day_table(region_codes, first_year, last_year);
+    }
+    
+    // Each entry counts the qualifying days strictly before its serial day
+    uint32_t weekend_count = 0;
+    uint32_t holiday_count = 0;
+    uint32_t business_count = 0;
+    for (size_t day_index = 0; day_index < day_count; day_index++) {
+        int serial_day = first_serial_day + int(day_index);
+        int weekday_index = serial_day % 7;
+        bool weekend_day = weekday_index == 0 || weekday_index == 6;
+        bool holiday_day = !holiday_table.empty() && holiday_table[size_t(serial_day)] != 0;
+        weekend_count += weekend_day ? 1 : 0;
+        holiday_count += holiday_day ? 1 : 0;
+        business_count += (!weekend_day && !holiday_day) ? 1 : 0;
+        prefix_tables.weekend_prefix_counts[day_index + 1] = weekend_count;
+        prefix_tables.holiday_prefix_counts[day_index + 1] = holiday_count;
+        prefix_tables.business_prefix_counts[day_index + 1] = business_count;
+    }
+    return prefix_tables;
+}
+
+rolling_window_statistics query_rolling_window_statistics(const rolling_window_prefix_tables& prefix_tables,
+                                                          int window_first_serial_day, int window_last_serial_day) {
+    size_t first_index = size_t(window_first_serial_day - prefix_tables.base_serial_day);
+    size_t end_index = size_t(window_last_serial_day - prefix_tables.base_serial_day + 1);
+    rolling_window_statistics window_statistics;
+    window_statistics.window_first_serial_day = window_first_serial_day;
+    window_statistics.window_last_serial_day = window_last_serial_day;
+    window_statistics.total_days = window_last_serial_day - window_first_serial_day + 1;
+    window_statistics.weekend_days = int(prefix_tables.weekend_prefix_counts[end_index] -
+                                         prefix_tables.weekend_prefix_counts[first_index]);
+    window_statistics.holiday_days = int(prefix_tables.holiday_prefix_counts[end_index] -
+                                         prefix_tables.holiday_prefix_counts[first_index]);
+    window_statistics.business_days = int(prefix_tables.business_prefix_counts[end_index] -
+                                          prefix_tables.business_prefix_counts[first_index]);
+    return window_statistics;
+}
+
+int calculate_trailing_window_start_serial_day(int day_value, int month_value, int year_value, int window_months) {
+    // Step back whole months, clamping to shorter months, then start on the following day
+    int shifted_month_index = year_value * 12 + (month_value - 1) - window_months;
+    int start_year = shifted_month_index / 12;
+    int start_month = shifted_month_index % 12 + 1;
+    if (start_year < 1) {
+        return calculate_serial_day_number(1, 1, 1);
+    }
+    int start_day = min(day_value, calculate_month_day_count(start_month, start_year));
+    return calculate_serial_day_number(start_day, start_month, start_year) + 1;
+}
+
+// Function appends one series row: end date, window start, totals and day-class counts
+void append_rolling_window_series_row(string& series_buffer, const rolling_window_statistics& window_statistics,
+                                      int day_value, int month_value, int year_value) {
+    char row_buffer[96];
+    int start_day = 0;
+    int start_month = 0;
+    int start_year = 0;
+    convert_serial_day_to_calendar_date(window_statistics.window_first_serial_day, start_day, start_month, start_year);
+    char* output_position = row_buffer;
+    output_position = write_padded_decimal(output_position, year_value, 4);
+    *output_position++ = '-';
+    output_position = write_padded_decimal(output_position, month_value, 2);
+    *output_position++ = '-';
+    output_position = write_padded_decimal(output_position, day_value, 2);
+    *output_position++ = ',';
+    output_position = write_padded_decimal(output_position, start_year, 4);
+    *output_position++ = '-';
+    output_position = write_padded_decimal(output_position, start_month, 2);
+    *output_position++ = '-';
+    output_position = write_padded_decimal(output_position, start_day, 2);
+    output_position += snprintf(output_position, sizeof(row_buffer) - size_t(output_position - row_buffer),
+                                ",%d,%d,%d,%d\n", window_statistics.total_days, window_statistics.business_days,
+                                window_statistics.weekend_days, window_statistics.holiday_days);
+    series_buffer.append(row_buffer, size_t(output_position - row_buffer));
+}
+
+int execute_rolling_window_statistics(int argument_count, char* argument_values[], const string& year_range_text) {
+    int first_year = 0;
+    int last_year = 0;
+    int window_months = find_command_line_integer_option(argument_count, argument_values, "--window-months", 12);
+    string step_text = find_command_line_option_value(argument_count, argument_values, "--step", "day");
+    string output_file_path = find_command_line_option_value(argument_count, argument_values, "--rolling-output", "");
+    vector<int> region_codes;
+    if (sscanf(year_range_text.c_str(), "%d-%d", &first_year, &last_year) != 2 ||
+        first_year < 1 || last_year > 9999 || first_year > last_year) {
+        cout << "ERROR: --rolling-stats expects <first-last> within 1-9999" << endl;
+        return 1;
+    }
+    if (window_months < 1 || (step_text != "day" && step_text != "month") ||
+        !parse_holiday_region_list(find_command_line_option_value(argument_count, argument_values, "--holidays", ""),
+                                   region_codes)) {
+        cout << "ERROR: Invalid rolling window options" << endl;
+        return 1;
+    }
+    chrono::steady_clock::time_point build_start_time = chrono::steady_clock::now();
+    
+    // Prefix tables span the earliest window start through the final day of the range
+    int table_first_serial_day = calculate_trailing_window_start_serial_day(1, 1, first_year, window_months);
+    int table_last_serial_day = calculate_serial_day_number(31, 12, last_year);
+    rolling_window_prefix_tables prefix_tables =
+        build_rolling_window_prefix_tables(table_first_serial_day, table_last_serial_day, region_codes);
+    chrono::steady_clock::time_point series_start_time = chrono::steady_clock::now();
+    
+    // Advance the window end one day (or one month end) at a time; each step is two table lookups
+    string series_buffer = "window_end,window_start,days,business_days,weekend_days,holiday_days\n";
+    size_t window_count = 0;
+    for (int year_value = first_year; year_value <= last_year; year_value++) {
+        for (int month_value = 1; month_value <= 12; month_value++) {
+            int month_day_count = calculate_month_day_count(month_value, year_value);
+            int month_first_serial_day = calculate_serial_day_number(1, month_value, year_value);
+            int first_end_day = step_text == "month" ? month_day_count : 1;
+            for (int day_value = first_end_day; day_value <= month_day_count; day_value++) {
+                rolling_window_statistics window_statistics = query_rolling_window_statistics(
+                    prefix_tables, calculate_trailing_window_start_serial_day(day_value, month_value, year_value, window_months),
+                    month_first_serial_day + day_value - 1);
+                append_rolling_window_series_row(series_buffer, window_statistics, day_value, month_value, year_value);
+                window_count++;
+            }
+        }
+    }
+    chrono::steady_clock::time_point series_end_time = chrono::steady_clock::now();
+    
+    // Write the series to the requested file, or to the console when none was given
+    if (output_file_path.empty()) {
+        cout << series_buffer;
+    } else if (!write_file_atomically(output_file_path, series_buffer)) {
+        cout << "ERROR: Unable to write rolling statistics: " << output_file_path << endl;
+        return 1;
+    }
+    double build_seconds = chrono::duration<double>(series_start_time - build_start_time).count();
+    double series_seconds = chrono::duration<double>(series_end_time - series_start_time).count();
+    
+    // Display summary on the console; when the series went to standard output the summary goes to
+    // standard error so the CSV stream stays machine-readable
+    ostream& summary_stream = output_file_path.empty() ? cerr : cout;
+    summary_stream << "ROLLING WINDOW STATISTICS REPORT" << endl;
+    summary_stream << string(40, '-') << endl;
+    summary_stream << "Years: " << first_year << "-" << last_year << " (trailing " << window_months << " months, "
+                   << step_text << " steps)" << endl;
+    summary_stream << "Windows Evaluated: " << window_count << endl;
+    summary_stream << "Prefix Table Days: " << prefix_tables.weekend_prefix_counts.size() - 1 << endl;
+    summary_stream << "Table Build Time: " << fixed << setprecision(3) << build_seconds * 1000.0 << " ms" << endl;
+    summary_stream << "Series Time: " << series_seconds * 1000.0 << " ms ("
+                   << setprecision(1) << (window_count > 0 ? series_seconds * 1e9 / double(window_count) : 0.0)
+                   << " ns per window)" << endl;
+    if (!output_file_path.empty()) {
+        summary_stream << "Series File: " << output_file_path << " (" << series_buffer.size() << " bytes)" << endl;
+    }
+    return 0;
+}
+
+/*
+================================================================================
+BIT SCANNING HELPER FUNCTIONS
+================================================================================
+*/
+
+// Function returns the index of the lowest set bit of a non-zero value
+inline int find_lowest_set_bit(uint64_t bit_pattern) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bit_pattern);
+#else
+    int bit_index = 0;
+    while ((bit_pattern & 1) == 0) {
+        bit_pattern >>= 1;
+        bit_index++;
+    }
+    return bit_index;
+#endif
+}
+
+// Function returns the index of the highest set bit of a non-zero value
+inline int find_highest_set_bit(uint64_t bit_pattern) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(bit_pattern);
+#else
+    int bit_index = 63;
+    while ((bit_pattern >> bit_index) == 0) {
+        bit_index--;
+    }
+    return bit_index;
+#endif
+}
+
+/*
+================================================================================
+CRON EXPRESSION COMPILER FUNCTIONS
+================================================================================
+*/
+
+// Function parses a field value as a number or a three-letter name (names are 0- or 1-based per table)
+bool parse_cron_field_value(const string& value_text, const char* const* value_names, int name_count, int name_base,
+                            int& parsed_value) {
+    if (value_text.empty()) {
+        return false;
+    }
+    if (value_names != NULL && isalpha((unsigned char)value_text[0])) {
+        for (int name_index = 0; name_index < name_count; name_index++) {
+            if (value_text.size() == 3 && toupper((unsigned char)value_text[0]) == value_names[name_index][0] &&
+                toupper((unsigned char)value_text[1]) == value_names[name_index][1] &&
+                toupper((unsigned char)value_text[2]) == value_names[name_index][2]) {
+                parsed_value = name_index + name_base;
+                return true;
+            }
+        }
+        return false;
+    }
+    char* parse_end = NULL;
+    long numeric_value = strtol(value_text.c_str(), &parse_end, 10);
+    if (*parse_end != '\0') {
+        return false;
+    }
+    parsed_value = int(numeric_value);
+    return true;
+}
+
+// Function compiles one comma-separated cron field (values, ranges, steps) into a bitset
+bool compile_cron_field(const string& field_text, int minimum_value, int maximum_value,
+                        const char* const* value_names, int name_count, int name_base, uint64_t& field_bits) {
+    field_bits = 0;
+    for (size_t item_begin = 0; item_begin <= field_text.size(); ) {
+        size_t item_end = field_text.find(',', item_begin);
+        item_end = item_end == string::npos ? field_text.size() : item_end;
+        string item_text = field_text.substr(item_begin, item_end - item_begin);
+        item_begin = item_end + 1;
+        int step_value = 1;
+        size_t step_position = item_text.find('/');
+        if (step_position != string::npos) {
+            if (!parse_cron_field_value(item_text.substr(step_position + 1), NULL, 0, 0, step_value) || step_value < 1) {
+                return false;
+            }
+            item_text.erase(step_position);
+        }
+        int range_first = minimum_value;
+        int range_last = maximum_value;
+        if (item_text != "*") {
+            size_t range_position = item_text.find('-');
+            if (!parse_cron_field_value(item_text.substr(0, range_position), value_names, name_count, name_base,
+                                        range_first)) {
+                return false;
+            }
+            if (range_position != string::npos) {
+                if (!parse_cron_field_value(item_text.substr(range_position + 1), value_names, name_count, name_base,
+                                            range_last)) {
+                    return false;
+                }
+            } else {
+                range_last = step_position != string::npos ? maximum_value : range_first; // "5/15" runs to the maximum
+            }
+        }
+        if (range_first < minimum_value || range_last > maximum_value || range_first > range_last) {
+            return false;
+        }
+        for (int field_value = range_first; field_value <= range_last; field_value += step_value) {
+            field_bits |= uint64_t(1) << field_value;
+        }
+    }
+    return !field_text.empty();
+}
+
+bool compile_cron_expression(const string& cron_expression, compiled_cron_schedule& compiled_schedule,
+                             string& error_text) {
+    static const char* const month_names[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                              "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+    static const char* const weekday_names[] = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+    memset(&compiled_schedule, 0, sizeof(compiled_schedule));
+    
+    // Expand the common macros into their five-field equivalents
+    string expanded_expression = cron_expression;
+    if (cron_expression == "@yearly" || cron_expression == "@annually") expanded_expression = "0 0 1 1 *";
+    else if (cron_expression == "@monthly") expanded_expression = "0 0 1 * *";
+    else if (cron_expression == "@weekly") expanded_expression = "0 0 * * 0";
+    else if (cron_expression == "@daily" || cron_expression == "@midnight") expanded_expression = "0 0 * * *";
+    else if (cron_expression == "@hourly") expanded_expression = "0 * * * *";
+    
+    string field_texts[6];
+    int field_count = 0;
+    for (size_t scan_position = 0; scan_position < expanded_expression.size() && field_count < 6; ) {
+        size_t field_begin = expanded_expression.find_first_not_of(" \t", scan_position);
+        if (field_begin == string::npos) {
+            break;
+        }
+        size_t field_end = expanded_expression.find_first_of(" \t", field_begin);
+        field_end = field_end == string::npos ? expanded_expression.size() : field_end;
+        field_texts[field_count++] = expanded_expression.substr(field_begin, field_end - field_begin);
+        scan_position = field_end;
+    }
+    if (field_count != 5) {
+        error_text = "expected five fields: minute hour day-of-month month weekday";
+        return false;
+    }
+    
+    uint64_t field_bits = 0;
+    if (!compile_cron_field(field_texts[0], 0, 59, NULL, 0, 0, field_bits)) {
+        error_text = "invalid minute field: " + field_texts[0];
+        return false;
+    }
+    compiled_schedule.minute_bits = field_bits;
+    if (!compile_cron_field(field_texts[1], 0, 23, NULL, 0, 0, field_bits)) {
+        error_text = "invalid hour field: " + field_texts[1];
+        return false;
+    }
+    compiled_schedule.hour_bits = uint32_t(field_bits);
+    if (!compile_cron_field(field_texts[3], 1, 12, month_names, 12, 1, field_bits)) {
+        error_text = "invalid month field: " + field_texts[3];
+        return false;
+    }
+    compiled_schedule.month_bits = uint16_t(field_bits);
+    
+    // Day of month accepts "L" for the final day alongside ordinary items
+    compiled_schedule.day_of_month_restricted = field_texts[2][0] != '*' && field_texts[2][0] != '?';
+    string ordinary_items;
+    for (size_t item_begin = 0; item_begin <= field_texts[2].size(); ) {
+        size_t item_end = field_texts[2].find(',', item_begin);
+        item_end = item_end == string::npos ? field_texts[2].size() : item_end;
+        string item_text = field_texts[2].substr(item_begin, item_end - item_begin);
+        item_begin = item_end + 1;
+        if (item_text == "L") {
+            compiled_schedule.last_day_of_month = true;
+        } else {
+            ordinary_items += (ordinary_items.empty() ? "" : ",") + (item_text == "?" ? string("*") : item_text);
+        }
+    }
+    if (!ordinary_items.empty()) {
+        if (!compile_cron_field(ordinary_items, 1, 31, NULL, 0, 0, field_bits)) {
+            error_text = "invalid day-of-month field: " + field_texts[2];
+            return false;
+        }
+        compiled_schedule.day_of_month_bits = uint32_t(field_bits);
+    }
+    
+    // Weekday accepts "nL" (last weekday n) and "n#k" (kth weekday n); 7 is an alias for Sunday
+    compiled_schedule.weekday_restricted = field_texts[4][0] != '*' && field_texts[4][0] != '?';
+    ordinary_items.clear();
+    for (size_t item_begin = 0; item_begin <= field_texts[4].size(); ) {
+        size_t item_end = field_texts[4].find(',', item_begin);
+        item_end = item_end == string::npos ? field_texts[4].size() : item_end;
+        string item_text = field_texts[4].substr(item_begin, item_end - item_begin);
+        item_begin = item_end + 1;
+        size_t hash_position = item_text.find('#');
+        int weekday_value = 0;
+        int occurrence_value = 0;
+        if (hash_position != string::npos) {
+            if (!parse_cron_field_value(item_text.substr(0, hash_position), weekday_names, 7, 0, weekday_value) ||
+                !parse_cron_field_value(item_text.substr(hash_position + 1), NULL, 0, 0, occurrence_value) ||
+                weekday_value < 0 || weekday_value > 7 || occurrence_value < 1 || occurrence_value > 5) {
+                error_text = "invalid weekday occurrence: " + item_text;
+                return false;
+            }
+            compiled_schedule.nth_weekday_masks[weekday_value % 7] |= uint8_t(1 << (occurrence_value - 1));
+        } else if (item_text.size() > 1 && item_text[item_text.size() - 1] == 'L') {
+            if (!parse_cron_field_value(item_text.substr(0, item_text.size() - 1), weekday_names, 7, 0, weekday_value) ||
+                weekday_value < 0 || weekday_value > 7) {
+                error_text = "invalid last weekday: " + item_text;
+                return false;
+            }
+            compiled_schedule.last_weekday_bits |= uint8_t(1 << (weekday_value % 7));
+        } else {
+            ordinary_items += (ordinary_items.empty() ? "" : ",") + (item_text == "?" ? string("*") : item_text);
+        }
+    }
+    if (!ordinary_items.empty()) {
+        if (!compile_cron_field(ordinary_items, 0, 7, weekday_names, 7, 0, field_bits)) {
+            error_text = "invalid weekday field: " + field_texts[4];
+            return false;
+        }
+        compiled_schedule.weekday_bits = uint8_t((field_bits | (field_bits >> 7)) & 0x7F);
+    }
+    
+    // Precompute the weekday day masks for each possible weekday of the first of the month
+    for (int first_weekday = 0; first_weekday < 7; first_weekday++) {
+        uint32_t day_mask = 0;
+        for (int day_value = 1; day_value <= 31; day_value++) {
+            if ((compiled_schedule.weekday_bits >> ((first_weekday + day_value - 1) % 7)) & 1) {
+                day_mask |= uint32_t(1) << day_value;
+            }
+        }
+        compiled_schedule.weekday_day_masks[first_weekday] = day_mask;
+    }
+    return true;
+}
+
+/*
+================================================================================
+CRON FIRE TIME COMPUTATION FUNCTIONS
+================================================================================
+*/
+
+uint32_t calculate_cron_day_mask(const compiled_cron_schedule& compiled_schedule, int month_value, int year_value) {
+    int month_day_count = calculate_month_day_count(month_value, year_value);
+    uint32_t valid_day_mask = (uint32_t(1) << (month_day_count + 1)) - 2; // Bits 1..month_day_count
+    if (!compiled_schedule.day_of_month_restricted && !compiled_schedule.weekday_restricted) {
+        return valid_day_mask;
+    }
+    
+    uint32_t day_of_month_mask = compiled_schedule.day_of_month_bits & valid_day_mask;
+    if (compiled_schedule.last_day_of_month) {
+        day_of_month_mask |= uint32_t(1) << month_day_count;
+    }
+    
+    int first_weekday = calculate_month_starting_day(month_value, year_value);
+    uint32_t weekday_mask = compiled_schedule.weekday_day_masks[first_weekday] & valid_day_mask;
+    for (int weekday_index = 0; weekday_index < 7; weekday_index++) {
+        int first_occurrence_day = 1 + (weekday_index - first_weekday + 7) % 7;
+        uint8_t occurrence_mask = compiled_schedule.nth_weekday_masks[weekday_index];
+        while (occurrence_mask != 0) {
+            int occurrence_day = first_occurrence_day + 7 * find_lowest_set_bit(occurrence_mask);
+            if (occurrence_day <= month_day_count) {
+                weekday_mask |= uint32_t(1) << occurrence_day;
+            }
+            occurrence_mask &= uint8_t(occurrence_mask - 1);
+        }
+        if ((compiled_schedule.last_weekday_bits >> weekday_index) & 1) {
+            weekday_mask |= uint32_t(1) << (first_occurrence_day + 7 * ((month_day_count - first_occurrence_day) / 7));
+        }
+    }
+    
+    // Classic cron semantics: when both day fields are restricted either one may match
+    if (compiled_schedule.day_of_month_restricted && compiled_schedule.weekday_restricted) {
+        return day_of_month_mask | weekday_mask;
+    }
+    return compiled_schedule.day_of_month_restricted ? day_of_month_mask : weekday_mask;
+}
+
+long long find_next_cron_fire_minute(const compiled_cron_schedule& compiled_schedule, long long after_serial_minute) {
+    long long candidate_minute = after_serial_minute + 1;
+    int start_day = 0;
+    int start_month = 0;
+    int start_year = 0;
+    convert_serial_day_to_calendar_date(int(candidate_minute / 1440), start_day, start_month, start_year);
+    int start_hour = int(candidate_minute % 1440) / 60;
+    int start_minute = int(candidate_minute % 60);
+    
+    // Jump month by month through matching months, then through matching days via the day mask
+    for (int year_value = start_year; year_value <= 9999; year_value++) {
+        uint32_t month_candidates = uint32_t(compiled_schedule.month_bits);
+        if (year_value == start_year) {
+            month_candidates &= ~((uint32_t(1) << start_month) - 1);
+        }
+        while (month_candidates != 0) {
+            int month_value = find_lowest_set_bit(month_candidates);
+            month_candidates &= month_candidates - 1;
+            bool start_month_selected = year_value == start_year && month_value == start_month;
+            uint32_t day_candidates = calculate_cron_day_mask(compiled_schedule, month_value, year_value);
+            if (start_month_selected) {
+                day_candidates &= ~((uint32_t(1) << start_day) - 1);
+            }
+            while (day_candidates != 0) {
+                int day_value = find_lowest_set_bit(day_candidates);
+                day_candidates &= day_candidates - 1;
+                bool start_day_selected = start_month_selected && day_value == start_day;
+                uint32_t hour_candidates = compiled_schedule.hour_bits &
+                                           ~((uint32_t(1) << (start_day_selected ? start_hour : 0)) - 1);
+                while (hour_candidates != 0) {
+                    int hour_value = find_lowest_set_bit(hour_candidates);
+                    hour_candidates &= hour_candidates - 1;
+                    int minimum_minute = (start_day_selected && hour_value == start_hour) ? start_minute : 0;
+                    uint64_t minute_candidates = compiled_schedule.minute_bits & ~((uint64_t(1) << minimum_minute) - 1);
+                    if (minute_candidates != 0) {
+                        return (long long)calculate_serial_day_number(day_value, month_value, year_value) * 1440 +
+                               hour_value * 60 + find_lowest_set_bit(minute_candidates);
+                    }
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+long long find_previous_cron_fire_minute(const compiled_cron_schedule& compiled_schedule, long long before_serial_minute) {
+    long long candidate_minute = before_serial_minute - 1;
+    if (candidate_minute < 1440) {
+        return -1; // Serial day 1 is the first representable day
+    }
+    int start_day = 0;
+    int start_month = 0;
+    int start_year = 0;
+    convert_serial_day_to_calendar_date(int(candidate_minute / 1440), start_day, start_month, start_year);
+    int start_hour = int(candidate_minute % 1440) / 60;
+    int start_minute = int(candidate_minute % 60);
+    
+    // Mirror of the forward search using the highest remaining bit at each level
+    for (int year_value = start_year; year_value >= 1; year_value--) {
+        uint32_t month_candidates = uint32_t(compiled_schedule.month_bits);
+        if (year_value == start_year) {
+            month_candidates &= (uint32_t(2) << start_month) - 1;
+        }
+        while (month_candidates != 0) {
+            int month_value = find_highest_set_bit(month_candidates);
+            month_candidates &= ~(uint32_t(1) << month_value);
+            bool start_month_selected = year_value == start_year && month_value == start_month;
+            uint32_t day_candidates = calculate_cron_day_mask(compiled_schedule, month_value, year_value);
+            if (start_month_selected) {
+                day_candidates &= (uint32_t(2) << start_day) - 1;
+            }
+            while (day_candidates != 0) {
+                int day_value = find_highest_set_bit(day_candidates);
+                day_candidates &= ~(uint32_t(1) << day_value);
+                bool start_day_selected = start_month_selected && day_value == start_day;
+                uint32_t hour_candidates = compiled_schedule.hour_bits &
+                                           (start_day_selected ? (uint32_t(2) << start_hour) - 1 : 0xFFFFFFu);
+                while (hour_candidates != 0) {
+                    int hour_value = find_highest_set_bit(hour_candidates);
+                    hour_candidates &= ~(uint32_t(1) << hour_value);
+                    uint64_t minute_candidates = compiled_schedule.minute_bits;
+                    if (start_day_selected && hour_value == start_hour) {
+                        minute_candidates &= (uint64_t(2) << start_minute) - 1;
+                    }
+                    if (minute_candidates != 0) {
+                        return (long long)calculate_serial_day_number(day_value, month_value, year_value) * 1440 +
+                               hour_value * 60 + find_highest_set_bit(minute_candidates);
+                    }
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+void compute_next_cron_fire_minutes(const vector<compiled_cron_schedule>& compiled_schedules,
+                                    long long after_serial_minute, vector<long long>& next_fire_minutes) {
+    next_fire_minutes.resize(compiled_schedules.size());
+    for (size_t schedule_index = 0; schedule_index < compiled_schedules.size(); schedule_index++) {
+        next_fire_minutes[schedule_index] = find_next_cron_fire_minute(compiled_schedules[schedule_index],
+                                                                       after_serial_minute);
+    }
+}
+
+/*
+================================================================================
+CRON COMMAND LINE FUNCTIONS
+================================================================================
+*/
+
+// Function formats a serial minute as YYYY-MM-DD HH:MM (Weekday)
+string format_serial_minute_text(long long serial_minute) {
+    static const char* const weekday_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    int serial_day = int(serial_minute / 1440);
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    char time_text[40];
+    snprintf(time_text, sizeof(time_text), "%04d-%02d-%02d %02d:%02d (%s)", year_value, month_value, day_value,
+             int(serial_minute % 1440) / 60, int(serial_minute % 60), weekday_names[serial_day % 7]);
+    return time_text;
+}
+
+int execute_cron_schedule_listing(int argument_count, char* argument_values[], const string& cron_expression) {
+    compiled_cron_schedule compiled_schedule;
+    string error_text;
+    if (!compile_cron_expression(cron_expression, compiled_schedule, error_text)) {
+        cout << "ERROR: " << error_text << endl;
+        return 1;
+    }
+    
+    // Reference time defaults to the start of the demonstration year
+    string from_text = find_command_line_option_value(argument_count, argument_values, "--cron-from", "2025-01-01T00:00");
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    int hour_value = 0;
+    int minute_value = 0;
+    if (!parse_iso_calendar_date(from_text.c_str(), min(from_text.size(), size_t(10)), day_value, month_value, year_value) ||
+        (from_text.size() > 10 && (sscanf(from_text.c_str() + 11, "%d:%d", &hour_value, &minute_value) != 2 ||
+                                   hour_value < 0 || hour_value > 23 || minute_value < 0 || minute_value > 59))) {
+        cout << "ERROR: --cron-from expects YYYY-MM-DD or YYYY-MM-DDTHH:MM" << endl;
+        return 1;
+    }
+    long long reference_minute = (long long)calculate_serial_day_number(day_value, month_value, year_value) * 1440 +
+                                 hour_value * 60 + minute_value;
+    int fire_count = find_command_line_integer_option(argument_count, argument_values, "--cron-count", 10);
+    bool search_backwards = check_command_line_flag_present(argument_count, argument_values, "--cron-previous");
+    
+    cout << "CRON SCHEDULE: " << cron_expression << endl;
+    cout << string(40, '-') << endl;
+    cout << (search_backwards ? "Fire times before " : "Fire times after ") << format_serial_minute_text(reference_minute)
+         << ":" << endl;
+    long long cursor_minute = reference_minute;
+    for (int fire_index = 0; fire_index < fire_count; fire_index++) {
+        cursor_minute = search_backwards ? find_previous_cron_fire_minute(compiled_schedule, cursor_minute) :
+                                           find_next_cron_fire_minute(compiled_schedule, cursor_minute);
+        if (cursor_minute < 0) {
+            cout << "  (no further fire times within years 1-9999)" << endl;
+            break;
+        }
+        cout << "  " << format_serial_minute_text(cursor_minute) << endl;
+    }
+    return 0;
+}
+
+// Function finds the next fire minute by testing each day's fields directly (benchmark reference)
+long long find_next_cron_fire_minute_by_day_scan(const compiled_cron_schedule& compiled_schedule,
+                                                 long long after_serial_minute, int day_limit) {
+    for (long long candidate_minute = after_serial_minute + 1; candidate_minute / 1440 <= after_serial_minute / 1440 + day_limit; ) {
+        int serial_day = int(candidate_minute / 1440);
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+        int month_day_count = calculate_month_day_count(month_value, year_value);
+        int weekday_index = serial_day % 7;
+        bool day_of_month_match = ((compiled_schedule.day_of_month_bits >> day_value) & 1) ||
+                                  (compiled_schedule.last_day_of_month && day_value == month_day_count);
+        bool weekday_match = ((compiled_schedule.weekday_bits >> weekday_index) & 1) ||
+                             ((compiled_schedule.nth_weekday_masks[weekday_index] >> ((day_value - 1) / 7)) & 1) ||
+                             (((compiled_schedule.last_weekday_bits >> weekday_index) & 1) && day_value + 7 > month_day_count);
+        bool day_match = (compiled_schedule.day_of_month_restricted && compiled_schedule.weekday_restricted) ?
+                         (day_of_month_match || weekday_match) :
+                         compiled_schedule.day_of_month_restricted ? day_of_month_match :
+                         compiled_schedule.weekday_restricted ? weekday_match : true;
+        if (((compiled_schedule.month_bits >> month_value) & 1) && day_match) {
+            for (int minute_of_day = int(candidate_minute % 1440); minute_of_day < 1440; minute_of_day++) {
+                if (((compiled_schedule.hour_bits >> (minute_of_day / 60)) & 1) &&
+                    ((compiled_schedule.minute_bits >> (minute_of_day % 60)) & 1)) {
+                    return (long long)serial_day * 1440 + minute_of_day;
+                }
+            }
+        }
+        candidate_minute = (long long)(serial_day + 1) * 1440;
+    }
+    return -1;
+}
+
+int execute_cron_schedule_benchmark(int schedule_count) {
+    // Random schedules mixing plain fields, steps, ranges, lists and the day extensions
+    static const char* const expression_templates[] = {
+        "%d %d * * *", "*/%d %d * * 1-5", "%d %d L * *", "%d %d * * 5L", "%d %d * * 1#%d", "%d %d %d * *",
+        "%d */%d * * *", "%d %d 29 2 *", "%d %d 13 * 5", "%d %d 1,15 */3 *"};
+    vector<string> cron_expressions(static_cast<size_t>(schedule_count));
+    uint32_t random_state = 12345;
+    for (int schedule_index = 0; schedule_index < schedule_count; schedule_index++) {
+        random_state = random_state * 1103515245u + 12345u;
+        int template_index = int((random_state >> 16) % 10);
+        int first_value = int((random_state >> 8) % 60);
+        int second_value = 1 + int((random_state >> 20) % 23);
+        int third_value = 1 + int((random_state >> 4) % 28);
+        char expression_text[48];
+        if (template_index == 1) {
+            snprintf(expression_text, sizeof(expression_text), expression_templates[1], 1 + first_value % 30, second_value);
+        } else if (template_index == 4) {
+            snprintf(expression_text, sizeof(expression_text), expression_templates[4], first_value, second_value,
+                     1 + third_value % 4);
+        } else if (template_index == 5) {
+            snprintf(expression_text, sizeof(expression_text), expression_templates[5], first_value, second_value,
+                     third_value);
+        } else if (template_index == 6) {
+            snprintf(expression_text, sizeof(expression_text), expression_templates[6], first_value, 1 + second_value % 12);
+        } else {
+            snprintf(expression_text, sizeof(expression_text), expression_templates[template_index], first_value,
+                     second_value);
+        }
+        cron_expressions[size_t(schedule_index)] = expression_text;
+    }
+    
+    // Compile every expression
+    chrono::steady_clock::time_point compile_start_time = chrono::steady_clock::now();
+    vector<compiled_cron_schedule> compiled_schedules(cron_expressions.size());
+    string error_text;
+    for (size_t schedule_index = 0; schedule_index < cron_expressions.size(); schedule_index++) {
+        if (!compile_cron_expression(cron_expressions[schedule_index], compiled_schedules[schedule_index], error_text)) {
+            cout << "ERROR: " << cron_expressions[schedule_index] << ": " << error_text << endl;
+            return 1;
+        }
+    }
+    double compile_seconds = chrono::duration<double>(chrono::steady_clock::now() - compile_start_time).count();
+    
+    // Batch next-fire and previous-fire computation from a fixed reference minute
+    long long reference_minute = (long long)calculate_serial_day_number(15, 6, 2025) * 1440 + 12 * 60 + 34;
+    vector<long long> next_fire_minutes;
+    chrono::steady_clock::time_point next_start_time = chrono::steady_clock::now();
+    compute_next_cron_fire_minutes(compiled_schedules, reference_minute, next_fire_minutes);
+    double next_seconds = chrono::duration<double>(chrono::steady_clock::now() - next_start_time).count();
+    
+    long long previous_checksum = 0;
+    chrono::steady_clock::time_point previous_start_time = chrono::steady_clock::now();
+    for (size_t schedule_index = 0; schedule_index < compiled_schedules.size(); schedule_index++) {
+        previous_checksum += find_previous_cron_fire_minute(compiled_schedules[schedule_index], reference_minute) % 1440;
+    }
+    double previous_seconds = chrono::duration<double>(chrono::steady_clock::now() - previous_start_time).count();
+    
+    // Day-by-day reference over a sample validates results and gives the baseline rate
+    size_t sample_count = min(compiled_schedules.size(), size_t(2000));
+    size_t mismatch_count = 0;
+    chrono::steady_clock::time_point scan_start_time = chrono::steady_clock::now();
+    for (size_t schedule_index = 0; schedule_index < sample_count; schedule_index++) {
+        long long scanned_minute = find_next_cron_fire_minute_by_day_scan(compiled_schedules[schedule_index],
+                                                                          reference_minute, 366 * 30);
+        mismatch_count += scanned_minute != next_fire_minutes[schedule_index] ? 1 : 0;
+    }
+    double scan_seconds = chrono::duration<double>(chrono::steady_clock::now() - scan_start_time).count();
+    
+    cout << "CRON SCHEDULE BENCHMARK" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Schedules: " << compiled_schedules.size() << endl;
+    cout << "Compile: " << fixed << setprecision(1) << compile_seconds * 1e9 / double(compiled_schedules.size())
+         << " ns per expression" << endl;
+    cout << "Next Fire (batch): " << next_seconds * 1e9 / double(compiled_schedules.size()) << " ns per schedule ("
+         << setprecision(0) << (next_seconds > 0.0 ? double(compiled_schedules.size()) / next_seconds : 0.0)
+         << " schedules/s)" << endl;
+    cout << "Previous Fire: " << setprecision(1) << previous_seconds * 1e9 / double(compiled_schedules.size())
+         << " ns per schedule (checksum " << previous_checksum << ")" << endl;
+    cout << "Day Scan Reference: " << scan_seconds * 1e9 / double(sample_count) << " ns per schedule over "
+         << sample_count << " samples" << endl;
+    cout << "Reference Mismatches: " << mismatch_count << endl;
+    return mismatch_count == 0 ? 0 : 1;
+}
+
+/*
+================================================================================
+TIMER WHEEL SLOT MANAGEMENT FUNCTIONS
+================================================================================
+*/
+
+// Function links an entry at the head of a slot and marks the slot occupied
+inline void link_timer_wheel_entry(calendar_timer_wheel& timer_wheel, uint32_t entry_index, uint32_t slot_index) {
+    timer_wheel_entry& wheel_entry = timer_wheel.wheel_entries[entry_index];
+    wheel_entry.slot_index = slot_index;
+    wheel_entry.previous_entry_index = TIMER_WHEEL_NO_ENTRY;
+    wheel_entry.next_entry_index = timer_wheel.slot_heads[slot_index];
+    if (wheel_entry.next_entry_index != TIMER_WHEEL_NO_ENTRY) {
+        timer_wheel.wheel_entries[wheel_entry.next_entry_index].previous_entry_index = entry_index;
+    }
+    timer_wheel.slot_heads[slot_index] = entry_index;
+    timer_wheel.slot_occupancy_bits[slot_index / 64] |= uint64_t(1) << (slot_index % 64);
+}
+
+// Function unlinks an entry from its slot and clears the occupancy bit of an emptied slot
+inline void unlink_timer_wheel_entry(calendar_timer_wheel& timer_wheel, uint32_t entry_index) {
+    timer_wheel_entry& wheel_entry = timer_wheel.wheel_entries[entry_index];
+    if (wheel_entry.previous_entry_index != TIMER_WHEEL_NO_ENTRY) {
+        timer_wheel.wheel_entries[wheel_entry.previous_entry_index].next_entry_index = wheel_entry.next_entry_index;
+    } else {
+        timer_wheel.slot_heads[wheel_entry.slot_index] = wheel_entry.next_entry_index;
+        if (wheel_entry.next_entry_index == TIMER_WHEEL_NO_ENTRY) {
+            timer_wheel.slot_occupancy_bits[wheel_entry.slot_index / 64] &= ~(uint64_t(1) << (wheel_entry.slot_index % 64));
+        }
+    }
+    if (wheel_entry.next_entry_index != TIMER_WHEEL_NO_ENTRY) {
+        timer_wheel.wheel_entries[wheel_entry.next_entry_index].previous_entry_index = wheel_entry.previous_entry_index;
+    }
+}
+
+// Function returns the entry to the pool, invalidating outstanding handles
+inline void release_timer_wheel_entry(calendar_timer_wheel& timer_wheel, uint32_t entry_index) {
+    timer_wheel_entry& wheel_entry = timer_wheel.wheel_entries[entry_index];
+    wheel_entry.slot_index = TIMER_WHEEL_NO_ENTRY;
+    wheel_entry.generation_count++;
+    wheel_entry.next_entry_index = timer_wheel.free_entry_index;
+    timer_wheel.free_entry_index = entry_index;
+    timer_wheel.active_entry_count--;
+}
+
+// Function selects the slot for an expiry: the coarsest level whose current period differs
+inline uint32_t select_timer_wheel_slot(long long current_minute, long long expiry_minute) {
+    if (expiry_minute <= current_minute) {
+        return TIMER_WHEEL_DUE_SLOT;
+    }
+    long long expiry_day = expiry_minute / TIMER_WHEEL_MINUTE_SLOTS;
+    long long current_day = current_minute / TIMER_WHEEL_MINUTE_SLOTS;
+    if (expiry_day == current_day) {
+        return uint32_t(TIMER_WHEEL_MINUTE_LEVEL + expiry_minute % TIMER_WHEEL_MINUTE_SLOTS);
+    }
+    if (expiry_day / TIMER_WHEEL_DAY_SLOTS == current_day / TIMER_WHEEL_DAY_SLOTS) {
+        return uint32_t(TIMER_WHEEL_DAY_LEVEL + expiry_day % TIMER_WHEEL_DAY_SLOTS);
+    }
+    const long long era_day_count = (long long)TIMER_WHEEL_DAY_SLOTS * TIMER_WHEEL_BLOCK_SLOTS;
+    if (expiry_day / era_day_count == current_day / era_day_count) {
+        return uint32_t(TIMER_WHEEL_BLOCK_LEVEL + (expiry_day / TIMER_WHEEL_DAY_SLOTS) % TIMER_WHEEL_BLOCK_SLOTS);
+    }
+    return TIMER_WHEEL_OVERFLOW_SLOT;
+}
+
+// Function moves every entry of a coarse slot to the slot matching the new current time
+void cascade_timer_wheel_slot(calendar_timer_wheel& timer_wheel, uint32_t slot_index) {
+    uint32_t entry_index = timer_wheel.slot_heads[slot_index];
+    timer_wheel.slot_heads[slot_index] = TIMER_WHEEL_NO_ENTRY;
+    timer_wheel.slot_occupancy_bits[slot_index / 64] &= ~(uint64_t(1) << (slot_index % 64));
+    while (entry_index != TIMER_WHEEL_NO_ENTRY) {
+        uint32_t next_entry_index = timer_wheel.wheel_entries[entry_index].next_entry_index;
+        link_timer_wheel_entry(timer_wheel, entry_index,
+                               select_timer_wheel_slot(timer_wheel.current_minute,
+                                                       timer_wheel.wheel_entries[entry_index].expiry_minute));
+        entry_index = next_entry_index;
+    }
+}
+
+// Function orders firings by expiry, keeping insertion order among equal expiries
+bool compare_timer_wheel_firing_order(const timer_wheel_firing& left_firing, const timer_wheel_firing& right_firing) {
+    return left_firing.expiry_minute < right_firing.expiry_minute;
+}
+
+// Function fires and releases every entry of a slot
+void fire_timer_wheel_slot(calendar_timer_wheel& timer_wheel, uint32_t slot_index,
+                           vector<timer_wheel_firing>& fired_reminders) {
+    size_t first_fired_index = fired_reminders.size();
+    uint32_t entry_index = timer_wheel.slot_heads[slot_index];
+    timer_wheel.slot_heads[slot_index] = TIMER_WHEEL_NO_ENTRY;
+    timer_wheel.slot_occupancy_bits[slot_index / 64] &= ~(uint64_t(1) << (slot_index % 64));
+    while (entry_index != TIMER_WHEEL_NO_ENTRY) {
+        timer_wheel_entry& wheel_entry = timer_wheel.wheel_entries[entry_index];
+        uint32_t next_entry_index = wheel_entry.next_entry_index;
+        timer_wheel_firing fired_reminder = {wheel_entry.expiry_minute, wheel_entry.reminder_identifier};
+        fired_reminders.push_back(fired_reminder);
+        release_timer_wheel_entry(timer_wheel, entry_index);
+        entry_index = next_entry_index;
+    }
+    
+    // Slots are LIFO lists; the due slot mixes expiries (timers inserted overdue), so restore expiry order
+    if (slot_index == TIMER_WHEEL_DUE_SLOT) {
+        reverse(fired_reminders.begin() + long(first_fired_index), fired_reminders.end());
+        stable_sort(fired_reminders.begin() + long(first_fired_index), fired_reminders.end(),
+                    compare_timer_wheel_firing_order);
+    }
+}
+
+// Function finds the first occupied slot in an inclusive index range, or -1
+int find_occupied_timer_wheel_slot(const calendar_timer_wheel& timer_wheel, int first_slot, int last_slot) {
+    for (int word_index = first_slot / 64; word_index <= last_slot / 64; word_index++) {
+        uint64_t word_bits = timer_wheel.slot_occupancy_bits[word_index];
+        if (word_index == first_slot / 64) {
+            word_bits &= ~uint64_t(0) << (first_slot % 64);
+        }
+        if (word_index == last_slot / 64 && last_slot % 64 != 63) {
+            word_bits &= (uint64_t(1) << (last_slot % 64 + 1)) - 1;
+        }
+        if (word_bits != 0) {
+            return word_index * 64 + find_lowest_set_bit(word_bits);
+        }
+    }
+    return -1;
+}
+
+// Function returns the next day after current_day whose day or block slot holds entries, or the
+// first day of the next era when only the overflow list can hold any
+long long find_next_timer_wheel_day(const calendar_timer_wheel& timer_wheel, long long current_day) {
+    const long long era_day_count = (long long)TIMER_WHEEL_DAY_SLOTS * TIMER_WHEEL_BLOCK_SLOTS;
+    int day_position = int(current_day % TIMER_WHEEL_DAY_SLOTS);
+    if (day_position + 1 < TIMER_WHEEL_DAY_SLOTS) {
+        int occupied_slot = find_occupied_timer_wheel_slot(timer_wheel, TIMER_WHEEL_DAY_LEVEL + day_position + 1,
+                                                           TIMER_WHEEL_DAY_LEVEL + TIMER_WHEEL_DAY_SLOTS - 1);
+        if (occupied_slot >= 0) {
+            return current_day - day_position + (occupied_slot - TIMER_WHEEL_DAY_LEVEL);
+        }
+    }
+    int block_position = int(current_day / TIMER_WHEEL_DAY_SLOTS % TIMER_WHEEL_BLOCK_SLOTS);
+    if (block_position + 1 < TIMER_WHEEL_BLOCK_SLOTS) {
+        int occupied_slot = find_occupied_timer_wheel_slot(timer_wheel, TIMER_WHEEL_BLOCK_LEVEL + block_position + 1,
+                                                           TIMER_WHEEL_BLOCK_LEVEL + TIMER_WHEEL_BLOCK_SLOTS - 1);
+        if (occupied_slot >= 0) {
+            return current_day - day_position +
+                   (long long)(occupied_slot - TIMER_WHEEL_BLOCK_LEVEL - block_position) * TIMER_WHEEL_DAY_SLOTS;
+        }
+    }
+    return current_day - current_day % era_day_count + era_day_count;
+}
+
+/*
+================================================================================
+TIMER WHEEL OPERATION FUNCTIONS
+================================================================================
+*/
+
+void initialize_calendar_timer_wheel(calendar_timer_wheel& timer_wheel, long long start_minute, size_t capacity_hint) {
+    timer_wheel.current_minute = start_minute;
+    timer_wheel.wheel_entries.clear();
+    timer_wheel.wheel_entries.reserve(capacity_hint);
+    timer_wheel.free_entry_index = TIMER_WHEEL_NO_ENTRY;
+    timer_wheel.active_entry_count = 0;
+    fill(timer_wheel.slot_heads, timer_wheel.slot_heads + TIMER_WHEEL_SLOT_COUNT, TIMER_WHEEL_NO_ENTRY);
+    memset(timer_wheel.slot_occupancy_bits, 0, sizeof(timer_wheel.slot_occupancy_bits));
+}
+
+uint64_t insert_calendar_timer(calendar_timer_wheel& timer_wheel, long long expiry_minute, uint64_t reminder_identifier) {
+    // Reuse a released entry when available, otherwise grow the pool
+    uint32_t entry_index = timer_wheel.free_entry_index;
+    if (entry_index != TIMER_WHEEL_NO_ENTRY) {
+        timer_wheel.free_entry_index = timer_wheel.wheel_entries[entry_index].next_entry_index;
+    } else {
+        entry_index = uint32_t(timer_wheel.wheel_entries.size());
+        timer_wheel_entry new_entry;
+        new_entry.generation_count = 0;
+        timer_wheel.wheel_entries.push_back(new_entry);
+    }
+    timer_wheel_entry& wheel_entry = timer_wheel.wheel_entries[entry_index];
+    wheel_entry.expiry_minute = expiry_minute;
+    wheel_entry.reminder_identifier = reminder_identifier;
+    link_timer_wheel_entry(timer_wheel, entry_index, select_timer_wheel_slot(timer_wheel.current_minute, expiry_minute));
+    timer_wheel.active_entry_count++;
+    return (uint64_t(wheel_entry.generation_count) << 32) | entry_index;
+}
+
+bool cancel_calendar_timer(calendar_timer_wheel& timer_wheel, uint64_t timer_handle) {
+    uint32_t entry_index = uint32_t(timer_handle);
+    if (entry_index >= timer_wheel.wheel_entries.size() ||
+        timer_wheel.wheel_entries[entry_index].slot_index == TIMER_WHEEL_NO_ENTRY ||
+        timer_wheel.wheel_entries[entry_index].generation_count != uint32_t(timer_handle >> 32)) {
+        return false; // Already fired, cancelled or never issued
+    }
+    unlink_timer_wheel_entry(timer_wheel, entry_index);
+    release_timer_wheel_entry(timer_wheel, entry_index);
+    return true;
+}
+
+size_t advance_calendar_timer_wheel(calendar_timer_wheel& timer_wheel, long long target_minute,
+                                    vector<timer_wheel_firing>& fired_reminders) {
+    size_t initial_fired_count = fired_reminders.size();
+    fire_timer_wheel_slot(timer_wheel, TIMER_WHEEL_DUE_SLOT, fired_reminders);
+    while (timer_wheel.current_minute < target_minute && timer_wheel.active_entry_count > 0) {
+        // Jump to the next occupied minute slot of the current day
+        long long day_start_minute = timer_wheel.current_minute - timer_wheel.current_minute % TIMER_WHEEL_MINUTE_SLOTS;
+        long long day_limit_minute = min(target_minute, day_start_minute + TIMER_WHEEL_MINUTE_SLOTS - 1);
+        int occupied_slot = find_occupied_timer_wheel_slot(
+            timer_wheel, int(timer_wheel.current_minute - day_start_minute) + 1, int(day_limit_minute - day_start_minute));
+        if (occupied_slot >= 0) {
+            timer_wheel.current_minute = day_start_minute + occupied_slot;
+            fire_timer_wheel_slot(timer_wheel, uint32_t(occupied_slot), fired_reminders);
+            continue;
+        }
+        timer_wheel.current_minute = day_limit_minute;
+        if (timer_wheel.current_minute == target_minute) {
+            break;
+        }
+        
+        // Skip empty days and enter the next one holding entries, cascading coarser slots whose period begins then
+        long long current_day = find_next_timer_wheel_day(timer_wheel, timer_wheel.current_minute / TIMER_WHEEL_MINUTE_SLOTS);
+        if (current_day * TIMER_WHEEL_MINUTE_SLOTS > target_minute) {
+            timer_wheel.current_minute = target_minute;
+            break;
+        }
+        timer_wheel.current_minute = current_day * TIMER_WHEEL_MINUTE_SLOTS;
+        if (current_day % TIMER_WHEEL_DAY_SLOTS == 0) {
+            if (current_day % ((long long)TIMER_WHEEL_DAY_SLOTS * TIMER_WHEEL_BLOCK_SLOTS) == 0) {
+                cascade_timer_wheel_slot(timer_wheel, TIMER_WHEEL_OVERFLOW_SLOT);
+            }
+            cascade_timer_wheel_slot(timer_wheel,
+                                     uint32_t(TIMER_WHEEL_BLOCK_LEVEL + (current_day / TIMER_WHEEL_DAY_SLOTS) % TIMER_WHEEL_BLOCK_SLOTS));
+        }
+        cascade_timer_wheel_slot(timer_wheel, uint32_t(TIMER_WHEEL_DAY_LEVEL + current_day % TIMER_WHEEL_DAY_SLOTS));
+        fire_timer_wheel_slot(timer_wheel, TIMER_WHEEL_DUE_SLOT, fired_reminders); // Midnight entries cascade as due
+    }
+    if (timer_wheel.active_entry_count == 0 && timer_wheel.current_minute < target_minute) {
+        timer_wheel.current_minute = target_minute; // Nothing pending: jump directly
+    }
+    return fired_reminders.size() - initial_fired_count;
+}
+
+/*
+================================================================================
+REMINDER DRIVER AND TIMER BENCHMARK FUNCTIONS
+================================================================================
+*/
+
+// Function converts the system clock to a UTC serial minute
+long long read_system_clock_serial_minute() {
+    long long unix_minutes = (long long)chrono::duration_cast<chrono::minutes>(
+        chrono::system_clock::now().time_since_epoch()).count();
+    return (long long)calculate_serial_day_number(1, 1, 1970) * 1440 + unix_minutes;
+}
+
+int execute_reminder_driver(int argument_count, char* argument_values[], const string& reminder_file_path) {
+    string clock_text = find_command_line_option_value(argument_count, argument_values, "--clock", "simulated");
+    string until_text = find_command_line_option_value(argument_count, argument_values, "--until", "");
+    if (clock_text != "simulated" && clock_text != "real") {
+        cout << "ERROR: --clock expects simulated or real" << endl;
+        return 1;
+    }
+    
+    // Load reminder lines: YYYY-MM-DD HH:MM text
+    ifstream reminder_stream(reminder_file_path.c_str());
+    if (!reminder_stream) {
+        cout << "ERROR: Unable to read reminders: " << reminder_file_path << endl;
+        return 1;
+    }
+    vector<string> reminder_texts;
+    vector<long long> reminder_minutes;
+    string reminder_line;
+    while (getline(reminder_stream, reminder_line)) {
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        int hour_value = 0;
+        int minute_value = 0;
+        if (!parse_iso_calendar_date(reminder_line.c_str(), min(reminder_line.size(), size_t(10)), day_value, month_value, year_value) ||
+            reminder_line.size() < 16 || sscanf(reminder_line.c_str() + 11, "%d:%d", &hour_value, &minute_value) != 2 ||
+            hour_value < 0 || hour_value > 23 || minute_value < 0 || minute_value > 59) {
+            continue; // Skip blank, comment and malformed lines
+        }
+        size_t text_begin = min(reminder_line.size(), size_t(17));
+        size_t text_end = reminder_line.find_last_not_of("\r\n");
+        reminder_texts.push_back(text_end == string::npos || text_end < text_begin ? string() :
+                                 reminder_line.substr(text_begin, text_end - text_begin + 1));
+        reminder_minutes.push_back((long long)calculate_serial_day_number(day_value, month_value, year_value) * 1440 +
+                                   hour_value * 60 + minute_value);
+    }
+    if (reminder_minutes.empty()) {
+        cout << "No reminders found in " << reminder_file_path << endl;
+        return 0;
+    }
+    
+    // Simulated clocks start just before the earliest reminder; the real clock starts now
+    bool real_clock_selected = clock_text == "real";
+    long long start_minute = real_clock_selected ? read_system_clock_serial_minute() :
+                             *min_element(reminder_minutes.begin(), reminder_minutes.end()) - 1;
+    calendar_timer_wheel timer_wheel;
+    initialize_calendar_timer_wheel(timer_wheel, start_minute, reminder_minutes.size());
+    for (size_t reminder_index = 0; reminder_index < reminder_minutes.size(); reminder_index++) {
+        insert_calendar_timer(timer_wheel, reminder_minutes[reminder_index], reminder_index);
+    }
+    long long until_minute = *max_element(reminder_minutes.begin(), reminder_minutes.end());
+    if (!until_text.empty()) {
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        if (!parse_iso_calendar_date(until_text.c_str(), until_text.size(), day_value, month_value, year_value)) {
+            cout << "ERROR: --until expects YYYY-MM-DD" << endl;
+            return 1;
+        }
+        until_minute = (long long)calculate_serial_day_number(day_value, month_value, year_value) * 1440 + 1439;
+    }
+    
+    cout << "REMINDER DRIVER (" << clock_text << " clock, " << reminder_minutes.size() << " reminders)" << endl;
+    cout << string(40, '-') << endl;
+    vector<timer_wheel_firing> fired_reminders;
+    size_t total_fired_count = 0;
+    while (timer_wheel.active_entry_count > 0 || !fired_reminders.empty()) {
+        // Real clocks poll once per second; simulated clocks advance straight to the horizon
+        long long clock_minute = real_clock_selected ? read_system_clock_serial_minute() : until_minute;
+        fired_reminders.clear();
+        advance_calendar_timer_wheel(timer_wheel, min(clock_minute, until_minute), fired_reminders);
+        for (size_t fired_index = 0; fired_index < fired_reminders.size(); fired_index++) {
+            cout << "FIRE " << format_serial_minute_text(fired_reminders[fired_index].expiry_minute) << "  "
+                 << reminder_texts[size_t(fired_reminders[fired_index].reminder_identifier)] << endl;
+        }
+        total_fired_count += fired_reminders.size();
+        if (clock_minute >= until_minute || !real_clock_selected) {
+            break;
+        }
+        if (fired_reminders.empty()) {
+            this_thread::sleep_for(chrono::seconds(1));
+        }
+    }
+    cout << "Fired: " << total_fired_count << ", Pending: " << timer_wheel.active_entry_count << endl;
+    return 0;
+}
+
+int execute_timer_wheel_benchmark(int timer_count) {
+    // Random expiries over two years, half of them cancelled before they fire
+    long long start_minute = (long long)calculate_serial_day_number(1, 1, 2025) * 1440;
+    long long horizon_minutes = 2LL * 366 * 1440;
+    vector<long long> expiry_minutes(static_cast<size_t>(timer_count));
+    uint64_t random_state = 88172645463325252ULL;
+    for (size_t timer_index = 0; timer_index < expiry_minutes.size(); timer_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        expiry_minutes[timer_index] = start_minute + 1 + (long long)(random_state % uint64_t(horizon_minutes));
+    }
+    
+    // Timer wheel: insert, cancel every other timer, then fire the rest
+    calendar_timer_wheel timer_wheel;
+    initialize_calendar_timer_wheel(timer_wheel, start_minute, expiry_minutes.size());
+    vector<uint64_t> timer_handles(expiry_minutes.size());
+    chrono::steady_clock::time_point wheel_insert_start = chrono::steady_clock::now();
+    for (size_t timer_index = 0; timer_index < expiry_minutes.size(); timer_index++) {
+        timer_handles[timer_index] = insert_calendar_timer(timer_wheel, expiry_minutes[timer_index], timer_index);
+    }
+    chrono::steady_clock::time_point wheel_cancel_start = chrono::steady_clock::now();
+    for (size_t timer_index = 0; timer_index < expiry_minutes.size(); timer_index += 2) {
+        cancel_calendar_timer(timer_wheel, timer_handles[timer_index]);
+    }
+    chrono::steady_clock::time_point wheel_fire_start = chrono::steady_clock::now();
+    vector<timer_wheel_firing> fired_reminders;
+    fired_reminders.reserve(expiry_minutes.size() / 2 + 1);
+    advance_calendar_timer_wheel(timer_wheel, start_minute + horizon_minutes + 1, fired_reminders);
+    chrono::steady_clock::time_point wheel_end = chrono::steady_clock::now();
+    uint64_t wheel_checksum = 0;
+    bool wheel_order_valid = true;
+    for (size_t fired_index = 0; fired_index < fired_reminders.size(); fired_index++) {
+        wheel_checksum += fired_reminders[fired_index].reminder_identifier * uint64_t(fired_reminders[fired_index].expiry_minute % 1000003);
+        wheel_order_valid &= fired_index == 0 ||
+                             fired_reminders[fired_index - 1].expiry_minute <= fired_reminders[fired_index].expiry_minute;
+    }
+    size_t wheel_fired_count = fired_reminders.size();
+    
+    // Binary heap baseline: cancellation marks entries that are skipped when popped
+    typedef pair<long long, uint64_t> heap_timer;
+    chrono::steady_clock::time_point heap_insert_start = chrono::steady_clock::now();
+    priority_queue<heap_timer, vector<heap_timer>, greater<heap_timer> > timer_heap;
+    vector<bool> cancelled_timers(expiry_minutes.size(), false);
+    for (size_t timer_index = 0; timer_index < expiry_minutes.size(); timer_index++) {
+        timer_heap.push(heap_timer(expiry_minutes[timer_index], timer_index));
+    }
+    chrono::steady_clock::time_point heap_cancel_start = chrono::steady_clock::now();
+    for (size_t timer_index = 0; timer_index < expiry_minutes.size(); timer_index += 2) {
+        cancelled_timers[timer_index] = true;
+    }
+    chrono::steady_clock::time_point heap_fire_start = chrono::steady_clock::now();
+    uint64_t heap_checksum = 0;
+    size_t heap_fired_count = 0;
+    while (!timer_heap.empty()) {
+        heap_timer next_timer = timer_heap.top();
+        timer_heap.pop();
+        if (!cancelled_timers[size_t(next_timer.second)]) {
+            heap_checksum += next_timer.second * uint64_t(next_timer.first % 1000003);
+            heap_fired_count++;
+        }
+    }
+    chrono::steady_clock::time_point heap_end = chrono::steady_clock::now();
+    
+    double wheel_insert_seconds = chrono::duration<double>(wheel_cancel_start - wheel_insert_start).count();
+    double wheel_cancel_seconds = chrono::duration<double>(wheel_fire_start - wheel_cancel_start).count();
+    double wheel_fire_seconds = chrono::duration<double>(wheel_end - wheel_fire_start).count();
+    double heap_insert_seconds = chrono::duration<double>(heap_cancel_start - heap_insert_start).count();
+    double heap_cancel_seconds = chrono::duration<double>(heap_fire_start - heap_cancel_start).count();
+    double heap_fire_seconds = chrono::duration<double>(heap_end - heap_fire_start).count();
+    double cancel_count = double((expiry_minutes.size() + 1) / 2);
+    
+    cout << "TIMER WHEEL BENCHMARK (" << expiry_minutes.size() << " timers over 2 years, half cancelled)" << endl;
+    cout << string(60, '-') << endl;
+    cout << "                  Insert M/s   Cancel M/s   Fire M/s" << endl;
+    cout << fixed << setprecision(2);
+    cout << "  Timer wheel   " << setw(12) << double(expiry_minutes.size()) / wheel_insert_seconds / 1e6
+         << setw(13) << cancel_count / wheel_cancel_seconds / 1e6
+         << setw(11) << double(wheel_fired_count) / wheel_fire_seconds / 1e6 << endl;
+    cout << "  Binary heap   " << setw(12) << double(expiry_minutes.size()) / heap_insert_seconds / 1e6
+         << setw(13) << cancel_count / heap_cancel_seconds / 1e6
+         << setw(11) << double(heap_fired_count) / heap_fire_seconds / 1e6 << endl;
+    cout << "  (heap cancellation marks entries; they are discarded when popped)" << endl;
+    cout << "Fired: wheel " << wheel_fired_count << ", heap " << heap_fired_count
+         << (wheel_checksum == heap_checksum && wheel_order_valid ? " (identical sets, wheel in expiry order)" :
+                                                                     " (MISMATCH)") << endl;
+    return wheel_checksum == heap_checksum && wheel_order_valid && wheel_fired_count == heap_fired_count ? 0 : 1;
+}
+
+/*
+================================================================================
+CAPACITY SEGMENT TREE FUNCTIONS
+================================================================================
+*/
+
+// Padding leaves hold a sentinel far below any booking level so they never win a maximum
+const int32_t CAPACITY_PADDING_VALUE = INT32_MIN / 2;
+
+// Function adds an amount to a node, recording it as pending for the node's children
+inline void apply_capacity_node_addition(capacity_segment_tree& segment_tree, int node_index, int32_t amount) {
+    // Leaves carry a pending slot too so the update stays branch-free on random ranges
+    segment_tree.node_maximums[size_t(node_index)] += amount;
+    segment_tree.pending_additions[size_t(node_index)] += amount;
+}
+
+// Function recomputes ancestors of a node from their children and pending additions
+inline void rebuild_capacity_ancestors(capacity_segment_tree& segment_tree, int node_index) {
+    while (node_index > 1) {
+        node_index >>= 1;
+        segment_tree.node_maximums[size_t(node_index)] =
+            max(segment_tree.node_maximums[size_t(2 * node_index)], segment_tree.node_maximums[size_t(2 * node_index + 1)]) +
+            segment_tree.pending_additions[size_t(node_index)];
+    }
+}
+
+void build_capacity_segment_tree(capacity_segment_tree& segment_tree, const int32_t* day_values, int day_count) {
+    segment_tree.indexed_count = day_count;
+    segment_tree.leaf_count = 1;
+    segment_tree.tree_height = 0;
+    while (segment_tree.leaf_count < day_count) {
+        segment_tree.leaf_count <<= 1;
+        segment_tree.tree_height++;
+    }
+    segment_tree.node_maximums.assign(size_t(2 * segment_tree.leaf_count), CAPACITY_PADDING_VALUE);
+    segment_tree.pending_additions.assign(size_t(2 * segment_tree.leaf_count), 0);
+    for (int day_index = 0; day_index < day_count; day_index++) {
+        segment_tree.node_maximums[size_t(segment_tree.leaf_count + day_index)] = day_values != NULL ? day_values[day_index] : 0;
+    }
+    for (int node_index = segment_tree.leaf_count - 1; node_index >= 1; node_index--) {
+        segment_tree.node_maximums[size_t(node_index)] = max(segment_tree.node_maximums[size_t(2 * node_index)],
+                                                             segment_tree.node_maximums[size_t(2 * node_index + 1)]);
+    }
+}
+
+void add_capacity_segment_range(capacity_segment_tree& segment_tree, int first_index, int last_index, int32_t amount) {
+    // A range covering every indexed day is a single pending addition at the root (padding stays far below zero)
+    if (first_index == 0 && last_index == segment_tree.indexed_count - 1) {
+        apply_capacity_node_addition(segment_tree, 1, amount);
+        return;
+    }
+    
+    // Bottom-up traversal touches O(log n) canonical nodes, then repairs the two boundary paths
+    int left_node = first_index + segment_tree.leaf_count;
+    int right_node = last_index + segment_tree.leaf_count + 1;
+    int left_boundary = left_node;
+    int right_boundary = right_node - 1;
+    for (; left_node < right_node; left_node >>= 1, right_node >>= 1) {
+        if (left_node & 1) {
+            apply_capacity_node_addition(segment_tree, left_node++, amount);
+        }
+        if (right_node & 1) {
+            apply_capacity_node_addition(segment_tree, --right_node, amount);
+        }
+    }
+    rebuild_capacity_ancestors(segment_tree, left_boundary);
+    rebuild_capacity_ancestors(segment_tree, right_boundary);
+}
+
+int32_t query_capacity_segment_maximum(const capacity_segment_tree& segment_tree, int first_index, int last_index) {
+    // Read-only bottom-up query: instead of pushing pending additions down, each side's maximum climbs
+    // with them. Everything a side has collected lies below that side's boundary path node, so moving
+    // up a level adds the pending addition of the new path node (left_node - 1 on the left, right_node
+    // on the right)
+    int left_node = first_index + segment_tree.leaf_count;
+    int right_node = last_index + segment_tree.leaf_count + 1;
+    int32_t left_maximum = CAPACITY_PADDING_VALUE;
+    int32_t right_maximum = CAPACITY_PADDING_VALUE;
+    bool left_collected = false;
+    bool right_collected = false;
+    while (left_node < right_node) {
+        if (left_node & 1) {
+            left_maximum = max(left_maximum, segment_tree.node_maximums[size_t(left_node++)]);
+            left_collected = true;
+        }
+        if (right_node & 1) {
+            right_maximum = max(right_maximum, segment_tree.node_maximums[size_t(--right_node)]);
+            right_collected = true;
+        }
+        left_node >>= 1;
+        right_node >>= 1;
+        left_maximum += left_collected ? segment_tree.pending_additions[size_t(left_node - 1)] : 0;
+        right_maximum += right_collected ? segment_tree.pending_additions[size_t(right_node)] : 0;
+    }
+    
+    // Finish each side with the pending additions above its final path node
+    for (int ancestor_index = (left_node - 1) >> 1; left_collected && ancestor_index >= 1; ancestor_index >>= 1) {
+        left_maximum += segment_tree.pending_additions[size_t(ancestor_index)];
+    }
+    for (int ancestor_index = right_node >> 1; right_collected && ancestor_index >= 1; ancestor_index >>= 1) {
+        right_maximum += segment_tree.pending_additions[size_t(ancestor_index)];
+    }
+    return max(left_maximum, right_maximum);
+}
+
+/*
+================================================================================
+YEAR-SHARDED CAPACITY CALENDAR FUNCTIONS
+================================================================================
+*/
+
+void initialize_sharded_capacity_calendar(sharded_capacity_calendar& capacity_calendar, int first_year, int last_year) {
+    capacity_calendar.first_year = first_year;
+    capacity_calendar.last_year = last_year;
+    capacity_calendar.year_shards = vector<capacity_year_shard>(size_t(last_year - first_year + 1));
+    for (int year_value = first_year; year_value <= last_year; year_value++) {
+        capacity_year_shard& year_shard = capacity_calendar.year_shards[size_t(year_value - first_year)];
+        year_shard.first_serial_day = calculate_serial_day_number(1, 1, year_value);
+        year_shard.day_count = calculate_leap_year_status(year_value) ? 366 : 365;
+        build_capacity_segment_tree(year_shard.day_tree, NULL, year_shard.day_count);
+    }
+}
+
+// Function returns the shard holding a serial day inside the calendar horizon
+inline size_t locate_capacity_shard_index(const sharded_capacity_calendar& capacity_calendar, int serial_day) {
+    // 400 Gregorian years hold 146097 days, so the estimate is off by at most one year
+    const vector<capacity_year_shard>& year_shards = capacity_calendar.year_shards;
+    size_t shard_index = min(year_shards.size() - 1,
+                             size_t(int64_t(serial_day - year_shards[0].first_serial_day) * 400 / 146097));
+    while (shard_index > 0 && serial_day < year_shards[shard_index].first_serial_day) {
+        shard_index--;
+    }
+    while (shard_index + 1 < year_shards.size() && serial_day >= year_shards[shard_index + 1].first_serial_day) {
+        shard_index++;
+    }
+    return shard_index;
+}
+
+// Function clips an inclusive serial day range to the calendar and returns the covered shard indexes
+bool locate_capacity_shard_range(const sharded_capacity_calendar& capacity_calendar, int& first_serial_day,
+                                 int& last_serial_day, size_t& first_shard_index, size_t& last_shard_index) {
+    const capacity_year_shard& first_shard = capacity_calendar.year_shards.front();
+    const capacity_year_shard& last_shard = capacity_calendar.year_shards.back();
+    first_serial_day = max(first_serial_day, first_shard.first_serial_day);
+    last_serial_day = min(last_serial_day, last_shard.first_serial_day + last_shard.day_count - 1);
+    if (first_serial_day > last_serial_day) {
+        return false;
+    }
+    first_shard_index = locate_capacity_shard_index(capacity_calendar, first_serial_day);
+    last_shard_index = locate_capacity_shard_index(capacity_calendar, last_serial_day);
+    return true;
+}
+
+void bulk_load_capacity_bookings(sharded_capacity_calendar& capacity_calendar, const vector<capacity_booking>& bookings) {
+    // One difference array over the whole horizon, then a linear build per year shard
+    const capacity_year_shard& first_shard = capacity_calendar.year_shards.front();
+    const capacity_year_shard& last_shard = capacity_calendar.year_shards.back();
+    int horizon_first_serial_day = first_shard.first_serial_day;
+    int horizon_day_count = last_shard.first_serial_day + last_shard.day_count - horizon_first_serial_day;
+    vector<int32_t> booking_levels(size_t(horizon_day_count) + 1, 0);
+    for (size_t booking_index = 0; booking_index < bookings.size(); booking_index++) {
+        int first_serial_day = max(bookings[booking_index].first_serial_day, horizon_first_serial_day);
+        int last_serial_day = min(bookings[booking_index].last_serial_day, horizon_first_serial_day + horizon_day_count - 1);
+        if (first_serial_day <= last_serial_day) {
+            booking_levels[size_t(first_serial_day - horizon_first_serial_day)] += bookings[booking_index].booked_amount;
+            booking_levels[size_t(last_serial_day - horizon_first_serial_day + 1)] -= bookings[booking_index].booked_amount;
+        }
+    }
+    for (int day_index = 1; day_index < horizon_day_count; day_index++) {
+        booking_levels[size_t(day_index)] += booking_levels[size_t(day_index - 1)];
+    }
+    for (size_t shard_index = 0; shard_index < capacity_calendar.year_shards.size(); shard_index++) {
+        capacity_year_shard& year_shard = capacity_calendar.year_shards[shard_index];
+        lock_guard<mutex> shard_lock(year_shard.shard_mutex);
+        build_capacity_segment_tree(year_shard.day_tree,
+                                    &booking_levels[size_t(year_shard.first_serial_day - horizon_first_serial_day)],
+                                    year_shard.day_count);
+    }
+}
+
+void reserve_capacity_range(sharded_capacity_calendar& capacity_calendar, int first_serial_day, int last_serial_day,
+                            int32_t booked_amount) {
+    size_t first_shard_index = 0;
+    size_t last_shard_index = 0;
+    if (!locate_capacity_shard_range(capacity_calendar, first_serial_day, last_serial_day, first_shard_index, last_shard_index)) {
+        return;
+    }
+    // Additions commute, so each year shard is updated under its own lock in turn
+    for (size_t shard_index = first_shard_index; shard_index <= last_shard_index; shard_index++) {
+        capacity_year_shard& year_shard = capacity_calendar.year_shards[shard_index];
+        lock_guard<mutex> shard_lock(year_shard.shard_mutex);
+        add_capacity_segment_range(year_shard.day_tree, max(first_serial_day, year_shard.first_serial_day) - year_shard.first_serial_day,
+                                   min(last_serial_day, year_shard.first_serial_day + year_shard.day_count - 1) -
+                                   year_shard.first_serial_day, booked_amount);
+    }
+}
+
+bool try_reserve_capacity_range(sharded_capacity_calendar& capacity_calendar, int first_serial_day, int last_serial_day,
+                                int32_t booked_amount, int32_t capacity_limit) {
+    size_t first_shard_index = 0;
+    size_t last_shard_index = 0;
+    if (!locate_capacity_shard_range(capacity_calendar, first_serial_day, last_serial_day, first_shard_index, last_shard_index)) {
+        return false;
+    }
+    // Locks are taken in ascending year order so concurrent multi-year reservations cannot deadlock
+    for (size_t shard_index = first_shard_index; shard_index <= last_shard_index; shard_index++) {
+        capacity_calendar.year_shards[shard_index].shard_mutex.lock();
+    }
+    bool capacity_available = true;
+    for (size_t shard_index = first_shard_index; shard_index <= last_shard_index && capacity_available; shard_index++) {
+        capacity_year_shard& year_shard = capacity_calendar.year_shards[shard_index];
+        capacity_available = query_capacity_segment_maximum(
+            year_shard.day_tree, max(first_serial_day, year_shard.first_serial_day) - year_shard.first_serial_day,
+            min(last_serial_day, year_shard.first_serial_day + year_shard.day_count - 1) - year_shard.first_serial_day) +
+            booked_amount <= capacity_limit;
+    }
+    for (size_t shard_index = first_shard_index; shard_index <= last_shard_index; shard_index++) {
+        capacity_year_shard& year_shard = capacity_calendar.year_shards[shard_index];
+        if (capacity_available) {
+            add_capacity_segment_range(year_shard.day_tree,
+                                       max(first_serial_day, year_shard.first_serial_day) - year_shard.first_serial_day,
+                                       min(last_serial_day, year_shard.first_serial_day + year_shard.day_count - 1) -
+                                       year_shard.first_serial_day, booked_amount);
+        }
+        year_shard.shard_mutex.unlock();
+    }
+    return capacity_available;
+}
+
+int32_t query_maximum_capacity_range(const sharded_capacity_calendar& capacity_calendar, int first_serial_day,
+                                     int last_serial_day) {
+    size_t first_shard_index = 0;
+    size_t last_shard_index = 0;
+    if (!locate_capacity_shard_range(capacity_calendar, first_serial_day, last_serial_day, first_shard_index, last_shard_index)) {
+        return 0;
+    }
+    // Queries only read the tree; the lock keeps them from observing a half-applied reservation
+    int32_t range_maximum = CAPACITY_PADDING_VALUE;
+    for (size_t shard_index = first_shard_index; shard_index <= last_shard_index; shard_index++) {
+        const capacity_year_shard& year_shard = capacity_calendar.year_shards[shard_index];
+        int first_index = max(first_serial_day, year_shard.first_serial_day) - year_shard.first_serial_day;
+        int last_index = min(last_serial_day, year_shard.first_serial_day + year_shard.day_count - 1) - year_shard.first_serial_day;
+        lock_guard<mutex> shard_lock(year_shard.shard_mutex);
+        range_maximum = max(range_maximum, (first_index == 0 && last_index == year_shard.day_count - 1) ?
+                                           year_shard.day_tree.node_maximums[1] :
+                                           query_capacity_segment_maximum(year_shard.day_tree, first_index, last_index));
+    }
+    return range_maximum;
+}
+
+/*
+================================================================================
+CAPACITY DISPLAY AND BENCHMARK FUNCTIONS
+================================================================================
+*/
+
+int execute_capacity_occupancy_display(int argument_count, char* argument_values[], const string& bookings_file_path) {
+    int occupancy_capacity = find_command_line_integer_option(argument_count, argument_values, "--capacity", 10);
+    ifstream bookings_stream(bookings_file_path.c_str());
+    if (!bookings_stream || occupancy_capacity < 1) {
+        cout << "ERROR: Unable to read bookings or invalid --capacity" << endl;
+        return 1;
+    }
+    
+    // Booking lines: first-date last-date amount
+    vector<capacity_booking> bookings;
+    int first_year = 9999;
+    int last_year = 1;
+    string booking_line;
+    while (getline(bookings_stream, booking_line)) {
+        char first_date_text[16] = {0};
+        char last_date_text[16] = {0};
+        int booked_amount = 0;
+        int first_day = 0, first_month = 0, first_booking_year = 0;
+        int last_day = 0, last_month = 0, last_booking_year = 0;
+        if (sscanf(booking_line.c_str(), "%15s %15s %d", first_date_text, last_date_text, &booked_amount) != 3 ||
+            !parse_iso_calendar_date(first_date_text, strlen(first_date_text), first_day, first_month, first_booking_year) ||
+            !parse_iso_calendar_date(last_date_text, strlen(last_date_text), last_day, last_month, last_booking_year)) {
+            continue; // Skip blank, comment and malformed lines
+        }
+        capacity_booking booking = {calculate_serial_day_number(first_day, first_month, first_booking_year),
+                                    calculate_serial_day_number(last_day, last_month, last_booking_year), booked_amount};
+        bookings.push_back(booking);
+        first_year = min(first_year, first_booking_year);
+        last_year = max(last_year, last_booking_year);
+    }
+    if (bookings.empty()) {
+        cout << "No bookings found in " << bookings_file_path << endl;
+        return 0;
+    }
+    sharded_capacity_calendar capacity_calendar;
+    initialize_sharded_capacity_calendar(capacity_calendar, first_year, last_year);
+    bulk_load_capacity_bookings(capacity_calendar, bookings);
+    
+    // Display the requested year (default: the first booked year) with occupancy markers
+    int display_year = find_command_line_integer_option(argument_count, argument_values, "--occupancy-year", first_year);
+    calendar_display_options display_options;
+    display_options.occupancy_calendar = &capacity_calendar;
+    display_options.occupancy_capacity = occupancy_capacity;
+    cout << "OCCUPANCY CALENDAR " << display_year << " (" << bookings.size() << " bookings, capacity "
+         << occupancy_capacity << ")" << endl;
+    cout << string(40, '-') << endl;
+    for (int target_month = 1; target_month <= 12; target_month++) {
+        generate_monthly_calendar_display(target_month, display_year, display_options);
+    }
+    return 0;
+}
+
+// Function times one random workload on the day scan and the sharded tree, returning false on any mismatch
+bool run_capacity_benchmark_profile(int operation_count, int thread_count, int maximum_range_days) {
+    // Horizon of 30 years; half the operations reserve a range, half query its peak level
+    const int first_year = 2020;
+    const int last_year = 2049;
+    sharded_capacity_calendar capacity_calendar;
+    initialize_sharded_capacity_calendar(capacity_calendar, first_year, last_year);
+    int horizon_first_serial_day = calculate_serial_day_number(1, 1, first_year);
+    int horizon_day_count = calculate_serial_day_number(31, 12, last_year) - horizon_first_serial_day + 1;
+    vector<int32_t> scanned_levels(size_t(horizon_day_count), 0);
+    
+    // Generate the operation stream once so both implementations see identical work
+    struct benchmark_operation { int first_day_index; int last_day_index; int32_t amount; };
+    vector<benchmark_operation> operations(static_cast<size_t>(operation_count));
+    uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+    for (size_t operation_index = 0; operation_index < operations.size(); operation_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        bool query_operation = (random_state & 1) != 0;
+        int range_length = 1 + int((random_state >> 8) % uint64_t(maximum_range_days));
+        int first_day_index = int((random_state >> 24) % uint64_t(horizon_day_count - range_length + 1));
+        benchmark_operation operation = {first_day_index, first_day_index + range_length - 1,
+                                         query_operation ? 0 : int32_t(1 + (random_state >> 40) % 5)};
+        operations[operation_index] = operation;
+    }
+    
+    // Day-by-day scan baseline
+    long long scan_checksum = 0;
+    chrono::steady_clock::time_point scan_start_time = chrono::steady_clock::now();
+    for (size_t operation_index = 0; operation_index < operations.size(); operation_index++) {
+        const benchmark_operation& operation = operations[operation_index];
+        if (operation.amount != 0) {
+            for (int day_index = operation.first_day_index; day_index <= operation.last_day_index; day_index++) {
+                scanned_levels[size_t(day_index)] += operation.amount;
+            }
+        } else {
+            scan_checksum += *max_element(scanned_levels.begin() + operation.first_day_index,
+                                          scanned_levels.begin() + operation.last_day_index + 1);
+        }
+    }
+    double scan_seconds = chrono::duration<double>(chrono::steady_clock::now() - scan_start_time).count();
+    
+    // Segment tree, single thread
+    long long tree_checksum = 0;
+    chrono::steady_clock::time_point tree_start_time = chrono::steady_clock::now();
+    for (size_t operation_index = 0; operation_index < operations.size(); operation_index++) {
+        const benchmark_operation& operation = operations[operation_index];
+        if (operation.amount != 0) {
+            reserve_capacity_range(capacity_calendar, horizon_first_serial_day + operation.first_day_index,
+                                   horizon_first_serial_day + operation.last_day_index, operation.amount);
+        } else {
+            tree_checksum += query_maximum_capacity_range(capacity_calendar, horizon_first_serial_day + operation.first_day_index,
+                                                          horizon_first_serial_day + operation.last_day_index);
+        }
+    }
+    double tree_seconds = chrono::duration<double>(chrono::steady_clock::now() - tree_start_time).count();
+    
+    // Segment tree, worker threads sharing the year shards (additions commute, so final levels are order independent)
+    chrono::steady_clock::time_point threaded_start_time = chrono::steady_clock::now();
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&, worker_index]() {
+            for (size_t operation_index = size_t(worker_index); operation_index < operations.size();
+                 operation_index += size_t(thread_count)) {
+                const benchmark_operation& operation = operations[operation_index];
+                if (operation.amount != 0) {
+                    reserve_capacity_range(capacity_calendar, horizon_first_serial_day + operation.first_day_index,
+                                           horizon_first_serial_day + operation.last_day_index, operation.amount);
+                } else {
+                    query_maximum_capacity_range(capacity_calendar, horizon_first_serial_day + operation.first_day_index,
+                                                 horizon_first_serial_day + operation.last_day_index);
+                }
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    double threaded_seconds = chrono::duration<double>(chrono::steady_clock::now() - threaded_start_time).count();
+    
+    // After the threaded pass every day holds exactly twice the scanned level
+    size_t mismatch_count = 0;
+    for (int day_index = 0; day_index < horizon_day_count; day_index++) {
+        int32_t tree_level = query_maximum_capacity_range(capacity_calendar, horizon_first_serial_day + day_index,
+                                                          horizon_first_serial_day + day_index);
+        mismatch_count += tree_level != 2 * scanned_levels[size_t(day_index)] ? 1 : 0;
+    }
+    
+    cout << "Ranges Up To " << maximum_range_days << " Days:" << endl;
+    cout << fixed << setprecision(1);
+    cout << "  Day Scan: " << scan_seconds * 1e9 / double(operations.size()) << " ns per operation" << endl;
+    cout << "  Segment Tree: " << tree_seconds * 1e9 / double(operations.size()) << " ns per operation ("
+         << setprecision(2) << (tree_seconds > 0.0 ? scan_seconds / tree_seconds : 0.0) << "x)" << endl;
+    cout << "  Segment Tree (" << thread_count << " threads): " << setprecision(1)
+         << threaded_seconds * 1e9 / double(operations.size()) << " ns per operation" << endl;
+    cout << "  Query Checksums: " << (scan_checksum == tree_checksum ? "match" : "MISMATCH")
+         << ", Final Level Mismatches: " << mismatch_count << endl;
+    return scan_checksum == tree_checksum && mismatch_count == 0;
+}
+
+int execute_capacity_benchmark(int operation_count, int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    cout << "CAPACITY SEGMENT TREE BENCHMARK (" << operation_count << " operations, 30 year shards)" << endl;
+    cout << string(60, '-') << endl;
+    
+    // Short stays favour the scan; multi-year leases and horizon queries favour the tree
+    bool results_match = run_capacity_benchmark_profile(operation_count, thread_count, 31);
+    results_match = run_capacity_benchmark_profile(operation_count, thread_count, 1826) && results_match;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+PACKED DATE VALUE TYPE FUNCTIONS
+================================================================================
+*/
+
+// Days preceding each month in a common year, indexed by month number (index 0 unused)
+const int16_t packed_date_days_before_month[16] = {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365, 365, 365};
+
+// Days in each month of a common year, indexed by month number (index 0 unused)
+const int8_t packed_date_month_lengths[16] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0};
+
+// Serial day number of 1900-01-01, the compact date epoch
+const int COMPACT_DATE_EPOCH_SERIAL_DAY = 693596;
+
+inline packed_calendar_date pack_calendar_date(int day_value, int month_value, int year_value) {
+    packed_calendar_date date_value = {uint32_t(year_value) << 9 | uint32_t(month_value) << 5 | uint32_t(day_value)};
+    return date_value;
+}
+
+inline int extract_packed_day(packed_calendar_date date_value) {
+    return int(date_value.packed_value & 31U);
+}
+
+inline int extract_packed_month(packed_calendar_date date_value) {
+    return int(date_value.packed_value >> 5 & 15U);
+}
+
+inline int extract_packed_year(packed_calendar_date date_value) {
+    return int(date_value.packed_value >> 9);
+}
+
+int convert_packed_date_to_serial_day(packed_calendar_date date_value) {
+    return calculate_serial_day_number(extract_packed_day(date_value), extract_packed_month(date_value),
+                                       extract_packed_year(date_value));
+}
+
+packed_calendar_date convert_serial_day_to_packed_date(int serial_day) {
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    return pack_calendar_date(day_value, month_value, year_value);
+}
+
+bool convert_packed_date_to_compact_date(packed_calendar_date date_value, compact_calendar_date& compact_date) {
+    int day_offset = convert_packed_date_to_serial_day(date_value) - COMPACT_DATE_EPOCH_SERIAL_DAY;
+    if (day_offset < 0 || day_offset > 65535) {
+        return false;
+    }
+    compact_date.day_offset = uint16_t(day_offset);
+    return true;
+}
+
+packed_calendar_date convert_compact_date_to_packed_date(compact_calendar_date compact_date) {
+    return convert_serial_day_to_packed_date(COMPACT_DATE_EPOCH_SERIAL_DAY + int(compact_date.day_offset));
+}
+
+bool calculate_leap_year_status(packed_calendar_date date_value) {
+    // Same Gregorian rule as the int form, evaluated without branches
+    int year_value = extract_packed_year(date_value);
+    return ((year_value % 4 == 0) & (year_value % 100 != 0)) | (year_value % 400 == 0);
+}
+
+int calculate_month_day_count(packed_calendar_date date_value) {
+    // February's leap day is masked in with a bitwise and, so neither operand short-circuits
+    int month_value = extract_packed_month(date_value);
+    return packed_date_month_lengths[month_value] + (int(month_value == 2) & int(calculate_leap_year_status(date_value)));
+}
+
+int calculate_day_of_year_position(packed_calendar_date date_value) {
+    // Table lookup replaces the month loop; the leap day counts only after February
+    int month_value = extract_packed_month(date_value);
+    return packed_date_days_before_month[month_value] + extract_packed_day(date_value) +
+           (int(month_value > 2) & int(calculate_leap_year_status(date_value)));
+}
+
+// Structure mirrors the separate-int layout used throughout the calendar code
+struct separate_calendar_date {
+    int day_value;
+    int month_value;
+    int year_value;
+};
+
+// Structure hashes the three fields with the boost-style combine step, the usual approach for separate ints
+struct separate_calendar_date_hasher {
+    size_t operator()(const separate_calendar_date& date_value) const {
+        size_t hash_value = hash<int>()(date_value.year_value);
+        hash_value ^= hash<int>()(date_value.month_value) + 0x9E3779B9U + (hash_value << 6) + (hash_value >> 2);
+        hash_value ^= hash<int>()(date_value.day_value) + 0x9E3779B9U + (hash_value << 6) + (hash_value >> 2);
+        return hash_value;
+    }
+};
+
+// Structure compares all three fields for hashed containers
+struct separate_calendar_date_equality {
+    bool operator()(const separate_calendar_date& left_date, const separate_calendar_date& right_date) const {
+        return left_date.day_value == right_date.day_value && left_date.month_value == right_date.month_value &&
+               left_date.year_value == right_date.year_value;
+    }
+};
+
+int execute_packed_date_benchmark(int date_count) {
+    // Random dates across the compact range so every layout holds identical values
+    vector<separate_calendar_date> separate_dates(static_cast<size_t>(date_count));
+    vector<packed_calendar_date> packed_dates(static_cast<size_t>(date_count));
+    vector<compact_calendar_date> compact_dates(static_cast<size_t>(date_count));
+    uint64_t random_state = 0x2545F4914F6CDD1DULL;
+    for (size_t date_index = 0; date_index < separate_dates.size(); date_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        compact_dates[date_index].day_offset = uint16_t(random_state % 65536);
+        packed_dates[date_index] = convert_compact_date_to_packed_date(compact_dates[date_index]);
+        separate_calendar_date separate_date = {extract_packed_day(packed_dates[date_index]),
+                                                extract_packed_month(packed_dates[date_index]),
+                                                extract_packed_year(packed_dates[date_index])};
+        separate_dates[date_index] = separate_date;
+    }
+    
+    // Round trips through every representation must agree before timing anything
+    size_t round_trip_failures = 0;
+    for (size_t date_index = 0; date_index < separate_dates.size(); date_index++) {
+        compact_calendar_date compact_date = {0};
+        round_trip_failures += !convert_packed_date_to_compact_date(packed_dates[date_index], compact_date) ||
+                               compact_date.day_offset != compact_dates[date_index].day_offset ||
+                               convert_serial_day_to_packed_date(convert_packed_date_to_serial_day(packed_dates[date_index])) !=
+                               packed_dates[date_index] ? 1 : 0;
+    }
+    
+    cout << "PACKED DATE BENCHMARK (" << date_count << " dates, 1900-01-01 to 2079-06-06)" << endl;
+    cout << string(60, '-') << endl;
+    cout << "Memory: separate ints " << separate_dates.size() * sizeof(separate_calendar_date) / 1024
+         << " KiB, packed 32-bit " << packed_dates.size() * sizeof(packed_calendar_date) / 1024
+         << " KiB, compact 16-bit " << compact_dates.size() * sizeof(compact_calendar_date) / 1024 << " KiB" << endl;
+    cout << fixed << setprecision(2);
+    
+    // Day-of-year positions
+    long long separate_checksum = 0;
+    long long packed_checksum = 0;
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    for (size_t date_index = 0; date_index < separate_dates.size(); date_index++) {
+        separate_checksum += calculate_day_of_year_position(separate_dates[date_index].day_value,
+                                                            separate_dates[date_index].month_value,
+                                                            separate_dates[date_index].year_value);
+    }
+    double separate_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    start_time = chrono::steady_clock::now();
+    for (size_t date_index = 0; date_index < packed_dates.size(); date_index++) {
+        packed_checksum += calculate_day_of_year_position(packed_dates[date_index]);
+    }
+    double packed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    cout << "Day Of Year: separate " << separate_seconds * 1e9 / date_count << " ns, packed "
+         << packed_seconds * 1e9 / date_count << " ns per date (" << (separate_checksum == packed_checksum ? "match" : "MISMATCH")
+         << ")" << endl;
+    bool results_match = separate_checksum == packed_checksum;
+    
+    // Sorting by date order
+    vector<separate_calendar_date> sorted_separate_dates(separate_dates);
+    vector<packed_calendar_date> sorted_packed_dates(packed_dates);
+    vector<compact_calendar_date> sorted_compact_dates(compact_dates);
+    start_time = chrono::steady_clock::now();
+    sort(sorted_separate_dates.begin(), sorted_separate_dates.end(),
+         [](const separate_calendar_date& left_date, const separate_calendar_date& right_date) {
+             if (left_date.year_value != right_date.year_value) return left_date.year_value < right_date.year_value;
+             if (left_date.month_value != right_date.month_value) return left_date.month_value < right_date.month_value;
+             return left_date.day_value < right_date.day_value;
+         });
+    separate_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    start_time = chrono::steady_clock::now();
+    sort(sorted_packed_dates.begin(), sorted_packed_dates.end());
+    packed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    start_time = chrono::steady_clock::now();
+    sort(sorted_compact_dates.begin(), sorted_compact_dates.end());
+    double compact_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    bool sorted_orders_match = true;
+    for (size_t date_index = 0; date_index < sorted_packed_dates.size(); date_index++) {
+        sorted_orders_match = sorted_orders_match &&
+            pack_calendar_date(sorted_separate_dates[date_index].day_value, sorted_separate_dates[date_index].month_value,
+                               sorted_separate_dates[date_index].year_value) == sorted_packed_dates[date_index] &&
+            convert_compact_date_to_packed_date(sorted_compact_dates[date_index]) == sorted_packed_dates[date_index];
+    }
+    cout << "Sort: separate " << separate_seconds * 1e3 << " ms, packed " << packed_seconds * 1e3 << " ms, compact "
+         << compact_seconds * 1e3 << " ms (" << (sorted_orders_match ? "match" : "MISMATCH") << ")" << endl;
+    results_match = results_match && sorted_orders_match;
+    
+    // Distinct counting through hashed sets
+    start_time = chrono::steady_clock::now();
+    unordered_set<separate_calendar_date, separate_calendar_date_hasher, separate_calendar_date_equality> separate_date_set;
+    for (size_t date_index = 0; date_index < separate_dates.size(); date_index++) {
+        separate_date_set.insert(separate_dates[date_index]);
+    }
+    separate_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    start_time = chrono::steady_clock::now();
+    unordered_set<packed_calendar_date, packed_calendar_date_hasher> packed_date_set;
+    for (size_t date_index = 0; date_index < packed_dates.size(); date_index++) {
+        packed_date_set.insert(packed_dates[date_index]);
+    }
+    packed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    cout << "Distinct (hash set): separate " << separate_seconds * 1e3 << " ms, packed " << packed_seconds * 1e3 << " ms ("
+         << packed_date_set.size() << " distinct, " << (separate_date_set.size() == packed_date_set.size() ? "match" : "MISMATCH")
+         << ")" << endl;
+    results_match = results_match && separate_date_set.size() == packed_date_set.size();
+    
+    cout << "Round Trip Failures: " << round_trip_failures << endl;
+    return results_match && round_trip_failures == 0 ? 0 : 1;
+}
+
+/*
+================================================================================
+RADIX DATE SORT FUNCTIONS
+================================================================================
+*/
+
+// Radix digit width; 11 bits keep one histogram per thread inside L1 cache
+const int RADIX_DATE_DIGIT_BITS = 11;
+const size_t RADIX_DATE_BUCKET_COUNT = size_t(1) << RADIX_DATE_DIGIT_BITS;
+
+// Columns shorter than this are sorted by std::sort, and each radix worker gets at least this many elements
+const size_t RADIX_DATE_MINIMUM_ELEMENTS = 65536;
+
+// Function runs a worker body once per thread index, inline when a single thread is requested
+template <typename worker_function_type>
+void run_radix_sort_workers(int thread_count, const worker_function_type& worker_function) {
+    if (thread_count == 1) {
+        worker_function(0);
+        return;
+    }
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread(worker_function, worker_index));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+}
+
+template <typename date_element_type>
+size_t radix_sort_date_column(date_element_type* date_elements, size_t element_count, bool remove_duplicates,
+                              int thread_count) {
+    if (element_count < 2) {
+        return element_count;
+    }
+    if (element_count < RADIX_DATE_MINIMUM_ELEMENTS) {
+        sort(date_elements, date_elements + element_count, [](date_element_type left_date, date_element_type right_date) {
+            return extract_radix_date_key(left_date) < extract_radix_date_key(right_date);
+        });
+        if (!remove_duplicates) {
+            return element_count;
+        }
+        return size_t(unique(date_elements, date_elements + element_count,
+                             [](date_element_type left_date, date_element_type right_date) {
+                                 return extract_radix_date_key(left_date) == extract_radix_date_key(right_date);
+                             }) - date_elements);
+    }
+    
+    // Keys are rebased on the column minimum so clustered dates need only as many passes as their span
+    uint32_t minimum_key = extract_radix_date_key(date_elements[0]);
+    uint32_t maximum_key = minimum_key;
+    for (size_t element_index = 1; element_index < element_count; element_index++) {
+        uint32_t date_key = extract_radix_date_key(date_elements[element_index]);
+        minimum_key = min(minimum_key, date_key);
+        maximum_key = max(maximum_key, date_key);
+    }
+    int pass_count = 0;
+    for (uint64_t remaining_span = maximum_key - minimum_key; remaining_span > 0; remaining_span >>= RADIX_DATE_DIGIT_BITS) {
+        pass_count++;
+    }
+    if (pass_count == 0) {
+        return remove_duplicates ? 1 : element_count;
+    }
+    
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    thread_count = int(min(size_t(thread_count), max(size_t(1), element_count / RADIX_DATE_MINIMUM_ELEMENTS)));
+    size_t chunk_size = (element_count + size_t(thread_count) - 1) / size_t(thread_count);
+    
+    // Per-thread histograms become per-thread write cursors; segment starts bound the duplicate check
+    vector<date_element_type> scratch_elements(element_count);
+    vector<size_t> bucket_cursors(size_t(thread_count) * RADIX_DATE_BUCKET_COUNT);
+    vector<size_t> segment_starts(size_t(thread_count) * RADIX_DATE_BUCKET_COUNT);
+    date_element_type* source_elements = date_elements;
+    date_element_type* destination_elements = &scratch_elements[0];
+    
+    for (int pass_index = 0; pass_index < pass_count; pass_index++) {
+        int digit_shift = pass_index * RADIX_DATE_DIGIT_BITS;
+        run_radix_sort_workers(thread_count, [&](int worker_index) {
+            size_t* worker_histogram = &bucket_cursors[size_t(worker_index) * RADIX_DATE_BUCKET_COUNT];
+            fill(worker_histogram, worker_histogram + RADIX_DATE_BUCKET_COUNT, size_t(0));
+            size_t chunk_end = min(element_count, size_t(worker_index + 1) * chunk_size);
+            for (size_t element_index = size_t(worker_index) * chunk_size; element_index < chunk_end; element_index++) {
+                worker_histogram[(extract_radix_date_key(source_elements[element_index]) - minimum_key) >> digit_shift &
+                                 (RADIX_DATE_BUCKET_COUNT - 1)]++;
+            }
+        });
+        
+        // A pass where every key shares the digit leaves the order unchanged; the top pass never does
+        bool final_pass = pass_index == pass_count - 1;
+        bool single_bucket_pass = false;
+        size_t running_offset = 0;
+        for (size_t bucket_index = 0; bucket_index < RADIX_DATE_BUCKET_COUNT; bucket_index++) {
+            size_t bucket_start = running_offset;
+            for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+                size_t& bucket_cursor = bucket_cursors[size_t(worker_index) * RADIX_DATE_BUCKET_COUNT + bucket_index];
+                size_t bucket_count = bucket_cursor;
+                bucket_cursor = running_offset;
+                segment_starts[size_t(worker_index) * RADIX_DATE_BUCKET_COUNT + bucket_index] = running_offset;
+                running_offset += bucket_count;
+            }
+            single_bucket_pass = single_bucket_pass || running_offset - bucket_start == element_count;
+        }
+        if (single_bucket_pass && !final_pass) {
+            continue;
+        }
+        
+        // Stable scatter; on the final pass equal keys arrive adjacent within each worker segment and are dropped
+        bool fuse_deduplication = remove_duplicates && final_pass;
+        run_radix_sort_workers(thread_count, [&](int worker_index) {
+            size_t* worker_cursors = &bucket_cursors[size_t(worker_index) * RADIX_DATE_BUCKET_COUNT];
+            const size_t* worker_segment_starts = &segment_starts[size_t(worker_index) * RADIX_DATE_BUCKET_COUNT];
+            size_t chunk_end = min(element_count, size_t(worker_index + 1) * chunk_size);
+            for (size_t element_index = size_t(worker_index) * chunk_size; element_index < chunk_end; element_index++) {
+                date_element_type date_element = source_elements[element_index];
+                uint32_t date_key = extract_radix_date_key(date_element);
+                size_t bucket_index = (date_key - minimum_key) >> digit_shift & (RADIX_DATE_BUCKET_COUNT - 1);
+                size_t& write_position = worker_cursors[bucket_index];
+                if (fuse_deduplication && write_position != worker_segment_starts[bucket_index] &&
+                    extract_radix_date_key(destination_elements[write_position - 1]) == date_key) {
+                    continue;
+                }
+                destination_elements[write_position++] = date_element;
+            }
+        });
+        swap(source_elements, destination_elements);
+    }
+    
+    if (!remove_duplicates) {
+        if (source_elements != date_elements) {
+            copy(source_elements, source_elements + element_count, date_elements);
+        }
+        return element_count;
+    }
+    
+    // Close the gaps left by dropped duplicates, also dropping repeats that straddle worker segments
+    size_t unique_count = 0;
+    for (size_t bucket_index = 0; bucket_index < RADIX_DATE_BUCKET_COUNT; bucket_index++) {
+        for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+            size_t segment_index = size_t(worker_index) * RADIX_DATE_BUCKET_COUNT + bucket_index;
+            for (size_t element_index = segment_starts[segment_index]; element_index < bucket_cursors[segment_index];
+                 element_index++) {
+                if (unique_count == 0 || extract_radix_date_key(date_elements[unique_count - 1]) !=
+                                         extract_radix_date_key(source_elements[element_index])) {
+                    date_elements[unique_count++] = source_elements[element_index];
+                }
+            }
+        }
+    }
+    return unique_count;
+}
+
+// Function fills a serial day column: clustered recent dates with a long tail, or uniform over 1900-2079
+void generate_date_sort_column(vector<int32_t>& serial_days, bool clustered_distribution) {
+    int tail_first_serial_day = calculate_serial_day_number(1, 1, 1900);
+    int recent_first_serial_day = calculate_serial_day_number(1, 1, 2024);
+    int last_serial_day = calculate_serial_day_number(6, 6, 2079);
+    uint64_t random_state = clustered_distribution ? 0xD1B54A32D192ED03ULL : 0x8BB84B93962EACC9ULL;
+    for (size_t element_index = 0; element_index < serial_days.size(); element_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        if (clustered_distribution && random_state % 10 != 0) {
+            serial_days[element_index] = recent_first_serial_day + int((random_state >> 8) % 731);
+        } else {
+            serial_days[element_index] = tail_first_serial_day + int((random_state >> 8) % uint64_t(last_serial_day - tail_first_serial_day + 1));
+        }
+    }
+}
+
+int execute_date_sort_benchmark(int element_count, int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    cout << "DATE SORT BENCHMARK (" << element_count << " dates, " << thread_count << " threads)" << endl;
+    cout << string(60, '-') << endl;
+    cout << fixed << setprecision(1);
+    bool results_match = true;
+    for (int distribution_index = 0; distribution_index < 2; distribution_index++) {
+        bool clustered_distribution = distribution_index == 0;
+        vector<int32_t> serial_days(static_cast<size_t>(element_count));
+        generate_date_sort_column(serial_days, clustered_distribution);
+        cout << (clustered_distribution ? "Clustered (90% in 2024-2025, tail from 1900):" : "Uniform (1900-2079):") << endl;
+        
+        // Baseline: comparison sort on (year, month, day) tuples, then unique
+        vector<separate_calendar_date> tuple_dates(serial_days.size());
+        for (size_t element_index = 0; element_index < serial_days.size(); element_index++) {
+            convert_serial_day_to_calendar_date(serial_days[element_index], tuple_dates[element_index].day_value,
+                                                tuple_dates[element_index].month_value, tuple_dates[element_index].year_value);
+        }
+        chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+        sort(tuple_dates.begin(), tuple_dates.end(), [](const separate_calendar_date& left_date, const separate_calendar_date& right_date) {
+            if (left_date.year_value != right_date.year_value) return left_date.year_value < right_date.year_value;
+            if (left_date.month_value != right_date.month_value) return left_date.month_value < right_date.month_value;
+            return left_date.day_value < right_date.day_value;
+        });
+        size_t tuple_unique_count = size_t(unique(tuple_dates.begin(), tuple_dates.end(), separate_calendar_date_equality()) -
+                                           tuple_dates.begin());
+        double tuple_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        
+        // std::sort on serial days, with and without unique
+        vector<int32_t> reference_days(serial_days);
+        start_time = chrono::steady_clock::now();
+        sort(reference_days.begin(), reference_days.end());
+        double reference_sort_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        start_time = chrono::steady_clock::now();
+        vector<int32_t> reference_unique_days(serial_days);
+        sort(reference_unique_days.begin(), reference_unique_days.end());
+        reference_unique_days.erase(unique(reference_unique_days.begin(), reference_unique_days.end()), reference_unique_days.end());
+        double reference_unique_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        
+        // Radix sort on serial days: plain, fused dedupe on one thread and on all threads
+        vector<int32_t> radix_days(serial_days);
+        start_time = chrono::steady_clock::now();
+        radix_sort_date_column(&radix_days[0], radix_days.size(), false, thread_count);
+        double radix_sort_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        results_match = results_match && radix_days == reference_days;
+        
+        radix_days = serial_days;
+        start_time = chrono::steady_clock::now();
+        radix_days.resize(radix_sort_date_column(&radix_days[0], radix_days.size(), true, 1));
+        double radix_single_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        results_match = results_match && radix_days == reference_unique_days;
+        
+        radix_days = serial_days;
+        start_time = chrono::steady_clock::now();
+        radix_days.resize(radix_sort_date_column(&radix_days[0], radix_days.size(), true, thread_count));
+        double radix_threaded_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        results_match = results_match && radix_days == reference_unique_days && tuple_unique_count == radix_days.size();
+        
+        // Radix sort on packed dates with fused dedupe
+        vector<packed_calendar_date> packed_dates(serial_days.size());
+        for (size_t element_index = 0; element_index < serial_days.size(); element_index++) {
+            packed_dates[element_index] = convert_serial_day_to_packed_date(serial_days[element_index]);
+        }
+        start_time = chrono::steady_clock::now();
+        packed_dates.resize(radix_sort_date_column(&packed_dates[0], packed_dates.size(), true, thread_count));
+        double radix_packed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        for (size_t element_index = 0; results_match && element_index < packed_dates.size(); element_index++) {
+            results_match = convert_packed_date_to_serial_day(packed_dates[element_index]) == reference_unique_days[element_index];
+        }
+        results_match = results_match && packed_dates.size() == reference_unique_days.size();
+        
+        cout << "  std::sort tuples + unique:       " << tuple_seconds * 1e3 << " ms" << endl;
+        cout << "  std::sort serial days:           " << reference_sort_seconds * 1e3 << " ms" << endl;
+        cout << "  radix serial days:               " << radix_sort_seconds * 1e3 << " ms" << endl;
+        cout << "  std::sort + unique serial days:  " << reference_unique_seconds * 1e3 << " ms" << endl;
+        cout << "  radix + dedupe (1 thread):       " << radix_single_seconds * 1e3 << " ms" << endl;
+        cout << "  radix + dedupe (" << thread_count << " threads):      " << radix_threaded_seconds * 1e3 << " ms" << endl;
+        cout << "  radix + dedupe packed dates:     " << radix_packed_seconds * 1e3 << " ms (" << reference_unique_days.size()
+             << " distinct)" << endl;
+    }
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+CALENDAR GROUP-BY AGGREGATION FUNCTIONS
+================================================================================
+*/
+
+// Key names accepted by --group-by, indexed by calendar_group_key_kind
+static const char* const calendar_group_key_names[GROUP_BY_KEY_COUNT] = {"weekday", "iso-week", "month", "quarter",
+                                                                         "day-of-year"};
+
+bool parse_calendar_group_key(const string& key_text, calendar_group_key_kind& key_kind) {
+    for (int key_index = 0; key_index < GROUP_BY_KEY_COUNT; key_index++) {
+        if (key_text == calendar_group_key_names[key_index]) {
+            key_kind = calendar_group_key_kind(key_index);
+            return true;
+        }
+    }
+    return false;
+}
+
+int calculate_calendar_group_count(calendar_group_key_kind key_kind) {
+    static const int group_counts[GROUP_BY_KEY_COUNT] = {7, 53, 12, 4, 366};
+    return group_counts[key_kind];
+}
+
+int calculate_calendar_group_index(int serial_day, calendar_group_key_kind key_kind) {
+    if (key_kind == GROUP_BY_WEEKDAY) {
+        return serial_day % 7;
+    }
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    if (key_kind == GROUP_BY_ISO_WEEK) {
+        int iso_week = 0;
+        int iso_year = 0;
+        calculate_iso_week_date(day_value, month_value, year_value, iso_week, iso_year);
+        return iso_week - 1;
+    }
+    if (key_kind == GROUP_BY_MONTH) {
+        return month_value - 1;
+    }
+    if (key_kind == GROUP_BY_QUARTER) {
+        return (month_value - 1) / 3;
+    }
+    return calculate_day_of_year_position(pack_calendar_date(day_value, month_value, year_value)) - 1;
+}
+
+// Function folds one row into a group aggregate
+inline void accumulate_calendar_group_value(calendar_group_aggregate& group_aggregate, double value) {
+    group_aggregate.value_sum += value;
+    group_aggregate.row_count++;
+    group_aggregate.minimum_value = min(group_aggregate.minimum_value, value);
+    group_aggregate.maximum_value = max(group_aggregate.maximum_value, value);
+}
+
+void aggregate_calendar_groups(const int32_t* serial_days, const double* values, size_t row_count,
+                               calendar_group_key_kind key_kind, int thread_count,
+                               vector<calendar_group_aggregate>& group_aggregates) {
+    calendar_group_aggregate empty_aggregate = {0.0, 0, HUGE_VAL, -HUGE_VAL};
+    size_t group_count = size_t(calculate_calendar_group_count(key_kind));
+    group_aggregates.assign(group_count, empty_aggregate);
+    if (row_count == 0) {
+        return;
+    }
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    thread_count = int(min(size_t(thread_count), max(size_t(1), row_count / 65536)));
+    
+    // Derive each key once per distinct day of the column span, so the row loop is a table lookup
+    // (weekdays need only a remainder, so they skip the extra pass over the column)
+    int32_t first_serial_day = 0;
+    vector<uint16_t> group_index_table;
+    pair<const int32_t*, const int32_t*> serial_day_range(serial_days, serial_days);
+    if (key_kind != GROUP_BY_WEEKDAY) {
+        serial_day_range = minmax_element(serial_days, serial_days + row_count);
+        first_serial_day = *serial_day_range.first;
+    }
+    size_t span_day_count = size_t(*serial_day_range.second - first_serial_day) + 1;
+    if (key_kind != GROUP_BY_WEEKDAY && span_day_count <= row_count) {
+        group_index_table.resize(span_day_count);
+        for (size_t day_offset = 0; day_offset < span_day_count; day_offset++) {
+            group_index_table[day_offset] = uint16_t(calculate_calendar_group_index(first_serial_day + int(day_offset), key_kind));
+        }
+    }
+    
+    // Each worker fills a private dense partial aggregate, merged after all workers finish
+    vector<vector<calendar_group_aggregate> > partial_aggregates(size_t(thread_count),
+                                                                 vector<calendar_group_aggregate>(group_count, empty_aggregate));
+    size_t chunk_size = (row_count + size_t(thread_count) - 1) / size_t(thread_count);
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&, worker_index]() {
+            // Column pointers are copied locally so stores into the aggregates cannot force reloads
+            calendar_group_aggregate* worker_aggregates = &partial_aggregates[size_t(worker_index)][0];
+            const int32_t* worker_serial_days = serial_days;
+            const double* worker_values = values;
+            size_t chunk_end = min(row_count, size_t(worker_index + 1) * chunk_size);
+            size_t row_index = size_t(worker_index) * chunk_size;
+            if (key_kind == GROUP_BY_WEEKDAY) {
+                for (; row_index < chunk_end; row_index++) {
+                    accumulate_calendar_group_value(worker_aggregates[worker_serial_days[row_index] % 7], worker_values[row_index]);
+                }
+            } else if (!group_index_table.empty()) {
+                const uint16_t* group_indexes = &group_index_table[0];
+                int32_t table_first_serial_day = first_serial_day;
+                for (; row_index < chunk_end; row_index++) {
+                    accumulate_calendar_group_value(worker_aggregates[group_indexes[worker_serial_days[row_index] - table_first_serial_day]],
+                                                    worker_values[row_index]);
+                }
+            } else {
+                for (; row_index < chunk_end; row_index++) {
+                    accumulate_calendar_group_value(
+                        worker_aggregates[calculate_calendar_group_index(worker_serial_days[row_index], key_kind)],
+                        worker_values[row_index]);
+                }
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    for (size_t worker_index = 0; worker_index < partial_aggregates.size(); worker_index++) {
+        for (size_t group_index = 0; group_index < group_count; group_index++) {
+            const calendar_group_aggregate& partial_aggregate = partial_aggregates[worker_index][group_index];
+            group_aggregates[group_index].value_sum += partial_aggregate.value_sum;
+            group_aggregates[group_index].row_count += partial_aggregate.row_count;
+            group_aggregates[group_index].minimum_value = min(group_aggregates[group_index].minimum_value,
+                                                              partial_aggregate.minimum_value);
+            group_aggregates[group_index].maximum_value = max(group_aggregates[group_index].maximum_value,
+                                                              partial_aggregate.maximum_value);
+        }
+    }
+}
+
+// Function returns the display label of one group
+string format_calendar_group_label(calendar_group_key_kind key_kind, int group_index) {
+    static const char* const weekday_labels[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    char label_text[16];
+    if (key_kind == GROUP_BY_WEEKDAY) {
+        return weekday_labels[group_index];
+    } else if (key_kind == GROUP_BY_ISO_WEEK) {
+        snprintf(label_text, sizeof(label_text), "W%02d", group_index + 1);
+    } else if (key_kind == GROUP_BY_MONTH) {
+        return convert_month_number_to_text(group_index + 1);
+    } else if (key_kind == GROUP_BY_QUARTER) {
+        snprintf(label_text, sizeof(label_text), "Q%d", group_index + 1);
+    } else {
+        snprintf(label_text, sizeof(label_text), "Day %d", group_index + 1);
+    }
+    return label_text;
+}
+
+int execute_calendar_group_by(const string& key_text, const string& input_file_path, int thread_count) {
+    calendar_group_key_kind key_kind = GROUP_BY_WEEKDAY;
+    if (!parse_calendar_group_key(key_text, key_kind)) {
+        cout << "ERROR: Unknown group key '" << key_text << "' (weekday, iso-week, month, quarter, day-of-year)" << endl;
+        return 1;
+    }
+    mapped_file_region input_region;
+    if (!map_file_read_only(input_file_path, input_region)) {
+        cout << "ERROR: Unable to read " << input_file_path << endl;
+        return 1;
+    }
+    
+    // Rows are "YYYY-MM-DD,value"; header and malformed lines are counted and skipped
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    vector<int32_t> serial_days;
+    vector<double> values;
+    size_t skipped_line_count = 0;
+    const char* line_start = input_region.mapped_data;
+    const char* data_end = input_region.mapped_data + input_region.mapped_size;
+    while (line_start < data_end) {
+        const char* line_end = static_cast<const char*>(memchr(line_start, '\n', size_t(data_end - line_start)));
+        if (line_end == NULL) {
+            line_end = data_end;
+        }
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        const char* value_start = line_start + 11;
+        char* value_end = NULL;
+        double row_value = 0.0;
+        if (line_end - line_start > 11 && line_start[10] == ',' &&
+            parse_iso_calendar_date(line_start, 10, day_value, month_value, year_value)) {
+            string value_text(value_start, line_end);
+            row_value = strtod(value_text.c_str(), &value_end);
+            if (value_end != value_text.c_str()) {
+                serial_days.push_back(calculate_serial_day_number(day_value, month_value, year_value));
+                values.push_back(row_value);
+            } else {
+                skipped_line_count++;
+            }
+        } else if (line_end > line_start) {
+            skipped_line_count++;
+        }
+        line_start = line_end + 1;
+    }
+    unmap_file_region(input_region);
+    double parse_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    vector<calendar_group_aggregate> group_aggregates;
+    start_time = chrono::steady_clock::now();
+    aggregate_calendar_groups(serial_days.empty() ? NULL : &serial_days[0], values.empty() ? NULL : &values[0],
+                              serial_days.size(), key_kind, thread_count, group_aggregates);
+    double aggregate_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    cout << "GROUP BY " << calendar_group_key_names[key_kind] << " (" << serial_days.size() << " rows, "
+         << skipped_line_count << " skipped)" << endl;
+    cout << string(72, '-') << endl;
+    cout << left << setw(12) << "Group" << right << setw(12) << "Rows" << setw(16) << "Sum" << setw(16) << "Min"
+         << setw(16) << "Max" << endl;
+    cout << fixed << setprecision(2);
+    for (size_t group_index = 0; group_index < group_aggregates.size(); group_index++) {
+        const calendar_group_aggregate& group_aggregate = group_aggregates[group_index];
+        if (group_aggregate.row_count == 0) {
+            continue;
+        }
+        cout << left << setw(12) << format_calendar_group_label(key_kind, int(group_index)) << right << setw(12)
+             << group_aggregate.row_count << setw(16) << group_aggregate.value_sum << setw(16) << group_aggregate.minimum_value
+             << setw(16) << group_aggregate.maximum_value << endl;
+    }
+    cout << "Parse: " << setprecision(1) << parse_seconds * 1e3 << " ms, Aggregate: " << aggregate_seconds * 1e3 << " ms ("
+         << (aggregate_seconds > 0.0 ? double(serial_days.size()) / aggregate_seconds / 1e6 : 0.0) << " M rows/s)" << endl;
+    return 0;
+}
+
+int execute_group_by_benchmark(int row_count, const string& key_text, int thread_count) {
+    calendar_group_key_kind key_kind = GROUP_BY_WEEKDAY;
+    if (!parse_calendar_group_key(key_text, key_kind)) {
+        cout << "ERROR: Unknown group key '" << key_text << "' (weekday, iso-week, month, quarter, day-of-year)" << endl;
+        return 1;
+    }
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    
+    // Ten years of daily facts in random order with integral values so sums compare exactly
+    vector<int32_t> serial_days(static_cast<size_t>(row_count));
+    vector<double> values(static_cast<size_t>(row_count));
+    int first_serial_day = calculate_serial_day_number(1, 1, 2015);
+    uint64_t random_state = 0xA0761D6478BD642FULL;
+    for (size_t row_index = 0; row_index < serial_days.size(); row_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        serial_days[row_index] = first_serial_day + int(random_state % 3653);
+        values[row_index] = double((random_state >> 20) % 10000);
+    }
+    
+    // Baseline: derive every row's key with separate calendar calls
+    calendar_group_aggregate empty_aggregate = {0.0, 0, HUGE_VAL, -HUGE_VAL};
+    vector<calendar_group_aggregate> baseline_aggregates(size_t(calculate_calendar_group_count(key_kind)), empty_aggregate);
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    for (size_t row_index = 0; row_index < serial_days.size(); row_index++) {
+        accumulate_calendar_group_value(baseline_aggregates[size_t(calculate_calendar_group_index(serial_days[row_index], key_kind))],
+                                        values[row_index]);
+    }
+    double baseline_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    vector<calendar_group_aggregate> single_aggregates;
+    start_time = chrono::steady_clock::now();
+    aggregate_calendar_groups(&serial_days[0], &values[0], serial_days.size(), key_kind, 1, single_aggregates);
+    double single_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    vector<calendar_group_aggregate> threaded_aggregates;
+    start_time = chrono::steady_clock::now();
+    aggregate_calendar_groups(&serial_days[0], &values[0], serial_days.size(), key_kind, thread_count, threaded_aggregates);
+    double threaded_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    bool results_match = true;
+    for (size_t group_index = 0; group_index < baseline_aggregates.size(); group_index++) {
+        for (int result_index = 0; result_index < 2; result_index++) {
+            const calendar_group_aggregate& kernel_aggregate = result_index == 0 ? single_aggregates[group_index] :
+                                                                                   threaded_aggregates[group_index];
+            results_match = results_match && kernel_aggregate.row_count == baseline_aggregates[group_index].row_count &&
+                            kernel_aggregate.value_sum == baseline_aggregates[group_index].value_sum &&
+                            kernel_aggregate.minimum_value == baseline_aggregates[group_index].minimum_value &&
+                            kernel_aggregate.maximum_value == baseline_aggregates[group_index].maximum_value;
+        }
+    }
+    
+    cout << "GROUP-BY BENCHMARK (" << row_count << " rows, key " << calendar_group_key_names[key_kind] << ")" << endl;
+    cout << string(60, '-') << endl;
+    cout << fixed << setprecision(1);
+    cout << "Per-Row Derivation: " << double(row_count) / baseline_seconds / 1e6 << " M rows/s" << endl;
+    cout << "Fused Kernel (1 thread): " << double(row_count) / single_seconds / 1e6 << " M rows/s" << endl;
+    cout << "Fused Kernel (" << thread_count << " threads): " << double(row_count) / threaded_seconds / 1e6 << " M rows/s" << endl;
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+BUSINESS-DAY RESAMPLING FUNCTIONS
+================================================================================
+*/
+
+vector<int32_t> build_business_day_index(int first_serial_day, int last_serial_day, resample_calendar_kind calendar_kind,
+                                         const vector<uint8_t>& holiday_table, uint8_t holiday_mask) {
+    vector<int32_t> target_days;
+    if (calendar_kind == RESAMPLE_CALENDAR_MONTH_END) {
+        // A partial final month is still labelled by its real last business day
+        int day_value = 0, month_value = 0, year_value = 0;
+        convert_serial_day_to_calendar_date(last_serial_day, day_value, month_value, year_value);
+        last_serial_day += calculate_month_day_count(month_value, year_value) - day_value;
+    }
+    target_days.reserve(size_t(max(0, last_serial_day - first_serial_day + 1)));
+    for (int serial_day = first_serial_day; serial_day <= last_serial_day; serial_day++) {
+        int weekday_index = serial_day % 7;
+        bool holiday_day = !holiday_table.empty() && (holiday_table[size_t(serial_day)] & holiday_mask) != 0;
+        if (weekday_index != 0 && weekday_index != 6 && !holiday_day) {
+            target_days.push_back(serial_day);
+        }
+    }
+    if (calendar_kind == RESAMPLE_CALENDAR_MONTH_END) {
+        // Keep a business day only when the next business day falls in another month
+        size_t kept_count = 0;
+        for (size_t day_index = 0; day_index < target_days.size(); day_index++) {
+            int day_value = 0, month_value = 0, year_value = 0;
+            int next_day_value = 0, next_month_value = 0, next_year_value = 0;
+            convert_serial_day_to_calendar_date(target_days[day_index], day_value, month_value, year_value);
+            if (day_index + 1 < target_days.size()) {
+                convert_serial_day_to_calendar_date(target_days[day_index + 1], next_day_value, next_month_value, next_year_value);
+            }
+            if (day_index + 1 == target_days.size() || next_month_value != month_value) {
+                target_days[kept_count++] = target_days[day_index];
+            }
+        }
+        target_days.resize(kept_count);
+    }
+    return target_days;
+}
+
+void align_series_to_calendar(const vector<int32_t>& target_days, const resample_series_columns& series_columns,
+                              resample_fill_method fill_method) {
+    // Both sequences ascend, so one cursor over the observations serves every target day
+    size_t observation_index = 0;
+    double carried_value = NAN;
+    for (size_t target_index = 0; target_index < target_days.size(); target_index++) {
+        int32_t target_day = target_days[target_index];
+        double bucket_sum = 0.0;
+        double bucket_last_value = NAN;
+        while (observation_index < series_columns.observation_count &&
+               series_columns.observation_days[observation_index] <= target_day) {
+            bucket_last_value = series_columns.observation_values[observation_index];
+            bucket_sum += bucket_last_value;
+            observation_index++;
+        }
+        if (bucket_last_value == bucket_last_value) {
+            carried_value = bucket_last_value;
+        }
+        series_columns.output_values[target_index] = fill_method == RESAMPLE_FILL_FORWARD ? carried_value :
+                                                     fill_method == RESAMPLE_FILL_LAST_VALUE ? bucket_last_value : bucket_sum;
+    }
+}
+
+void resample_series_batch(const vector<int32_t>& target_days, const vector<resample_series_columns>& series_columns,
+                           resample_fill_method fill_method, int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    thread_count = int(min(size_t(thread_count), max(size_t(1), series_columns.size())));
+    atomic<size_t> next_series_index(0);
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            for (size_t series_index = next_series_index++; series_index < series_columns.size();
+                 series_index = next_series_index++) {
+                align_series_to_calendar(target_days, series_columns[series_index], fill_method);
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+}
+
+int execute_series_resampling(int argument_count, char* argument_values[], const string& input_file_path) {
+    string output_file_path = find_command_line_option_value(argument_count, argument_values, "--resample-output", "");
+    string calendar_text = find_command_line_option_value(argument_count, argument_values, "--resample-calendar", "business");
+    string fill_text = find_command_line_option_value(argument_count, argument_values, "--resample-fill", "ffill");
+    int thread_count = find_command_line_integer_option(argument_count, argument_values, "--threads", 0);
+    vector<int> region_codes;
+    if (output_file_path.empty() || (calendar_text != "business" && calendar_text != "month-end") ||
+        (fill_text != "ffill" && fill_text != "last" && fill_text != "sum") ||
+        !parse_holiday_region_list(find_command_line_option_value(argument_count, argument_values, "--holidays", ""),
+                                   region_codes)) {
+        cout << "ERROR: --resample requires --resample-output and valid calendar, fill and holiday options" << endl;
+        return 1;
+    }
+    resample_calendar_kind calendar_kind = calendar_text == "business" ? RESAMPLE_CALENDAR_BUSINESS_DAYS :
+                                                                         RESAMPLE_CALENDAR_MONTH_END;
+    resample_fill_method fill_method = fill_text == "ffill" ? RESAMPLE_FILL_FORWARD :
+                                       fill_text == "last" ? RESAMPLE_FILL_LAST_VALUE : RESAMPLE_FILL_SUM;
+    ifstream input_stream(input_file_path.c_str());
+    if (!input_stream) {
+        cout << "ERROR: Unable to read " << input_file_path << endl;
+        return 1;
+    }
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    
+    // Rows are "series,YYYY-MM-DD,value"; series keep first-appearance order
+    vector<string> series_names;
+    unordered_map<string, size_t> series_lookup;
+    vector<vector<pair<int32_t, double> > > series_observations;
+    int first_serial_day = INT32_MAX;
+    int last_serial_day = 0;
+    size_t skipped_line_count = 0;
+    string input_line;
+    while (getline(input_stream, input_line)) {
+        size_t first_comma = input_line.find(',');
+        size_t second_comma = first_comma == string::npos ? string::npos : input_line.find(',', first_comma + 1);
+        int day_value = 0, month_value = 0, year_value = 0;
+        char* value_end = NULL;
+        if (second_comma == string::npos || second_comma - first_comma != 11 ||
+            !parse_iso_calendar_date(input_line.c_str() + first_comma + 1, 10, day_value, month_value, year_value)) {
+            skipped_line_count += input_line.empty() ? 0 : 1;
+            continue;
+        }
+        double observation_value = strtod(input_line.c_str() + second_comma + 1, &value_end);
+        if (value_end == input_line.c_str() + second_comma + 1) {
+            skipped_line_count++;
+            continue;
+        }
+        string series_name = input_line.substr(0, first_comma);
+        unordered_map<string, size_t>::iterator series_position = series_lookup.find(series_name);
+        if (series_position == series_lookup.end()) {
+            series_position = series_lookup.insert(make_pair(series_name, series_names.size())).first;
+            series_names.push_back(series_name);
+            series_observations.push_back(vector<pair<int32_t, double> >());
+        }
+        size_t series_index = series_position->second;
+        int serial_day = calculate_serial_day_number(day_value, month_value, year_value);
+        series_observations[series_index].push_back(make_pair(int32_t(serial_day), observation_value));
+        first_serial_day = min(first_serial_day, serial_day);
+        last_serial_day = max(last_serial_day, serial_day);
+    }
+    if (series_names.empty()) {
+        cout << "No observations found in " << input_file_path << endl;
+        return 1;
+    }
+    
+    // One target index for every series; holidays come from the calendar core's rule table
+    uint8_t holiday_mask = 0;
+    for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+        holiday_mask |= uint8_t(1 << region_codes[region_index]);
+    }
+    vector<uint8_t> holiday_table = region_codes.empty() ? vector<uint8_t>() : build_holiday_day_table(region_codes);
+    vector<int32_t> target_days = build_business_day_index(first_serial_day, last_serial_day, calendar_kind,
+                                                           holiday_table, holiday_mask);
+    
+    // Split each series into ascending day and value columns with a column-major output block
+    vector<vector<int32_t> > observation_days(series_names.size());
+    vector<vector<double> > observation_values(series_names.size());
+    vector<double> output_block(series_names.size() * target_days.size());
+    vector<resample_series_columns> series_columns(series_names.size());
+    for (size_t series_index = 0; series_index < series_names.size(); series_index++) {
+        vector<pair<int32_t, double> >& observations = series_observations[series_index];
+        stable_sort(observations.begin(), observations.end(),
+                    [](const pair<int32_t, double>& left_pair, const pair<int32_t, double>& right_pair) {
+                        return left_pair.first < right_pair.first;
+                    });
+        for (size_t observation_index = 0; observation_index < observations.size(); observation_index++) {
+            observation_days[series_index].push_back(observations[observation_index].first);
+            observation_values[series_index].push_back(observations[observation_index].second);
+        }
+        resample_series_columns columns = {&observation_days[series_index][0], &observation_values[series_index][0],
+                                           observations.size(),
+                                           target_days.empty() ? NULL : &output_block[series_index * target_days.size()]};
+        series_columns[series_index] = columns;
+    }
+    resample_series_batch(target_days, series_columns, fill_method, thread_count);
+    
+    // Wide output: one row per target day, one column per series, empty cells for missing values
+    string output_text = "date";
+    for (size_t series_index = 0; series_index < series_names.size(); series_index++) {
+        output_text += "," + series_names[series_index];
+    }
+    output_text += "\n";
+    char cell_text[40];
+    for (size_t target_index = 0; target_index < target_days.size(); target_index++) {
+        int day_value = 0, month_value = 0, year_value = 0;
+        convert_serial_day_to_calendar_date(target_days[target_index], day_value, month_value, year_value);
+        snprintf(cell_text, sizeof(cell_text), "%04d-%02d-%02d", year_value, month_value, day_value);
+        output_text += cell_text;
+        for (size_t series_index = 0; series_index < series_names.size(); series_index++) {
+            double cell_value = output_block[series_index * target_days.size() + target_index];
+            output_text += ",";
+            if (cell_value == cell_value) {
+                snprintf(cell_text, sizeof(cell_text), "%.10g", cell_value);
+                output_text += cell_text;
+            }
+        }
+        output_text += "\n";
+    }
+    if (!write_file_atomically(output_file_path, output_text)) {
+        cout << "ERROR: Unable to write " << output_file_path << endl;
+        return 1;
+    }
+    double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    cout << "RESAMPLING REPORT" << endl;
+    cout << string(40, '-') << endl;
+    cout << "Series: " << series_names.size() << endl;
+    cout << "Target Days: " << target_days.size() << " (" << calendar_text << ", " << fill_text << ")" << endl;
+    cout << "Skipped Lines: " << skipped_line_count << endl;
+    cout << "Elapsed: " << fixed << setprecision(1) << elapsed_seconds * 1e3 << " ms" << endl;
+    return 0;
+}
+
+int execute_resample_benchmark(int series_count, int thread_count) {
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    vector<uint8_t> holiday_table = build_holiday_day_table(vector<int>(1, int(HOLIDAY_REGION_UNITED_STATES)));
+    int first_serial_day = calculate_serial_day_number(1, 1, 2015);
+    int last_serial_day = calculate_serial_day_number(31, 12, 2024);
+    vector<int32_t> target_days = build_business_day_index(first_serial_day, last_serial_day, RESAMPLE_CALENDAR_BUSINESS_DAYS,
+                                                           holiday_table, uint8_t(1 << HOLIDAY_REGION_UNITED_STATES));
+    
+    // Irregular series: each observes a random subset of calendar days, weekends included
+    vector<vector<int32_t> > observation_days(static_cast<size_t>(series_count));
+    vector<vector<double> > observation_values(static_cast<size_t>(series_count));
+    uint64_t random_state = 0x94D049BB133111EBULL;
+    for (size_t series_index = 0; series_index < observation_days.size(); series_index++) {
+        for (int serial_day = first_serial_day - 10; serial_day <= last_serial_day; serial_day++) {
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 7;
+            random_state ^= random_state << 17;
+            if (random_state % 5 < 2) {
+                observation_days[series_index].push_back(serial_day);
+                observation_values[series_index].push_back(double((random_state >> 16) % 1000) / 4.0);
+            }
+        }
+    }
+    size_t observation_total = 0;
+    vector<double> output_block(observation_days.size() * target_days.size());
+    vector<resample_series_columns> series_columns(observation_days.size());
+    for (size_t series_index = 0; series_index < observation_days.size(); series_index++) {
+        resample_series_columns columns = {&observation_days[series_index][0], &observation_values[series_index][0],
+                                           observation_days[series_index].size(),
+                                           &output_block[series_index * target_days.size()]};
+        series_columns[series_index] = columns;
+        observation_total += observation_days[series_index].size();
+    }
+    
+    cout << "RESAMPLE BENCHMARK (" << series_count << " series, " << observation_total << " observations, "
+         << target_days.size() << " US business days)" << endl;
+    cout << string(60, '-') << endl;
+    cout << fixed << setprecision(1);
+    bool results_match = true;
+    static const char* const fill_names[] = {"ffill", "last", "sum"};
+    for (int fill_index = 0; fill_index < 3; fill_index++) {
+        resample_fill_method fill_method = resample_fill_method(fill_index);
+        
+        // Baseline: binary search for every target day of every series
+        vector<double> baseline_block(output_block.size());
+        chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+        for (size_t series_index = 0; series_index < observation_days.size(); series_index++) {
+            const vector<int32_t>& days = observation_days[series_index];
+            const vector<double>& values = observation_values[series_index];
+            size_t previous_bound = 0;
+            for (size_t target_index = 0; target_index < target_days.size(); target_index++) {
+                size_t bound = size_t(upper_bound(days.begin(), days.end(), target_days[target_index]) - days.begin());
+                double cell_value = NAN;
+                if (fill_method == RESAMPLE_FILL_FORWARD) {
+                    cell_value = bound > 0 ? values[bound - 1] : NAN;
+                } else if (fill_method == RESAMPLE_FILL_LAST_VALUE) {
+                    cell_value = bound > previous_bound ? values[bound - 1] : NAN;
+                } else {
+                    cell_value = 0.0;
+                    for (size_t observation_index = previous_bound; observation_index < bound; observation_index++) {
+                        cell_value += values[observation_index];
+                    }
+                }
+                baseline_block[series_index * target_days.size() + target_index] = cell_value;
+                previous_bound = bound;
+            }
+        }
+        double baseline_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        
+        start_time = chrono::steady_clock::now();
+        resample_series_batch(target_days, series_columns, fill_method, 1);
+        double merge_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        start_time = chrono::steady_clock::now();
+        resample_series_batch(target_days, series_columns, fill_method, thread_count);
+        double threaded_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        
+        for (size_t cell_index = 0; cell_index < output_block.size(); cell_index++) {
+            results_match = results_match && (output_block[cell_index] == baseline_block[cell_index] ||
+                                              (output_block[cell_index] != output_block[cell_index] &&
+                                               baseline_block[cell_index] != baseline_block[cell_index]));
+        }
+        cout << left << setw(6) << fill_names[fill_index] << right << " Binary Search: " << baseline_seconds * 1e3
+             << " ms, Merge: " << merge_seconds * 1e3 << " ms, Merge (" << thread_count << " threads): "
+             << threaded_seconds * 1e3 << " ms" << endl;
+    }
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+COMPRESSED DATE SET FUNCTIONS
+================================================================================
+*/
+
+// Function returns the number of set bits in a word
+inline int count_set_bits(uint64_t bit_pattern) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bit_pattern);
+#else
+    int bit_count = 0;
+    for (; bit_pattern != 0; bit_pattern &= bit_pattern - 1) {
+        bit_count++;
+    }
+    return bit_count;
+#endif
+}
+
+// Function expands any container encoding into a day-of-year bitmap
+void expand_date_set_container(const compressed_date_set& date_set, const date_set_container& year_container,
+                               uint64_t bitmap_words[DATE_SET_BITMAP_WORDS]) {
+    fill(bitmap_words, bitmap_words + DATE_SET_BITMAP_WORDS, uint64_t(0));
+    const uint16_t* container_values = date_set.container_values.empty() ? NULL :
+                                       &date_set.container_values[year_container.value_offset];
+    size_t value_count = year_container.value_count;
+    if (year_container.container_kind == DATE_SET_BITMAP_CONTAINER) {
+        for (size_t value_index = 0; value_index < value_count; value_index++) {
+            bitmap_words[value_index >> 2] |= uint64_t(container_values[value_index]) << ((value_index & 3) * 16);
+        }
+    } else if (year_container.container_kind == DATE_SET_ARRAY_CONTAINER) {
+        for (size_t value_index = 0; value_index < value_count; value_index++) {
+            bitmap_words[container_values[value_index] >> 6] |= uint64_t(1) << (container_values[value_index] & 63);
+        }
+    } else {
+        for (size_t value_index = 0; value_index + 1 < value_count; value_index += 2) {
+            int run_first_index = container_values[value_index];
+            int run_last_index = run_first_index + container_values[value_index + 1];
+            for (int word_index = run_first_index >> 6; word_index <= run_last_index >> 6; word_index++) {
+                // Mask the run's bits within this word
+                int low_bit = max(run_first_index, word_index * 64) - word_index * 64;
+                int high_bit = min(run_last_index, word_index * 64 + 63) - word_index * 64;
+                uint64_t high_mask = high_bit == 63 ? ~uint64_t(0) : (uint64_t(1) << (high_bit + 1)) - 1;
+                bitmap_words[word_index] |= high_mask & ~((uint64_t(1) << low_bit) - 1);
+            }
+        }
+    }
+}
+
+// Function appends a year to a set from its bitmap, choosing the smallest of the three encodings
+void append_date_set_container(compressed_date_set& date_set, int year_value, const uint64_t bitmap_words[DATE_SET_BITMAP_WORDS]) {
+    int cardinality = 0;
+    int run_count = 0;
+    uint64_t carry_bit = 0;
+    for (int word_index = 0; word_index < DATE_SET_BITMAP_WORDS; word_index++) {
+        cardinality += count_set_bits(bitmap_words[word_index]);
+        run_count += count_set_bits(bitmap_words[word_index] & ~(bitmap_words[word_index] << 1 | carry_bit));
+        carry_bit = bitmap_words[word_index] >> 63;
+    }
+    if (cardinality == 0) {
+        return;
+    }
+    vector<uint16_t>& container_values = date_set.container_values;
+    date_set_container year_container = {int16_t(year_value), DATE_SET_ARRAY_CONTAINER, 0, uint16_t(cardinality), 0,
+                                         uint32_t(container_values.size())};
+    size_t array_bytes = size_t(cardinality) * 2;
+    size_t run_bytes = size_t(run_count) * 4;
+    size_t bitmap_bytes = DATE_SET_BITMAP_WORDS * 8;
+    if (array_bytes <= run_bytes && array_bytes <= bitmap_bytes) {
+        for (int word_index = 0; word_index < DATE_SET_BITMAP_WORDS; word_index++) {
+            for (uint64_t remaining_bits = bitmap_words[word_index]; remaining_bits != 0; remaining_bits &= remaining_bits - 1) {
+                container_values.push_back(uint16_t(word_index * 64 + find_lowest_set_bit(remaining_bits)));
+            }
+        }
+    } else if (run_bytes <= bitmap_bytes) {
+        year_container.container_kind = DATE_SET_RUN_CONTAINER;
+        int run_first_index = -1;
+        for (int day_index = 0; day_index <= DATE_SET_BITMAP_WORDS * 64; day_index++) {
+            bool day_present = day_index < DATE_SET_BITMAP_WORDS * 64 && (bitmap_words[day_index >> 6] >> (day_index & 63) & 1) != 0;
+            if (day_present && run_first_index < 0) {
+                run_first_index = day_index;
+            } else if (!day_present && run_first_index >= 0) {
+                container_values.push_back(uint16_t(run_first_index));
+                container_values.push_back(uint16_t(day_index - 1 - run_first_index));
+                run_first_index = -1;
+            }
+        }
+    } else {
+        year_container.container_kind = DATE_SET_BITMAP_CONTAINER;
+        for (int value_index = 0; value_index < DATE_SET_BITMAP_WORDS * 4; value_index++) {
+            container_values.push_back(uint16_t(bitmap_words[value_index >> 2] >> ((value_index & 3) * 16)));
+        }
+    }
+    year_container.value_count = uint16_t(container_values.size() - year_container.value_offset);
+    date_set.year_containers.push_back(year_container);
+}
+
+// Function appends a container of another set unchanged
+void copy_date_set_container(compressed_date_set& date_set, const compressed_date_set& source_set,
+                             const date_set_container& source_container) {
+    date_set_container year_container = source_container;
+    year_container.value_offset = uint32_t(date_set.container_values.size());
+    date_set.container_values.insert(date_set.container_values.end(),
+                                     source_set.container_values.begin() + ptrdiff_t(source_container.value_offset),
+                                     source_set.container_values.begin() + ptrdiff_t(source_container.value_offset) +
+                                     ptrdiff_t(source_container.value_count));
+    date_set.year_containers.push_back(year_container);
+}
+
+// Function locates the container for a year, returning NULL when the year is empty
+const date_set_container* locate_date_set_container(const compressed_date_set& date_set, int year_value) {
+    vector<date_set_container>::const_iterator container_position = lower_bound(
+        date_set.year_containers.begin(), date_set.year_containers.end(), year_value,
+        [](const date_set_container& year_container, int search_year) { return year_container.year_value < search_year; });
+    return container_position != date_set.year_containers.end() && container_position->year_value == year_value ?
+           &*container_position : NULL;
+}
+
+compressed_date_set build_compressed_date_set(const vector<int32_t>& serial_days) {
+    compressed_date_set date_set;
+    uint64_t bitmap_words[DATE_SET_BITMAP_WORDS];
+    size_t day_position = 0;
+    while (day_position < serial_days.size()) {
+        // Gather every day of this year into one bitmap, then encode it once
+        int day_value = 0, month_value = 0, year_value = 0;
+        convert_serial_day_to_calendar_date(serial_days[day_position], day_value, month_value, year_value);
+        int year_first_serial_day = calculate_serial_day_number(1, 1, year_value);
+        int next_year_first_serial_day = calculate_serial_day_number(1, 1, year_value + 1);
+        fill(bitmap_words, bitmap_words + DATE_SET_BITMAP_WORDS, uint64_t(0));
+        for (; day_position < serial_days.size() && serial_days[day_position] < next_year_first_serial_day; day_position++) {
+            int day_index = serial_days[day_position] - year_first_serial_day;
+            bitmap_words[day_index >> 6] |= uint64_t(1) << (day_index & 63);
+        }
+        append_date_set_container(date_set, year_value, bitmap_words);
+    }
+    date_set.year_containers.shrink_to_fit();
+    date_set.container_values.shrink_to_fit();
+    return date_set;
+}
+
+void add_date_set_day(compressed_date_set& date_set, int serial_day) {
+    // Containers share one value pool, so single insertions rebuild through a union; bulk loads use the builder
+    if (!contains_date_set_day(date_set, serial_day)) {
+        date_set = calculate_date_set_union(date_set, build_compressed_date_set(vector<int32_t>(1, serial_day)));
+    }
+}
+
+bool expand_date_set_year(const compressed_date_set& date_set, int year_value, uint64_t bitmap_words[DATE_SET_BITMAP_WORDS]) {
+    const date_set_container* year_container = locate_date_set_container(date_set, year_value);
+    if (year_container == NULL) {
+        return false;
+    }
+    expand_date_set_container(date_set, *year_container, bitmap_words);
+    return true;
+}
+
+bool contains_date_set_day(const compressed_date_set& date_set, int serial_day) {
+    int day_value = 0, month_value = 0, year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    const date_set_container* year_container = locate_date_set_container(date_set, year_value);
+    if (year_container == NULL) {
+        return false;
+    }
+    uint16_t day_index = uint16_t(serial_day - calculate_serial_day_number(1, 1, year_value));
+    const uint16_t* container_values = &date_set.container_values[year_container->value_offset];
+    if (year_container->container_kind == DATE_SET_ARRAY_CONTAINER) {
+        return binary_search(container_values, container_values + year_container->value_count, day_index);
+    } else if (year_container->container_kind == DATE_SET_BITMAP_CONTAINER) {
+        return (container_values[day_index >> 4] >> (day_index & 15) & 1) != 0;
+    }
+    for (size_t value_index = 0; value_index + 1 < year_container->value_count; value_index += 2) {
+        if (day_index >= container_values[value_index] && day_index <= container_values[value_index] + container_values[value_index + 1]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Enumeration selects the word-wise operation combine_date_sets applies
+enum date_set_operation_kind { DATE_SET_UNION = 0, DATE_SET_INTERSECTION = 1, DATE_SET_DIFFERENCE = 2 };
+
+// Function merges two sets by year, combining matching years through their bitmaps
+compressed_date_set combine_date_sets(const compressed_date_set& left_set, const compressed_date_set& right_set,
+                                      date_set_operation_kind operation_kind) {
+    compressed_date_set result_set;
+    size_t left_index = 0;
+    size_t right_index = 0;
+    uint64_t left_words[DATE_SET_BITMAP_WORDS];
+    uint64_t right_words[DATE_SET_BITMAP_WORDS];
+    while (left_index < left_set.year_containers.size() || right_index < right_set.year_containers.size()) {
+        bool left_available = left_index < left_set.year_containers.size();
+        bool right_available = right_index < right_set.year_containers.size();
+        int left_year = left_available ? left_set.year_containers[left_index].year_value : INT32_MAX;
+        int right_year = right_available ? right_set.year_containers[right_index].year_value : INT32_MAX;
+        
+        // Years present on one side only are copied or dropped without decoding
+        if (left_year < right_year) {
+            if (operation_kind != DATE_SET_INTERSECTION) {
+                copy_date_set_container(result_set, left_set, left_set.year_containers[left_index]);
+            }
+            left_index++;
+            continue;
+        }
+        if (right_year < left_year) {
+            if (operation_kind == DATE_SET_UNION) {
+                copy_date_set_container(result_set, right_set, right_set.year_containers[right_index]);
+            }
+            right_index++;
+            continue;
+        }
+        expand_date_set_container(left_set, left_set.year_containers[left_index++], left_words);
+        expand_date_set_container(right_set, right_set.year_containers[right_index++], right_words);
+        for (int word_index = 0; word_index < DATE_SET_BITMAP_WORDS; word_index++) {
+            left_words[word_index] = operation_kind == DATE_SET_UNION ? left_words[word_index] | right_words[word_index] :
+                                     operation_kind == DATE_SET_INTERSECTION ? left_words[word_index] & right_words[word_index] :
+                                     left_words[word_index] & ~right_words[word_index];
+        }
+        append_date_set_container(result_set, left_year, left_words);
+    }
+    result_set.year_containers.shrink_to_fit();
+    result_set.container_values.shrink_to_fit();
+    return result_set;
+}
+
+compressed_date_set calculate_date_set_union(const compressed_date_set& left_set, const compressed_date_set& right_set) {
+    return combine_date_sets(left_set, right_set, DATE_SET_UNION);
+}
+
+compressed_date_set calculate_date_set_intersection(const compressed_date_set& left_set, const compressed_date_set& right_set) {
+    return combine_date_sets(left_set, right_set, DATE_SET_INTERSECTION);
+}
+
+compressed_date_set calculate_date_set_difference(const compressed_date_set& left_set, const compressed_date_set& right_set) {
+    return combine_date_sets(left_set, right_set, DATE_SET_DIFFERENCE);
+}
+
+size_t calculate_date_set_intersection_cardinality(const compressed_date_set& left_set, const compressed_date_set& right_set) {
+    size_t common_day_count = 0;
+    size_t left_index = 0;
+    size_t right_index = 0;
+    uint64_t left_words[DATE_SET_BITMAP_WORDS];
+    uint64_t right_words[DATE_SET_BITMAP_WORDS];
+    while (left_index < left_set.year_containers.size() && right_index < right_set.year_containers.size()) {
+        int left_year = left_set.year_containers[left_index].year_value;
+        int right_year = right_set.year_containers[right_index].year_value;
+        if (left_year != right_year) {
+            left_year < right_year ? left_index++ : right_index++;
+            continue;
+        }
+        expand_date_set_container(left_set, left_set.year_containers[left_index++], left_words);
+        expand_date_set_container(right_set, right_set.year_containers[right_index++], right_words);
+        for (int word_index = 0; word_index < DATE_SET_BITMAP_WORDS; word_index++) {
+            common_day_count += size_t(count_set_bits(left_words[word_index] & right_words[word_index]));
+        }
+    }
+    return common_day_count;
+}
+
+size_t calculate_date_set_cardinality(const compressed_date_set& date_set) {
+    size_t day_count = 0;
+    for (size_t container_index = 0; container_index < date_set.year_containers.size(); container_index++) {
+        day_count += date_set.year_containers[container_index].cardinality;
+    }
+    return day_count;
+}
+
+size_t calculate_date_set_memory_bytes(const compressed_date_set& date_set) {
+    return sizeof(compressed_date_set) + date_set.year_containers.capacity() * sizeof(date_set_container) +
+           date_set.container_values.capacity() * sizeof(uint16_t);
+}
+
+void append_date_set_serial_days(const compressed_date_set& date_set, vector<int32_t>& serial_days) {
+    uint64_t bitmap_words[DATE_SET_BITMAP_WORDS];
+    for (size_t container_index = 0; container_index < date_set.year_containers.size(); container_index++) {
+        const date_set_container& year_container = date_set.year_containers[container_index];
+        int year_first_serial_day = calculate_serial_day_number(1, 1, year_container.year_value);
+        expand_date_set_container(date_set, year_container, bitmap_words);
+        for (int word_index = 0; word_index < DATE_SET_BITMAP_WORDS; word_index++) {
+            for (uint64_t remaining_bits = bitmap_words[word_index]; remaining_bits != 0; remaining_bits &= remaining_bits - 1) {
+                serial_days.push_back(year_first_serial_day + word_index * 64 + find_lowest_set_bit(remaining_bits));
+            }
+        }
+    }
+}
+
+// Function reads one ISO date per line into ascending distinct serial days
+bool read_date_list_file(const string& date_list_path, vector<int32_t>& serial_days) {
+    ifstream date_list_stream(date_list_path.c_str());
+    if (!date_list_stream) {
+        return false;
+    }
+    string date_line;
+    while (getline(date_list_stream, date_line)) {
+        int day_value = 0, month_value = 0, year_value = 0;
+        date_line.erase(date_line.find_last_not_of(" \t\r") + 1); // Tolerate CRLF files and trailing blanks
+        if (parse_iso_calendar_date(date_line.c_str(), date_line.size(), day_value, month_value, year_value)) {
+            serial_days.push_back(calculate_serial_day_number(day_value, month_value, year_value));
+        }
+    }
+    sort(serial_days.begin(), serial_days.end());
+    serial_days.erase(unique(serial_days.begin(), serial_days.end()), serial_days.end());
+    return true;
+}
+
+int execute_date_set_display(int argument_count, char* argument_values[], const string& date_list_path) {
+    string other_list_path = find_command_line_option_value(argument_count, argument_values, "--date-set-other", "");
+    string operation_text = find_command_line_option_value(argument_count, argument_values, "--date-set-op", "intersect");
+    vector<int32_t> serial_days;
+    vector<int32_t> other_serial_days;
+    if (!read_date_list_file(date_list_path, serial_days) ||
+        (!other_list_path.empty() && !read_date_list_file(other_list_path, other_serial_days)) ||
+        (operation_text != "union" && operation_text != "intersect" && operation_text != "difference")) {
+        cout << "ERROR: Unable to read date lists or unknown --date-set-op" << endl;
+        return 1;
+    }
+    compressed_date_set date_set = build_compressed_date_set(serial_days);
+    if (!other_list_path.empty()) {
+        compressed_date_set other_set = build_compressed_date_set(other_serial_days);
+        date_set = operation_text == "union" ? calculate_date_set_union(date_set, other_set) :
+                   operation_text == "intersect" ? calculate_date_set_intersection(date_set, other_set) :
+                   calculate_date_set_difference(date_set, other_set);
+    }
+    
+    // Summarize the container mix before rendering
+    int container_counts[3] = {0, 0, 0};
+    for (size_t container_index = 0; container_index < date_set.year_containers.size(); container_index++) {
+        container_counts[date_set.year_containers[container_index].container_kind]++;
+    }
+    int display_year = find_command_line_integer_option(argument_count, argument_values, "--date-set-year",
+                                                        date_set.year_containers.empty() ? 2025 :
+                                                        date_set.year_containers.front().year_value);
+    cout << "DATE SET " << display_year << " (" << calculate_date_set_cardinality(date_set) << " days, "
+         << date_set.year_containers.size() << " years: " << container_counts[DATE_SET_ARRAY_CONTAINER] << " array, "
+         << container_counts[DATE_SET_BITMAP_CONTAINER] << " bitmap, " << container_counts[DATE_SET_RUN_CONTAINER] << " run; "
+         << calculate_date_set_memory_bytes(date_set) << " bytes)" << endl;
+    cout << string(40, '-') << endl;
+    calendar_display_options display_options;
+    display_options.highlighted_days = &date_set;
+    for (int target_month = 1; target_month <= 12; target_month++) {
+        generate_monthly_calendar_display(target_month, display_year, display_options);
+    }
+    return 0;
+}
+
+int execute_date_set_benchmark(int user_count) {
+    // Ten years of activity per user in three profiles: sparse random, dense random and streaks
+    int first_serial_day = calculate_serial_day_number(1, 1, 2015);
+    int last_serial_day = calculate_serial_day_number(31, 12, 2024);
+    int horizon_day_count = last_serial_day - first_serial_day + 1;
+    vector<vector<int32_t> > user_day_lists(static_cast<size_t>(user_count));
+    uint64_t random_state = 0xBF58476D1CE4E5B9ULL;
+    for (size_t user_index = 0; user_index < user_day_lists.size(); user_index++) {
+        int profile_index = int(user_index % 3);
+        bool streak_active = false;
+        for (int serial_day = first_serial_day; serial_day <= last_serial_day; serial_day++) {
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 7;
+            random_state ^= random_state << 17;
+            bool day_active = profile_index == 0 ? random_state % 100 < 1 :
+                              profile_index == 1 ? random_state % 100 < 70 :
+                              (streak_active = (random_state % 100 < 3) ? !streak_active : streak_active);
+            if (day_active) {
+                user_day_lists[user_index].push_back(serial_day);
+            }
+        }
+    }
+    
+    // Memory: compressed sets against sorted int32 vectors and dense per-user bitmaps
+    vector<compressed_date_set> user_sets(user_day_lists.size());
+    size_t compressed_bytes[3] = {0, 0, 0};
+    size_t vector_bytes[3] = {0, 0, 0};
+    size_t bitmap_bytes[3] = {0, 0, 0};
+    int container_counts[3] = {0, 0, 0};
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    for (size_t user_index = 0; user_index < user_day_lists.size(); user_index++) {
+        user_sets[user_index] = build_compressed_date_set(user_day_lists[user_index]);
+    }
+    double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    for (size_t user_index = 0; user_index < user_day_lists.size(); user_index++) {
+        compressed_bytes[user_index % 3] += calculate_date_set_memory_bytes(user_sets[user_index]);
+        vector_bytes[user_index % 3] += sizeof(vector<int32_t>) + user_day_lists[user_index].size() * sizeof(int32_t);
+        bitmap_bytes[user_index % 3] += size_t((horizon_day_count + 63) / 64 * 8);
+        for (size_t container_index = 0; container_index < user_sets[user_index].year_containers.size(); container_index++) {
+            container_counts[user_sets[user_index].year_containers[container_index].container_kind]++;
+        }
+    }
+    
+    // Pairwise intersections of neighbouring users: set_intersection on vectors against containers
+    size_t vector_common_days = 0;
+    start_time = chrono::steady_clock::now();
+    vector<int32_t> intersection_days;
+    for (size_t user_index = 0; user_index + 1 < user_day_lists.size(); user_index++) {
+        intersection_days.clear();
+        set_intersection(user_day_lists[user_index].begin(), user_day_lists[user_index].end(),
+                         user_day_lists[user_index + 1].begin(), user_day_lists[user_index + 1].end(),
+                         back_inserter(intersection_days));
+        vector_common_days += intersection_days.size();
+    }
+    double vector_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    size_t set_common_days = 0;
+    start_time = chrono::steady_clock::now();
+    for (size_t user_index = 0; user_index + 1 < user_sets.size(); user_index++) {
+        set_common_days += calculate_date_set_cardinality(calculate_date_set_intersection(user_sets[user_index],
+                                                                                          user_sets[user_index + 1]));
+    }
+    double set_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    size_t counted_common_days = 0;
+    start_time = chrono::steady_clock::now();
+    for (size_t user_index = 0; user_index + 1 < user_sets.size(); user_index++) {
+        counted_common_days += calculate_date_set_intersection_cardinality(user_sets[user_index], user_sets[user_index + 1]);
+    }
+    double count_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    // Iteration, union and difference must reproduce the vector results exactly
+    bool results_match = vector_common_days == set_common_days && vector_common_days == counted_common_days;
+    for (size_t user_index = 0; results_match && user_index + 1 < user_sets.size(); user_index += 97) {
+        vector<int32_t> iterated_days;
+        append_date_set_serial_days(user_sets[user_index], iterated_days);
+        vector<int32_t> union_days;
+        vector<int32_t> difference_days;
+        vector<int32_t> expected_union_days;
+        vector<int32_t> expected_difference_days;
+        append_date_set_serial_days(calculate_date_set_union(user_sets[user_index], user_sets[user_index + 1]), union_days);
+        append_date_set_serial_days(calculate_date_set_difference(user_sets[user_index], user_sets[user_index + 1]),
+                                    difference_days);
+        set_union(user_day_lists[user_index].begin(), user_day_lists[user_index].end(), user_day_lists[user_index + 1].begin(),
+                  user_day_lists[user_index + 1].end(), back_inserter(expected_union_days));
+        set_difference(user_day_lists[user_index].begin(), user_day_lists[user_index].end(),
+                       user_day_lists[user_index + 1].begin(), user_day_lists[user_index + 1].end(),
+                       back_inserter(expected_difference_days));
+        results_match = iterated_days == user_day_lists[user_index] && union_days == expected_union_days &&
+                        difference_days == expected_difference_days &&
+                        contains_date_set_day(user_sets[user_index], user_day_lists[user_index].empty() ? 0 :
+                                              user_day_lists[user_index].back()) == !user_day_lists[user_index].empty();
+    }
+    
+    cout << "DATE SET BENCHMARK (" << user_count << " users, 2015-2024, sparse/dense/streak profiles)" << endl;
+    cout << string(60, '-') << endl;
+    cout << "Containers: " << container_counts[DATE_SET_ARRAY_CONTAINER] << " array, "
+         << container_counts[DATE_SET_BITMAP_CONTAINER] << " bitmap, " << container_counts[DATE_SET_RUN_CONTAINER] << " run" << endl;
+    static const char* const profile_names[] = {"Sparse (1%)", "Dense (70%)", "Streaks"};
+    for (int profile_index = 0; profile_index < 3; profile_index++) {
+        cout << "Memory " << left << setw(12) << profile_names[profile_index] << right << ": compressed "
+             << compressed_bytes[profile_index] / 1024 << " KiB, sorted vectors " << vector_bytes[profile_index] / 1024
+             << " KiB, dense bitmaps " << bitmap_bytes[profile_index] / 1024 << " KiB" << endl;
+    }
+    cout << fixed << setprecision(1);
+    cout << "Build: " << build_seconds * 1e3 << " ms" << endl;
+    cout << "Intersections: set_intersection " << vector_seconds * 1e3 << " ms, containers " << set_seconds * 1e3
+         << " ms, cardinality only " << count_seconds * 1e3 << " ms" << endl;
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+VACATION OPTIMIZER FUNCTIONS
+================================================================================
+*/
+
+// Function reports whether a day index is marked in a planning bitmap
+inline bool check_day_bitmap_bit(const uint64_t day_words[VACATION_WINDOW_WORDS], int day_index) {
+    return (day_words[day_index >> 6] >> (day_index & 63) & 1) != 0;
+}
+
+int calculate_vacation_window_day_count(int year_value) {
+    return (calculate_leap_year_status(year_value) ? 366 : 365) + (calculate_leap_year_status(year_value + 1) ? 366 : 365);
+}
+
+void build_year_off_day_bitmap(int year_value, const vector<uint8_t>& holiday_table, uint8_t holiday_mask,
+                               uint8_t extra_off_weekdays, uint64_t off_day_words[VACATION_WINDOW_WORDS]) {
+    fill(off_day_words, off_day_words + VACATION_WINDOW_WORDS, uint64_t(0));
+    int year_first_serial_day = calculate_serial_day_number(1, 1, year_value);
+    int window_day_count = calculate_vacation_window_day_count(year_value);
+    uint8_t off_weekdays = uint8_t(extra_off_weekdays | 0x41); // Sunday and Saturday
+    bool holidays_selected = holiday_mask != 0 && !holiday_table.empty();
+    for (int day_index = 0; day_index < window_day_count; day_index++) {
+        int serial_day = year_first_serial_day + day_index;
+        bool holiday_day = holidays_selected && (holiday_table[size_t(serial_day)] & holiday_mask) != 0;
+        if (holiday_day || (off_weekdays >> (serial_day % 7) & 1) != 0) {
+            off_day_words[day_index >> 6] |= uint64_t(1) << (day_index & 63);
+        }
+    }
+}
+
+vacation_break_plan find_longest_vacation_break(const uint64_t off_day_words[VACATION_WINDOW_WORDS], int year_day_count,
+                                                int window_day_count, int vacation_budget) {
+    // The window grows one day at a time and sheds days from the left while it needs more
+    // working days than the budget; each day enters and leaves once. Breaks may end in the
+    // following year but must start in the plan year, so the pass stops once the left edge leaves it
+    vacation_break_plan best_plan = {0, -1, 0, 0};
+    int window_first_day = 0;
+    int window_working_days = 0;
+    for (int day_index = 0; day_index < window_day_count; day_index++) {
+        window_working_days += check_day_bitmap_bit(off_day_words, day_index) ? 0 : 1;
+        while (window_working_days > vacation_budget) {
+            window_working_days -= check_day_bitmap_bit(off_day_words, window_first_day) ? 0 : 1;
+            window_first_day++;
+        }
+        if (window_first_day >= year_day_count) {
+            break;
+        }
+        int break_length = day_index - window_first_day + 1;
+        if (break_length > best_plan.break_length ||
+            (break_length == best_plan.break_length && window_working_days < best_plan.vacation_day_count)) {
+            vacation_break_plan window_plan = {window_first_day, day_index, window_working_days, break_length};
+            best_plan = window_plan;
+        }
+    }
+    return best_plan;
+}
+
+vector<vacation_break_plan> rank_bridge_day_opportunities(const uint64_t off_day_words[VACATION_WINDOW_WORDS],
+                                                          int year_day_count, int window_day_count,
+                                                          int maximum_vacation_days) {
+    // Prefix counts of working days turn every gap between two blocks of days off into O(1) arithmetic
+    vector<int> working_prefix(size_t(window_day_count) + 1, 0);
+    for (int day_index = 0; day_index < window_day_count; day_index++) {
+        working_prefix[size_t(day_index) + 1] = working_prefix[size_t(day_index)] + (check_day_bitmap_bit(off_day_words, day_index) ? 0 : 1);
+    }
+    
+    // Collect maximal blocks of consecutive days off
+    vector<pair<int, int> > off_blocks;
+    for (int day_index = 0; day_index < window_day_count; day_index++) {
+        if (check_day_bitmap_bit(off_day_words, day_index)) {
+            if (!off_blocks.empty() && off_blocks.back().second == day_index - 1) {
+                off_blocks.back().second = day_index;
+            } else {
+                off_blocks.push_back(make_pair(day_index, day_index));
+            }
+        }
+    }
+    
+    // Bridging block i to block j spends the working days between them and joins everything in between;
+    // only bridges starting in the plan year count, so the Christmas to New Year bridge belongs to December
+    vector<vacation_break_plan> opportunities;
+    for (size_t first_block = 0; first_block < off_blocks.size() && off_blocks[first_block].first < year_day_count; first_block++) {
+        for (size_t last_block = first_block + 1; last_block < off_blocks.size(); last_block++) {
+            int first_day_index = off_blocks[first_block].first;
+            int last_day_index = off_blocks[last_block].second;
+            int vacation_day_count = working_prefix[size_t(last_day_index) + 1] - working_prefix[size_t(first_day_index)];
+            if (vacation_day_count > maximum_vacation_days) {
+                break;
+            }
+            vacation_break_plan opportunity = {first_day_index, last_day_index, vacation_day_count,
+                                               last_day_index - first_day_index + 1};
+            opportunities.push_back(opportunity);
+        }
+    }
+    sort(opportunities.begin(), opportunities.end(), [](const vacation_break_plan& left_plan, const vacation_break_plan& right_plan) {
+        // Compare break days per vacation day without division, then prefer longer breaks
+        long long left_ratio = (long long)left_plan.break_length * right_plan.vacation_day_count;
+        long long right_ratio = (long long)right_plan.break_length * left_plan.vacation_day_count;
+        if (left_ratio != right_ratio) return left_ratio > right_ratio;
+        if (left_plan.break_length != right_plan.break_length) return left_plan.break_length > right_plan.break_length;
+        return left_plan.first_day_index < right_plan.first_day_index;
+    });
+    return opportunities;
+}
+
+void optimize_vacation_batch(int year_value, const vector<vacation_request>& vacation_requests,
+                             const vector<uint8_t>& holiday_table, vector<vacation_break_plan>& break_plans,
+                             int thread_count) {
+    int year_day_count = calculate_leap_year_status(year_value) ? 366 : 365;
+    int window_day_count = calculate_vacation_window_day_count(year_value);
+    
+    // Employees sharing a region, regular days off and budget share one answer; budgets beyond the
+    // planning window (at most 731 days, well within the 16-bit key field) plan identically
+    vector<uint32_t> request_keys(vacation_requests.size());
+    for (size_t request_index = 0; request_index < vacation_requests.size(); request_index++) {
+        const vacation_request& request = vacation_requests[request_index];
+        request_keys[request_index] = uint32_t(request.region_code + 1) << 24 | uint32_t(request.extra_off_weekdays) << 16 |
+                                      uint32_t(min(max(request.vacation_budget, 0), window_day_count));
+    }
+    vector<uint32_t> distinct_keys(request_keys);
+    sort(distinct_keys.begin(), distinct_keys.end());
+    distinct_keys.erase(unique(distinct_keys.begin(), distinct_keys.end()), distinct_keys.end());
+    
+    vector<vacation_break_plan> distinct_plans(distinct_keys.size());
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    thread_count = int(min(size_t(thread_count), max(size_t(1), distinct_keys.size())));
+    atomic<size_t> next_key_index(0);
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            uint64_t off_day_words[VACATION_WINDOW_WORDS];
+            for (size_t key_index = next_key_index++; key_index < distinct_keys.size(); key_index = next_key_index++) {
+                int region_code = int(distinct_keys[key_index] >> 24) - 1;
+                build_year_off_day_bitmap(year_value, holiday_table, region_code < 0 ? 0 : uint8_t(1 << region_code),
+                                          uint8_t(distinct_keys[key_index] >> 16), off_day_words);
+                distinct_plans[key_index] = find_longest_vacation_break(off_day_words, year_day_count, window_day_count,
+                                                                        int(distinct_keys[key_index] & 0xFFFF));
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    break_plans.resize(vacation_requests.size());
+    for (size_t request_index = 0; request_index < vacation_requests.size(); request_index++) {
+        break_plans[request_index] = distinct_plans[size_t(lower_bound(distinct_keys.begin(), distinct_keys.end(),
+                                                                       request_keys[request_index]) - distinct_keys.begin())];
+    }
+}
+
+// Function formats a day index of a year as YYYY-MM-DD (Www); indexes past December 31 fall in the next year
+string format_year_day_text(int year_value, int day_index) {
+    static const char* const weekday_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    int serial_day = calculate_serial_day_number(1, 1, year_value) + day_index;
+    int day_value = 0;
+    int month_value = 0;
+    int date_year = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, date_year);
+    char day_text[24];
+    snprintf(day_text, sizeof(day_text), "%04d-%02d-%02d (%s)", date_year, month_value, day_value,
+             weekday_names[serial_day % 7]);
+    return day_text;
+}
+
+int execute_vacation_planner(int argument_count, char* argument_values[], int year_value) {
+    int vacation_budget = find_command_line_integer_option(argument_count, argument_values, "--vacation-days", 10);
+    int bridge_day_limit = find_command_line_integer_option(argument_count, argument_values, "--bridge-days",
+                                                            VACATION_DEFAULT_BRIDGE_DAYS);
+    string part_time_text = find_command_line_option_value(argument_count, argument_values, "--part-time-off", "");
+    vector<int> region_codes;
+    if (year_value < 1 || year_value > 9998 || vacation_budget < 0 || bridge_day_limit < 0 ||
+        !parse_holiday_region_list(find_command_line_option_value(argument_count, argument_values, "--holidays", ""),
+                                   region_codes)) {
+        cout << "ERROR: --vacation-plan expects a year within 1-9998 and valid options" << endl;
+        return 1;
+    }
+    
+    // Regular days off are given as weekday abbreviations
+    static const char* const weekday_labels[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    uint8_t extra_off_weekdays = 0;
+    istringstream part_time_stream(part_time_text);
+    string weekday_text;
+    while (getline(part_time_stream, weekday_text, ',')) {
+        int weekday_index = int(find(weekday_labels, weekday_labels + 7, weekday_text) - weekday_labels);
+        if (weekday_index == 7) {
+            cout << "ERROR: Unknown weekday in --part-time-off: " << weekday_text << endl;
+            return 1;
+        }
+        extra_off_weekdays |= uint8_t(1 << weekday_index);
+    }
+    uint8_t holiday_mask = 0;
+    for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+        holiday_mask |= uint8_t(1 << region_codes[region_index]);
+    }
+    vector<uint8_t> holiday_table = region_codes.empty() ? vector<uint8_t>() : build_holiday_day_table(region_codes);
+    uint64_t off_day_words[VACATION_WINDOW_WORDS];
+    build_year_off_day_bitmap(year_value, holiday_table, holiday_mask, extra_off_weekdays, off_day_words);
+    int year_day_count = calculate_leap_year_status(year_value) ? 366 : 365;
+    int window_day_count = calculate_vacation_window_day_count(year_value);
+    
+    vacation_break_plan best_plan = find_longest_vacation_break(off_day_words, year_day_count, window_day_count,
+                                                                vacation_budget);
+    cout << "VACATION PLAN " << year_value << " (" << vacation_budget << " vacation days)" << endl;
+    cout << string(60, '-') << endl;
+    cout << "Longest Break: " << best_plan.break_length << " days, " << format_year_day_text(year_value, best_plan.first_day_index)
+         << " to " << format_year_day_text(year_value, best_plan.last_day_index) << ", using "
+         << best_plan.vacation_day_count << " vacation days" << endl;
+    cout << "Vacation Days:";
+    for (int day_index = best_plan.first_day_index; day_index <= best_plan.last_day_index; day_index++) {
+        if (!check_day_bitmap_bit(off_day_words, day_index)) {
+            cout << " " << format_year_day_text(year_value, day_index).substr(5, 5);
+        }
+    }
+    cout << endl;
+    
+    int bridge_vacation_days = min(vacation_budget, bridge_day_limit);
+    vector<vacation_break_plan> opportunities = rank_bridge_day_opportunities(off_day_words, year_day_count, window_day_count,
+                                                                              bridge_vacation_days);
+    cout << "Best Bridge Days (up to " << bridge_vacation_days << " vacation days, break days per vacation day):" << endl;
+    for (size_t opportunity_index = 0; opportunity_index < opportunities.size() && opportunity_index < 10; opportunity_index++) {
+        const vacation_break_plan& opportunity = opportunities[opportunity_index];
+        cout << "  " << format_year_day_text(year_value, opportunity.first_day_index) << " to "
+             << format_year_day_text(year_value, opportunity.last_day_index) << ": " << opportunity.vacation_day_count
+             << " vacation -> " << opportunity.break_length << " days off" << endl;
+    }
+    return 0;
+}
+
+// Function finds the longest break by trying every start day, the approach the optimizer replaces
+vacation_break_plan find_longest_vacation_break_by_search(const uint64_t off_day_words[VACATION_WINDOW_WORDS],
+                                                          int year_day_count, int window_day_count, int vacation_budget) {
+    vacation_break_plan best_plan = {0, -1, 0, 0};
+    for (int first_day_index = 0; first_day_index < year_day_count; first_day_index++) {
+        for (int last_day_index = first_day_index; last_day_index < window_day_count; last_day_index++) {
+            int working_day_count = 0;
+            for (int day_index = first_day_index; day_index <= last_day_index; day_index++) {
+                working_day_count += check_day_bitmap_bit(off_day_words, day_index) ? 0 : 1;
+            }
+            if (working_day_count > vacation_budget) {
+                break;
+            }
+            int break_length = last_day_index - first_day_index + 1;
+            if (break_length > best_plan.break_length ||
+                (break_length == best_plan.break_length && working_day_count < best_plan.vacation_day_count)) {
+                vacation_break_plan window_plan = {first_day_index, last_day_index, working_day_count, break_length};
+                best_plan = window_plan;
+            }
+        }
+    }
+    return best_plan;
+}
+
+int execute_vacation_benchmark(int employee_count, int thread_count) {
+    // Employees spread over three regions, budgets of 5-30 days and occasional part-time days off
+    const int year_value = 2026;
+    vector<int> region_codes;
+    for (int region_code = 0; region_code < HOLIDAY_REGION_COUNT; region_code++) {
+        region_codes.push_back(region_code);
+    }
+    vector<uint8_t> holiday_table = build_holiday_day_table(region_codes);
+    vector<vacation_request> vacation_requests(static_cast<size_t>(employee_count));
+    uint64_t random_state = 0x5851F42D4C957F2DULL;
+    for (size_t request_index = 0; request_index < vacation_requests.size(); request_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        vacation_request request = {int(random_state % HOLIDAY_REGION_COUNT), 5 + int((random_state >> 8) % 26),
+                                    uint8_t((random_state >> 16) % 10 == 0 ? 1 << (1 + (random_state >> 24) % 5) : 0)};
+        vacation_requests[request_index] = request;
+    }
+    int year_day_count = calculate_leap_year_status(year_value) ? 366 : 365;
+    int window_day_count = calculate_vacation_window_day_count(year_value);
+    
+    // Brute force per employee, timed on a sample and scaled to the whole batch
+    size_t sample_count = min(vacation_requests.size(), size_t(200));
+    vector<vacation_break_plan> searched_plans(sample_count);
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    for (size_t request_index = 0; request_index < sample_count; request_index++) {
+        const vacation_request& request = vacation_requests[request_index];
+        uint64_t off_day_words[VACATION_WINDOW_WORDS];
+        build_year_off_day_bitmap(year_value, holiday_table, uint8_t(1 << request.region_code), request.extra_off_weekdays,
+                                  off_day_words);
+        searched_plans[request_index] = find_longest_vacation_break_by_search(off_day_words, year_day_count, window_day_count,
+                                                                              request.vacation_budget);
+    }
+    double search_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    // Sliding window per employee, and the batch that shares work between identical requests
+    vector<vacation_break_plan> window_plans(vacation_requests.size());
+    start_time = chrono::steady_clock::now();
+    for (size_t request_index = 0; request_index < vacation_requests.size(); request_index++) {
+        const vacation_request& request = vacation_requests[request_index];
+        uint64_t off_day_words[VACATION_WINDOW_WORDS];
+        build_year_off_day_bitmap(year_value, holiday_table, uint8_t(1 << request.region_code), request.extra_off_weekdays,
+                                  off_day_words);
+        window_plans[request_index] = find_longest_vacation_break(off_day_words, year_day_count, window_day_count,
+                                                                  request.vacation_budget);
+    }
+    double window_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    vector<vacation_break_plan> batch_plans;
+    start_time = chrono::steady_clock::now();
+    optimize_vacation_batch(year_value, vacation_requests, holiday_table, batch_plans, thread_count);
+    double batch_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    // Brute force and the window must agree on length and cost; the batch must equal the window exactly
+    bool results_match = true;
+    for (size_t request_index = 0; request_index < vacation_requests.size(); request_index++) {
+        const vacation_break_plan& window_plan = window_plans[request_index];
+        results_match = results_match && batch_plans[request_index].first_day_index == window_plan.first_day_index &&
+                        batch_plans[request_index].break_length == window_plan.break_length;
+        if (request_index < sample_count) {
+            results_match = results_match && searched_plans[request_index].break_length == window_plan.break_length &&
+                            searched_plans[request_index].vacation_day_count == window_plan.vacation_day_count;
+        }
+    }
+    
+    cout << "VACATION OPTIMIZER BENCHMARK (" << employee_count << " employees, " << year_value << ", US/GB/DE)" << endl;
+    cout << string(60, '-') << endl;
+    cout << fixed << setprecision(2);
+    cout << "Brute Force: " << search_seconds * 1e6 / double(sample_count) << " us per employee (sampled "
+         << sample_count << ")" << endl;
+    cout << "Sliding Window: " << window_seconds * 1e6 / double(employee_count) << " us per employee" << endl;
+    cout << "Batch (shared requests): " << batch_seconds * 1e3 << " ms total, "
+         << batch_seconds * 1e6 / double(employee_count) << " us per employee" << endl;
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+PERSISTENT RENDER CACHE FUNCTIONS
+================================================================================
+*/
+
+// Function folds bytes into a 64-bit FNV-1a hash
+inline uint64_t fold_fnv1a_hash(uint64_t hash_value, const void* data_pointer, size_t data_length) {
+    const unsigned char* byte_pointer = static_cast<const unsigned char*>(data_pointer);
+    for (size_t byte_index = 0; byte_index < data_length; byte_index++) {
+        hash_value = (hash_value ^ byte_pointer[byte_index]) * 0x100000001B3ULL;
+    }
+    return hash_value;
+}
+
+uint64_t calculate_render_input_hash(int layout_class, int month_value, int output_format, uint32_t option_flags,
+                                     uint64_t holiday_set_hash) {
+    // Fields are serialized at fixed widths so the key does not depend on struct padding
+    uint32_t key_fields[5] = {RENDER_CACHE_FORMAT_VERSION, uint32_t(layout_class) << 8 | uint32_t(month_value),
+                              uint32_t(output_format), option_flags, 0};
+    uint64_t hash_value = fold_fnv1a_hash(0xCBF29CE484222325ULL, key_fields, sizeof(key_fields));
+    return fold_fnv1a_hash(hash_value, &holiday_set_hash, sizeof(holiday_set_hash));
+}
+
+uint64_t calculate_month_holiday_set_hash(const vector<uint8_t>& holiday_table, uint8_t holiday_mask,
+                                          int month_value, int year_value) {
+    // Only the positions of holidays inside the month matter, so years with the same
+    // layout and holiday positions share one cached rendering
+    uint32_t holiday_day_mask = 0;
+    int month_first_serial_day = calculate_serial_day_number(1, month_value, year_value);
+    int month_day_count = calculate_month_day_count(month_value, year_value);
+    for (int day_index = 0; day_index < month_day_count; day_index++) {
+        if ((holiday_table[size_t(month_first_serial_day + day_index)] & holiday_mask) != 0) {
+            holiday_day_mask |= uint32_t(1) << day_index;
+        }
+    }
+    return fold_fnv1a_hash(0xCBF29CE484222325ULL, &holiday_day_mask, sizeof(holiday_day_mask));
+}
+
+// Function maps a pack file and indexes its entries; returns false when absent or damaged
+bool load_render_cache_pack(const string& pack_file_path, mapped_file_region& mapped_pack,
+                            vector<render_cache_slot>& loaded_slots, uint64_t& access_clock) {
+    loaded_slots.clear();
+    access_clock = 0;
+    if (!map_file_read_only(pack_file_path, mapped_pack)) {
+        return false;
+    }
+    render_cache_file_header file_header;
+    bool pack_valid = mapped_pack.mapped_size >= sizeof(file_header);
+    if (pack_valid) {
+        memcpy(&file_header, mapped_pack.mapped_data, sizeof(file_header));
+        pack_valid = memcmp(file_header.magic, RENDER_CACHE_MAGIC, sizeof(RENDER_CACHE_MAGIC)) == 0 &&
+                     file_header.format_version == RENDER_CACHE_FORMAT_VERSION &&
+                     file_header.header_checksum == calculate_crc32_checksum(&file_header,
+                                                                             offsetof(render_cache_file_header, header_checksum)) &&
+                     file_header.index_offset <= mapped_pack.mapped_size &&
+                     (mapped_pack.mapped_size - file_header.index_offset) / sizeof(render_cache_index_record) >=
+                         file_header.entry_count;
+    }
+    if (pack_valid) {
+        const char* index_pointer = mapped_pack.mapped_data + file_header.index_offset;
+        size_t index_length = size_t(file_header.entry_count) * sizeof(render_cache_index_record);
+        pack_valid = calculate_crc32_checksum(index_pointer, index_length) == file_header.index_checksum;
+        for (uint32_t entry_index = 0; pack_valid && entry_index < file_header.entry_count; entry_index++) {
+            render_cache_slot cache_slot;
+            memcpy(&cache_slot.index_record, index_pointer + size_t(entry_index) * sizeof(render_cache_index_record),
+                   sizeof(render_cache_index_record));
+            pack_valid = cache_slot.index_record.data_offset <= file_header.index_offset &&
+                         cache_slot.index_record.data_length <= file_header.index_offset - cache_slot.index_record.data_offset;
+            cache_slot.data_pointer = mapped_pack.mapped_data + cache_slot.index_record.data_offset;
+            cache_slot.checksum_verified = false;
+            loaded_slots.push_back(cache_slot);
+        }
+    }
+    if (!pack_valid) {
+        unmap_file_region(mapped_pack);
+        loaded_slots.clear();
+        return false;
+    }
+    access_clock = file_header.access_clock;
+    return true;
+}
+
+void open_persistent_render_cache(persistent_render_cache& render_cache, const string& pack_file_path,
+                                  uint64_t size_limit_bytes) {
+    render_cache.pack_file_path = pack_file_path;
+    render_cache.size_limit_bytes = size_limit_bytes;
+    render_cache.cache_slots.clear();
+    render_cache.pending_outputs.clear();
+    render_cache.lookup_count = 0;
+    render_cache.hit_count = 0;
+    render_cache.hit_byte_count = 0;
+    render_cache.stored_byte_count = 0;
+    render_cache.evicted_entry_count = 0;
+    render_cache.rejected_entry_count = 0;
+    vector<render_cache_slot> loaded_slots;
+    load_render_cache_pack(pack_file_path, render_cache.mapped_pack, loaded_slots, render_cache.access_clock);
+    for (size_t slot_index = 0; slot_index < loaded_slots.size(); slot_index++) {
+        render_cache.cache_slots[loaded_slots[slot_index].index_record.input_hash] = loaded_slots[slot_index];
+    }
+}
+
+bool lookup_render_cache(persistent_render_cache& render_cache, uint64_t input_hash,
+                         const char*& data_pointer, size_t& data_length) {
+    render_cache.lookup_count++;
+    unordered_map<uint64_t, render_cache_slot>::iterator slot_position = render_cache.cache_slots.find(input_hash);
+    if (slot_position == render_cache.cache_slots.end()) {
+        return false;
+    }
+    render_cache_slot& cache_slot = slot_position->second;
+    
+    // Bytes from the pack are checked once per process before they are first served
+    if (!cache_slot.checksum_verified) {
+        if (calculate_crc32_checksum(cache_slot.data_pointer, cache_slot.index_record.data_length) !=
+            cache_slot.index_record.data_checksum) {
+            render_cache.cache_slots.erase(slot_position);
+            render_cache.rejected_entry_count++;
+            return false;
+        }
+        cache_slot.checksum_verified = true;
+    }
+    cache_slot.index_record.last_access_tick = ++render_cache.access_clock;
+    data_pointer = cache_slot.data_pointer;
+    data_length = cache_slot.index_record.data_length;
+    render_cache.hit_count++;
+    render_cache.hit_byte_count += data_length;
+    return true;
+}
+
+void store_render_cache(persistent_render_cache& render_cache, uint64_t input_hash, const string& rendered_output) {
+    render_cache.pending_outputs.push_back(rendered_output);
+    render_cache_slot cache_slot;
+    cache_slot.index_record.input_hash = input_hash;
+    cache_slot.index_record.data_offset = 0;
+    cache_slot.index_record.data_length = uint32_t(rendered_output.size());
+    cache_slot.index_record.data_checksum = calculate_crc32_checksum(rendered_output.data(), rendered_output.size());
+    cache_slot.index_record.last_access_tick = ++render_cache.access_clock;
+    cache_slot.data_pointer = render_cache.pending_outputs.back().data();
+    cache_slot.checksum_verified = true;
+    render_cache.cache_slots[input_hash] = cache_slot;
+    render_cache.stored_byte_count += rendered_output.size();
+}
+
+bool flush_persistent_render_cache(persistent_render_cache& render_cache) {
+    // Another process may have replaced the pack since it was opened; fold its entries in
+    // so concurrent writers lose nothing but the least recently used outputs. The lock file
+    // spans load, merge and rename, so no flush merges a pack another is about to replace
+    // and no two flushes share the temporary file
+    exclusive_file_lock pack_lock;
+    if (!acquire_exclusive_file_lock(render_cache.pack_file_path + ".lock", pack_lock)) {
+        return false;
+    }
+    mapped_file_region current_pack;
+    vector<render_cache_slot> current_slots;
+    uint64_t current_access_clock = 0;
+    load_render_cache_pack(render_cache.pack_file_path, current_pack, current_slots, current_access_clock);
+    vector<render_cache_slot> merged_slots;
+    merged_slots.reserve(render_cache.cache_slots.size() + current_slots.size());
+    for (unordered_map<uint64_t, render_cache_slot>::const_iterator slot_position = render_cache.cache_slots.begin();
+         slot_position != render_cache.cache_slots.end(); ++slot_position) {
+        merged_slots.push_back(slot_position->second);
+    }
+    for (size_t slot_index = 0; slot_index < current_slots.size(); slot_index++) {
+        if (render_cache.cache_slots.find(current_slots[slot_index].index_record.input_hash) == render_cache.cache_slots.end() &&
+            calculate_crc32_checksum(current_slots[slot_index].data_pointer, current_slots[slot_index].index_record.data_length) ==
+                current_slots[slot_index].index_record.data_checksum) {
+            merged_slots.push_back(current_slots[slot_index]);
+        }
+    }
+    uint64_t merged_access_clock = max(render_cache.access_clock, current_access_clock);
+    
+    // Keep the most recently used outputs that fit within the size limit
+    sort(merged_slots.begin(), merged_slots.end(), [](const render_cache_slot& left_slot, const render_cache_slot& right_slot) {
+        return left_slot.index_record.last_access_tick > right_slot.index_record.last_access_tick;
+    });
+    uint64_t pack_size = sizeof(render_cache_file_header);
+    size_t kept_count = 0;
+    while (kept_count < merged_slots.size() &&
+           pack_size + merged_slots[kept_count].index_record.data_length + sizeof(render_cache_index_record) <=
+               render_cache.size_limit_bytes) {
+        pack_size += merged_slots[kept_count].index_record.data_length + sizeof(render_cache_index_record);
+        kept_count++;
+    }
+    render_cache.evicted_entry_count += merged_slots.size() - kept_count;
+    merged_slots.resize(kept_count);
+    
+    // Header, packed outputs, then the index
+    string pack_contents(sizeof(render_cache_file_header), '\0');
+    pack_contents.reserve(size_t(pack_size));
+    vector<render_cache_index_record> index_records(kept_count);
+    for (size_t slot_index = 0; slot_index < kept_count; slot_index++) {
+        index_records[slot_index] = merged_slots[slot_index].index_record;
+        index_records[slot_index].data_offset = pack_contents.size();
+        pack_contents.append(merged_slots[slot_index].data_pointer, merged_slots[slot_index].index_record.data_length);
+    }
+    render_cache_file_header file_header;
+    memset(&file_header, 0, sizeof(file_header));
+    memcpy(file_header.magic, RENDER_CACHE_MAGIC, sizeof(RENDER_CACHE_MAGIC));
+    file_header.format_version = RENDER_CACHE_FORMAT_VERSION;
+    file_header.entry_count = uint32_t(kept_count);
+    file_header.access_clock = merged_access_clock;
+    file_header.index_offset = pack_contents.size();
+    pack_contents.append(reinterpret_cast<const char*>(index_records.data()), kept_count * sizeof(render_cache_index_record));
+    file_header.index_checksum = calculate_crc32_checksum(pack_contents.data() + file_header.index_offset,
+                                                          kept_count * sizeof(render_cache_index_record));
+    file_header.header_checksum = calculate_crc32_checksum(&file_header, offsetof(render_cache_file_header, header_checksum));
+    memcpy(&pack_contents[0], &file_header, sizeof(file_header));
+    
+    // Mappings are released before the rename (required on Windows), then the new pack is served
+    unmap_file_region(current_pack);
+    unmap_file_region(render_cache.mapped_pack);
+    render_cache.cache_slots.clear();
+    render_cache.pending_outputs.clear();
+    bool write_succeeded = write_file_atomically(render_cache.pack_file_path, pack_contents);
+    vector<render_cache_slot> loaded_slots;
+    load_render_cache_pack(render_cache.pack_file_path, render_cache.mapped_pack, loaded_slots, render_cache.access_clock);
+    release_exclusive_file_lock(pack_lock);
+    for (size_t slot_index = 0; slot_index < loaded_slots.size(); slot_index++) {
+        render_cache.cache_slots[loaded_slots[slot_index].index_record.input_hash] = loaded_slots[slot_index];
+    }
+    return write_succeeded;
+}
+
+void close_persistent_render_cache(persistent_render_cache& render_cache) {
+    unmap_file_region(render_cache.mapped_pack);
+    render_cache.cache_slots.clear();
+    render_cache.pending_outputs.clear();
+}
+
+void append_cached_monthly_calendar_display(persistent_render_cache& render_cache, string& display_buffer,
+                                            int target_month, int target_year, const calendar_display_options& display_options) {
+    // Phase, occupancy and highlight annotations depend on the exact dates and bypass the cache
+    if (display_options.lunar_phase_table != NULL || display_options.occupancy_calendar != NULL ||
+        display_options.highlighted_days != NULL) {
+        append_monthly_calendar_display(display_buffer, target_month, target_year, display_options);
+        return;
+    }
+    
+    // Everything below the title line is fixed by the layout class, month and holiday positions
+    uint32_t option_flags = display_options.holiday_day_table != NULL ? RENDER_CACHE_OPTION_HOLIDAY_MARKERS : 0;
+    uint64_t holiday_set_hash = display_options.holiday_day_table != NULL ?
+        calculate_month_holiday_set_hash(*display_options.holiday_day_table, display_options.holiday_region_mask,
+                                         target_month, target_year) : 0;
+    uint64_t input_hash = calculate_render_input_hash(calculate_year_layout_class(target_year), target_month,
+                                                      RENDER_CACHE_FORMAT_TEXT_MONTH, option_flags, holiday_set_hash);
+    const char* cached_data = NULL;
+    size_t cached_length = 0;
+    if (lookup_render_cache(render_cache, input_hash, cached_data, cached_length)) {
+        append_monthly_calendar_title(display_buffer, target_month, target_year);
+        display_buffer.append(cached_data, cached_length);
+        return;
+    }
+    
+    size_t display_start = display_buffer.size();
+    append_monthly_calendar_display(display_buffer, target_month, target_year, display_options);
+    size_t body_start = display_buffer.find('\n', display_start + 1) + 1;
+    store_render_cache(render_cache, input_hash, display_buffer.substr(body_start));
+}
+
+int execute_render_cache_report(int argument_count, char* argument_values[], const string& pack_file_path) {
+    string years_text = find_command_line_option_value(argument_count, argument_values, "--cache-years", "2000-2099");
+    string output_file_path = find_command_line_option_value(argument_count, argument_values, "--cache-output", "");
+    int size_limit_kilobytes = find_command_line_integer_option(argument_count, argument_values, "--cache-limit-kb", 4096);
+    int first_year = 0;
+    int last_year = 0;
+    vector<int> region_codes;
+    if (sscanf(years_text.c_str(), "%d-%d", &first_year, &last_year) != 2 || first_year < 1 || last_year > 9999 ||
+        first_year > last_year || size_limit_kilobytes <= 0 ||
+        !parse_holiday_region_list(find_command_line_option_value(argument_count, argument_values, "--holidays", ""),
+                                   region_codes)) {
+        cout << "ERROR: --render-cache expects --cache-years <y1-y2> within 1-9999 and valid options" << endl;
+        return 1;
+    }
+    vector<uint8_t> holiday_table;
+    calendar_display_options display_options;
+    if (!region_codes.empty()) {
+        holiday_table = build_holiday_day_table(region_codes);
+        display_options.holiday_day_table = &holiday_table;
+        for (size_t region_index = 0; region_index < region_codes.size(); region_index++) {
+            display_options.holiday_region_mask |= uint8_t(1 << region_codes[region_index]);
+        }
+    }
+    
+    persistent_render_cache render_cache;
+    open_persistent_render_cache(render_cache, pack_file_path, uint64_t(size_limit_kilobytes) * 1024);
+    size_t loaded_entry_count = render_cache.cache_slots.size();
+    
+    // Render every month through the cache
+    string rendered_text;
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    for (int year_value = first_year; year_value <= last_year; year_value++) {
+        for (int month_value = 1; month_value <= 12; month_value++) {
+            append_cached_monthly_calendar_display(render_cache, rendered_text, month_value, year_value, display_options);
+        }
+    }
+    double cached_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    unsigned long long lookup_count = render_cache.lookup_count;
+    unsigned long long hit_count = render_cache.hit_count;
+    unsigned long long hit_byte_count = render_cache.hit_byte_count;
+    unsigned long long stored_byte_count = render_cache.stored_byte_count;
+    unsigned long long rejected_entry_count = render_cache.rejected_entry_count;
+    bool flush_succeeded = flush_persistent_render_cache(render_cache);
+    size_t stored_entry_count = render_cache.cache_slots.size();
+    size_t pack_size = render_cache.mapped_pack.mapped_size;
+    unsigned long long evicted_entry_count = render_cache.evicted_entry_count;
+    close_persistent_render_cache(render_cache);
+    
+    // The cached text must equal a direct rendering byte for byte
+    string direct_text;
+    start_time = chrono::steady_clock::now();
+    for (int year_value = first_year; year_value <= last_year; year_value++) {
+        for (int month_value = 1; month_value <= 12; month_value++) {
+            append_monthly_calendar_display(direct_text, month_value, year_value, display_options);
+        }
+    }
+    double direct_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    if (!output_file_path.empty() && !write_file_atomically(output_file_path, rendered_text)) {
+        cout << "ERROR: Unable to write " << output_file_path << endl;
+        return 1;
+    }
+    
+    cout << "RENDER CACHE REPORT (" << first_year << "-" << last_year << ", " << pack_file_path << ")" << endl;
+    cout << string(60, '-') << endl;
+    cout << "Entries Loaded: " << loaded_entry_count << endl;
+    cout << "Lookups: " << lookup_count << ", hits " << hit_count << ", misses " << (lookup_count - hit_count) << endl;
+    cout << "Hit Ratio: " << fixed << setprecision(1)
+         << (lookup_count > 0 ? double(hit_count) * 100.0 / double(lookup_count) : 0.0) << "%" << endl;
+    cout << "Bytes Saved: " << hit_byte_count << " served from cache, " << stored_byte_count << " rendered" << endl;
+    if (rejected_entry_count > 0) {
+        cout << "Rejected Entries: " << rejected_entry_count << " (checksum mismatch)" << endl;
+    }
+    cout << "Pack: " << stored_entry_count << " entries, " << pack_size << " bytes (limit " << size_limit_kilobytes
+         << " KB, " << evicted_entry_count << " evicted)" << endl;
+    cout << setprecision(3) << "Time: " << cached_seconds * 1000.0 << " ms cached, " << direct_seconds * 1000.0
+         << " ms direct" << endl;
+    cout << "Output: " << (rendered_text == direct_text ? "matches direct rendering" : "MISMATCH") << endl;
+    if (!flush_succeeded) {
+        cout << "ERROR: Unable to update " << pack_file_path << endl;
+        return 1;
+    }
+    return rendered_text == direct_text ? 0 : 1;
+}
+
+/*
+================================================================================
+WEEK ROW EMITTER FUNCTIONS
+================================================================================
+*/
+
+const char* retrieve_calendar_row_cell_strip() {
+    // Cells for days 1-31 come from a two-character digit-pair table (" 1" .. "31")
+    static const struct calendar_row_cell_strip {
+        alignas(16) char cell_bytes[CALENDAR_ROW_STRIP_LENGTH];
+        calendar_row_cell_strip() {
+            char digit_pairs[32][2];
+            for (int day_value = 0; day_value < 32; day_value++) {
+                digit_pairs[day_value][0] = day_value >= 10 ? char('0' + day_value / 10) : ' ';
+                digit_pairs[day_value][1] = char('0' + day_value % 10);
+            }
+            memset(cell_bytes, ' ', sizeof(cell_bytes));
+            for (int day_value = 1; day_value <= 31; day_value++) {
+                memcpy(cell_bytes + CALENDAR_ROW_STRIP_BLANK_BYTES + (day_value - 1) * 3 + 1, digit_pairs[day_value], 2);
+            }
+        }
+    } shared_cell_strip;
+    return shared_cell_strip.cell_bytes;
+}
+
+void build_calendar_row_marker_strip(const char* day_markers, int month_day_count, calendar_row_marker_strip& marker_strip) {
+    // A marker replaces the blank immediately before the day number
+    memset(marker_strip.marker_bytes, 0, sizeof(marker_strip.marker_bytes));
+    marker_strip.markers_present = false;
+    for (int day_value = 1; day_value <= month_day_count; day_value++) {
+        if (day_markers[day_value] != 0) {
+            marker_strip.marker_bytes[CALENDAR_ROW_STRIP_BLANK_BYTES + (day_value - 1) * 3 + (day_value >= 10 ? 0 : 1)] =
+                day_markers[day_value];
+            marker_strip.markers_present = true;
+        }
+    }
+}
+
+void append_calendar_week_rows(string& display_buffer, int starting_day_position, int month_day_count,
+                               const calendar_row_marker_strip& marker_strip) {
+    // Every row is a 21-byte window of the strip: the first starts inside the blank
+    // cells, later rows start at their Sunday. A final short row is cut at its last day.
+    const char* cell_strip = retrieve_calendar_row_cell_strip();
+    int row_first_day = 1;
+    int row_leading_cells = starting_day_position;
+    while (row_first_day <= month_day_count) {
+        int row_day_count = min(7 - row_leading_cells, month_day_count - row_first_day + 1);
+        int row_start = CALENDAR_ROW_STRIP_BLANK_BYTES + (row_first_day - 1 - row_leading_cells) * 3;
+        int row_length = (row_leading_cells + row_day_count) * 3;
+        alignas(16) char row_bytes[32];
+#if defined(CALENDAR_SSE2_ROW_EMITTER_AVAILABLE)
+        __m128i low_cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell_strip + row_start));
+        __m128i high_cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell_strip + row_start + 16));
+        if (marker_strip.markers_present) {
+            // SSE2 blend: keep the cell where the marker byte is zero, otherwise take the marker
+            __m128i low_markers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(marker_strip.marker_bytes + row_start));
+            __m128i high_markers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(marker_strip.marker_bytes + row_start + 16));
+            __m128i low_keep = _mm_cmpeq_epi8(low_markers, _mm_setzero_si128());
+            __m128i high_keep = _mm_cmpeq_epi8(high_markers, _mm_setzero_si128());
+            low_cells = _mm_or_si128(_mm_and_si128(low_keep, low_cells), _mm_andnot_si128(low_keep, low_markers));
+            high_cells = _mm_or_si128(_mm_and_si128(high_keep, high_cells), _mm_andnot_si128(high_keep, high_markers));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(row_bytes), low_cells);
+        _mm_store_si128(reinterpret_cast<__m128i*>(row_bytes + 16), high_cells);
+#else
+        memcpy(row_bytes, cell_strip + row_start, 21);
+        if (marker_strip.markers_present) {
+            for (int byte_index = 0; byte_index < 21; byte_index++) {
+                char marker_byte = marker_strip.marker_bytes[row_start + byte_index];
+                row_bytes[byte_index] = marker_byte != 0 ? marker_byte : row_bytes[byte_index];
+            }
+        }
+#endif
+        row_bytes[row_length] = '\n';
+        display_buffer.append(row_bytes, size_t(row_length) + 1);
+        row_first_day += row_day_count;
+        row_leading_cells = 0;
+    }
+}
+
+void append_calendar_week_rows_by_cell(string& display_buffer, int starting_day_position, int month_day_count,
+                                       const char* day_markers) {
+    // Generate leading spaces for first week alignment
+    int calendar_position_counter = 0;
+    for (int leading_space_counter = 0; leading_space_counter < starting_day_position; leading_space_counter++) {
+        display_buffer += "   "; // Three spaces per calendar position
+        calendar_position_counter++;
+    }
+    
+    // Generate calendar days right-aligned in three-character cells
+    for (int current_day = 1; current_day <= month_day_count; current_day++) {
+        char day_cell[3] = {' ', current_day >= 10 ? char('0' + current_day / 10) : ' ', char('0' + current_day % 10)};
+        
+        // Marked days carry the marker immediately before the day number
+        if (day_markers[current_day] != 0) {
+            day_cell[current_day >= 10 ? 0 : 1] = day_markers[current_day];
+        }
+        display_buffer.append(day_cell, 3);
+        calendar_position_counter++;
+        
+        // Insert line break after Saturday (position 7) for new week
+        if (calendar_position_counter % 7 == 0) {
+            display_buffer += "\n";
+        }
+    }
+    
+    // Add final newline if month doesn't end on Saturday
+    if (calendar_position_counter % 7 != 0) {
+        display_buffer += "\n";
+    }
+}
+
+// Function reads a per-row timing source: processor cycles where available, nanoseconds otherwise
+inline unsigned long long read_row_timing_counter() {
+#if defined(CALENDAR_SSE2_ROW_EMITTER_AVAILABLE)
+    return (unsigned long long)__rdtsc();
+#else
+    return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+int execute_row_emitter_benchmark(int row_count) {
+    // Every start weekday and month length, with and without markers, must match the reference
+    bool results_match = true;
+    char day_markers[32];
+    const char marker_choices[] = {0, LUNAR_NEW_MOON_MARKER, HOLIDAY_DAY_MARKER, DATE_SET_HIGHLIGHT_MARKER};
+    for (int marker_pattern = 0; marker_pattern < 3; marker_pattern++) {
+        for (int day_value = 0; day_value < 32; day_value++) {
+            day_markers[day_value] = marker_pattern == 0 ? 0 :
+                                     marker_pattern == 1 ? marker_choices[day_value % 4] : marker_choices[1 + day_value % 3];
+        }
+        for (int starting_day_position = 0; starting_day_position < 7; starting_day_position++) {
+            for (int month_day_count = 28; month_day_count <= 31; month_day_count++) {
+                calendar_row_marker_strip marker_strip;
+                build_calendar_row_marker_strip(day_markers, month_day_count, marker_strip);
+                string vector_rows;
+                string reference_rows;
+                append_calendar_week_rows(vector_rows, starting_day_position, month_day_count, marker_strip);
+                append_calendar_week_rows_by_cell(reference_rows, starting_day_position, month_day_count, day_markers);
+                results_match = results_match && vector_rows == reference_rows;
+            }
+        }
+    }
+    
+    // Time whole months and divide by their rows; buffers are reused so only formatting is measured
+    memset(day_markers, 0, sizeof(day_markers));
+    day_markers[13] = HOLIDAY_DAY_MARKER;
+    calendar_row_marker_strip plain_strip;
+    calendar_row_marker_strip marked_strip;
+    build_calendar_row_marker_strip(day_markers, 31, marked_strip);
+    memset(day_markers, 0, sizeof(day_markers));
+    build_calendar_row_marker_strip(day_markers, 31, plain_strip);
+    char marked_day_markers[32] = {0};
+    marked_day_markers[13] = HOLIDAY_DAY_MARKER;
+    
+    string row_buffer;
+    row_buffer.reserve(256);
+    int month_count = max(1, row_count / 5);
+    long long emitted_row_count = 0;
+    size_t checksum_value = 0;
+    double timing_results[4];
+    for (int benchmark_index = 0; benchmark_index < 4; benchmark_index++) {
+        bool vector_emitter = benchmark_index % 2 == 1;
+        bool markers_enabled = benchmark_index >= 2;
+        emitted_row_count = 0;
+        unsigned long long start_counter = read_row_timing_counter();
+        for (int month_index = 0; month_index < month_count; month_index++) {
+            int starting_day_position = month_index % 7;
+            int month_day_count = 28 + month_index % 4;
+            row_buffer.clear();
+            if (vector_emitter) {
+                append_calendar_week_rows(row_buffer, starting_day_position, month_day_count,
+                                          markers_enabled ? marked_strip : plain_strip);
+            } else {
+                append_calendar_week_rows_by_cell(row_buffer, starting_day_position, month_day_count,
+                                                  markers_enabled ? marked_day_markers : day_markers);
+            }
+            emitted_row_count += (starting_day_position + month_day_count + 6) / 7;
+            checksum_value += row_buffer.size();
+        }
+        timing_results[benchmark_index] = double(read_row_timing_counter() - start_counter) / double(emitted_row_count);
+    }
+    
+    const char* timing_unit = "ns";
+#if defined(CALENDAR_SSE2_ROW_EMITTER_AVAILABLE)
+    timing_unit = "cycles";
+#endif
+    cout << "WEEK ROW EMITTER BENCHMARK (" << emitted_row_count << " rows per run)" << endl;
+    cout << string(60, '-') << endl;
+#if defined(CALENDAR_SSE2_ROW_EMITTER_AVAILABLE)
+    cout << "Vector Path: SSE2" << endl;
+#else
+    cout << "Vector Path: unavailable (portable strip copy)" << endl;
+#endif
+    cout << fixed << setprecision(1);
+    cout << "Per-Cell Rows: " << timing_results[0] << " " << timing_unit << "/row" << endl;
+    cout << "Strip Rows: " << timing_results[1] << " " << timing_unit << "/row (" << setprecision(2)
+         << (timing_results[1] > 0.0 ? timing_results[0] / timing_results[1] : 0.0) << "x)" << endl;
+    cout << setprecision(1) << "Per-Cell Rows (marked): " << timing_results[2] << " " << timing_unit << "/row" << endl;
+    cout << "Strip Rows (marked): " << timing_results[3] << " " << timing_unit << "/row (" << setprecision(2)
+         << (timing_results[3] > 0.0 ? timing_results[2] / timing_results[3] : 0.0) << "x)" << endl;
+    cout << "Checksum: " << checksum_value << endl;
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
+
+/*
+================================================================================
+DAYLIGHT SAVING TRANSITION REPORT FUNCTIONS
+================================================================================
+*/
+
+// Function reads a big-endian 32-bit signed value from TZif data
+inline int32_t read_tzif_int32(const unsigned char* data_pointer) {
+    return int32_t(uint32_t(data_pointer[0]) << 24 | uint32_t(data_pointer[1]) << 16 | uint32_t(data_pointer[2]) << 8 |
+                   uint32_t(data_pointer[3]));
+}
+
+// Function reads a big-endian 64-bit signed value from TZif data
+inline int64_t read_tzif_int64(const unsigned char* data_pointer) {
+    return int64_t(uint64_t(uint32_t(read_tzif_int32(data_pointer))) << 32 | uint64_t(uint32_t(read_tzif_int32(data_pointer + 4))));
+}
+
+bool list_zoneinfo_files(const string& directory_path, const string& relative_prefix, vector<string>& zone_names) {
+    // Generated variants and the local-time link duplicate the primary zones
+    vector<string> entry_names;
+    vector<bool> entry_directories;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA find_data;
+    HANDLE find_handle = FindFirstFileA((directory_path + "\\*").c_str(), &find_data);
+    if (find_handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    do {
+        entry_names.push_back(find_data.cFileName);
+        entry_directories.push_back((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+    } while (FindNextFileA(find_handle, &find_data));
+    FindClose(find_handle);
+#else
+    DIR* directory_stream = opendir(directory_path.c_str());
+    if (directory_stream == NULL) {
+        return false;
+    }
+    for (struct dirent* directory_entry = readdir(directory_stream); directory_entry != NULL;
+         directory_entry = readdir(directory_stream)) {
+        struct stat entry_status;
+        string entry_path = directory_path + "/" + directory_entry->d_name;
+        if (stat(entry_path.c_str(), &entry_status) != 0) {
+            continue;
+        }
+        entry_names.push_back(directory_entry->d_name);
+        entry_directories.push_back(S_ISDIR(entry_status.st_mode));
+    }
+    closedir(directory_stream);
+#endif
+    for (size_t entry_index = 0; entry_index < entry_names.size(); entry_index++) {
+        const string& entry_name = entry_names[entry_index];
+        if (entry_name.empty() || entry_name[0] == '.' || entry_name == "posix" || entry_name == "right" ||
+            entry_name == "localtime" || entry_name == "posixrules" || entry_name == "Factory") {
+            continue;
+        }
+        if (entry_directories[entry_index]) {
+            list_zoneinfo_files(directory_path + "/" + entry_name, relative_prefix + entry_name + "/", zone_names);
+        } else {
+            zone_names.push_back(relative_prefix + entry_name);
+        }
+    }
+    return true;
+}
+
+// Function parses a POSIX TZ name (alphabetic or <quoted>) and returns the position after it
+const char* parse_posix_zone_name(const char* text_position, char* zone_abbreviation) {
+    size_t name_length = 0;
+    if (*text_position == '<') {
+        text_position++;
+        while (*text_position != '\0' && *text_position != '>') {
+            if (name_length < 7) zone_abbreviation[name_length++] = *text_position;
+            text_position++;
+        }
+        if (*text_position == '>') text_position++;
+    } else {
+        while (isalpha((unsigned char)*text_position)) {
+            if (name_length < 7) zone_abbreviation[name_length++] = *text_position;
+            text_position++;
+        }
+    }
+    zone_abbreviation[name_length] = '\0';
+    return name_length > 0 ? text_position : NULL;
+}
+
+// Function parses [+-]hh[:mm[:ss]] and returns the position after it
+const char* parse_posix_zone_seconds(const char* text_position, int& time_seconds) {
+    int sign_value = 1;
+    if (*text_position == '+' || *text_position == '-') {
+        sign_value = *text_position == '-' ? -1 : 1;
+        text_position++;
+    }
+    if (!isdigit((unsigned char)*text_position)) {
+        return NULL;
+    }
+    int field_values[3] = {0, 0, 0};
+    for (int field_index = 0; field_index < 3; field_index++) {
+        while (isdigit((unsigned char)*text_position)) {
+            field_values[field_index] = field_values[field_index] * 10 + (*text_position++ - '0');
+        }
+        if (field_index < 2 && *text_position == ':' && isdigit((unsigned char)text_position[1])) {
+            text_position++;
+        } else {
+            break;
+        }
+    }
+    time_seconds = sign_value * (field_values[0] * 3600 + field_values[1] * 60 + field_values[2]);
+    return text_position;
+}
+
+// Function parses a rule date (Jn, n or Mm.w.d) with an optional /time (default 02:00)
+const char* parse_posix_zone_rule(const char* text_position, posix_zone_rule_date& rule_date) {
+    rule_date.rule_kind = *text_position == 'J' ? 'J' : *text_position == 'M' ? 'M' : 'D';
+    if (rule_date.rule_kind != 'D') {
+        text_position++;
+    }
+    int rule_fields[3] = {0, 0, 0};
+    int field_count = rule_date.rule_kind == 'M' ? 3 : 1;
+    for (int field_index = 0; field_index < field_count; field_index++) {
+        if (!isdigit((unsigned char)*text_position)) {
+            return NULL;
+        }
+        while (isdigit((unsigned char)*text_position)) {
+            rule_fields[field_index] = rule_fields[field_index] * 10 + (*text_position++ - '0');
+        }
+        if (field_index + 1 < field_count && *text_position++ != '.') {
+            return NULL;
+        }
+    }
+    rule_date.first_field = rule_fields[0];
+    rule_date.second_field = rule_fields[1];
+    rule_date.third_field = rule_fields[2];
+    rule_date.local_time_seconds = 7200;
+    if (*text_position == '/') {
+        text_position = parse_posix_zone_seconds(text_position + 1, rule_date.local_time_seconds);
+    }
+    return text_position;
+}
+
+bool parse_posix_zone_footer(const char* footer_text, posix_zone_footer& zone_footer) {
+    // std offset [dst [offset] [,start[/time],end[/time]]]; POSIX offsets count west of UTC
+    memset(&zone_footer, 0, sizeof(zone_footer));
+    const char* text_position = parse_posix_zone_name(footer_text, zone_footer.standard_abbreviation);
+    int posix_offset_seconds = 0;
+    if (text_position == NULL || (text_position = parse_posix_zone_seconds(text_position, posix_offset_seconds)) == NULL) {
+        return false;
+    }
+    zone_footer.standard_offset_seconds = -posix_offset_seconds;
+    if (*text_position == '\0') {
+        return true;
+    }
+    text_position = parse_posix_zone_name(text_position, zone_footer.daylight_abbreviation);
+    if (text_position == NULL) {
+        return false;
+    }
+    zone_footer.daylight_offset_seconds = zone_footer.standard_offset_seconds + 3600;
+    if (*text_position != ',' && *text_position != '\0') {
+        if ((text_position = parse_posix_zone_seconds(text_position, posix_offset_seconds)) == NULL) {
+            return false;
+        }
+        zone_footer.daylight_offset_seconds = -posix_offset_seconds;
+    }
+    // A daylight name without rules would need the historical posixrules default; such zones report no rule
+    if (*text_position != ',' ||
+        (text_position = parse_posix_zone_rule(text_position + 1, zone_footer.daylight_start_rule)) == NULL ||
+        *text_position != ',' ||
+        (text_position = parse_posix_zone_rule(text_position + 1, zone_footer.daylight_end_rule)) == NULL) {
+        return false;
+    }
+    zone_footer.daylight_rules_present = true;
+    return true;
+}
+
+// Function resolves a POSIX rule date to a serial day within a year
+int calculate_posix_rule_serial_day(const posix_zone_rule_date& rule_date, int year_value) {
+    int year_first_serial_day = calculate_serial_day_number(1, 1, year_value);
+    if (rule_date.rule_kind == 'J') {
+        // Julian day 1-365 never counts February 29
+        return year_first_serial_day + rule_date.first_field - 1 +
+               (calculate_leap_year_status(year_value) && rule_date.first_field >= 60 ? 1 : 0);
+    }
+    if (rule_date.rule_kind == 'D') {
+        return year_first_serial_day + rule_date.first_field;
+    }
+    return calculate_nth_weekday_serial_day(rule_date.second_field == 5 ? -1 : rule_date.second_field,
+                                            rule_date.third_field, rule_date.first_field, year_value);
+}
+
+// Function appends a transition if it changes the offset or the daylight flag
+void append_time_zone_transition(vector<time_zone_transition>& zone_transitions, long long utc_seconds,
+                                 int offset_before_seconds, bool daylight_before, const char* abbreviation_before,
+                                 int offset_after_seconds, bool daylight_after, const char* abbreviation_after) {
+    if (offset_before_seconds == offset_after_seconds && daylight_before == daylight_after) {
+        return;
+    }
+    time_zone_transition zone_transition;
+    memset(&zone_transition, 0, sizeof(zone_transition));
+    zone_transition.utc_seconds = utc_seconds;
+    zone_transition.offset_before_seconds = offset_before_seconds;
+    zone_transition.offset_after_seconds = offset_after_seconds;
+    zone_transition.daylight_before = daylight_before;
+    zone_transition.daylight_after = daylight_after;
+    strncpy(zone_transition.abbreviation_before, abbreviation_before, sizeof(zone_transition.abbreviation_before) - 1);
+    strncpy(zone_transition.abbreviation_after, abbreviation_after, sizeof(zone_transition.abbreviation_after) - 1);
+    zone_transitions.push_back(zone_transition);
+}
+
+bool parse_tzif_transitions(const char* file_data, size_t file_size, long long first_utc_seconds, long long last_utc_seconds,
+                            vector<time_zone_transition>& zone_transitions) {
+    // Fields are decoded in place from the mapping; only transitions inside the window are copied out
+    const unsigned char* data_begin = reinterpret_cast<const unsigned char*>(file_data);
+    const unsigned char* data_end = data_begin + file_size;
+    if (file_size < 44 || memcmp(data_begin, "TZif", 4) != 0) {
+        return false;
+    }
+    int time_size = 4;
+    const unsigned char* header_pointer = data_begin;
+    for (int block_index = 0; ; block_index++) {
+        uint32_t header_counts[6];
+        for (int count_index = 0; count_index < 6; count_index++) {
+            header_counts[count_index] = uint32_t(read_tzif_int32(header_pointer + 20 + count_index * 4));
+        }
+        uint32_t utc_indicator_count = header_counts[0];
+        uint32_t standard_indicator_count = header_counts[1];
+        uint32_t leap_second_count = header_counts[2];
+        uint32_t transition_count = header_counts[3];
+        uint32_t type_count = header_counts[4];
+        uint32_t abbreviation_byte_count = header_counts[5];
+        uint64_t block_length = uint64_t(transition_count) * uint64_t(time_size + 1) + uint64_t(type_count) * 6 +
+                                abbreviation_byte_count + uint64_t(leap_second_count) * uint64_t(time_size + 4) +
+                                standard_indicator_count + utc_indicator_count;
+        const unsigned char* block_pointer = header_pointer + 44;
+        if (type_count == 0 || block_length > uint64_t(data_end - block_pointer)) {
+            return false;
+        }
+        
+        // Version 2+ files repeat the data with 64-bit times; the first block is skipped
+        if (block_index == 0 && header_pointer[4] >= '2') {
+            header_pointer = block_pointer + block_length;
+            time_size = 8;
+            if (data_end - header_pointer < 44 || memcmp(header_pointer, "TZif", 4) != 0) {
+                return false;
+            }
+            continue;
+        }
+        
+        const unsigned char* transition_times = block_pointer;
+        const unsigned char* transition_types = transition_times + size_t(transition_count) * size_t(time_size);
+        const unsigned char* local_time_types = transition_types + transition_count;
+        const char* abbreviation_bytes = reinterpret_cast<const char*>(local_time_types + size_t(type_count) * 6);
+        const unsigned char* footer_pointer = block_pointer + block_length;
+        
+        // Local time type fields: offset (4), daylight flag (1), abbreviation index (1)
+        char type_abbreviations[256][8];
+        for (uint32_t type_index = 0; type_index < type_count && type_index < 256; type_index++) {
+            const unsigned char* type_pointer = local_time_types + type_index * 6;
+            size_t abbreviation_index = type_pointer[5];
+            size_t copy_length = 0;
+            while (abbreviation_index + copy_length < abbreviation_byte_count && copy_length < 7 &&
+                   abbreviation_bytes[abbreviation_index + copy_length] != '\0') {
+                type_abbreviations[type_index][copy_length] = abbreviation_bytes[abbreviation_index + copy_length];
+                copy_length++;
+            }
+            type_abbreviations[type_index][copy_length] = '\0';
+        }
+        
+        // Times before the first transition use type 0
+        uint32_t previous_type = 0;
+        long long last_transition_seconds = LLONG_MIN;
+        for (uint32_t transition_index = 0; transition_index < transition_count; transition_index++) {
+            long long utc_seconds = time_size == 8 ? read_tzif_int64(transition_times + size_t(transition_index) * 8) :
+                                                     read_tzif_int32(transition_times + size_t(transition_index) * 4);
+            uint32_t current_type = transition_types[transition_index];
+            if (current_type >= type_count || current_type >= 256) {
+                return false;
+            }
+            if (utc_seconds >= first_utc_seconds && utc_seconds <= last_utc_seconds) {
+                const unsigned char* before_pointer = local_time_types + previous_type * 6;
+                const unsigned char* after_pointer = local_time_types + current_type * 6;
+                append_time_zone_transition(zone_transitions, utc_seconds, read_tzif_int32(before_pointer), before_pointer[4] != 0,
+                                            type_abbreviations[previous_type], read_tzif_int32(after_pointer),
+                                            after_pointer[4] != 0, type_abbreviations[current_type]);
+            }
+            previous_type = current_type;
+            last_transition_seconds = utc_seconds;
+        }
+        
+        // The footer rule extends the table past its final explicit transition
+        if (time_size == 8 && footer_pointer < data_end && *footer_pointer == '\n') {
+            const unsigned char* footer_end = static_cast<const unsigned char*>(
+                memchr(footer_pointer + 1, '\n', size_t(data_end - footer_pointer - 1)));
+            posix_zone_footer zone_footer;
+            if (footer_end != NULL && footer_end - footer_pointer - 1 < 64) {
+                string footer_text(reinterpret_cast<const char*>(footer_pointer + 1), reinterpret_cast<const char*>(footer_end));
+                if (parse_posix_zone_footer(footer_text.c_str(), zone_footer) && zone_footer.daylight_rules_present) {
+                    int first_rule_year = 0;
+                    int last_rule_year = 0;
+                    int day_value = 0;
+                    int month_value = 0;
+                    convert_serial_day_to_calendar_date(int(UNIX_EPOCH_SERIAL_DAY + first_utc_seconds / 86400) - 1,
+                                                        day_value, month_value, first_rule_year);
+                    convert_serial_day_to_calendar_date(int(UNIX_EPOCH_SERIAL_DAY + last_utc_seconds / 86400) + 1,
+                                                        day_value, month_value, last_rule_year);
+                    for (int rule_year = max(first_rule_year, 1); rule_year <= min(last_rule_year, 9999); rule_year++) {
+                        // Daylight starts at a standard-time instant and ends at a daylight-time instant
+                        long long start_seconds = (long long)(calculate_posix_rule_serial_day(zone_footer.daylight_start_rule,
+                                                                                               rule_year) - UNIX_EPOCH_SERIAL_DAY) * 86400 +
+                                                  zone_footer.daylight_start_rule.local_time_seconds - zone_footer.standard_offset_seconds;
+                        long long end_seconds = (long long)(calculate_posix_rule_serial_day(zone_footer.daylight_end_rule,
+                                                                                             rule_year) - UNIX_EPOCH_SERIAL_DAY) * 86400 +
+                                                zone_footer.daylight_end_rule.local_time_seconds - zone_footer.daylight_offset_seconds;
+                        if (start_seconds > last_transition_seconds && start_seconds >= first_utc_seconds &&
+                            start_seconds <= last_utc_seconds) {
+                            append_time_zone_transition(zone_transitions, start_seconds, zone_footer.standard_offset_seconds, false,
+                                                        zone_footer.standard_abbreviation, zone_footer.daylight_offset_seconds,
+                                                        true, zone_footer.daylight_abbreviation);
+                        }
+                        if (end_seconds > last_transition_seconds && end_seconds >= first_utc_seconds &&
+                            end_seconds <= last_utc_seconds) {
+                            append_time_zone_transition(zone_transitions, end_seconds, zone_footer.daylight_offset_seconds, true,
+                                                        zone_footer.daylight_abbreviation, zone_footer.standard_offset_seconds,
+                                                        false, zone_footer.standard_abbreviation);
+                        }
+                    }
+                }
+            }
+        }
+        break;
+    }
+    
+    // Explicit and rule-generated entries can meet at the boundary year
+    sort(zone_transitions.begin(), zone_transitions.end(), [](const time_zone_transition& left_transition,
+                                                              const time_zone_transition& right_transition) {
+        return left_transition.utc_seconds < right_transition.utc_seconds;
+    });
+    zone_transitions.erase(unique(zone_transitions.begin(), zone_transitions.end(),
+                                  [](const time_zone_transition& left_transition, const time_zone_transition& right_transition) {
+                                      return left_transition.utc_seconds == right_transition.utc_seconds;
+                                  }), zone_transitions.end());
+    return true;
+}
+
+// Function formats a UTC offset in seconds as +hh:mm
+string format_utc_offset_text(int offset_seconds) {
+    char offset_text[16];
+    int absolute_seconds = abs(offset_seconds);
+    snprintf(offset_text, sizeof(offset_text), "%c%02d:%02d", offset_seconds < 0 ? '-' : '+', absolute_seconds / 3600,
+             absolute_seconds / 60 % 60);
+    return offset_text;
+}
+
+// Function names the kind of change a transition makes
+const char* describe_time_zone_transition(const time_zone_transition& zone_transition) {
+    if (zone_transition.daylight_before != zone_transition.daylight_after) {
+        return zone_transition.daylight_after ? "dst-start" : "dst-end";
+    }
+    return "offset-change";
+}
+
+bool load_canonical_zone_names(const string& zoneinfo_directory, unordered_set<string>& canonical_names) {
+    // tzdata.zi names every zone on a "Z" line; links ("L" lines) are the backward-compatibility names
+    string table_line;
+    ifstream compiled_stream((zoneinfo_directory + "/tzdata.zi").c_str());
+    while (getline(compiled_stream, table_line)) {
+        if (table_line.compare(0, 2, "Z ") == 0) {
+            canonical_names.insert(table_line.substr(2, table_line.find(' ', 2) - 2));
+        }
+    }
+    
+    // The zone tables list one zone per line in the third tab-separated column
+    static const char* const zone_table_names[] = {"zone1970.tab", "zone.tab"};
+    for (size_t table_index = 0; table_index < 2 && canonical_names.empty(); table_index++) {
+        ifstream table_stream((zoneinfo_directory + "/" + zone_table_names[table_index]).c_str());
+        while (getline(table_stream, table_line)) {
+            if (table_line.empty() || table_line[0] == '#') {
+                continue;
+            }
+            size_t first_tab = table_line.find('\t');
+            size_t second_tab = first_tab == string::npos ? string::npos : table_line.find('\t', first_tab + 1);
+            if (second_tab != string::npos) {
+                size_t name_end = table_line.find_first_of("\t\r", second_tab + 1);
+                canonical_names.insert(table_line.substr(second_tab + 1, name_end == string::npos ? string::npos :
+                                                                                                   name_end - second_tab - 1));
+            }
+        }
+    }
+    return !canonical_names.empty();
+}
+
+int rank_time_zone_name(const string& zone_name, const unordered_set<string>& canonical_names) {
+    if (canonical_names.count(zone_name) != 0) {
+        return 0;
+    }
+    return zone_name.find('/') != string::npos ? 1 : 2; // Area/City links such as Asia/Calcutta before GB or Zulu
+}
+
+int execute_daylight_transition_report(int argument_count, char* argument_values[], const string& year_range_text) {
+    string zoneinfo_directory = find_command_line_option_value(argument_count, argument_values, "--zoneinfo", "/usr/share/zoneinfo");
+    string json_output_path = find_command_line_option_value(argument_count, argument_values, "--dst-json", "");
+    string zone_prefix = find_command_line_option_value(argument_count, argument_values, "--dst-zone", "");
+    int thread_count = find_command_line_integer_option(argument_count, argument_values, "--threads", 0);
+    int first_year = 0;
+    int last_year = 0;
+    int parsed_field_count = sscanf(year_range_text.c_str(), "%d-%d", &first_year, &last_year);
+    if (parsed_field_count == 1) {
+        last_year = first_year;
+    }
+    if (parsed_field_count < 1 || first_year < 2 || last_year > 9998 || first_year > last_year) {
+        cout << "ERROR: --dst-report expects <year> or <first-last> within 2-9998" << endl;
+        return 1;
+    }
+    
+    vector<string> zone_names;
+    if (!list_zoneinfo_files(zoneinfo_directory, "", zone_names)) {
+        cout << "ERROR: Unable to read zone directory: " << zoneinfo_directory << endl;
+        return 1;
+    }
+    sort(zone_names.begin(), zone_names.end());
+    zone_names.erase(remove_if(zone_names.begin(), zone_names.end(), [&zone_prefix](const string& zone_name) {
+        return zone_name.compare(0, zone_prefix.size(), zone_prefix) != 0;
+    }), zone_names.end());
+    
+    // A day of margin on each side covers local dates that fall in the range but not in UTC
+    long long first_utc_seconds = (long long)(calculate_serial_day_number(1, 1, first_year) - 1 - UNIX_EPOCH_SERIAL_DAY) * 86400;
+    long long last_utc_seconds = (long long)(calculate_serial_day_number(31, 12, last_year) + 2 - UNIX_EPOCH_SERIAL_DAY) * 86400;
+    
+    // Workers map and parse zones claimed through a shared counter
+    vector<time_zone_transition_report> zone_reports(zone_names.size());
+    vector<uint8_t> zone_parsed(zone_names.size(), 0); // One byte per zone; vector<bool> packs bits workers would share
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    atomic<size_t> next_zone_index(0);
+    atomic<unsigned long long> mapped_byte_count(0);
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            for (size_t zone_index = next_zone_index++; zone_index < zone_names.size(); zone_index = next_zone_index++) {
+                mapped_file_region mapped_zone;
+                if (!map_file_read_only(zoneinfo_directory + "/" + zone_names[zone_index], mapped_zone)) {
+                    continue;
+                }
+                time_zone_transition_report& zone_report = zone_reports[zone_index];
+                zone_report.zone_name = zone_names[zone_index];
+                zone_report.content_hash = fold_fnv1a_hash(0xCBF29CE484222325ULL, mapped_zone.mapped_data, mapped_zone.mapped_size);
+                zone_parsed[zone_index] = parse_tzif_transitions(mapped_zone.mapped_data, mapped_zone.mapped_size,
+                                                                 first_utc_seconds, last_utc_seconds, zone_report.transitions) ? 1 : 0;
+                mapped_byte_count += mapped_zone.mapped_size;
+                unmap_file_region(mapped_zone);
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+    double parse_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    
+    // Linked or copied zone files are reported once under the best-ranked name, with the rest as aliases;
+    // without the zone tables the ranking falls back to the shape of the names
+    unordered_set<string> canonical_zone_names;
+    load_canonical_zone_names(zoneinfo_directory, canonical_zone_names);
+    vector<time_zone_transition_report> unique_reports;
+    unordered_map<uint64_t, size_t> report_by_content;
+    size_t parsed_zone_count = 0;
+    for (size_t zone_index = 0; zone_index < zone_reports.size(); zone_index++) {
+        if (!zone_parsed[zone_index]) {
+            continue;
+        }
+        parsed_zone_count++;
+        unordered_map<uint64_t, size_t>::iterator report_position = report_by_content.find(zone_reports[zone_index].content_hash);
+        if (report_position != report_by_content.end()) {
+            time_zone_transition_report& unique_report = unique_reports[report_position->second];
+            if (rank_time_zone_name(zone_reports[zone_index].zone_name, canonical_zone_names) <
+                rank_time_zone_name(unique_report.zone_name, canonical_zone_names)) {
+                unique_report.alias_names.push_back(unique_report.zone_name);
+                unique_report.zone_name = zone_reports[zone_index].zone_name;
+            } else {
+                unique_report.alias_names.push_back(zone_reports[zone_index].zone_name);
+            }
+            continue;
+        }
+        report_by_content[zone_reports[zone_index].content_hash] = unique_reports.size();
+        unique_reports.push_back(zone_reports[zone_index]);
+    }
+    
+    // Headings can change while folding, so groups and their aliases are put back in name order
+    for (size_t report_index = 0; report_index < unique_reports.size(); report_index++) {
+        sort(unique_reports[report_index].alias_names.begin(), unique_reports[report_index].alias_names.end());
+    }
+    sort(unique_reports.begin(), unique_reports.end(), [](const time_zone_transition_report& left_report,
+                                                          const time_zone_transition_report& right_report) {
+        return left_report.zone_name < right_report.zone_name;
+    });
+    
+    // Keep transitions whose local date before the change falls inside the year range
+    size_t reported_transition_count = 0;
+    size_t zones_with_transitions = 0;
+    for (size_t report_index = 0; report_index < unique_reports.size(); report_index++) {
+        vector<time_zone_transition>& zone_transitions = unique_reports[report_index].transitions;
+        zone_transitions.erase(remove_if(zone_transitions.begin(), zone_transitions.end(),
+                                         [first_year, last_year](const time_zone_transition& zone_transition) {
+            int day_value = 0;
+            int month_value = 0;
+            int year_value = 0;
+            long long local_seconds = zone_transition.utc_seconds + zone_transition.offset_before_seconds;
+            convert_serial_day_to_calendar_date(int(UNIX_EPOCH_SERIAL_DAY + (local_seconds - (local_seconds % 86400 + 86400) % 86400) / 86400),
+                                                day_value, month_value, year_value);
+            return year_value < first_year || year_value > last_year;
+        }), zone_transitions.end());
+        reported_transition_count += zone_transitions.size();
+        zones_with_transitions += zone_transitions.empty() ? 0 : 1;
+    }
+    
+    // Text report: one block per zone, transitions in time order
+    string report_text;
+    string json_text = "{\n  \"first_year\": " + to_string(first_year) + ",\n  \"last_year\": " + to_string(last_year) +
+                       ",\n  \"zones\": [";
+    bool first_json_zone = true;
+    for (size_t report_index = 0; report_index < unique_reports.size(); report_index++) {
+        const time_zone_transition_report& zone_report = unique_reports[report_index];
+        if (zone_report.transitions.empty()) {
+            continue;
+        }
+        report_text += zone_report.zone_name;
+        if (!zone_report.alias_names.empty()) {
+            report_text += " (also";
+            for (size_t alias_index = 0; alias_index < zone_report.alias_names.size(); alias_index++) {
+                report_text += " " + zone_report.alias_names[alias_index];
+            }
+            report_text += ")";
+        }
+        report_text += "\n";
+        json_text += string(first_json_zone ? "" : ",") + "\n    {\"zone\": \"" + zone_report.zone_name + "\", \"aliases\": [";
+        first_json_zone = false;
+        for (size_t alias_index = 0; alias_index < zone_report.alias_names.size(); alias_index++) {
+            json_text += string(alias_index > 0 ? ", " : "") + "\"" + zone_report.alias_names[alias_index] + "\"";
+        }
+        json_text += "], \"transitions\": [";
+        for (size_t transition_index = 0; transition_index < zone_report.transitions.size(); transition_index++) {
+            const time_zone_transition& zone_transition = zone_report.transitions[transition_index];
+            long long utc_minute = (long long)UNIX_EPOCH_SERIAL_DAY * 1440 + zone_transition.utc_seconds / 60;
+            string local_before_text = format_serial_minute_text(utc_minute + zone_transition.offset_before_seconds / 60);
+            string local_after_text = format_serial_minute_text(utc_minute + zone_transition.offset_after_seconds / 60);
+            string utc_text = format_serial_minute_text(utc_minute);
+            char line_text[200];
+            snprintf(line_text, sizeof(line_text), "  %s -> %s  %-6s %s -> %-6s %s  %s\n", local_before_text.c_str(),
+                     local_after_text.substr(11, 5).c_str(), zone_transition.abbreviation_before,
+                     format_utc_offset_text(zone_transition.offset_before_seconds).c_str(), zone_transition.abbreviation_after,
+                     format_utc_offset_text(zone_transition.offset_after_seconds).c_str(),
+                     describe_time_zone_transition(zone_transition));
+            report_text += line_text;
+            snprintf(line_text, sizeof(line_text),
+                     "%s\n      {\"utc\": \"%sT%s:00Z\", \"local_date\": \"%s\", \"weekday\": \"%s\", \"local_time_before\": \"%s\", "
+                     "\"local_time_after\": \"%s\", ", transition_index > 0 ? "," : "", utc_text.substr(0, 10).c_str(),
+                     utc_text.substr(11, 5).c_str(), local_before_text.substr(0, 10).c_str(),
+                     local_before_text.substr(18, 3).c_str(), local_before_text.substr(11, 5).c_str(),
+                     local_after_text.substr(11, 5).c_str());
+            json_text += line_text;
+            snprintf(line_text, sizeof(line_text),
+                     "\"offset_before\": %d, \"offset_after\": %d, \"abbreviation_before\": \"%s\", "
+                     "\"abbreviation_after\": \"%s\", \"kind\": \"%s\"}", zone_transition.offset_before_seconds,
+                     zone_transition.offset_after_seconds, zone_transition.abbreviation_before,
+                     zone_transition.abbreviation_after, describe_time_zone_transition(zone_transition));
+            json_text += line_text;
+        }
+        json_text += "\n    ]}";
+    }
+    json_text += "\n  ]\n}\n";
+    
+    cout << "DAYLIGHT SAVING TRANSITIONS " << first_year << "-" << last_year << " (" << zoneinfo_directory << ")" << endl;
+    cout << string(60, '-') << endl;
+    cout << report_text;
+    cout << string(60, '-') << endl;
+    cout << "Zone Files: " << parsed_zone_count << " parsed (" << mapped_byte_count.load() << " bytes mapped), "
+         << unique_reports.size() << " distinct" << endl;
+    cout << "Transitions: " << reported_transition_count << " in " << zones_with_transitions << " zones" << endl;
+    cout << "Parse Time: " << fixed << setprecision(3) << parse_seconds * 1000.0 << " ms (" << thread_count << " threads)" << endl;
+    if (!json_output_path.empty()) {
+        if (!write_file_atomically(json_output_path, json_text)) {
+            cout << "ERROR: Unable to write " << json_output_path << endl;
+            return 1;
+        }
+        cout << "JSON Report: " << json_output_path << endl;
+    }
+    return 0;
+}
+
+/*
+================================================================================
+TIMELINE RENDERER FUNCTIONS
+================================================================================
+*/
+
+// Bucket names indexed by timeline_level_kind
+const char* const timeline_level_names[TIMELINE_LEVEL_COUNT] = {"day", "week", "month", "quarter", "year"};
+
+// Function returns the number of the bucket containing a serial day, counting from 0001-01-01
+int calculate_timeline_bucket_number(int level_kind, int serial_day) {
+    if (level_kind == TIMELINE_LEVEL_DAY) {
+        return serial_day;
+    }
+    if (level_kind == TIMELINE_LEVEL_WEEK) {
+        return (serial_day - 1) / 7; // Serial day 1 is a Monday, so weeks start on Monday as in ISO 8601
+    }
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    return level_kind == TIMELINE_LEVEL_MONTH ? (year_value - 1) * 12 + month_value - 1 :
+           level_kind == TIMELINE_LEVEL_QUARTER ? (year_value - 1) * 4 + (month_value - 1) / 3 : year_value - 1;
+}
+
+// Function returns the first serial day of a numbered bucket
+int calculate_timeline_bucket_start(int level_kind, int bucket_number) {
+    if (level_kind == TIMELINE_LEVEL_DAY) {
+        return bucket_number;
+    }
+    if (level_kind == TIMELINE_LEVEL_WEEK) {
+        return bucket_number * 7 + 1;
+    }
+    int month_number = level_kind == TIMELINE_LEVEL_MONTH ? bucket_number :
+                       level_kind == TIMELINE_LEVEL_QUARTER ? bucket_number * 3 : bucket_number * 12;
+    return calculate_serial_day_number(1, month_number % 12 + 1, month_number / 12 + 1);
+}
+
+// Function formats a serial day as YYYY-MM-DD
+string format_timeline_day_text(int serial_day) {
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    char day_text[16];
+    snprintf(day_text, sizeof(day_text), "%04d-%02d-%02d", year_value, month_value, day_value);
+    return day_text;
+}
+
+// Function builds an iterative maximum tree: leaves at tree_values[value_count + index], parents below them
+void build_timeline_maximum_tree(const int* values, size_t value_count, int* tree_values) {
+    copy(values, values + value_count, tree_values + value_count);
+    for (size_t node_index = value_count - 1; node_index >= 1 && node_index < value_count; node_index--) {
+        tree_values[node_index] = max(tree_values[2 * node_index], tree_values[2 * node_index + 1]);
+    }
+}
+
+// Function returns the maximum value over [first_index, end_index), or INT_MIN for an empty range
+int query_timeline_maximum_tree(const int* tree_values, size_t value_count, size_t first_index, size_t end_index) {
+    int maximum_value = INT_MIN;
+    for (first_index += value_count, end_index += value_count; first_index < end_index; first_index >>= 1, end_index >>= 1) {
+        if (first_index & 1) {
+            maximum_value = max(maximum_value, tree_values[first_index++]);
+        }
+        if (end_index & 1) {
+            maximum_value = max(maximum_value, tree_values[--end_index]);
+        }
+    }
+    return maximum_value;
+}
+
+// Function returns the last index before end_index whose value reaches minimum_value, or value_count if none does
+size_t find_previous_timeline_reaching_index(const int* tree_values, size_t value_count, size_t end_index, int minimum_value) {
+    if (query_timeline_maximum_tree(tree_values, value_count, 0, end_index) < minimum_value) {
+        return value_count;
+    }
+    // The range [low_index, end_index) always reaches the value and [high_index, end_index) never does
+    size_t low_index = 0;
+    size_t high_index = end_index;
+    while (high_index - low_index > 1) {
+        size_t middle_index = low_index + (high_index - low_index) / 2;
+        if (query_timeline_maximum_tree(tree_values, value_count, middle_index, end_index) >= minimum_value) {
+            low_index = middle_index;
+        } else {
+            high_index = middle_index;
+        }
+    }
+    return low_index;
+}
+
+// Function folds one lane's activity steps and start days into the non-empty buckets of a level.
+// Only buckets holding a step or a start need aggregates of their own; the buckets between two such
+// buckets share one active count and are stored as a single run
+void append_timeline_lane_runs(int level_kind, const vector<pair<int, int32_t> >& activity_steps,
+                               const int* first_serial_days, size_t task_count, vector<timeline_bucket_run>& lane_runs) {
+    size_t step_index = 0;
+    size_t start_index = 0;
+    int32_t active_tasks = 0;                // Tasks active from the last applied step onwards
+    int previous_bucket = INT_MIN;
+    while (step_index < activity_steps.size() || start_index < task_count) {
+        int next_day = min(step_index < activity_steps.size() ? activity_steps[step_index].first : INT_MAX,
+                           start_index < task_count ? first_serial_days[start_index] : INT_MAX);
+        int bucket_number = calculate_timeline_bucket_number(level_kind, next_day);
+        if (active_tasks > 0 && bucket_number > previous_bucket + 1) {
+            timeline_bucket_run uniform_run = {previous_bucket + 1, bucket_number, active_tasks, 0, 0};
+            lane_runs.push_back(uniform_run);
+        }
+
+        // Walk the bucket's days segment by segment between steps
+        int bucket_end_day = calculate_timeline_bucket_start(level_kind, bucket_number + 1);
+        int segment_first_day = calculate_timeline_bucket_start(level_kind, bucket_number);
+        timeline_bucket_run bucket_run = {bucket_number, bucket_number + 1, 0, 0, 0};
+        while (true) {
+            int segment_end_day = step_index < activity_steps.size() && activity_steps[step_index].first < bucket_end_day ?
+                                  activity_steps[step_index].first : bucket_end_day;
+            if (segment_end_day > segment_first_day) {
+                bucket_run.peak_active_tasks = max(bucket_run.peak_active_tasks, active_tasks);
+                bucket_run.task_day_total += int64_t(active_tasks) * (segment_end_day - segment_first_day);
+            }
+            if (segment_end_day == bucket_end_day) {
+                break;
+            }
+            active_tasks = activity_steps[step_index++].second;
+            segment_first_day = segment_end_day;
+        }
+        while (start_index < task_count && first_serial_days[start_index] < bucket_end_day) {
+            bucket_run.started_task_count++;
+            start_index++;
+        }
+        if (bucket_run.peak_active_tasks > 0) {
+            lane_runs.push_back(bucket_run);
+        }
+        previous_bucket = bucket_number;
+    }
+}
+
+void build_timeline_lod_index(const vector<timeline_task>& timeline_tasks, const vector<string>& task_titles,
+                              const vector<string>& lane_names, timeline_lod_index& lod_index, int thread_count) {
+    lod_index.lane_names = lane_names;
+    lod_index.task_count = timeline_tasks.size();
+    lod_index.span_first_serial_day = INT_MAX;
+    lod_index.span_last_serial_day = INT_MIN;
+    for (size_t task_index = 0; task_index < timeline_tasks.size(); task_index++) {
+        lod_index.span_first_serial_day = min(lod_index.span_first_serial_day, timeline_tasks[task_index].first_serial_day);
+        lod_index.span_last_serial_day = max(lod_index.span_last_serial_day, timeline_tasks[task_index].last_serial_day);
+    }
+    if (timeline_tasks.empty()) {
+        lod_index.span_first_serial_day = calculate_serial_day_number(1, 1, 2000);
+        lod_index.span_last_serial_day = lod_index.span_first_serial_day - 1;
+    }
+    size_t lane_count = lane_names.size();
+    size_t task_count = timeline_tasks.size();
+
+    // Group tasks by lane with a counting sort; workers then order each lane's slice by first day
+    vector<size_t>& lane_task_offsets = lod_index.lane_task_offsets;
+    lane_task_offsets.assign(lane_count + 1, 0);
+    for (size_t task_index = 0; task_index < task_count; task_index++) {
+        lane_task_offsets[size_t(timeline_tasks[task_index].lane_index) + 1]++;
+    }
+    for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+        lane_task_offsets[lane_index + 1] += lane_task_offsets[lane_index];
+    }
+    vector<size_t> lane_fill_positions(lane_task_offsets.begin(), lane_task_offsets.end() - 1);
+    vector<uint32_t> lane_task_order(task_count);
+    for (size_t task_index = 0; task_index < task_count; task_index++) {
+        lane_task_order[lane_fill_positions[size_t(timeline_tasks[task_index].lane_index)]++] = uint32_t(task_index);
+    }
+    lod_index.task_first_serial_days.resize(task_count);
+    lod_index.task_last_serial_days.resize(task_count);
+    lod_index.sorted_last_serial_days.resize(task_count);
+    lod_index.task_last_day_trees.resize(2 * task_count);
+    vector<vector<timeline_bucket_run> > lane_runs[TIMELINE_LEVEL_COUNT];
+    for (int level_kind = 0; level_kind < TIMELINE_LEVEL_COUNT; level_kind++) {
+        lane_runs[level_kind].resize(lane_count);
+    }
+
+    // Lanes are independent: merging a lane's sorted first and last days gives the steps of its active
+    // task count, which every level folds into sparse bucket runs
+    if (thread_count <= 0) {
+        thread_count = max(1, int(thread::hardware_concurrency()));
+    }
+    thread_count = int(min(size_t(thread_count), max(size_t(1), lane_count)));
+    atomic<size_t> next_lane_index(0);
+    vector<thread> worker_threads;
+    for (int worker_index = 0; worker_index < thread_count; worker_index++) {
+        worker_threads.push_back(thread([&]() {
+            vector<pair<int, int32_t> > activity_steps;
+            for (size_t lane_index = next_lane_index++; lane_index < lane_count; lane_index = next_lane_index++) {
+                size_t lane_first = lane_task_offsets[lane_index];
+                size_t lane_task_count = lane_task_offsets[lane_index + 1] - lane_first;
+                sort(lane_task_order.begin() + long(lane_first), lane_task_order.begin() + long(lane_first + lane_task_count),
+                     [&](uint32_t left_index, uint32_t right_index) {
+                    const timeline_task& left_task = timeline_tasks[left_index];
+                    const timeline_task& right_task = timeline_tasks[right_index];
+                    if (left_task.first_serial_day != right_task.first_serial_day) {
+                        return left_task.first_serial_day < right_task.first_serial_day;
+                    }
+                    if (left_task.last_serial_day != right_task.last_serial_day) {
+                        return left_task.last_serial_day < right_task.last_serial_day;
+                    }
+                    return left_index < right_index;
+                });
+                int* first_days = lod_index.task_first_serial_days.data() + lane_first;
+                int* last_days = lod_index.task_last_serial_days.data() + lane_first;
+                int* sorted_last_days = lod_index.sorted_last_serial_days.data() + lane_first;
+                for (size_t task_offset = 0; task_offset < lane_task_count; task_offset++) {
+                    const timeline_task& current_task = timeline_tasks[lane_task_order[lane_first + task_offset]];
+                    first_days[task_offset] = current_task.first_serial_day;
+                    last_days[task_offset] = current_task.last_serial_day;
+                    sorted_last_days[task_offset] = current_task.last_serial_day;
+                }
+                sort(sorted_last_days, sorted_last_days + lane_task_count);
+                build_timeline_maximum_tree(last_days, lane_task_count, lod_index.task_last_day_trees.data() + 2 * lane_first);
+
+                // A task is active from its first day through its last, so the count changes at first
+                // days and on the day after last days; equal consecutive counts share one step
+                activity_steps.clear();
+                size_t first_index = 0;
+                size_t last_index = 0;
+                int32_t active_tasks = 0;
+                while (last_index < lane_task_count) {
+                    int step_day = min(first_index < lane_task_count ? first_days[first_index] : INT_MAX,
+                                       sorted_last_days[last_index] + 1);
+                    for (; first_index < lane_task_count && first_days[first_index] == step_day; first_index++) {
+                        active_tasks++;
+                    }
+                    for (; last_index < lane_task_count && sorted_last_days[last_index] + 1 == step_day; last_index++) {
+                        active_tasks--;
+                    }
+                    if (activity_steps.empty() || activity_steps.back().second != active_tasks) {
+                        activity_steps.push_back(make_pair(step_day, active_tasks));
+                    }
+                }
+                for (int level_kind = 0; level_kind < TIMELINE_LEVEL_COUNT; level_kind++) {
+                    append_timeline_lane_runs(level_kind, activity_steps, first_days, lane_task_count,
+                                              lane_runs[level_kind][lane_index]);
+                }
+            }
+        }));
+    }
+    for (size_t worker_index = 0; worker_index < worker_threads.size(); worker_index++) {
+        worker_threads[worker_index].join();
+    }
+
+    // Flatten each level's lane runs, then lay out titles in the lanes' task order
+    for (int level_kind = 0; level_kind < TIMELINE_LEVEL_COUNT; level_kind++) {
+        lod_index.lane_run_offsets[level_kind].assign(lane_count + 1, 0);
+        lod_index.bucket_runs[level_kind].clear();
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            lod_index.lane_run_offsets[level_kind][lane_index + 1] = lod_index.lane_run_offsets[level_kind][lane_index] +
+                                                                     lane_runs[level_kind][lane_index].size();
+        }
+        lod_index.bucket_runs[level_kind].reserve(lod_index.lane_run_offsets[level_kind][lane_count]);
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            lod_index.bucket_runs[level_kind].insert(lod_index.bucket_runs[level_kind].end(),
+                                                     lane_runs[level_kind][lane_index].begin(),
+                                                     lane_runs[level_kind][lane_index].end());
+            vector<timeline_bucket_run>().swap(lane_runs[level_kind][lane_index]);
+        }
+    }
+    lod_index.task_title_offsets.assign(task_count + 1, 0);
+    lod_index.task_title_text.clear();
+    for (size_t task_position = 0; task_position < task_count && !task_titles.empty(); task_position++) {
+        lod_index.task_title_text += task_titles[lane_task_order[task_position]];
+        lod_index.task_title_offsets[task_position + 1] = lod_index.task_title_text.size();
+    }
+}
+
+int select_timeline_level(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                          int column_count, int& first_bucket, int& bucket_count, int& buckets_per_column) {
+    // The finest level whose visible buckets fit the width; at the year level each column takes as many
+    // years as needed for the whole view to fit
+    view_first_serial_day = max(view_first_serial_day, lod_index.span_first_serial_day);
+    view_last_serial_day = min(view_last_serial_day, lod_index.span_last_serial_day);
+    first_bucket = 0;
+    bucket_count = 0;
+    buckets_per_column = 1;
+    if (view_last_serial_day < view_first_serial_day || column_count <= 0) {
+        return TIMELINE_LEVEL_DAY;
+    }
+    for (int level_kind = 0; level_kind < TIMELINE_LEVEL_COUNT; level_kind++) {
+        first_bucket = calculate_timeline_bucket_number(level_kind, view_first_serial_day);
+        bucket_count = calculate_timeline_bucket_number(level_kind, view_last_serial_day) - first_bucket + 1;
+        if (bucket_count <= column_count || level_kind == TIMELINE_LEVEL_YEAR) {
+            buckets_per_column = (bucket_count + column_count - 1) / column_count;
+            bucket_count = (bucket_count + buckets_per_column - 1) / buckets_per_column;
+            return level_kind;
+        }
+    }
+    return TIMELINE_LEVEL_YEAR;
+}
+
+// Function starts a view layout at the selected level with the visible bucket boundaries clipped to the task
+// span and zeroed aggregates; returns the visible bucket count
+int prepare_timeline_view_layout(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                                 int column_count, timeline_view_layout& view_layout) {
+    int bucket_count = 0;
+    view_layout.level_kind = select_timeline_level(lod_index, view_first_serial_day, view_last_serial_day, column_count,
+                                                   view_layout.first_bucket, bucket_count, view_layout.buckets_per_column);
+    size_t lane_count = lod_index.lane_names.size();
+    timeline_level_aggregates& visible_buckets = view_layout.visible_buckets;
+    visible_buckets.bucket_first_serial_days.clear();
+    for (int column_index = 0; bucket_count > 0 && column_index <= bucket_count; column_index++) {
+        int bucket_start = calculate_timeline_bucket_start(view_layout.level_kind,
+                                                           view_layout.first_bucket + column_index * view_layout.buckets_per_column);
+        visible_buckets.bucket_first_serial_days.push_back(min(max(bucket_start, lod_index.span_first_serial_day),
+                                                               lod_index.span_last_serial_day + 1));
+    }
+    size_t cell_count = lane_count * size_t(bucket_count);
+    visible_buckets.peak_active_tasks.assign(cell_count, 0);
+    visible_buckets.task_day_totals.assign(cell_count, 0);
+    visible_buckets.started_task_counts.assign(cell_count, 0);
+    view_layout.lane_shows_bars.assign(lane_count, 0);
+    view_layout.lane_bar_offsets.assign(lane_count + 1, 0);
+    view_layout.bar_task_positions.clear();
+    return bucket_count;
+}
+
+void build_timeline_view_layout(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                                int column_count, timeline_view_layout& view_layout) {
+    int bucket_count = prepare_timeline_view_layout(lod_index, view_first_serial_day, view_last_serial_day, column_count,
+                                                    view_layout);
+    if (bucket_count == 0) {
+        return;
+    }
+    int level_kind = view_layout.level_kind;
+    int first_bucket = view_layout.first_bucket;
+    int buckets_per_column = view_layout.buckets_per_column;
+    int end_bucket = first_bucket + bucket_count * buckets_per_column;
+    size_t lane_count = lod_index.lane_names.size();
+    timeline_level_aggregates& visible_buckets = view_layout.visible_buckets;
+    const vector<int>& bucket_starts = visible_buckets.bucket_first_serial_days;
+
+    // Each lane's runs are located by binary search; at most one run per visible bucket is read, and
+    // merged columns take the highest peak and the sums of their buckets
+    const vector<timeline_bucket_run>& bucket_runs = lod_index.bucket_runs[level_kind];
+    for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+        const timeline_bucket_run* run_end = bucket_runs.data() + lod_index.lane_run_offsets[level_kind][lane_index + 1];
+        const timeline_bucket_run* run_position = partition_point(
+            bucket_runs.data() + lod_index.lane_run_offsets[level_kind][lane_index], run_end,
+            [&](const timeline_bucket_run& bucket_run) { return bucket_run.end_bucket <= first_bucket; });
+        for (; run_position != run_end && run_position->first_bucket < end_bucket; ++run_position) {
+            bool uniform_run = run_position->end_bucket - run_position->first_bucket > 1;
+            for (int bucket_number = max(run_position->first_bucket, first_bucket);
+                 bucket_number < min(run_position->end_bucket, end_bucket); bucket_number++) {
+                size_t column_index = size_t((bucket_number - first_bucket) / buckets_per_column);
+                size_t cell_index = lane_index * size_t(bucket_count) + column_index;
+                int bucket_day_count = buckets_per_column == 1 ? bucket_starts[column_index + 1] - bucket_starts[column_index] :
+                                       calculate_timeline_bucket_start(level_kind, bucket_number + 1) -
+                                       calculate_timeline_bucket_start(level_kind, bucket_number);
+                visible_buckets.peak_active_tasks[cell_index] = max(visible_buckets.peak_active_tasks[cell_index],
+                                                                    run_position->peak_active_tasks);
+                visible_buckets.started_task_counts[cell_index] += run_position->started_task_count;
+                visible_buckets.task_day_totals[cell_index] += uniform_run ?
+                    int64_t(run_position->peak_active_tasks) * bucket_day_count : run_position->task_day_total;
+            }
+        }
+    }
+
+    // At day and week zoom, lanes with few visible tasks list them for bars: tasks started by the window's
+    // end minus tasks finished before it opens gives the count without touching the tasks
+    if (level_kind > TIMELINE_LEVEL_WEEK) {
+        return;
+    }
+    int window_first_day = bucket_starts.front();
+    int window_last_day = bucket_starts.back() - 1;
+    for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+        size_t lane_first = lod_index.lane_task_offsets[lane_index];
+        size_t lane_task_count = lod_index.lane_task_offsets[lane_index + 1] - lane_first;
+        const int* first_days = lod_index.task_first_serial_days.data() + lane_first;
+        const int* sorted_last_days = lod_index.sorted_last_serial_days.data() + lane_first;
+        size_t started_end = size_t(upper_bound(first_days, first_days + lane_task_count, window_last_day) - first_days);
+        size_t window_start = size_t(lower_bound(first_days, first_days + lane_task_count, window_first_day) - first_days);
+        size_t finished_count = size_t(lower_bound(sorted_last_days, sorted_last_days + lane_task_count, window_first_day) -
+                                       sorted_last_days);
+        if (started_end - finished_count <= size_t(TIMELINE_BAR_TASK_LIMIT)) {
+            // Tasks begun before the window that are still running are found newest first through the tree
+            view_layout.lane_shows_bars[lane_index] = 1;
+            size_t lane_bar_begin = view_layout.bar_task_positions.size();
+            const int* last_day_tree = lod_index.task_last_day_trees.data() + 2 * lane_first;
+            for (size_t search_end = window_start; ; ) {
+                size_t reaching_index = find_previous_timeline_reaching_index(last_day_tree, lane_task_count, search_end,
+                                                                              window_first_day);
+                if (reaching_index == lane_task_count) {
+                    break;
+                }
+                view_layout.bar_task_positions.push_back(lane_first + reaching_index);
+                search_end = reaching_index;
+            }
+            reverse(view_layout.bar_task_positions.begin() + long(lane_bar_begin), view_layout.bar_task_positions.end());
+            for (size_t task_offset = window_start; task_offset < started_end; task_offset++) {
+                view_layout.bar_task_positions.push_back(lane_first + task_offset);
+            }
+        }
+        view_layout.lane_bar_offsets[lane_index + 1] = view_layout.bar_task_positions.size();
+    }
+}
+
+// Function builds the axis label text for the bucket starting on a serial day
+string format_timeline_bucket_label(int level_kind, int serial_day) {
+    static const char* const month_abbreviations[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                                      "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    int day_value = 0;
+    int month_value = 0;
+    int year_value = 0;
+    convert_serial_day_to_calendar_date(serial_day, day_value, month_value, year_value);
+    char label_text[24];
+    if (level_kind <= TIMELINE_LEVEL_WEEK) {
+        snprintf(label_text, sizeof(label_text), "%s %04d", month_abbreviations[month_value - 1], year_value);
+    } else {
+        snprintf(label_text, sizeof(label_text), "%04d", year_value);
+    }
+    return label_text;
+}
+
+// Function returns a task's title from the index
+string extract_timeline_task_title(const timeline_lod_index& lod_index, size_t task_position) {
+    if (lod_index.task_title_text.empty()) {
+        return string();
+    }
+    return lod_index.task_title_text.substr(lod_index.task_title_offsets[task_position],
+                                            lod_index.task_title_offsets[task_position + 1] -
+                                            lod_index.task_title_offsets[task_position]);
+}
+
+// Function places a lane's bars in rows, each on the first row where it clears the previous bar and its
+// trailing title by a blank column; returns the row count (at least one)
+int arrange_timeline_bar_rows(const timeline_lod_index& lod_index, const timeline_view_layout& view_layout,
+                              size_t lane_index, vector<timeline_bar_placement>& bar_placements) {
+    const vector<int>& bucket_starts = view_layout.visible_buckets.bucket_first_serial_days;
+    bar_placements.clear();
+    vector<int> row_free_columns;
+    for (size_t bar_index = view_layout.lane_bar_offsets[lane_index]; bar_index < view_layout.lane_bar_offsets[lane_index + 1];
+         bar_index++) {
+        timeline_bar_placement bar_placement;
+        bar_placement.task_position = view_layout.bar_task_positions[bar_index];
+        int first_day = max(lod_index.task_first_serial_days[bar_placement.task_position], bucket_starts.front());
+        int last_day = min(lod_index.task_last_serial_days[bar_placement.task_position], bucket_starts.back() - 1);
+        bar_placement.first_column = (calculate_timeline_bucket_number(view_layout.level_kind, first_day) - view_layout.first_bucket) /
+                                     view_layout.buckets_per_column;
+        bar_placement.last_column = (calculate_timeline_bucket_number(view_layout.level_kind, last_day) - view_layout.first_bucket) /
+                                    view_layout.buckets_per_column;
+        int title_length = int(extract_timeline_task_title(lod_index, bar_placement.task_position).size());
+        bar_placement.title_inside = title_length <= bar_placement.last_column - bar_placement.first_column - 1;
+        int end_column = bar_placement.last_column + 1 + (bar_placement.title_inside ? 0 : 1 + title_length);
+        bar_placement.row_index = 0;
+        while (size_t(bar_placement.row_index) < row_free_columns.size() &&
+               row_free_columns[size_t(bar_placement.row_index)] > bar_placement.first_column) {
+            bar_placement.row_index++;
+        }
+        if (size_t(bar_placement.row_index) == row_free_columns.size()) {
+            row_free_columns.push_back(0);
+        }
+        row_free_columns[size_t(bar_placement.row_index)] = end_column + 1;
+        bar_placements.push_back(bar_placement);
+    }
+    return max(1, int(row_free_columns.size()));
+}
+
+string format_timeline_view(const timeline_lod_index& lod_index, const timeline_view_layout& view_layout,
+                            int view_first_serial_day, int view_last_serial_day, int output_format) {
+    const timeline_level_aggregates& visible_buckets = view_layout.visible_buckets;
+    size_t bucket_count = visible_buckets.bucket_first_serial_days.empty() ? 0 : visible_buckets.bucket_first_serial_days.size() - 1;
+    size_t lane_count = lod_index.lane_names.size();
+    int level_kind = view_layout.level_kind;
+    string view_title;
+    if (bucket_count == 0) {
+        // A view holding no day of the task span is reported rather than drawn with an inverted range
+        view_title = lod_index.task_count == 0 ? string("TIMELINE: empty view, no tasks") :
+            "TIMELINE " + format_timeline_day_text(view_first_serial_day) + " to " +
+            format_timeline_day_text(view_last_serial_day) + ": empty view, tasks span " +
+            format_timeline_day_text(lod_index.span_first_serial_day) + " to " +
+            format_timeline_day_text(lod_index.span_last_serial_day) + " (" + to_string(lod_index.task_count) + " tasks)";
+        if (output_format == TIMELINE_FORMAT_TEXT) {
+            return view_title + "\n";
+        }
+        string svg_text = "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" + to_string(view_title.size() * 7 + 8) +
+                          "\" height=\"24\" font-family=\"Helvetica\" font-size=\"11\">\n<text x=\"4\" y=\"16\">" +
+                          escape_print_text(view_title, PRINT_FORMAT_SVG) + "</text>\n</svg>\n";
+        if (output_format == TIMELINE_FORMAT_SVG) {
+            return svg_text;
+        }
+        return "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>Timeline</title>\n</head>\n<body>\n<h1>" +
+               escape_print_text(view_title, PRINT_FORMAT_SVG) + "</h1>\n" + svg_text + "</body>\n</html>\n";
+    }
+
+    // Axis labels go where a bucket opens a new month (day and week levels) or year
+    vector<string> bucket_labels(bucket_count);
+    int previous_period = -1;
+    for (size_t column_index = 0; column_index < bucket_count; column_index++) {
+        int day_value = 0;
+        int month_value = 0;
+        int year_value = 0;
+        convert_serial_day_to_calendar_date(visible_buckets.bucket_first_serial_days[column_index], day_value, month_value,
+                                            year_value);
+        int current_period = level_kind <= TIMELINE_LEVEL_WEEK ? year_value * 12 + month_value : year_value;
+        if (current_period != previous_period) {
+            bucket_labels[column_index] = format_timeline_bucket_label(level_kind, visible_buckets.bucket_first_serial_days[column_index]);
+            previous_period = current_period;
+        }
+    }
+    int window_first_day = visible_buckets.bucket_first_serial_days.front();
+    int window_last_day = visible_buckets.bucket_first_serial_days.back() - 1;
+    view_title = "TIMELINE " + format_timeline_day_text(window_first_day) + " to " + format_timeline_day_text(window_last_day) +
+        " (" + (view_layout.buckets_per_column > 1 ? to_string(view_layout.buckets_per_column) + "-" : string()) +
+        timeline_level_names[level_kind] + " buckets, " + to_string(bucket_count) + " columns, " +
+        to_string(lod_index.task_count) + " tasks)";
+
+    // Heat strips shade each bucket relative to the lane's busiest visible bucket; bar lanes draw
+    // every visible task, clipped ends marked with < and >
+    static const char intensity_glyphs[] = " .:-=+*#%@";
+    vector<timeline_bar_placement> bar_placements;
+    string rendered_output;
+    if (output_format == TIMELINE_FORMAT_TEXT) {
+        size_t label_width = 4;
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            label_width = max(label_width, min(lod_index.lane_names[lane_index].size(), size_t(20)));
+        }
+        string axis_line(label_width + 1 + bucket_count, ' ');
+        axis_line[label_width] = '|';
+        size_t free_column = 0;
+        for (size_t column_index = 0; column_index < bucket_count; column_index++) {
+            if (!bucket_labels[column_index].empty() && column_index >= free_column) {
+                size_t copy_length = min(bucket_labels[column_index].size(), bucket_count - column_index);
+                axis_line.replace(label_width + 1 + column_index, copy_length, bucket_labels[column_index], 0, copy_length);
+                free_column = column_index + bucket_labels[column_index].size() + 1;
+            }
+        }
+        rendered_output += view_title + "\n" + axis_line + "\n";
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            string lane_label = lod_index.lane_names[lane_index].substr(0, label_width);
+            lane_label.append(label_width - lane_label.size(), ' ');
+            if (view_layout.lane_shows_bars[lane_index]) {
+                int row_count = arrange_timeline_bar_rows(lod_index, view_layout, lane_index, bar_placements);
+                vector<string> row_cells(size_t(row_count), string(bucket_count, ' '));
+                for (size_t bar_index = 0; bar_index < bar_placements.size(); bar_index++) {
+                    const timeline_bar_placement& bar_placement = bar_placements[bar_index];
+                    string& cells = row_cells[size_t(bar_placement.row_index)];
+                    char left_glyph = lod_index.task_first_serial_days[bar_placement.task_position] < window_first_day ? '<' : '[';
+                    char right_glyph = lod_index.task_last_serial_days[bar_placement.task_position] > window_last_day ? '>' : ']';
+                    if (bar_placement.first_column == bar_placement.last_column) {
+                        cells[size_t(bar_placement.first_column)] = left_glyph == '<' ? '<' : right_glyph == '>' ? '>' : '#';
+                    } else {
+                        cells[size_t(bar_placement.first_column)] = left_glyph;
+                        cells.replace(size_t(bar_placement.first_column) + 1,
+                                      size_t(bar_placement.last_column - bar_placement.first_column - 1),
+                                      size_t(bar_placement.last_column - bar_placement.first_column - 1), '=');
+                        cells[size_t(bar_placement.last_column)] = right_glyph;
+                    }
+                    string task_title = extract_timeline_task_title(lod_index, bar_placement.task_position);
+                    size_t title_column = size_t(bar_placement.title_inside ? bar_placement.first_column + 1 : bar_placement.last_column + 2);
+                    if (title_column < bucket_count) {
+                        size_t copy_length = min(task_title.size(), bucket_count - title_column);
+                        cells.replace(title_column, copy_length, task_title, 0, copy_length);
+                    }
+                }
+                for (size_t row_index = 0; row_index < row_cells.size(); row_index++) {
+                    rendered_output += (row_index == 0 ? lane_label : string(label_width, ' ')) + "|" + row_cells[row_index] + "\n";
+                }
+                continue;
+            }
+            const int32_t* lane_peaks = visible_buckets.peak_active_tasks.data() + lane_index * bucket_count;
+            int32_t lane_maximum = *max_element(lane_peaks, lane_peaks + bucket_count);
+            string lane_line = lane_label + "|";
+            for (size_t column_index = 0; column_index < bucket_count; column_index++) {
+                lane_line += lane_peaks[column_index] == 0 ? ' ' :
+                             intensity_glyphs[1 + (lane_peaks[column_index] * 8 + lane_maximum - 1) / lane_maximum];
+            }
+            rendered_output += lane_line + "\n";
+        }
+        return rendered_output;
+    }
+
+    // SVG (bare or inside an HTML page): bar lanes take one row per bar row, heat lanes one rectangle per
+    // busy bucket with opacity by relative load
+    const int cell_width = 8;
+    const int row_height = 16;
+    const int label_width = 160;
+    const int axis_height = 24;
+    vector<int> lane_row_counts(lane_count, 1);
+    size_t total_row_count = 0;
+    for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+        if (view_layout.lane_shows_bars[lane_index]) {
+            lane_row_counts[lane_index] = arrange_timeline_bar_rows(lod_index, view_layout, lane_index, bar_placements);
+        }
+        total_row_count += size_t(lane_row_counts[lane_index]);
+    }
+    size_t svg_width = size_t(label_width) + bucket_count * cell_width + 8;
+    size_t svg_height = size_t(axis_height) + total_row_count * row_height + 8;
+    char element_text[256];
+    snprintf(element_text, sizeof(element_text),
+             "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%lu\" height=\"%lu\" font-family=\"Helvetica\" font-size=\"11\">\n",
+             (unsigned long)svg_width, (unsigned long)svg_height);
+    string svg_text = element_text;
+    int free_x_position = 0;
+    for (size_t column_index = 0; column_index < bucket_count; column_index++) {
+        if (!bucket_labels[column_index].empty()) {
+            int x_position = label_width + int(column_index) * cell_width;
+            if (x_position < free_x_position) {
+                continue;
+            }
+            free_x_position = x_position + int(bucket_labels[column_index].size()) * 7 + 4; // Keep labels from overlapping
+            snprintf(element_text, sizeof(element_text),
+                     "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%lu\" stroke=\"#ccc\"/><text x=\"%d\" y=\"14\">%s</text>\n",
+                     x_position, axis_height - 4, x_position, (unsigned long)(svg_height - 8), x_position + 2,
+                     bucket_labels[column_index].c_str());
+            svg_text += element_text;
+        }
+    }
+    int y_position = axis_height;
+    for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+        svg_text += "<text x=\"4\" y=\"" + to_string(y_position + 12) + "\">" +
+                    escape_print_text(lod_index.lane_names[lane_index], PRINT_FORMAT_SVG) + "</text>\n";
+        if (view_layout.lane_shows_bars[lane_index]) {
+            arrange_timeline_bar_rows(lod_index, view_layout, lane_index, bar_placements);
+            for (size_t bar_index = 0; bar_index < bar_placements.size(); bar_index++) {
+                const timeline_bar_placement& bar_placement = bar_placements[bar_index];
+                string task_title = escape_print_text(extract_timeline_task_title(lod_index, bar_placement.task_position),
+                                                      PRINT_FORMAT_SVG);
+                int x_position = label_width + bar_placement.first_column * cell_width;
+                int bar_width = (bar_placement.last_column - bar_placement.first_column + 1) * cell_width;
+                int bar_y_position = y_position + bar_placement.row_index * row_height;
+                snprintf(element_text, sizeof(element_text),
+                         "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" rx=\"2\" fill=\"#2a6fb0\"><title>",
+                         x_position, bar_y_position + 2, bar_width, row_height - 4);
+                svg_text += element_text + task_title + (task_title.empty() ? "" : " ") +
+                            format_timeline_day_text(lod_index.task_first_serial_days[bar_placement.task_position]) + " to " +
+                            format_timeline_day_text(lod_index.task_last_serial_days[bar_placement.task_position]) +
+                            "</title></rect>\n";
+                if (!task_title.empty()) {
+                    snprintf(element_text, sizeof(element_text), "<text x=\"%d\" y=\"%d\" fill=\"%s\">",
+                             bar_placement.title_inside ? x_position + 3 : x_position + bar_width + 3, bar_y_position + 12,
+                             bar_placement.title_inside ? "#fff" : "#000");
+                    svg_text += element_text + task_title + "</text>\n";
+                }
+            }
+            y_position += lane_row_counts[lane_index] * row_height;
+            continue;
+        }
+        const int32_t* lane_peaks = visible_buckets.peak_active_tasks.data() + lane_index * bucket_count;
+        const int64_t* lane_task_days = visible_buckets.task_day_totals.data() + lane_index * bucket_count;
+        const int32_t* lane_started_tasks = visible_buckets.started_task_counts.data() + lane_index * bucket_count;
+        int32_t lane_maximum = *max_element(lane_peaks, lane_peaks + bucket_count);
+        for (size_t column_index = 0; column_index < bucket_count; column_index++) {
+            if (lane_peaks[column_index] == 0) {
+                continue;
+            }
+            snprintf(element_text, sizeof(element_text),
+                     "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"#2a6fb0\" fill-opacity=\"%.2f\">"
+                     "<title>peak %d, %lld task-days, %d started</title></rect>\n",
+                     label_width + int(column_index) * cell_width, y_position + 2, cell_width, row_height - 4,
+                     0.15 + 0.85 * double(lane_peaks[column_index]) / double(lane_maximum), lane_peaks[column_index],
+                     (long long)lane_task_days[column_index], lane_started_tasks[column_index]);
+            svg_text += element_text;
+        }
+        y_position += row_height;
+    }
+    svg_text += "</svg>\n";
+    if (output_format == TIMELINE_FORMAT_SVG) {
+        return svg_text;
+    }
+    return "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n<title>Timeline</title>\n</head>\n<body>\n<h1>" +
+           escape_print_text(view_title, PRINT_FORMAT_SVG) + "</h1>\n" + svg_text + "</body>\n</html>\n";
+}
+
+string render_timeline_view(const timeline_lod_index& lod_index, int view_first_serial_day, int view_last_serial_day,
+                            int column_count, int output_format) {
+    timeline_view_layout view_layout;
+    build_timeline_view_layout(lod_index, view_first_serial_day, view_last_serial_day, column_count, view_layout);
+    return format_timeline_view(lod_index, view_layout, view_first_serial_day, view_last_serial_day, output_format);
+}
+
+// Function loads first,last,lane[,title] rows from a mapped CSV file, assigning lanes in order of appearance
+bool read_timeline_task_file(const string& task_file_path, vector<timeline_task>& timeline_tasks, vector<string>& task_titles,
+                             vector<string>& lane_names, size_t& skipped_row_count) {
+    mapped_file_region mapped_tasks;
+    if (!map_file_read_only(task_file_path, mapped_tasks)) {
+        return false;
+    }
+    unordered_map<string, int> lane_lookup;
+    skipped_row_count = 0;
+    bool first_row = true;
+    const char* row_begin = mapped_tasks.mapped_data;
+    const char* data_end = mapped_tasks.mapped_data + mapped_tasks.mapped_size;
+    while (row_begin < data_end) {
+        const char* row_end = static_cast<const char*>(memchr(row_begin, '\n', size_t(data_end - row_begin)));
+        row_end = row_end == NULL ? data_end : row_end;
+        const char* next_row = row_end < data_end ? row_end + 1 : data_end;
+        if (row_end > row_begin && row_end[-1] == '\r') {
+            row_end--;
+        }
+        const char* field_begin[4];
+        const char* field_end[4];
+        int first_date[3];
+        int last_date[3];
+        bool row_valid = row_end > row_begin;
+        for (int field_index = 0; row_valid && field_index < 3; field_index++) {
+            row_valid = locate_csv_field(row_begin, row_end, field_index, ',', field_begin[field_index], field_end[field_index]);
+        }
+        bool first_date_valid = row_valid &&
+                    parse_iso_calendar_date(field_begin[0], size_t(field_end[0] - field_begin[0]), first_date[0], first_date[1], first_date[2]);
+        row_valid = first_date_valid &&
+                    parse_iso_calendar_date(field_begin[1], size_t(field_end[1] - field_begin[1]), last_date[0], last_date[1], last_date[2]);
+        if (row_valid) {
+            timeline_task current_task;
+            current_task.first_serial_day = calculate_serial_day_number(first_date[0], first_date[1], first_date[2]);
+            current_task.last_serial_day = calculate_serial_day_number(last_date[0], last_date[1], last_date[2]);
+            row_valid = current_task.last_serial_day >= current_task.first_serial_day;
+            if (row_valid) {
+                string lane_name(field_begin[2], field_end[2]);
+                unordered_map<string, int>::iterator lane_position = lane_lookup.find(lane_name);
+                if (lane_position == lane_lookup.end()) {
+                    lane_position = lane_lookup.insert(make_pair(lane_name, int(lane_names.size()))).first;
+                    lane_names.push_back(lane_name);
+                }
+                current_task.lane_index = lane_position->second;
+                timeline_tasks.push_back(current_task);
+                bool title_present = locate_csv_field(row_begin, row_end, 3, ',', field_begin[3], field_end[3]);
+                task_titles.push_back(title_present ? string(field_begin[3], field_end[3]) : string());
+            }
+        }
+        // A first row whose first field is not a date is a header such as first,last,lane,title
+        bool header_row = first_row && !first_date_valid;
+        skipped_row_count += row_valid || row_end == row_begin || header_row ? 0 : 1;
+        first_row = first_row && row_end == row_begin;
+        row_begin = next_row;
+    }
+    unmap_file_region(mapped_tasks);
+    return true;
+}
+
+int execute_timeline_rendering(int argument_count, char* argument_values[], const string& task_file_path) {
+    string format_text = find_command_line_option_value(argument_count, argument_values, "--timeline-format", "text");
+    string output_file_path = find_command_line_option_value(argument_count, argument_values, "--timeline-output", "");
+    string from_text = find_command_line_option_value(argument_count, argument_values, "--timeline-from", "");
+    string to_text = find_command_line_option_value(argument_count, argument_values, "--timeline-to", "");
+    int column_count = find_command_line_integer_option(argument_count, argument_values, "--timeline-width", 100);
+    int output_format = format_text == "text" ? TIMELINE_FORMAT_TEXT : format_text == "svg" ? TIMELINE_FORMAT_SVG :
+                        format_text == "html" ? TIMELINE_FORMAT_HTML : -1;
+    vector<timeline_task> timeline_tasks;
+    vector<string> task_titles;
+    vector<string> lane_names;
+    size_t skipped_row_count = 0;
+    if (output_format < 0 || column_count <= 0) {
+        cout << "ERROR: --timeline-format expects text, svg or html and --timeline-width a positive count" << endl;
+        return 1;
+    }
+    if (!read_timeline_task_file(task_file_path, timeline_tasks, task_titles, lane_names, skipped_row_count)) {
+        cout << "ERROR: Unable to read timeline tasks: " << task_file_path << endl;
+        return 1;
+    }
+
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    timeline_lod_index lod_index;
+    build_timeline_lod_index(timeline_tasks, task_titles, lane_names, lod_index,
+                             find_command_line_integer_option(argument_count, argument_values, "--threads", 0));
+    double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+
+    // The view defaults to the whole task span
+    int view_first_serial_day = lod_index.span_first_serial_day;
+    int view_last_serial_day = lod_index.span_last_serial_day;
+    int date_fields[3];
+    if (!from_text.empty()) {
+        if (!parse_iso_calendar_date(from_text.c_str(), from_text.size(), date_fields[0], date_fields[1], date_fields[2])) {
+            cout << "ERROR: --timeline-from expects YYYY-MM-DD" << endl;
+            return 1;
+        }
+        view_first_serial_day = calculate_serial_day_number(date_fields[0], date_fields[1], date_fields[2]);
+    }
+    if (!to_text.empty()) {
+        if (!parse_iso_calendar_date(to_text.c_str(), to_text.size(), date_fields[0], date_fields[1], date_fields[2])) {
+            cout << "ERROR: --timeline-to expects YYYY-MM-DD" << endl;
+            return 1;
+        }
+        view_last_serial_day = calculate_serial_day_number(date_fields[0], date_fields[1], date_fields[2]);
+    }
+    if (!from_text.empty() && !to_text.empty() && view_last_serial_day < view_first_serial_day) {
+        cout << "ERROR: --timeline-from must not be after --timeline-to" << endl;
+        return 1;
+    }
+    if (view_last_serial_day < view_first_serial_day) {
+        // A single bound past the task span still names a real range: the view collapses onto that day
+        view_first_serial_day = view_last_serial_day = from_text.empty() ? view_last_serial_day : view_first_serial_day;
+    }
+
+    start_time = chrono::steady_clock::now();
+    string rendered_output = render_timeline_view(lod_index, view_first_serial_day, view_last_serial_day, column_count,
+                                                  output_format);
+    double render_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    if (output_file_path.empty()) {
+        cout << rendered_output;
+    } else if (!write_file_atomically(output_file_path, rendered_output)) {
+        cout << "ERROR: Unable to write " << output_file_path << endl;
+        return 1;
+    } else {
+        cout << "Timeline Written: " << output_file_path << " (" << rendered_output.size() << " bytes)" << endl;
+    }
+    cout << "Tasks: " << timeline_tasks.size() << " in " << lane_names.size() << " lanes";
+    if (skipped_row_count > 0) {
+        cout << " (" << skipped_row_count << " rows skipped)";
+    }
+    cout << endl;
+    cout << "LOD Build: " << fixed << setprecision(3) << build_seconds * 1000.0 << " ms, Render: "
+         << render_seconds * 1000.0 << " ms" << endl;
+    return 0;
+}
+
+// Function folds one lane's daily active counts into a view's buckets (the scan baseline's aggregation)
+void aggregate_timeline_lane(const vector<int>& bucket_starts, const int32_t* active_counts, const int32_t* start_counts,
+                             size_t lane_offset, timeline_level_aggregates& output_aggregates) {
+    size_t bucket_count = bucket_starts.size() - 1;
+    for (size_t bucket_index = 0; bucket_index < bucket_count; bucket_index++) {
+        int first_offset = bucket_starts[bucket_index] - bucket_starts.front();
+        int end_offset = bucket_starts[bucket_index + 1] - bucket_starts.front();
+        int32_t peak_active = 0;
+        int64_t task_days = 0;
+        int32_t started_tasks = 0;
+        for (int day_offset = first_offset; day_offset < end_offset; day_offset++) {
+            peak_active = max(peak_active, active_counts[day_offset]);
+            task_days += active_counts[day_offset];
+            started_tasks += start_counts[day_offset];
+        }
+        output_aggregates.peak_active_tasks[lane_offset + bucket_index] = peak_active;
+        output_aggregates.task_day_totals[lane_offset + bucket_index] = task_days;
+        output_aggregates.started_task_counts[lane_offset + bucket_index] = started_tasks;
+    }
+}
+
+// Function renders a view by scanning every task, the per-zoom cost the LOD index removes
+string render_timeline_view_by_scan(const vector<timeline_task>& timeline_tasks, const timeline_lod_index& lod_index,
+                                    int view_first_serial_day, int view_last_serial_day, int column_count, int output_format) {
+    // Same level and buckets as the indexed render; aggregates and bar tasks recomputed from the tasks
+    timeline_view_layout view_layout;
+    int bucket_count = prepare_timeline_view_layout(lod_index, view_first_serial_day, view_last_serial_day, column_count,
+                                                    view_layout);
+    size_t lane_count = lod_index.lane_names.size();
+    if (bucket_count > 0) {
+        const vector<int>& bucket_starts = view_layout.visible_buckets.bucket_first_serial_days;
+        int window_first_day = bucket_starts.front();
+        int window_end_day = bucket_starts.back();
+        size_t window_day_count = size_t(window_end_day - window_first_day);
+        vector<int32_t> daily_active(lane_count * window_day_count, 0);
+        vector<int32_t> daily_starts(lane_count * window_day_count, 0);
+        for (size_t task_index = 0; task_index < timeline_tasks.size(); task_index++) {
+            const timeline_task& current_task = timeline_tasks[task_index];
+            int32_t* lane_active = daily_active.data() + size_t(current_task.lane_index) * window_day_count;
+            for (int serial_day = max(current_task.first_serial_day, window_first_day);
+                 serial_day <= min(current_task.last_serial_day, window_end_day - 1); serial_day++) {
+                lane_active[serial_day - window_first_day]++;
+            }
+            if (current_task.first_serial_day >= window_first_day && current_task.first_serial_day < window_end_day) {
+                daily_starts[size_t(current_task.lane_index) * window_day_count +
+                             size_t(current_task.first_serial_day - window_first_day)]++;
+            }
+        }
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            aggregate_timeline_lane(bucket_starts, daily_active.data() + lane_index * window_day_count,
+                                    daily_starts.data() + lane_index * window_day_count, lane_index * size_t(bucket_count),
+                                    view_layout.visible_buckets);
+        }
+
+        // Bar lanes: every task is checked against the window
+        for (size_t lane_index = 0; lane_index < lane_count; lane_index++) {
+            size_t lane_bar_begin = view_layout.bar_task_positions.size();
+            for (size_t task_position = lod_index.lane_task_offsets[lane_index];
+                 view_layout.level_kind <= TIMELINE_LEVEL_WEEK && task_position < lod_index.lane_task_offsets[lane_index + 1];
+                 task_position++) {
+                if (lod_index.task_first_serial_days[task_position] < window_end_day &&
+                    lod_index.task_last_serial_days[task_position] >= window_first_day) {
+                    view_layout.bar_task_positions.push_back(task_position);
+                }
+            }
+            if (view_layout.bar_task_positions.size() - lane_bar_begin > size_t(TIMELINE_BAR_TASK_LIMIT)) {
+                view_layout.bar_task_positions.resize(lane_bar_begin);
+            } else {
+                view_layout.lane_shows_bars[lane_index] = view_layout.level_kind <= TIMELINE_LEVEL_WEEK ? 1 : 0;
+            }
+            view_layout.lane_bar_offsets[lane_index + 1] = view_layout.bar_task_positions.size();
+        }
+    }
+    return format_timeline_view(lod_index, view_layout, view_first_serial_day, view_last_serial_day, output_format);
+}
+
+int execute_timeline_benchmark(int task_count) {
+    // Tasks of 1-60 days in 200 lanes over five years
+    const int lane_count = 200;
+    const int span_first_serial_day = calculate_serial_day_number(1, 1, 2025);
+    const int span_day_count = calculate_serial_day_number(31, 12, 2029) - span_first_serial_day + 1;
+    vector<string> lane_names;
+    for (int lane_index = 0; lane_index < lane_count; lane_index++) {
+        lane_names.push_back("project-" + to_string(lane_index));
+    }
+    vector<timeline_task> timeline_tasks(static_cast<size_t>(task_count));
+    vector<string> task_titles(timeline_tasks.size());
+    uint64_t random_state = 0x2545F4914F6CDD1DULL;
+    for (size_t task_index = 0; task_index < timeline_tasks.size(); task_index++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        timeline_task& current_task = timeline_tasks[task_index];
+        current_task.lane_index = int(random_state % lane_count);
+        current_task.first_serial_day = span_first_serial_day + int((random_state >> 16) % uint64_t(span_day_count));
+        current_task.last_serial_day = min(current_task.first_serial_day + int((random_state >> 40) % 60),
+                                           span_first_serial_day + span_day_count - 1);
+        task_titles[task_index] = "task-" + to_string(task_index);
+    }
+
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+    timeline_lod_index lod_index;
+    build_timeline_lod_index(timeline_tasks, task_titles, lane_names, lod_index, 0);
+    double build_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+    size_t run_count = 0;
+    for (int level_kind = 0; level_kind < TIMELINE_LEVEL_COUNT; level_kind++) {
+        run_count += lod_index.bucket_runs[level_kind].size();
+    }
+
+    // One view per zoom level: whole span, one year, one quarter, one month on a 120-column screen,
+    // then a fortnight and a view past the span's end
+    const int view_lengths[] = {span_day_count, 365, 91, 31, 14};
+    const int column_count = 120;
+    bool results_match = true;
+    cout << "TIMELINE LOD BENCHMARK (" << task_count << " tasks, " << lane_count << " lanes, 2025-2029)" << endl;
+    cout << string(60, '-') << endl;
+    cout << "LOD Build: " << fixed << setprecision(3) << build_seconds * 1000.0 << " ms, " << run_count << " bucket runs ("
+         << run_count * sizeof(timeline_bucket_run) / 1024 << " KiB)" << endl;
+    for (size_t view_index = 0; view_index < sizeof(view_lengths) / sizeof(view_lengths[0]); view_index++) {
+        int view_first_serial_day = span_first_serial_day + (span_day_count - view_lengths[view_index]) / 2;
+        int view_last_serial_day = view_first_serial_day + view_lengths[view_index] - 1;
+        timeline_view_layout view_layout;
+        build_timeline_view_layout(lod_index, view_first_serial_day, view_last_serial_day, column_count, view_layout);
+        size_t bar_lane_count = size_t(count(view_layout.lane_shows_bars.begin(), view_layout.lane_shows_bars.end(), 1));
+        const int repetition_count = 20;
+        string indexed_output;
+        string scanned_output;
+        start_time = chrono::steady_clock::now();
+        for (int repetition_index = 0; repetition_index < repetition_count; repetition_index++) {
+            indexed_output = render_timeline_view(lod_index, view_first_serial_day, view_last_serial_day, column_count,
+                                                  TIMELINE_FORMAT_TEXT);
+        }
+        double indexed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count() / repetition_count;
+        start_time = chrono::steady_clock::now();
+        scanned_output = render_timeline_view_by_scan(timeline_tasks, lod_index, view_first_serial_day, view_last_serial_day,
+                                                      column_count, TIMELINE_FORMAT_TEXT);
+        double scanned_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        results_match = results_match && indexed_output == scanned_output;
+        cout << setw(4) << view_lengths[view_index] << "-day view (" << timeline_level_names[view_layout.level_kind] << ", "
+             << view_layout.visible_buckets.bucket_first_serial_days.size() - 1 << " columns, " << bar_lane_count
+             << " bar lanes): scan " << setprecision(3) << scanned_seconds * 1000.0 << " ms, LOD "
+             << indexed_seconds * 1000.0 << " ms" << endl;
+    }
+
+    // A view wholly after the task span must come back as an empty view from both renderers
+    string empty_output = render_timeline_view(lod_index, span_first_serial_day + span_day_count,
+                                               span_first_serial_day + span_day_count + 30, column_count, TIMELINE_FORMAT_TEXT);
+    results_match = results_match && empty_output.find("empty view") != string::npos &&
+                    empty_output == render_timeline_view_by_scan(timeline_tasks, lod_index, span_first_serial_day + span_day_count,
+                                                                 span_first_serial_day + span_day_count + 30, column_count,
+                                                                 TIMELINE_FORMAT_TEXT);
+    
+    // On a screen narrower than the span's years, years share columns and the whole span is still drawn
+    int span_last_serial_day = span_first_serial_day + span_day_count - 1;
+    string narrow_output = render_timeline_view(lod_index, span_first_serial_day, span_last_serial_day, 3, TIMELINE_FORMAT_TEXT);
+    results_match = results_match && narrow_output.find(" to " + format_timeline_day_text(span_last_serial_day)) != string::npos &&
+                    narrow_output == render_timeline_view_by_scan(timeline_tasks, lod_index, span_first_serial_day,
+                                                                  span_last_serial_day, 3, TIMELINE_FORMAT_TEXT);
+    cout << "Results: " << (results_match ? "match" : "MISMATCH") << endl;
+    return results_match ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/*
+================================================================================
+CALENDAR C ABI INTERFACE
+================================================================================
+Purpose: Stable C calling convention around the calendar core for use from
+         foreign function interfaces, with scalar and batch entry points
+Build:   Compile CALENDAR BY ARTLEST.cpp with -DCALENDAR_LIBRARY_BUILD as a
+         shared library (see README.md)
+Standards: C89 compatible declarations, C++11 implementation
+================================================================================
+*/
+
+#ifndef CALENDAR_C_API_H
+#define CALENDAR_C_API_H
+
+#include <stddef.h>      /* Provides size_t for buffer and array lengths */
+#include <stdint.h>      /* Provides fixed-width integer types for array elements */
+
+/* Symbol export control for the shared library build */
+#if defined(_WIN32)
+#  if defined(CALENDAR_LIBRARY_BUILD)
+#    define CALENDAR_API __declspec(dllexport)
+#  else
+#    define CALENDAR_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define CALENDAR_API __attribute__((visibility("default")))
+#else
+#  define CALENDAR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Interface version, incremented only for backward compatible additions */
+#define CALENDAR_API_VERSION 2
+
+/* Supported proleptic Gregorian year range */
+#define CALENDAR_MIN_YEAR 1
+#define CALENDAR_MAX_YEAR 9999
+
+/* Status codes returned by entry points (negative values indicate failure) */
+#define CALENDAR_STATUS_OK 0
+#define CALENDAR_STATUS_INVALID_ARGUMENT -1
+#define CALENDAR_STATUS_BUFFER_TOO_SMALL -2
+
+/* Annual statistics matching the statistical analysis report */
+typedef struct calendar_year_statistics {
+    int32_t year;                  /* Year the statistics describe */
+    int32_t leap_year;             /* 1 for leap years, 0 otherwise */
+    int32_t total_days;            /* Days in the year */
+    int32_t weekend_days;          /* Saturdays and Sundays */
+    int32_t weekday_count;         /* Monday through Friday days */
+    int32_t shortest_month_days;   /* Length of the shortest month */
+    int32_t longest_month_days;    /* Length of the longest month */
+    int32_t reserved;              /* Padding kept zero for layout stability */
+    double average_month_days;     /* Mean month length */
+    double weekend_percentage;     /* Weekend share of total days */
+} calendar_year_statistics;
+
+/*
+--------------------------------------------------------------------------------
+SCALAR ENTRY POINTS
+Each returns CALENDAR_STATUS_INVALID_ARGUMENT for out-of-range input.
+--------------------------------------------------------------------------------
+*/
+
+/* Returns CALENDAR_API_VERSION of the loaded library */
+CALENDAR_API int32_t calendar_api_version(void);
+
+/* Returns 1 for leap years and 0 for common years */
+CALENDAR_API int32_t calendar_is_leap_year(int32_t year);
+
+/* Returns the number of days in the month (28 to 31) */
+CALENDAR_API int32_t calendar_month_length(int32_t month, int32_t year);
+
+/* Returns the day of week for the date (0=Sunday through 6=Saturday) */
+CALENDAR_API int32_t calendar_weekday(int32_t day, int32_t month, int32_t year);
+
+/* Returns the one-based day of year position for the date */
+CALENDAR_API int32_t calendar_day_of_year(int32_t day, int32_t month, int32_t year);
+
+/*
+--------------------------------------------------------------------------------
+BATCH ENTRY POINTS
+Input and output arrays are contiguous with element_count entries. Invalid
+elements produce -1 in their output slot and the call returns
+CALENDAR_STATUS_INVALID_ARGUMENT after processing every element.
+--------------------------------------------------------------------------------
+*/
+
+CALENDAR_API int32_t calendar_batch_is_leap_year(const int32_t* years, int32_t* results, size_t element_count);
+
+CALENDAR_API int32_t calendar_batch_month_length(const int32_t* months, const int32_t* years,
+                                                 int32_t* results, size_t element_count);
+
+CALENDAR_API int32_t calendar_batch_weekday(const int32_t* days, const int32_t* months, const int32_t* years,
+                                            int32_t* results, size_t element_count);
+
+CALENDAR_API int32_t calendar_batch_day_of_year(const int32_t* days, const int32_t* months, const int32_t* years,
+                                                int32_t* results, size_t element_count);
+
+/*
+--------------------------------------------------------------------------------
+RENDERING AND STATISTICS ENTRY POINTS
+Rendered text matches generate_monthly_calendar_display byte for byte and is
+not NUL-terminated. When the buffer is too small nothing is written,
+*bytes_required receives the needed size and CALENDAR_STATUS_BUFFER_TOO_SMALL
+is returned; pass a NULL buffer with zero capacity to query the size.
+--------------------------------------------------------------------------------
+*/
+
+/* Renders one month into buffer; *bytes_required receives the text length */
+CALENDAR_API int32_t calendar_render_month(int32_t month, int32_t year, char* buffer,
+                                           size_t buffer_capacity, size_t* bytes_required);
+
+/* Renders months back to back; month_offsets (optional) receives element_count + 1 offsets */
+CALENDAR_API int32_t calendar_batch_render_months(const int32_t* months, const int32_t* years, size_t element_count,
+                                                  char* buffer, size_t buffer_capacity,
+                                                  size_t* month_offsets, size_t* bytes_required);
+
+/* Fills statistics for one year */
+CALENDAR_API int32_t calendar_year_statistics_compute(int32_t year, calendar_year_statistics* statistics);
+
+/* Fills statistics for element_count years; invalid years leave year set to -1 */
+CALENDAR_API int32_t calendar_batch_year_statistics(const int32_t* years, calendar_year_statistics* statistics,
+                                                    size_t element_count);
+
+/*
+--------------------------------------------------------------------------------
+SORTING ENTRY POINTS (API version 2)
+Serial day numbers count from 0001-01-01 = 1. Columns are sorted in place
+with LSD radix passes; thread_count 0 uses every hardware thread.
+--------------------------------------------------------------------------------
+*/
+
+/* Sorts serial days ascending; when remove_duplicates is nonzero the distinct
+   values are left at the front and *result_count (optional) receives their number */
+CALENDAR_API int32_t calendar_batch_sort_serial_days(int32_t* serial_days, size_t element_count, int32_t remove_duplicates,
+                                                     int32_t thread_count, size_t* result_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALENDAR_C_API_H */
@@ -0,0 +1,139 @@
+/*
+================================================================================
+CALENDAR C ABI BENCHMARK PROGRAM
+================================================================================
+Purpose: Compares one-call-per-date scalar entry points with the batch entry
+         points over the same contiguous date arrays
+Usage:   cc -O2 calendar_c_api_benchmark.c -L. -lcalendar -o calendar_c_api_benchmark
+         ./calendar_c_api_benchmark [element_count]
+Standards: C99
+================================================================================
+*/
+
+#include <stdio.h>       /* Provides formatted console output */
+#include <stdlib.h>      /* Provides dynamic array allocation */
+#include <time.h>        /* Provides processor clock measurement */
+
+#include "calendar_c_api.h"
+
+/* Returns elapsed processor seconds since the supplied clock reading */
+static double measure_elapsed_seconds(clock_t start_clock) {
+    return (double)(clock() - start_clock) / CLOCKS_PER_SEC;
+}
+
+/* Orders serial days for the qsort baseline */
+static int compare_serial_days(const void* left_value, const void* right_value) {
+    int32_t left_day = *(const int32_t*)left_value;
+    int32_t right_day = *(const int32_t*)right_value;
+    return (left_day > right_day) - (left_day < right_day);
+}
+
+/* Prints one benchmark line with throughput in million dates per second */
+static void report_benchmark_result(const char* benchmark_name, size_t element_count, double elapsed_seconds,
+                                    long result_checksum) {
+    printf("  %-26s %8.3f s %10.1f M dates/s   (checksum %ld)\n", benchmark_name, elapsed_seconds,
+           elapsed_seconds > 0.0 ? (double)element_count / elapsed_seconds / 1e6 : 0.0, result_checksum);
+}
+
+int main(int argument_count, char* argument_values[]) {
+    size_t element_count = argument_count > 1 ? (size_t)strtoul(argument_values[1], NULL, 10) : 10000000;
+    int32_t* days = (int32_t*)malloc(element_count * sizeof(int32_t));
+    int32_t* months = (int32_t*)malloc(element_count * sizeof(int32_t));
+    int32_t* years = (int32_t*)malloc(element_count * sizeof(int32_t));
+    int32_t* results = (int32_t*)malloc(element_count * sizeof(int32_t));
+    size_t element_index;
+    clock_t start_clock;
+    long result_checksum;
+
+    if (days == NULL || months == NULL || years == NULL || results == NULL) {
+        printf("ERROR: Unable to allocate %lu elements\n", (unsigned long)element_count);
+        return 1;
+    }
+
+    /* Consecutive days starting 1970-01-01, the typical layout of a date column */
+    {
+        int32_t day = 1, month = 1, year = 1970;
+        for (element_index = 0; element_index < element_count; element_index++) {
+            days[element_index] = day;
+            months[element_index] = month;
+            years[element_index] = year;
+            if (++day > calendar_month_length(month, year)) {
+                day = 1;
+                if (++month > 12) {
+                    month = 1;
+                    year = year < CALENDAR_MAX_YEAR ? year + 1 : 1970;
+                }
+            }
+        }
+    }
+
+    printf("C ABI BENCHMARK (%lu dates)\n", (unsigned long)element_count);
+
+    start_clock = clock();
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += calendar_weekday(days[element_index], months[element_index], years[element_index]);
+    }
+    report_benchmark_result("weekday scalar", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    start_clock = clock();
+    calendar_batch_weekday(days, months, years, results, element_count);
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += results[element_index];
+    }
+    report_benchmark_result("weekday batch", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    start_clock = clock();
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += calendar_day_of_year(days[element_index], months[element_index], years[element_index]);
+    }
+    report_benchmark_result("day of year scalar", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    start_clock = clock();
+    calendar_batch_day_of_year(days, months, years, results, element_count);
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += results[element_index];
+    }
+    report_benchmark_result("day of year batch", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    start_clock = clock();
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += calendar_month_length(months[element_index], years[element_index]);
+    }
+    report_benchmark_result("month length scalar", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    start_clock = clock();
+    calendar_batch_month_length(months, years, results, element_count);
+    result_checksum = 0;
+    for (element_index = 0; element_index < element_count; element_index++) {
+        result_checksum += results[element_index];
+    }
+    report_benchmark_result("month length batch", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    /* Shuffled serial days: qsort against the radix batch sort (single thread for a like-for-like clock) */
+    for (element_index = 0; element_index < element_count; element_index++) {
+        results[element_index] = 719163 + (int32_t)(((uint32_t)element_index * 2654435761U) % 40000U);
+    }
+    start_clock = clock();
+    qsort(results, element_count, sizeof(int32_t), compare_serial_days);
+    result_checksum = element_count > 0 ? results[element_count / 2] : 0;
+    report_benchmark_result("sort serial days qsort", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    for (element_index = 0; element_index < element_count; element_index++) {
+        results[element_index] = 719163 + (int32_t)(((uint32_t)element_index * 2654435761U) % 40000U);
+    }
+    start_clock = clock();
+    calendar_batch_sort_serial_days(results, element_count, 0, 1, NULL);
+    result_checksum = element_count > 0 ? results[element_count / 2] : 0;
+    report_benchmark_result("sort serial days batch", element_count, measure_elapsed_seconds(start_clock), result_checksum);
+
+    free(days);
+    free(months);
+    free(years);
+    free(results);
+    return 0;
+}
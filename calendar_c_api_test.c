@@ -0,0 +1,206 @@
+/*
+================================================================================
+CALENDAR C ABI TEST PROGRAM
+================================================================================
+Purpose: Verifies the exported C entry points against known calendar facts
+         and checks that batch results match the scalar functions
+Usage:   cc calendar_c_api_test.c -L. -lcalendar -o calendar_c_api_test
+Standards: C99
+================================================================================
+*/
+
+#include <stdio.h>       /* Provides formatted console output */
+#include <string.h>      /* Provides memory comparison for rendered text */
+#include <stdlib.h>      /* Provides dynamic buffer allocation */
+
+#include "calendar_c_api.h"
+
+static int executed_check_count = 0;
+static int failed_check_count = 0;
+
+/* Records a check result and reports failures with their source line */
+static void verify_condition(int condition_result, const char* condition_text, int source_line) {
+    executed_check_count++;
+    if (!condition_result) {
+        failed_check_count++;
+        printf("FAILED (line %d): %s\n", source_line, condition_text);
+    }
+}
+
+#define CHECK(condition) verify_condition((condition) ? 1 : 0, #condition, __LINE__)
+
+static void test_scalar_entry_points(void) {
+    CHECK(calendar_api_version() == CALENDAR_API_VERSION);
+
+    /* Leap year rules including century exceptions */
+    CHECK(calendar_is_leap_year(2024) == 1);
+    CHECK(calendar_is_leap_year(2025) == 0);
+    CHECK(calendar_is_leap_year(1900) == 0);
+    CHECK(calendar_is_leap_year(2000) == 1);
+    CHECK(calendar_is_leap_year(0) == CALENDAR_STATUS_INVALID_ARGUMENT);
+
+    /* Month lengths */
+    CHECK(calendar_month_length(2, 2024) == 29);
+    CHECK(calendar_month_length(2, 2023) == 28);
+    CHECK(calendar_month_length(4, 2025) == 30);
+    CHECK(calendar_month_length(12, 2025) == 31);
+    CHECK(calendar_month_length(13, 2025) == CALENDAR_STATUS_INVALID_ARGUMENT);
+
+    /* Weekdays (0=Sunday) */
+    CHECK(calendar_weekday(1, 1, 2025) == 3);
+    CHECK(calendar_weekday(4, 7, 1776) == 4);
+    CHECK(calendar_weekday(1, 1, 1) == 1);
+    CHECK(calendar_weekday(31, 12, 9999) == 5);
+    CHECK(calendar_weekday(30, 2, 2024) == CALENDAR_STATUS_INVALID_ARGUMENT);
+
+    /* Day of year positions */
+    CHECK(calendar_day_of_year(1, 1, 2025) == 1);
+    CHECK(calendar_day_of_year(1, 3, 2024) == 61);
+    CHECK(calendar_day_of_year(31, 12, 2024) == 366);
+    CHECK(calendar_day_of_year(0, 1, 2024) == CALENDAR_STATUS_INVALID_ARGUMENT);
+}
+
+static void test_batch_entry_points(void) {
+    enum { ELEMENT_COUNT = 4000 };
+    static int32_t days[ELEMENT_COUNT], months[ELEMENT_COUNT], years[ELEMENT_COUNT];
+    static int32_t batch_results[ELEMENT_COUNT];
+    int element_index;
+    int batch_matches = 1;
+
+    /* Build a spread of valid dates across the supported range */
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        years[element_index] = 1 + (element_index * 7919) % CALENDAR_MAX_YEAR;
+        months[element_index] = 1 + element_index % 12;
+        days[element_index] = 1 + element_index % 28;
+    }
+
+    CHECK(calendar_batch_is_leap_year(years, batch_results, ELEMENT_COUNT) == CALENDAR_STATUS_OK);
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        batch_matches &= batch_results[element_index] == calendar_is_leap_year(years[element_index]);
+    }
+    CHECK(batch_matches);
+
+    CHECK(calendar_batch_month_length(months, years, batch_results, ELEMENT_COUNT) == CALENDAR_STATUS_OK);
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        batch_matches &= batch_results[element_index] == calendar_month_length(months[element_index], years[element_index]);
+    }
+    CHECK(batch_matches);
+
+    CHECK(calendar_batch_weekday(days, months, years, batch_results, ELEMENT_COUNT) == CALENDAR_STATUS_OK);
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        batch_matches &= batch_results[element_index] ==
+                         calendar_weekday(days[element_index], months[element_index], years[element_index]);
+    }
+    CHECK(batch_matches);
+
+    CHECK(calendar_batch_day_of_year(days, months, years, batch_results, ELEMENT_COUNT) == CALENDAR_STATUS_OK);
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        batch_matches &= batch_results[element_index] ==
+                         calendar_day_of_year(days[element_index], months[element_index], years[element_index]);
+    }
+    CHECK(batch_matches);
+
+    /* Invalid elements are flagged in place without stopping the batch */
+    days[10] = 31;
+    months[10] = 2;
+    CHECK(calendar_batch_weekday(days, months, years, batch_results, ELEMENT_COUNT) == CALENDAR_STATUS_INVALID_ARGUMENT);
+    CHECK(batch_results[10] == CALENDAR_STATUS_INVALID_ARGUMENT);
+    CHECK(batch_results[11] == calendar_weekday(days[11], months[11], years[11]));
+    CHECK(calendar_batch_weekday(NULL, months, years, batch_results, 1) == CALENDAR_STATUS_INVALID_ARGUMENT);
+}
+
+static void test_rendering_entry_points(void) {
+    const char expected_prefix[] = "\n             January 2025\n----------------------------\n Su Mo Tu We Th Fr Sa\n"
+                                   "           1  2  3  4\n";
+    int32_t render_months[3] = {1, 2, 12};
+    int32_t render_years[3] = {2025, 2024, 1999};
+    size_t month_offsets[4];
+    size_t required_size = 0;
+    size_t single_size = 0;
+    char* render_buffer;
+    char* single_buffer;
+    int element_index;
+
+    /* Size query followed by render into an exactly sized buffer */
+    CHECK(calendar_render_month(1, 2025, NULL, 0, &required_size) == CALENDAR_STATUS_BUFFER_TOO_SMALL);
+    CHECK(required_size > sizeof(expected_prefix));
+    render_buffer = (char*)malloc(required_size);
+    CHECK(calendar_render_month(1, 2025, render_buffer, required_size, &single_size) == CALENDAR_STATUS_OK);
+    CHECK(single_size == required_size);
+    CHECK(memcmp(render_buffer, expected_prefix, sizeof(expected_prefix) - 1) == 0);
+    free(render_buffer);
+
+    /* Batch rendering concatenates the individual renders */
+    CHECK(calendar_batch_render_months(render_months, render_years, 3, NULL, 0, NULL, &required_size) ==
+          CALENDAR_STATUS_BUFFER_TOO_SMALL);
+    render_buffer = (char*)malloc(required_size);
+    CHECK(calendar_batch_render_months(render_months, render_years, 3, render_buffer, required_size,
+                                       month_offsets, &required_size) == CALENDAR_STATUS_OK);
+    CHECK(month_offsets[0] == 0 && month_offsets[3] == required_size);
+    for (element_index = 0; element_index < 3; element_index++) {
+        calendar_render_month(render_months[element_index], render_years[element_index], NULL, 0, &single_size);
+        single_buffer = (char*)malloc(single_size);
+        calendar_render_month(render_months[element_index], render_years[element_index], single_buffer, single_size,
+                              &single_size);
+        CHECK(month_offsets[element_index + 1] - month_offsets[element_index] == single_size);
+        CHECK(memcmp(render_buffer + month_offsets[element_index], single_buffer, single_size) == 0);
+        free(single_buffer);
+    }
+    free(render_buffer);
+}
+
+static void test_statistics_entry_points(void) {
+    int32_t statistics_years[3] = {2024, 2025, 0};
+    calendar_year_statistics year_statistics[3];
+
+    CHECK(calendar_batch_year_statistics(statistics_years, year_statistics, 3) == CALENDAR_STATUS_INVALID_ARGUMENT);
+    CHECK(year_statistics[0].leap_year == 1 && year_statistics[0].total_days == 366);
+    CHECK(year_statistics[0].weekend_days == 104 && year_statistics[0].weekday_count == 262);
+    CHECK(year_statistics[1].leap_year == 0 && year_statistics[1].total_days == 365);
+    CHECK(year_statistics[1].shortest_month_days == 28 && year_statistics[1].longest_month_days == 31);
+    CHECK(year_statistics[2].year == -1);
+    CHECK(calendar_year_statistics_compute(2025, NULL) == CALENDAR_STATUS_INVALID_ARGUMENT);
+}
+
+static void test_sorting_entry_points(void) {
+    enum { ELEMENT_COUNT = 200000 };
+    static int32_t serial_days[ELEMENT_COUNT];
+    int32_t small_days[6] = {739000, -5, 1, 739000, 3652059, 1};
+    size_t result_count = 0;
+    int element_index;
+    int sorted_order = 1;
+
+    /* Small columns, including negative values and duplicates */
+    CHECK(calendar_batch_sort_serial_days(small_days, 6, 1, 1, &result_count) == CALENDAR_STATUS_OK);
+    CHECK(result_count == 4);
+    CHECK(small_days[0] == -5 && small_days[1] == 1 && small_days[2] == 739000 && small_days[3] == 3652059);
+
+    /* Radix path with duplicates spread across several worker chunks */
+    for (element_index = 0; element_index < ELEMENT_COUNT; element_index++) {
+        serial_days[element_index] = 693596 + (int32_t)(((uint32_t)element_index * 2654435761U) % 5000U);
+    }
+    CHECK(calendar_batch_sort_serial_days(serial_days, ELEMENT_COUNT, 0, 3, &result_count) == CALENDAR_STATUS_OK);
+    CHECK(result_count == ELEMENT_COUNT);
+    for (element_index = 1; element_index < ELEMENT_COUNT; element_index++) {
+        sorted_order &= serial_days[element_index - 1] <= serial_days[element_index];
+    }
+    CHECK(sorted_order);
+    CHECK(calendar_batch_sort_serial_days(serial_days, ELEMENT_COUNT, 1, 3, &result_count) == CALENDAR_STATUS_OK);
+    CHECK(result_count == 5000);
+    for (element_index = 1; element_index < (int)result_count; element_index++) {
+        sorted_order &= serial_days[element_index - 1] + 1 == serial_days[element_index];
+    }
+    CHECK(sorted_order);
+    CHECK(calendar_batch_sort_serial_days(NULL, 1, 0, 0, NULL) == CALENDAR_STATUS_INVALID_ARGUMENT);
+}
+
+int main(void) {
+    test_scalar_entry_points();
+    test_batch_entry_points();
+    test_rendering_entry_points();
+    test_statistics_entry_points();
+    test_sorting_entry_points();
+
+    printf("C ABI checks: %d executed, %d failed\n", executed_check_count, failed_check_count);
+    return failed_check_count == 0 ? 0 : 1;
+}